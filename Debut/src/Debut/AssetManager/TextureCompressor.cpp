@@ -0,0 +1,732 @@
+#include <Debut/dbtpch.h>
+#include <Debut/AssetManager/TextureCompressor.h>
+#include <Debut/Core/JobSystem.h>
+
+#include <cfloat>
+
+#ifdef DBT_SIMD_SSE
+	#include <emmintrin.h>
+#endif
+
+namespace Debut
+{
+	// Block pixels split by channel so that 4 pixels can be processed at once
+	struct alignas(16) ColorBlock
+	{
+		float Channels[4][16];
+	};
+
+	static const float s_BC1Weights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+	static const float s_BC4Weights[8] = { 0.0f, 1.0f, 1.0f / 7.0f, 2.0f / 7.0f, 3.0f / 7.0f, 4.0f / 7.0f, 5.0f / 7.0f, 6.0f / 7.0f };
+	static const uint32_t s_BC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	static void LoadBlock(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, ColorBlock& block)
+	{
+		// Blocks on the border of non multiple of 4 levels repeat the last pixel
+		for (uint32_t y = 0; y < 4; y++)
+		{
+			uint32_t pixelY = std::min(blockY * 4 + y, height - 1);
+			for (uint32_t x = 0; x < 4; x++)
+			{
+				uint32_t pixelX = std::min(blockX * 4 + x, width - 1);
+				const uint8_t* pixel = pixels + ((size_t)pixelY * width + pixelX) * 4;
+
+				for (uint32_t c = 0; c < 4; c++)
+					block.Channels[c][y * 4 + x] = pixel[c];
+			}
+		}
+	}
+
+	// Finds the closest palette entry for each pixel and returns the total weighted squared error
+	static float FindClosest(const ColorBlock& block, const float palette[][4], uint32_t nEntries, const float weights[4], uint8_t* indices)
+	{
+#ifdef DBT_SIMD_SSE
+		__m128 totalError = _mm_setzero_ps();
+
+		for (uint32_t p = 0; p < 16; p += 4)
+		{
+			__m128 channels[4];
+			for (uint32_t c = 0; c < 4; c++)
+				channels[c] = _mm_load_ps(block.Channels[c] + p);
+
+			__m128 bestError = _mm_set1_ps(FLT_MAX);
+			__m128i bestIndex = _mm_setzero_si128();
+
+			for (uint32_t i = 0; i < nEntries; i++)
+			{
+				__m128 error = _mm_setzero_ps();
+				for (uint32_t c = 0; c < 4; c++)
+				{
+					__m128 diff = _mm_sub_ps(channels[c], _mm_set1_ps(palette[i][c]));
+					error = _mm_add_ps(error, _mm_mul_ps(_mm_mul_ps(diff, diff), _mm_set1_ps(weights[c])));
+				}
+
+				__m128i closer = _mm_castps_si128(_mm_cmplt_ps(error, bestError));
+				bestError = _mm_min_ps(error, bestError);
+				bestIndex = _mm_or_si128(_mm_andnot_si128(closer, bestIndex), _mm_and_si128(closer, _mm_set1_epi32(i)));
+			}
+
+			alignas(16) int32_t pixelIndices[4];
+			_mm_store_si128((__m128i*)pixelIndices, bestIndex);
+			for (uint32_t i = 0; i < 4; i++)
+				indices[p + i] = (uint8_t)pixelIndices[i];
+
+			totalError = _mm_add_ps(totalError, bestError);
+		}
+
+		alignas(16) float errors[4];
+		_mm_store_ps(errors, totalError);
+		return errors[0] + errors[1] + errors[2] + errors[3];
+#else
+		float totalError = 0.0f;
+		for (uint32_t p = 0; p < 16; p++)
+		{
+			float bestError = FLT_MAX;
+			for (uint32_t i = 0; i < nEntries; i++)
+			{
+				float error = 0.0f;
+				for (uint32_t c = 0; c < 4; c++)
+				{
+					float diff = block.Channels[c][p] - palette[i][c];
+					error += diff * diff * weights[c];
+				}
+
+				if (error < bestError)
+				{
+					bestError = error;
+					indices[p] = (uint8_t)i;
+				}
+			}
+			totalError += bestError;
+		}
+		return totalError;
+#endif
+	}
+
+	static void ComputeEndpoints(const ColorBlock& block, const float weights[4], Texture2DParameter quality, float start[4], float end[4])
+	{
+		float mean[4] = { 0, 0, 0, 0 };
+		float min[4] = { 255, 255, 255, 255 };
+		float max[4] = { 0, 0, 0, 0 };
+
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			for (uint32_t p = 0; p < 16; p++)
+			{
+				mean[c] += block.Channels[c][p];
+				min[c] = std::min(min[c], block.Channels[c][p]);
+				max[c] = std::max(max[c], block.Channels[c][p]);
+			}
+			mean[c] /= 16.0f;
+		}
+
+		float covariance[4][4] = {};
+		for (uint32_t p = 0; p < 16; p++)
+			for (uint32_t i = 0; i < 4; i++)
+				for (uint32_t j = i; j < 4; j++)
+					covariance[i][j] += (block.Channels[i][p] - mean[i]) * (block.Channels[j][p] - mean[j]) * weights[i] * weights[j];
+		for (uint32_t i = 0; i < 4; i++)
+			for (uint32_t j = 0; j < i; j++)
+				covariance[i][j] = covariance[j][i];
+
+		if (quality == Texture2DParameter::QUALITY_FAST)
+		{
+			// Bounding box diagonal, flipping the channels that go against the one with the biggest spread
+			uint32_t mainChannel = 0;
+			for (uint32_t c = 1; c < 4; c++)
+				if (covariance[c][c] > covariance[mainChannel][mainChannel])
+					mainChannel = c;
+
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				bool flip = covariance[mainChannel][c] < 0.0f;
+				start[c] = flip ? max[c] : min[c];
+				end[c] = flip ? min[c] : max[c];
+			}
+			return;
+		}
+
+		// Principal axis with power iteration, starting from the bounding box diagonal
+		float axis[4];
+		for (uint32_t c = 0; c < 4; c++)
+			axis[c] = (max[c] - min[c]) * weights[c];
+
+		for (uint32_t iteration = 0; iteration < 8; iteration++)
+		{
+			float next[4] = { 0, 0, 0, 0 };
+			float length = 0.0f;
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				for (uint32_t j = 0; j < 4; j++)
+					next[i] += covariance[i][j] * axis[j];
+				length = std::max(length, std::abs(next[i]));
+			}
+
+			if (length < FLT_EPSILON)
+				break;
+			for (uint32_t c = 0; c < 4; c++)
+				axis[c] = next[c] / length;
+		}
+
+		float axisLength = 0.0f;
+		for (uint32_t c = 0; c < 4; c++)
+			axisLength += axis[c] * axis[c];
+
+		// Flat block
+		if (axisLength < FLT_EPSILON)
+		{
+			for (uint32_t c = 0; c < 4; c++)
+				start[c] = end[c] = mean[c];
+			return;
+		}
+
+		float minProj = FLT_MAX, maxProj = -FLT_MAX;
+		for (uint32_t p = 0; p < 16; p++)
+		{
+			float proj = 0.0f;
+			for (uint32_t c = 0; c < 4; c++)
+				proj += (block.Channels[c][p] - mean[c]) * axis[c];
+
+			minProj = std::min(minProj, proj);
+			maxProj = std::max(maxProj, proj);
+		}
+
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			start[c] = std::clamp(mean[c] + axis[c] * minProj / axisLength, 0.0f, 255.0f);
+			end[c] = std::clamp(mean[c] + axis[c] * maxProj / axisLength, 0.0f, 255.0f);
+		}
+	}
+
+	// Least squares fit of the endpoints given the interpolation weight assigned to each pixel
+	static bool RefineEndpoints(const ColorBlock& block, const uint8_t* indices, const float* paletteWeights, float start[4], float end[4])
+	{
+		float a = 0, b = 0, c = 0;
+		float startSum[4] = { 0, 0, 0, 0 };
+		float endSum[4] = { 0, 0, 0, 0 };
+
+		for (uint32_t p = 0; p < 16; p++)
+		{
+			float w = paletteWeights[indices[p]];
+			a += (1 - w) * (1 - w);
+			b += (1 - w) * w;
+			c += w * w;
+
+			for (uint32_t ch = 0; ch < 4; ch++)
+			{
+				startSum[ch] += (1 - w) * block.Channels[ch][p];
+				endSum[ch] += w * block.Channels[ch][p];
+			}
+		}
+
+		float det = a * c - b * b;
+		if (std::abs(det) < FLT_EPSILON)
+			return false;
+
+		for (uint32_t ch = 0; ch < 4; ch++)
+		{
+			start[ch] = std::clamp((c * startSum[ch] - b * endSum[ch]) / det, 0.0f, 255.0f);
+			end[ch] = std::clamp((a * endSum[ch] - b * startSum[ch]) / det, 0.0f, 255.0f);
+		}
+		return true;
+	}
+
+	static uint32_t GetRefineIterations(Texture2DParameter quality)
+	{
+		switch (quality)
+		{
+		case Texture2DParameter::QUALITY_FAST: return 0;
+		case Texture2DParameter::QUALITY_NORMAL: return 1;
+		default: return 3;
+		}
+	}
+
+	///////////////////////////////////////////////////// BC1 //////////////////////////////////////////////////////
+
+	static uint16_t PackRGB565(const float color[4])
+	{
+		uint32_t r = (uint32_t)std::round(color[0] * 31.0f / 255.0f);
+		uint32_t g = (uint32_t)std::round(color[1] * 63.0f / 255.0f);
+		uint32_t b = (uint32_t)std::round(color[2] * 31.0f / 255.0f);
+		return (uint16_t)((r << 11) | (g << 5) | b);
+	}
+
+	static void UnpackRGB565(uint16_t packed, uint8_t color[3])
+	{
+		uint32_t r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+		color[0] = (uint8_t)((r << 3) | (r >> 2));
+		color[1] = (uint8_t)((g << 2) | (g >> 4));
+		color[2] = (uint8_t)((b << 3) | (b >> 2));
+	}
+
+	static float EvaluateBC1(const ColorBlock& block, const float start[4], const float end[4], uint16_t& c0, uint16_t& c1, uint8_t* indices)
+	{
+		static const float weights[4] = { 1.0f, 1.0f, 1.0f, 0.0f };
+
+		c0 = PackRGB565(start);
+		c1 = PackRGB565(end);
+		// 4 color mode requires c0 > c1
+		if (c0 < c1)
+			std::swap(c0, c1);
+
+		uint8_t e0[3], e1[3];
+		UnpackRGB565(c0, e0);
+		UnpackRGB565(c1, e1);
+
+		float palette[4][4];
+		for (uint32_t i = 0; i < 4; i++)
+			for (uint32_t c = 0; c < 4; c++)
+				palette[i][c] = c < 3 ? e0[c] + (e1[c] - e0[c]) * s_BC1Weights[i] : 0.0f;
+
+		// Equal endpoints would switch the block to 3 color mode, only index 0 is safe to use
+		uint32_t nEntries = c0 == c1 ? 1 : 4;
+		return FindClosest(block, palette, nEntries, weights, indices);
+	}
+
+	static void EncodeBC1Block(const ColorBlock& block, Texture2DParameter quality, uint8_t* output)
+	{
+		static const float weights[4] = { 1.0f, 1.0f, 1.0f, 0.0f };
+
+		float start[4], end[4];
+		ComputeEndpoints(block, weights, quality, start, end);
+
+		uint16_t c0, c1;
+		uint8_t indices[16];
+		float error = EvaluateBC1(block, start, end, c0, c1, indices);
+
+		for (uint32_t i = 0; i < GetRefineIterations(quality); i++)
+		{
+			// Refine with respect to the actual (possibly swapped) endpoints
+			uint8_t e0[3], e1[3];
+			UnpackRGB565(c0, e0);
+			UnpackRGB565(c1, e1);
+
+			float newStart[4] = { (float)e0[0], (float)e0[1], (float)e0[2], 0.0f };
+			float newEnd[4] = { (float)e1[0], (float)e1[1], (float)e1[2], 0.0f };
+			if (!RefineEndpoints(block, indices, s_BC1Weights, newStart, newEnd))
+				break;
+
+			uint16_t newC0, newC1;
+			uint8_t newIndices[16];
+			float newError = EvaluateBC1(block, newStart, newEnd, newC0, newC1, newIndices);
+			if (newError >= error)
+				break;
+
+			error = newError;
+			c0 = newC0; c1 = newC1;
+			memcpy(indices, newIndices, 16);
+		}
+
+		uint32_t packedIndices = 0;
+		for (uint32_t p = 0; p < 16; p++)
+			packedIndices |= (uint32_t)indices[p] << (p * 2);
+
+		memcpy(output, &c0, 2);
+		memcpy(output + 2, &c1, 2);
+		memcpy(output + 4, &packedIndices, 4);
+	}
+
+	static void DecodeBC1Block(const uint8_t* input, uint8_t* output, bool alwaysFourColors)
+	{
+		uint16_t c0, c1;
+		uint32_t indices;
+		memcpy(&c0, input, 2);
+		memcpy(&c1, input + 2, 2);
+		memcpy(&indices, input + 4, 4);
+
+		uint8_t palette[4][4];
+		UnpackRGB565(c0, palette[0]);
+		UnpackRGB565(c1, palette[1]);
+		palette[0][3] = palette[1][3] = 255;
+
+		if (c0 > c1 || alwaysFourColors)
+		{
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				palette[2][c] = (uint8_t)((2 * palette[0][c] + palette[1][c]) / 3);
+				palette[3][c] = (uint8_t)((palette[0][c] + 2 * palette[1][c]) / 3);
+			}
+			palette[2][3] = palette[3][3] = 255;
+		}
+		else
+		{
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				palette[2][c] = (uint8_t)((palette[0][c] + palette[1][c]) / 2);
+				palette[3][c] = 0;
+			}
+			palette[2][3] = 255;
+			palette[3][3] = 0;
+		}
+
+		for (uint32_t p = 0; p < 16; p++)
+			memcpy(output + p * 4, palette[(indices >> (p * 2)) & 3], 4);
+	}
+
+	///////////////////////////////////////////////////// BC4 //////////////////////////////////////////////////////
+
+	static float EvaluateBC4(const ColorBlock& block, uint32_t channel, int32_t a0, int32_t a1, uint8_t* indices)
+	{
+		float weights[4] = { 0, 0, 0, 0 };
+		weights[channel] = 1.0f;
+
+		float palette[8][4] = {};
+		for (uint32_t i = 0; i < 8; i++)
+			palette[i][channel] = a0 + (a1 - a0) * s_BC4Weights[i];
+
+		// Same as BC1: equal endpoints switch to the 6 values mode, only use the first endpoint
+		return FindClosest(block, palette, a0 == a1 ? 1 : 8, weights, indices);
+	}
+
+	static void EncodeBC4Block(const ColorBlock& block, uint32_t channel, Texture2DParameter quality, uint8_t* output)
+	{
+		float min = 255.0f, max = 0.0f;
+		for (uint32_t p = 0; p < 16; p++)
+		{
+			min = std::min(min, block.Channels[channel][p]);
+			max = std::max(max, block.Channels[channel][p]);
+		}
+
+		// a0 > a1 selects the 8 values mode
+		int32_t a0 = (int32_t)max, a1 = (int32_t)min;
+		uint8_t indices[16];
+		float error = EvaluateBC4(block, channel, a0, a1, indices);
+
+		// Insetting the endpoints usually gives a better distribution of the interpolated values
+		int32_t searchRadius = quality == Texture2DParameter::QUALITY_FAST ? 0 : (quality == Texture2DParameter::QUALITY_NORMAL ? 2 : 6);
+		int32_t bestA0 = a0, bestA1 = a1;
+		for (int32_t d0 = 0; d0 <= searchRadius; d0++)
+		{
+			for (int32_t d1 = 0; d1 <= searchRadius; d1++)
+			{
+				int32_t newA0 = a0 - d0, newA1 = a1 + d1;
+				if ((d0 == 0 && d1 == 0) || newA0 <= newA1)
+					continue;
+
+				uint8_t newIndices[16];
+				float newError = EvaluateBC4(block, channel, newA0, newA1, newIndices);
+				if (newError < error)
+				{
+					error = newError;
+					bestA0 = newA0; bestA1 = newA1;
+					memcpy(indices, newIndices, 16);
+				}
+			}
+		}
+
+		uint64_t packedIndices = 0;
+		for (uint32_t p = 0; p < 16; p++)
+			packedIndices |= (uint64_t)indices[p] << (p * 3);
+
+		output[0] = (uint8_t)bestA0;
+		output[1] = (uint8_t)bestA1;
+		for (uint32_t i = 0; i < 6; i++)
+			output[2 + i] = (uint8_t)(packedIndices >> (i * 8));
+	}
+
+	static void DecodeBC4Block(const uint8_t* input, uint8_t* output, uint32_t channel)
+	{
+		uint8_t palette[8];
+		palette[0] = input[0];
+		palette[1] = input[1];
+
+		if (palette[0] > palette[1])
+		{
+			for (uint32_t i = 1; i < 7; i++)
+				palette[i + 1] = (uint8_t)(((7 - i) * palette[0] + i * palette[1]) / 7);
+		}
+		else
+		{
+			for (uint32_t i = 1; i < 5; i++)
+				palette[i + 1] = (uint8_t)(((5 - i) * palette[0] + i * palette[1]) / 5);
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		uint64_t indices = 0;
+		for (uint32_t i = 0; i < 6; i++)
+			indices |= (uint64_t)input[2 + i] << (i * 8);
+
+		for (uint32_t p = 0; p < 16; p++)
+			output[p * 4 + channel] = palette[(indices >> (p * 3)) & 7];
+	}
+
+	///////////////////////////////////////////////////// BC7 //////////////////////////////////////////////////////
+
+	class BitWriter
+	{
+	public:
+		BitWriter(uint8_t* output) : m_Output(output), m_Position(0) { memset(output, 0, 16); }
+
+		void Write(uint32_t value, uint32_t nBits)
+		{
+			for (uint32_t i = 0; i < nBits; i++, m_Position++)
+				m_Output[m_Position / 8] |= ((value >> i) & 1) << (m_Position % 8);
+		}
+
+	private:
+		uint8_t* m_Output;
+		uint32_t m_Position;
+	};
+
+	class BitReader
+	{
+	public:
+		BitReader(const uint8_t* input) : m_Input(input), m_Position(0) {}
+
+		uint32_t Read(uint32_t nBits)
+		{
+			uint32_t ret = 0;
+			for (uint32_t i = 0; i < nBits; i++, m_Position++)
+				ret |= ((m_Input[m_Position / 8] >> (m_Position % 8)) & 1) << i;
+			return ret;
+		}
+
+	private:
+		const uint8_t* m_Input;
+		uint32_t m_Position;
+	};
+
+	struct BC7Endpoints
+	{
+		uint8_t Start[4];
+		uint8_t End[4];
+		uint8_t StartP;
+		uint8_t EndP;
+	};
+
+	static float EvaluateBC7(const ColorBlock& block, const float start[4], const float end[4], BC7Endpoints& endpoints, uint8_t* indices)
+	{
+		static const float weights[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		float bestError = FLT_MAX;
+
+		// Try every combination of p-bits, each one shifts the reachable endpoints by one unit
+		for (uint8_t p = 0; p < 4; p++)
+		{
+			BC7Endpoints curr;
+			curr.StartP = p & 1;
+			curr.EndP = p >> 1;
+
+			uint32_t dequantStart[4], dequantEnd[4];
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				curr.Start[c] = (uint8_t)std::clamp((int32_t)std::round((start[c] - curr.StartP) / 2.0f), 0, 127);
+				curr.End[c] = (uint8_t)std::clamp((int32_t)std::round((end[c] - curr.EndP) / 2.0f), 0, 127);
+				dequantStart[c] = (curr.Start[c] << 1) | curr.StartP;
+				dequantEnd[c] = (curr.End[c] << 1) | curr.EndP;
+			}
+
+			float palette[16][4];
+			for (uint32_t i = 0; i < 16; i++)
+				for (uint32_t c = 0; c < 4; c++)
+					palette[i][c] = (float)(((64 - s_BC7Weights[i]) * dequantStart[c] + s_BC7Weights[i] * dequantEnd[c] + 32) >> 6);
+
+			uint8_t currIndices[16];
+			float error = FindClosest(block, palette, 16, weights, currIndices);
+			if (error < bestError)
+			{
+				bestError = error;
+				endpoints = curr;
+				memcpy(indices, currIndices, 16);
+			}
+		}
+
+		return bestError;
+	}
+
+	static void EncodeBC7Block(const ColorBlock& block, Texture2DParameter quality, uint8_t* output)
+	{
+		static const float weights[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		float paletteWeights[16];
+		for (uint32_t i = 0; i < 16; i++)
+			paletteWeights[i] = s_BC7Weights[i] / 64.0f;
+
+		float start[4], end[4];
+		ComputeEndpoints(block, weights, quality, start, end);
+
+		BC7Endpoints endpoints;
+		uint8_t indices[16];
+		float error = EvaluateBC7(block, start, end, endpoints, indices);
+
+		for (uint32_t i = 0; i < GetRefineIterations(quality); i++)
+		{
+			if (!RefineEndpoints(block, indices, paletteWeights, start, end))
+				break;
+
+			BC7Endpoints newEndpoints;
+			uint8_t newIndices[16];
+			float newError = EvaluateBC7(block, start, end, newEndpoints, newIndices);
+			if (newError >= error)
+				break;
+
+			error = newError;
+			endpoints = newEndpoints;
+			memcpy(indices, newIndices, 16);
+		}
+
+		// The most significant bit of the first index is implicitly 0
+		if (indices[0] & 8)
+		{
+			std::swap(endpoints.Start, endpoints.End);
+			std::swap(endpoints.StartP, endpoints.EndP);
+			for (uint32_t p = 0; p < 16; p++)
+				indices[p] = 15 - indices[p];
+		}
+
+		// Mode 6
+		BitWriter writer(output);
+		writer.Write(1 << 6, 7);
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			writer.Write(endpoints.Start[c], 7);
+			writer.Write(endpoints.End[c], 7);
+		}
+		writer.Write(endpoints.StartP, 1);
+		writer.Write(endpoints.EndP, 1);
+
+		writer.Write(indices[0], 3);
+		for (uint32_t p = 1; p < 16; p++)
+			writer.Write(indices[p], 4);
+	}
+
+	static void DecodeBC7Block(const uint8_t* input, uint8_t* output)
+	{
+		// Only mode 6 is produced by the encoder, other modes are decoded as magenta
+		if ((input[0] & 0x7F) != (1 << 6))
+		{
+			for (uint32_t p = 0; p < 16; p++)
+			{
+				output[p * 4 + 0] = 255; output[p * 4 + 1] = 0;
+				output[p * 4 + 2] = 255; output[p * 4 + 3] = 255;
+			}
+			return;
+		}
+
+		BitReader reader(input);
+		reader.Read(7);
+
+		uint32_t start[4], end[4];
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			start[c] = reader.Read(7) << 1;
+			end[c] = reader.Read(7) << 1;
+		}
+		uint32_t startP = reader.Read(1), endP = reader.Read(1);
+
+		for (uint32_t p = 0; p < 16; p++)
+		{
+			uint32_t index = reader.Read(p == 0 ? 3 : 4);
+			for (uint32_t c = 0; c < 4; c++)
+				output[p * 4 + c] = (uint8_t)(((64 - s_BC7Weights[index]) * (start[c] | startP) + s_BC7Weights[index] * (end[c] | endP) + 32) >> 6);
+		}
+	}
+
+	////////////////////////////////////////////////// Compressor //////////////////////////////////////////////////
+
+	static void CompressBlock(const ColorBlock& block, CookedTextureFormat format, Texture2DParameter quality, uint8_t* output)
+	{
+		switch (format)
+		{
+		case CookedTextureFormat::BC1:
+			EncodeBC1Block(block, quality, output);
+			break;
+		case CookedTextureFormat::BC3:
+			EncodeBC4Block(block, 3, quality, output);
+			EncodeBC1Block(block, quality, output + 8);
+			break;
+		case CookedTextureFormat::BC4:
+			EncodeBC4Block(block, 0, quality, output);
+			break;
+		case CookedTextureFormat::BC5:
+			EncodeBC4Block(block, 0, quality, output);
+			EncodeBC4Block(block, 1, quality, output + 8);
+			break;
+		case CookedTextureFormat::BC7:
+			EncodeBC7Block(block, quality, output);
+			break;
+		default:
+			DBT_CORE_ASSERT(false, "Unsupported block compression format");
+			break;
+		}
+	}
+
+	void TextureCompressor::Compress(const uint8_t* pixels, uint32_t width, uint32_t height, CookedTextureFormat format,
+		Texture2DParameter quality, uint8_t* output)
+	{
+		DBT_PROFILE_FUNCTION();
+
+		uint32_t blocksX = (width + 3) / 4;
+		uint32_t blocksY = (height + 3) / 4;
+		uint32_t blockSize = GetBlockSize(format);
+
+		// Rows of blocks are spread over the job system workers
+		JobSystem::ParallelFor(blocksY, 4, [=](uint32_t firstRow, uint32_t lastRow)
+		{
+			ColorBlock block;
+			for (uint32_t y = firstRow; y < lastRow; y++)
+			{
+				for (uint32_t x = 0; x < blocksX; x++)
+				{
+					LoadBlock(pixels, width, height, x, y, block);
+					CompressBlock(block, format, quality, output + ((size_t)y * blocksX + x) * blockSize);
+				}
+			}
+		});
+	}
+
+	void TextureCompressor::Decompress(const uint8_t* blocks, uint32_t width, uint32_t height, CookedTextureFormat format, uint8_t* output)
+	{
+		uint32_t blocksX = (width + 3) / 4;
+		uint32_t blocksY = (height + 3) / 4;
+		uint32_t blockSize = GetBlockSize(format);
+		uint8_t pixels[16 * 4];
+
+		for (uint32_t y = 0; y < blocksY; y++)
+		{
+			for (uint32_t x = 0; x < blocksX; x++)
+			{
+				const uint8_t* block = blocks + ((size_t)y * blocksX + x) * blockSize;
+				memset(pixels, 0, sizeof(pixels));
+				for (uint32_t p = 0; p < 16; p++)
+					pixels[p * 4 + 3] = 255;
+
+				switch (format)
+				{
+				case CookedTextureFormat::BC1: DecodeBC1Block(block, pixels, false); break;
+				case CookedTextureFormat::BC3: DecodeBC1Block(block + 8, pixels, true); DecodeBC4Block(block, pixels, 3); break;
+				case CookedTextureFormat::BC4: DecodeBC4Block(block, pixels, 0); break;
+				case CookedTextureFormat::BC5: DecodeBC4Block(block, pixels, 0); DecodeBC4Block(block + 8, pixels, 1); break;
+				case CookedTextureFormat::BC7: DecodeBC7Block(block, pixels); break;
+				default: DBT_CORE_ASSERT(false, "Unsupported block compression format"); break;
+				}
+
+				// Only copy the pixels that are inside the image
+				for (uint32_t py = 0; py < 4 && y * 4 + py < height; py++)
+					for (uint32_t px = 0; px < 4 && x * 4 + px < width; px++)
+						memcpy(output + ((size_t)(y * 4 + py) * width + x * 4 + px) * 4, pixels + (py * 4 + px) * 4, 4);
+			}
+		}
+	}
+
+	uint32_t TextureCompressor::GetBlockSize(CookedTextureFormat format)
+	{
+		switch (format)
+		{
+		case CookedTextureFormat::BC1:
+		case CookedTextureFormat::BC4:
+			return 8;
+		case CookedTextureFormat::BC3:
+		case CookedTextureFormat::BC5:
+		case CookedTextureFormat::BC7:
+			return 16;
+		default:
+			DBT_CORE_ASSERT(false, "Format isn't block compressed");
+			return 0;
+		}
+	}
+
+	uint64_t TextureCompressor::GetCompressedSize(uint32_t width, uint32_t height, CookedTextureFormat format)
+	{
+		return (uint64_t)((width + 3) / 4) * ((height + 3) / 4) * GetBlockSize(format);
+	}
+}
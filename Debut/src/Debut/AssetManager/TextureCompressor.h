@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Debut/Core/Core.h>
+#include <Debut/Rendering/Texture.h>
+#include <Debut/AssetManager/TextureImporter.h>
+
+/*
+	CPU block compression for cooked textures.
+
+	- BC1 / BC3: color, BC3 when the texture has an alpha channel
+	- BC4 / BC5: single channel masks and two channel normal maps
+	- BC7: color at high quality, only mode 6 (single subset, RGBA endpoints, 4 bit indices) is used
+
+	The quality parameter trades speed for precision: Fast uses bounding box endpoints, Normal fits the
+	principal axis of the block and High also refines the endpoints with a least squares fit. Blocks are
+	spread across the job system workers.
+*/
+
+namespace Debut
+{
+	class TextureCompressor
+	{
+	public:
+		// Compresses an RGBA8 image, the output buffer must be at least GetCompressedSize bytes
+		static void Compress(const uint8_t* pixels, uint32_t width, uint32_t height, CookedTextureFormat format,
+			Texture2DParameter quality, uint8_t* output);
+		// Decompresses a block compressed image back to RGBA8, the TextureCompress benchmarks use it to check the encoders
+		static void Decompress(const uint8_t* blocks, uint32_t width, uint32_t height, CookedTextureFormat format, uint8_t* output);
+
+		static uint32_t GetBlockSize(CookedTextureFormat format);
+		static uint64_t GetCompressedSize(uint32_t width, uint32_t height, CookedTextureFormat format);
+	};
+}
@@ -0,0 +1,233 @@
+#include <Debut/dbtpch.h>
+
+#include <Debut/AssetManager/TextureImporter.h>
+#include <Debut/AssetManager/TextureCompressor.h>
+#include <Debut/AssetManager/AssetManager.h>
+
+#include <stb_image.h>
+#include <stb_image_resize.h>
+
+namespace Debut
+{
+	static bool GetSourceInfo(const std::string& path, uint64_t& size, int64_t& time)
+	{
+		std::error_code error;
+		size = std::filesystem::file_size(path, error);
+		if (error)
+			return false;
+
+		time = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+		return !error;
+	}
+
+	bool TextureImporter::CookTexture(const std::string& path, const Texture2DConfig& config)
+	{
+		DBT_PROFILE_FUNCTION();
+
+		CookedTextureHeader header;
+		if (!GetSourceInfo(path, header.SourceSize, header.SourceTime))
+		{
+			Log.CoreError("Couldn't cook texture {0}: the source file doesn't exist", path);
+			return false;
+		}
+
+		// Decode once, always to RGBA so that every level has the same layout
+		int width, height, channels;
+		stbi_uc* pixels = nullptr;
+		stbi_set_flip_vertically_on_load(1);
+		{
+			DBT_PROFILE_SCOPE("TextureImporter::CookTexture::Decode");
+			pixels = stbi_load(path.c_str(), &width, &height, &channels, 4);
+		}
+
+		if (pixels == nullptr)
+		{
+			Log.CoreError("Couldn't cook texture {0}: {1}", path, stbi_failure_reason());
+			return false;
+		}
+
+		std::vector<CookedTextureLevel> levels;
+		std::vector<uint8_t> data;
+		CookedTextureFormat format = GetCookedFormat(pixels, width, height, config);
+		GenerateMips(pixels, width, height, config, levels, data);
+		stbi_image_free(pixels);
+
+		if (format != CookedTextureFormat::RGBA8)
+			CompressLevels(format, config, levels, data);
+
+		header.Width = width;
+		header.Height = height;
+		header.NumLevels = (uint32_t)levels.size();
+		header.Format = format;
+		header.Settings = GetCookSettings(config);
+
+		// Make level offsets relative to the beginning of the file
+		uint64_t dataStart = sizeof(CookedTextureHeader) + sizeof(CookedTextureLevel) * levels.size();
+		for (auto& level : levels)
+			level.Offset += dataStart;
+
+		std::filesystem::path cookedPath(GetCookedPath(config.ID));
+		std::error_code error;
+		std::filesystem::create_directories(cookedPath.parent_path(), error);
+
+		std::ofstream outFile(cookedPath, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!outFile.good())
+		{
+			Log.CoreError("Couldn't write the cooked texture for {0}", path);
+			return false;
+		}
+
+		outFile.write((const char*)&header, sizeof(header));
+		outFile.write((const char*)levels.data(), sizeof(CookedTextureLevel) * levels.size());
+		outFile.write((const char*)data.data(), data.size());
+		outFile.close();
+
+		return true;
+	}
+
+	void TextureImporter::GenerateMips(const uint8_t* source, uint32_t width, uint32_t height, const Texture2DConfig& config,
+		std::vector<CookedTextureLevel>& levels, std::vector<uint8_t>& data)
+	{
+		DBT_PROFILE_FUNCTION();
+
+		uint32_t nLevels = 1;
+		if (config.Mipmaps)
+			nLevels = (uint32_t)std::floor(std::log2(std::max(width, height))) + 1;
+
+		// Compute the size of the whole chain first so that we only allocate once
+		uint64_t totalSize = 0;
+		for (uint32_t i = 0; i < nLevels; i++)
+		{
+			uint32_t levelWidth = std::max(width >> i, 1u);
+			uint32_t levelHeight = std::max(height >> i, 1u);
+
+			levels.push_back({ levelWidth, levelHeight, totalSize, (uint64_t)levelWidth * levelHeight * 4 });
+			totalSize += levels.back().Size;
+		}
+
+		data.resize(totalSize);
+		memcpy(data.data(), source, levels[0].Size);
+
+		stbir_edge edgeMode = config.WrapMode == Texture2DParameter::WRAP_REPEAT ? STBIR_EDGE_WRAP : STBIR_EDGE_CLAMP;
+		// Averaging sRGB values as if they were linear darkens the mips, data textures must be averaged as they are
+		stbir_colorspace colorSpace = config.SRGB ? STBIR_COLORSPACE_SRGB : STBIR_COLORSPACE_LINEAR;
+
+		// Each level is filtered from the previous one: Mitchell is sharp enough to avoid blurry mips and
+		// weighting by alpha avoids dark halos around transparent areas
+		for (uint32_t i = 1; i < nLevels; i++)
+		{
+			const CookedTextureLevel& prev = levels[i - 1];
+			const CookedTextureLevel& curr = levels[i];
+
+			stbir_resize_uint8_generic(data.data() + prev.Offset, prev.Width, prev.Height, 0,
+				data.data() + curr.Offset, curr.Width, curr.Height, 0, 4, 3, 0,
+				edgeMode, STBIR_FILTER_MITCHELL, colorSpace, nullptr);
+		}
+	}
+
+	CookedTextureFormat TextureImporter::GetCookedFormat(const uint8_t* pixels, uint32_t width, uint32_t height, const Texture2DConfig& config)
+	{
+		if (config.Compression == Texture2DParameter::COMPRESSION_NONE)
+			return CookedTextureFormat::RGBA8;
+
+		// Compressed storage needs the first level to be made of whole blocks
+		if (width % 4 != 0 || height % 4 != 0)
+		{
+			Log.CoreWarn("Texture size {0}x{1} isn't a multiple of 4, it won't be compressed", width, height);
+			return CookedTextureFormat::RGBA8;
+		}
+
+		switch (config.Compression)
+		{
+		case Texture2DParameter::COMPRESSION_MASK: return CookedTextureFormat::BC4;
+		case Texture2DParameter::COMPRESSION_NORMALMAP: return CookedTextureFormat::BC5;
+		default: break;
+		}
+
+		if (config.Quality == Texture2DParameter::QUALITY_HIGH)
+			return CookedTextureFormat::BC7;
+
+		// BC1 can't store alpha, fall back to BC3 only when it's actually used
+		for (size_t i = 0; i < (size_t)width * height; i++)
+			if (pixels[i * 4 + 3] != 255)
+				return CookedTextureFormat::BC3;
+		return CookedTextureFormat::BC1;
+	}
+
+	void TextureImporter::CompressLevels(CookedTextureFormat format, const Texture2DConfig& config,
+		std::vector<CookedTextureLevel>& levels, std::vector<uint8_t>& data)
+	{
+		DBT_PROFILE_FUNCTION();
+
+		std::vector<CookedTextureLevel> compressedLevels;
+		uint64_t totalSize = 0;
+		for (auto& level : levels)
+		{
+			compressedLevels.push_back({ level.Width, level.Height, totalSize, TextureCompressor::GetCompressedSize(level.Width, level.Height, format) });
+			totalSize += compressedLevels.back().Size;
+		}
+
+		std::vector<uint8_t> compressedData(totalSize);
+		for (uint32_t i = 0; i < levels.size(); i++)
+			TextureCompressor::Compress(data.data() + levels[i].Offset, levels[i].Width, levels[i].Height, format, config.Quality,
+				compressedData.data() + compressedLevels[i].Offset);
+
+		levels = std::move(compressedLevels);
+		data = std::move(compressedData);
+	}
+
+	std::string TextureImporter::GetCookedPath(UUID id)
+	{
+		// Editor textures can be loaded before a project is opened
+		std::stringstream ss;
+		ss << (AssetManager::s_AssetsDir.empty() ? ".\\Lib\\Assets\\" : AssetManager::s_AssetsDir) << id << ".tex";
+		return ss.str();
+	}
+
+	bool TextureImporter::IsCookedValid(const std::string& path, const Texture2DConfig& config, const uint8_t* data, size_t size)
+	{
+		const CookedTextureHeader* header = GetHeader(data, size);
+		if (header == nullptr)
+			return false;
+
+		uint64_t sourceSize;
+		int64_t sourceTime;
+		// Cooked textures can also be shipped without their source
+		if (!GetSourceInfo(path, sourceSize, sourceTime))
+			return header->Settings == GetCookSettings(config);
+
+		return header->Settings == GetCookSettings(config) && header->SourceSize == sourceSize && header->SourceTime == sourceTime;
+	}
+
+	const CookedTextureHeader* TextureImporter::GetHeader(const uint8_t* data, size_t size)
+	{
+		if (data == nullptr || size < sizeof(CookedTextureHeader))
+			return nullptr;
+
+		const CookedTextureHeader* header = (const CookedTextureHeader*)data;
+		if (header->Magic != DBT_COOKED_TEXTURE_MAGIC || header->Version != DBT_COOKED_TEXTURE_VERSION)
+			return nullptr;
+
+		// Make sure that all the levels are inside the file
+		if (size < sizeof(CookedTextureHeader) + sizeof(CookedTextureLevel) * header->NumLevels)
+			return nullptr;
+		const CookedTextureLevel* levels = GetLevels(data);
+		for (uint32_t i = 0; i < header->NumLevels; i++)
+			if (levels[i].Offset + levels[i].Size > size)
+				return nullptr;
+
+		return header;
+	}
+
+	const CookedTextureLevel* TextureImporter::GetLevels(const uint8_t* data)
+	{
+		return (const CookedTextureLevel*)(data + sizeof(CookedTextureHeader));
+	}
+
+	uint32_t TextureImporter::GetCookSettings(const Texture2DConfig& config)
+	{
+		// Only the settings that change the cooked data: filtering is a sampler state
+		return (uint32_t)config.WrapMode | ((uint32_t)config.Mipmaps << 8) | ((uint32_t)config.SRGB << 9) | ((uint32_t)config.Compression << 16) |
+			((uint32_t)config.Quality << 24);
+	}
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Debut/Core/Core.h>
+#include <Debut/Core/UUID.h>
+#include <Debut/Rendering/Texture.h>
+
+/*
+	Cooked texture layout:
+		- CookedTextureHeader
+		- CookedTextureLevel[NumLevels]
+		- Level data, each level starting at its own offset from the beginning of the file
+
+	Levels are stored from the biggest (0) to the smallest (1x1). The data is already flipped vertically
+	and either expanded to 4 channels or block compressed, so it can be uploaded as is.
+*/
+
+#define DBT_COOKED_TEXTURE_MAGIC	0x58455444	// "DTEX"
+#define DBT_COOKED_TEXTURE_VERSION	3
+
+namespace Debut
+{
+	enum class CookedTextureFormat : uint32_t
+	{
+		RGBA8 = 0, BC1, BC3, BC4, BC5, BC7
+	};
+
+	struct CookedTextureHeader
+	{
+		uint32_t Magic = DBT_COOKED_TEXTURE_MAGIC;
+		uint32_t Version = DBT_COOKED_TEXTURE_VERSION;
+
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		uint32_t NumLevels = 0;
+		CookedTextureFormat Format = CookedTextureFormat::RGBA8;
+
+		// Used to find out whether the cooked file is stale
+		uint32_t Settings = 0;
+		uint32_t Padding = 0;
+		uint64_t SourceSize = 0;
+		int64_t SourceTime = 0;
+	};
+
+	struct CookedTextureLevel
+	{
+		uint32_t Width;
+		uint32_t Height;
+		uint64_t Offset;
+		uint64_t Size;
+	};
+
+	class TextureImporter
+	{
+	public:
+		static bool CookTexture(const std::string& path, const Texture2DConfig& config);
+
+		static std::string GetCookedPath(UUID id);
+		static bool IsCookedValid(const std::string& path, const Texture2DConfig& config, const uint8_t* data, size_t size);
+
+		static const CookedTextureHeader* GetHeader(const uint8_t* data, size_t size);
+		static const CookedTextureLevel* GetLevels(const uint8_t* data);
+
+	private:
+		static uint32_t GetCookSettings(const Texture2DConfig& config);
+		static CookedTextureFormat GetCookedFormat(const uint8_t* pixels, uint32_t width, uint32_t height, const Texture2DConfig& config);
+		static void CompressLevels(CookedTextureFormat format, const Texture2DConfig& config,
+			std::vector<CookedTextureLevel>& levels, std::vector<uint8_t>& data);
+		static void GenerateMips(const uint8_t* source, uint32_t width, uint32_t height, const Texture2DConfig& config,
+			std::vector<CookedTextureLevel>& levels, std::vector<uint8_t>& data);
+	};
+}
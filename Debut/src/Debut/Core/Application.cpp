@@ -5,6 +5,9 @@
 #include <Debut/Core/Window.h>
 #include <Debut/ImGui/ImGuiLayer.h>
 #include <Debut/Core/Input.h>
+#include <Debut/Core/JobSystem.h>
+#include <Debut/Core/FrameProfiler.h>
+#include <Debut/Core/FrameAllocator.h>
 
 #include <Debut/Rendering/Renderer/Renderer.h>
 
@@ -12,7 +15,15 @@ namespace Debut
 {
 	Application* Application::s_Instance = nullptr;
 
-	Application::Application(const std::string& name)
+	bool ApplicationCommandLineArgs::Has(const std::string& arg) const
+	{
+		for (int i = 1; i < Count; i++)
+			if (arg == Args[i])
+				return true;
+		return false;
+	}
+
+	Application::Application(const std::string& name, ApplicationCommandLineArgs args)
 	{
 		DBT_PROFILE_FUNCTION();
 		DBT_ASSERT(!s_Instance, "Application already exists.")
@@ -21,6 +32,10 @@ namespace Debut
 		m_Window = std::unique_ptr<Window>(Window::Create(name));
 		m_Window->SetEventCallback(DBT_BIND(Application::OnEvent));
 
+		JobSystem::Init();
+		// Building the frames has a cost, only do it when someone is going to look at them
+		if (args.Has("--profile"))
+			FrameProfiler::Init();
 		Renderer::Init();
 
 		m_ImGuiLayer = new ImGuiLayer();
@@ -29,7 +44,8 @@ namespace Debut
 
 	Application::~Application()
 	{
-
+		FrameProfiler::Shutdown();
+		JobSystem::Shutdown();
 	}
 
 	void Application::Run()
@@ -38,12 +54,15 @@ namespace Debut
 		{
 			while (m_Running)
 			{
-				DBT_PROFILE_SCOPE("Application Loop Frame");
+				DBT_PROFILE_FRAME("Application Loop Frame");
 
 				float time = (float)glfwGetTime();
 				Timestep timestep = time - m_LastFrameTime;
 				m_LastFrameTime = time;
 
+				// Run what the workers scheduled for the main thread during the last frame
+				JobSystem::ProcessMainThreadJobs();
+
 				if (!m_Minimized)
 				{
 					DBT_PROFILE_SCOPE("Layer updates")
@@ -65,7 +84,10 @@ namespace Debut
 					DBT_PROFILE_SCOPE("Window Update");
 					m_Window->OnUpdate();
 				}
-				
+
+				// Transient data of this frame isn't needed anymore
+				FrameAllocator::EndFrame();
+				Renderer::EndFrame();
 			}
 		}
 	}
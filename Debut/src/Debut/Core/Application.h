@@ -18,10 +18,19 @@ namespace Debut
 	class ImGuiLayer;
 	class Window;
 
+	struct ApplicationCommandLineArgs
+	{
+		int Count = 0;
+		char** Args = nullptr;
+
+		bool Has(const std::string& arg) const;
+	};
+
 	class Application
 	{
 	public:
-		Application(const std::string& name = "Debut Application");
+		// Pass --profile to record the frames shown by the profiler panel from the start
+		Application(const std::string& name = "Debut Application", ApplicationCommandLineArgs args = ApplicationCommandLineArgs());
 		
 		virtual ~Application();
 
@@ -57,5 +66,5 @@ namespace Debut
 		Timestep m_Timestep;
 	};
 
-	Application* CreateApplication();
+	Application* CreateApplication(ApplicationCommandLineArgs args);
 }
@@ -30,6 +30,10 @@
 
 #define DBT_PROFILE 1
 
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+	#define DBT_SIMD_SSE 1
+#endif
+
 #define BIT(x) (1 << x)
 
 #define DBT_BIND(x) [this](auto&&... args) -> decltype(auto) {return this->x(std::forward<decltype(args)>(args)...);}
@@ -8,7 +8,7 @@
 
 #ifdef DBT_PLATFORM_WINDOWS
 
-extern Debut::Application* Debut::CreateApplication();
+extern Debut::Application* Debut::CreateApplication(Debut::ApplicationCommandLineArgs args);
 
 int main(int argc, char** argv)
 {
@@ -20,7 +20,7 @@ int main(int argc, char** argv)
 		Debut::Log.Init();
 		Debut::Log.CoreInfo("CWD: {0}", std::filesystem::current_path().string().c_str());
 		// Create the application
-		app = Debut::CreateApplication();
+		app = Debut::CreateApplication({ argc, argv });
 		Debut::Log.CoreInfo("Created application");
 	}
 	DBT_PROFILE_END_SESSION();
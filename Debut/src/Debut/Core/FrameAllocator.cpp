@@ -0,0 +1,115 @@
+#include <Debut/dbtpch.h>
+#include <Debut/Core/FrameAllocator.h>
+#include <Debut/Core/MemoryTracker.h>
+
+namespace Debut
+{
+	struct FrameAllocator::ThreadMemory
+	{
+		struct Block
+		{
+			Scope<uint8_t[]> Data;
+			size_t Size;
+		};
+
+		std::vector<Block> Blocks;
+		size_t CurrentBlock = 0;
+		size_t Offset = 0;
+		uint64_t Frame = 0;
+
+		~ThreadMemory()
+		{
+			for (auto& block : Blocks)
+				MemoryTracker::Free(MemoryTag::FrameAllocator, MemoryType::CPU, block.Size);
+		}
+	};
+
+	std::atomic<uint64_t> FrameAllocator::s_Frame = 0;
+	size_t FrameAllocator::s_BlockSize = 1024 * 1024;
+
+	std::atomic<uint32_t> FrameAllocator::s_Allocations = 0;
+	std::atomic<uint64_t> FrameAllocator::s_AllocatedBytes = 0;
+	std::atomic<uint32_t> FrameAllocator::s_HeapAllocations = 0;
+	std::atomic<uint64_t> FrameAllocator::s_HeapBytes = 0;
+	FrameAllocatorStats FrameAllocator::s_PrevStats;
+
+	FrameAllocator::ThreadMemory& FrameAllocator::GetThreadMemory()
+	{
+		thread_local ThreadMemory memory;
+		return memory;
+	}
+
+	void* FrameAllocator::Allocate(size_t size, size_t alignment)
+	{
+		ThreadMemory& memory = GetThreadMemory();
+		uint64_t frame = s_Frame.load(std::memory_order_acquire);
+
+		// First allocation of the frame on this thread: start from the beginning of the memory
+		if (memory.Frame != frame)
+		{
+			// The last frame needed more than a block, merge them so that the memory is contiguous from now on
+			if (memory.Blocks.size() > 1)
+			{
+				size_t totalSize = 0;
+				for (auto& block : memory.Blocks)
+				{
+					totalSize += block.Size;
+					MemoryTracker::Free(MemoryTag::FrameAllocator, MemoryType::CPU, block.Size);
+				}
+
+				memory.Blocks.clear();
+				memory.Blocks.push_back({ Scope<uint8_t[]>(new uint8_t[totalSize]), totalSize });
+				MemoryTracker::Allocate(MemoryTag::FrameAllocator, MemoryType::CPU, totalSize);
+				s_HeapAllocations.fetch_add(1, std::memory_order_relaxed);
+				s_HeapBytes.fetch_add(totalSize, std::memory_order_relaxed);
+			}
+
+			memory.CurrentBlock = 0;
+			memory.Offset = 0;
+			memory.Frame = frame;
+		}
+
+		s_Allocations.fetch_add(1, std::memory_order_relaxed);
+		s_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+		while (memory.CurrentBlock < memory.Blocks.size())
+		{
+			ThreadMemory::Block& block = memory.Blocks[memory.CurrentBlock];
+			uintptr_t base = (uintptr_t)block.Data.get();
+			size_t start = ((base + memory.Offset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+
+			if (start + size <= block.Size)
+			{
+				memory.Offset = start + size;
+				return block.Data.get() + start;
+			}
+
+			memory.CurrentBlock++;
+			memory.Offset = 0;
+		}
+
+		// Out of memory, add a block big enough for the allocation
+		size_t blockSize = std::max(s_BlockSize, size + alignment);
+		memory.Blocks.push_back({ Scope<uint8_t[]>(new uint8_t[blockSize]), blockSize });
+		memory.CurrentBlock = memory.Blocks.size() - 1;
+		MemoryTracker::Allocate(MemoryTag::FrameAllocator, MemoryType::CPU, blockSize);
+		s_HeapAllocations.fetch_add(1, std::memory_order_relaxed);
+		s_HeapBytes.fetch_add(blockSize, std::memory_order_relaxed);
+
+		uintptr_t base = (uintptr_t)memory.Blocks.back().Data.get();
+		size_t start = ((base + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+		memory.Offset = start + size;
+
+		return memory.Blocks.back().Data.get() + start;
+	}
+
+	void FrameAllocator::EndFrame()
+	{
+		s_PrevStats.Allocations = s_Allocations.exchange(0, std::memory_order_relaxed);
+		s_PrevStats.AllocatedBytes = s_AllocatedBytes.exchange(0, std::memory_order_relaxed);
+		s_PrevStats.HeapAllocations = s_HeapAllocations.exchange(0, std::memory_order_relaxed);
+		s_PrevStats.HeapBytes = s_HeapBytes.exchange(0, std::memory_order_relaxed);
+
+		s_Frame.fetch_add(1, std::memory_order_release);
+	}
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <Debut/Core/Core.h>
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/*
+	Linear allocator for the data that only lives for a frame. Every thread bumps a pointer in its own memory,
+	which is reused at the next frame without being freed: after the first frames the memory is big enough for
+	a whole frame and the allocator doesn't touch the heap anymore.
+
+	Memory allocated in a frame can't be used after FrameAllocator::EndFrame. Threads notice the end of the frame
+	the next time they allocate, so jobs that span multiple frames shouldn't use this allocator.
+
+	USAGE:
+		FrameVector<LightComponent*> lights;
+		lights.reserve(count);
+
+		DirectionalLightComponent* light = FrameAllocator::New<DirectionalLightComponent>();
+*/
+
+namespace Debut
+{
+	struct FrameAllocatorStats
+	{
+		uint32_t Allocations = 0;
+		uint64_t AllocatedBytes = 0;
+		// Memory requested to the heap because the memory of a thread was full
+		uint32_t HeapAllocations = 0;
+		uint64_t HeapBytes = 0;
+	};
+
+	class FrameAllocator
+	{
+	public:
+		static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+		// Objects are never destroyed, so they must be trivially destructible
+		template <typename T, typename ...Args>
+		static T* New(Args&& ...args)
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "Frame allocated objects are never destroyed");
+			return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		}
+
+		// Called by the main thread once the frame is over
+		static void EndFrame();
+
+		static inline FrameAllocatorStats GetStats() { return s_PrevStats; }
+
+	private:
+		struct ThreadMemory;
+		static ThreadMemory& GetThreadMemory();
+
+	private:
+		static std::atomic<uint64_t> s_Frame;
+		static size_t s_BlockSize;
+
+		static std::atomic<uint32_t> s_Allocations;
+		static std::atomic<uint64_t> s_AllocatedBytes;
+		static std::atomic<uint32_t> s_HeapAllocations;
+		static std::atomic<uint64_t> s_HeapBytes;
+		static FrameAllocatorStats s_PrevStats;
+	};
+
+	// Allocator for the standard containers, deallocations are ignored
+	template <typename T>
+	class FrameAllocatorAdapter
+	{
+	public:
+		using value_type = T;
+
+		FrameAllocatorAdapter() = default;
+		template <typename U>
+		FrameAllocatorAdapter(const FrameAllocatorAdapter<U>&) {}
+
+		T* allocate(size_t n) { return (T*)FrameAllocator::Allocate(n * sizeof(T), alignof(T)); }
+		void deallocate(T*, size_t) {}
+
+		template <typename U>
+		bool operator==(const FrameAllocatorAdapter<U>&) const { return true; }
+		template <typename U>
+		bool operator!=(const FrameAllocatorAdapter<U>&) const { return false; }
+	};
+
+	template <typename T>
+	using FrameVector = std::vector<T, FrameAllocatorAdapter<T>>;
+}
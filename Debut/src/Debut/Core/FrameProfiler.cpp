@@ -0,0 +1,245 @@
+#include <Debut/dbtpch.h>
+#include <Debut/Core/FrameProfiler.h>
+
+#include <fstream>
+#include <iomanip>
+#include <filesystem>
+
+namespace Debut
+{
+	FrameProfiler::Listener FrameProfiler::s_Listener;
+	std::mutex FrameProfiler::s_Mutex;
+
+	std::vector<ProfiledFrame> FrameProfiler::s_History;
+	uint32_t FrameProfiler::s_HistoryStart = 0;
+	uint32_t FrameProfiler::s_MaxFrames = 0;
+	uint64_t FrameProfiler::s_NextFrameIndex = 0;
+
+	std::atomic<bool> FrameProfiler::s_Enabled = false;
+	std::atomic<bool> FrameProfiler::s_Paused = false;
+	std::atomic<float> FrameProfiler::s_SpikeThreshold = 0.0f;
+	std::string FrameProfiler::s_CaptureDirectory = "Profiling";
+
+	void FrameProfiler::Init(uint32_t historySize)
+	{
+		{
+			std::lock_guard<std::mutex> lock(s_Mutex);
+			s_MaxFrames = historySize;
+			s_History.clear();
+			s_History.reserve(historySize);
+			s_HistoryStart = 0;
+		}
+
+		Instrumentor::Get().SetListener(&s_Listener);
+		s_Enabled = true;
+	}
+
+	void FrameProfiler::Shutdown()
+	{
+		if (!s_Enabled)
+			return;
+
+		Instrumentor::Get().SetListener(nullptr);
+		s_Enabled = false;
+
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		s_History.clear();
+	}
+
+	void FrameProfiler::Flush()
+	{
+		Instrumentor::Get().Flush();
+	}
+
+	void FrameProfiler::SetPaused(bool paused)
+	{
+		s_Paused = paused;
+	}
+
+	void FrameProfiler::GetFrameTimes(std::vector<float>& times)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		times.resize(s_History.size());
+		for (uint32_t i = 0; i < s_History.size(); i++)
+			times[i] = s_History[(s_HistoryStart + i) % s_History.size()].GetDuration();
+	}
+
+	bool FrameProfiler::GetFrame(uint32_t index, ProfiledFrame& frame)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		if (index >= s_History.size())
+			return false;
+
+		frame = s_History[(s_HistoryStart + index) % s_History.size()];
+		return true;
+	}
+
+	void FrameProfiler::GetScopeStats(std::vector<ProfiledScopeStats>& stats)
+	{
+		std::unordered_map<const char*, uint32_t> statIndices;
+		std::unordered_map<const char*, std::pair<float, uint32_t>> frameTotals;
+		std::vector<float> sums;
+		uint32_t totalCalls = 0;
+
+		stats.clear();
+		std::lock_guard<std::mutex> lock(s_Mutex);
+
+		for (uint32_t i = 0; i < s_History.size(); i++)
+		{
+			const ProfiledFrame& frame = s_History[(s_HistoryStart + i) % s_History.size()];
+			bool last = i == s_History.size() - 1;
+
+			// A scope can be called more than once in a frame, the stats are about the total time
+			frameTotals.clear();
+			for (auto& scope : frame.Scopes)
+			{
+				auto& total = frameTotals[scope.Name];
+				total.first += ProfiledFrame::ToMilliseconds(scope.End - scope.Start);
+				total.second++;
+			}
+
+			for (auto& total : frameTotals)
+			{
+				auto it = statIndices.find(total.first);
+				if (it == statIndices.end())
+				{
+					it = statIndices.insert({ total.first, (uint32_t)stats.size() }).first;
+					stats.push_back({ total.first, total.second.first, 0.0f, total.second.first, 0.0f, 0, 0.0f });
+					sums.push_back(0.0f);
+				}
+
+				ProfiledScopeStats& stat = stats[it->second];
+				stat.Min = std::min(stat.Min, total.second.first);
+				stat.Max = std::max(stat.Max, total.second.first);
+				stat.Frames++;
+				stat.Calls += total.second.second;
+				if (last)
+					stat.Last = total.second.first;
+				sums[it->second] += total.second.first;
+			}
+		}
+
+		for (uint32_t i = 0; i < stats.size(); i++)
+		{
+			stats[i].Avg = sums[i] / stats[i].Frames;
+			stats[i].Calls /= stats[i].Frames;
+		}
+
+		std::sort(stats.begin(), stats.end(), [](const ProfiledScopeStats& a, const ProfiledScopeStats& b) { return a.Avg > b.Avg; });
+	}
+
+	void FrameProfiler::CaptureNextSpike(float thresholdMs)
+	{
+		s_SpikeThreshold = thresholdMs;
+	}
+
+	bool FrameProfiler::SaveFrame(uint32_t index)
+	{
+		ProfiledFrame frame;
+		if (!GetFrame(index, frame))
+			return false;
+		return WriteFrame(frame);
+	}
+
+	void FrameProfiler::AddFrame(ProfiledFrame&& frame)
+	{
+		if (s_Paused)
+			return;
+
+		float threshold = s_SpikeThreshold;
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		frame.Index = s_NextFrameIndex++;
+
+		if (threshold > 0 && frame.GetDuration() > threshold)
+		{
+			s_SpikeThreshold = 0.0f;
+			WriteFrame(frame);
+		}
+
+		if (s_History.size() < s_MaxFrames)
+			s_History.push_back(std::move(frame));
+		else if (s_MaxFrames > 0)
+		{
+			s_History[s_HistoryStart] = std::move(frame);
+			s_HistoryStart = (s_HistoryStart + 1) % s_MaxFrames;
+		}
+	}
+
+	bool FrameProfiler::WriteFrame(const ProfiledFrame& frame)
+	{
+		std::filesystem::create_directories(s_CaptureDirectory);
+		std::string path = s_CaptureDirectory + "/Frame-" + std::to_string(frame.Index) + ".json";
+
+		std::ofstream output(path);
+		if (!output.is_open())
+		{
+			Log.CoreError("Couldn't save the profiled frame to {0}", path);
+			return false;
+		}
+
+		// Same format as the instrumentation sessions, so that the frame can be opened in a trace viewer
+		uint64_t start = frame.GetStart();
+		output << std::setprecision(3) << std::fixed;
+		output << "{\"otherData\": {},\"traceEvents\":[";
+		for (uint32_t i = 0; i < frame.Scopes.size(); i++)
+		{
+			const ProfiledScope& scope = frame.Scopes[i];
+			if (i > 0)
+				output << ",";
+
+			output << "{\"name\":";
+			Instrumentor::WriteJsonString(output, scope.Name);
+			output << ",\"cat\":\"function\",\"ph\":\"X\",\"dur\":" << Instrumentor::TicksToMicroseconds(scope.End - scope.Start);
+			output << ",\"pid\":0,\"tid\":0,\"ts\":" << Instrumentor::TicksToMicroseconds(scope.Start - start) << "}";
+		}
+		output << "]}";
+
+		Log.CoreInfo("Saved frame {0} ({1} ms) to {2}", frame.Index, frame.GetDuration(), path);
+		return true;
+	}
+
+	void FrameProfiler::Listener::OnProfileEvents(const std::vector<ProfileRecord>& records)
+	{
+		for (auto& record : records)
+		{
+			const ProfileEvent& event = record.Event;
+
+			if (event.Type == ProfileEventType::Frame)
+			{
+				// Frames are only tracked on the first thread that marks one
+				if (m_FrameThread == UINT32_MAX)
+					m_FrameThread = record.ThreadIndex;
+				if (record.ThreadIndex != m_FrameThread)
+					continue;
+
+				// Children end before their parents, so the scopes of the frame have already been received
+				ProfiledFrame frame;
+				frame.Scopes.reserve(m_Pending.size() + 1);
+				frame.Scopes.push_back({ event.Name, event.Start, event.End, 0 });
+				for (auto& scope : m_Pending)
+					if (scope.Start >= event.Start)
+						frame.Scopes.push_back(scope);
+				m_Pending.clear();
+
+				std::sort(frame.Scopes.begin() + 1, frame.Scopes.end(), [](const ProfiledScope& a, const ProfiledScope& b)
+					{ return a.Start < b.Start || (a.Start == b.Start && a.End > b.End); });
+
+				// Rebuild the hierarchy: a scope is nested in the open scopes that end after it starts
+				std::vector<uint64_t> openScopes = { event.End };
+				for (uint32_t i = 1; i < frame.Scopes.size(); i++)
+				{
+					ProfiledScope& scope = frame.Scopes[i];
+					while (openScopes.size() > 1 && scope.Start >= openScopes.back())
+						openScopes.pop_back();
+
+					scope.Depth = (uint32_t)openScopes.size();
+					openScopes.push_back(scope.End);
+				}
+
+				FrameProfiler::AddFrame(std::move(frame));
+			}
+			else if (event.Type == ProfileEventType::Scope && record.ThreadIndex == m_FrameThread)
+				m_Pending.push_back({ event.Name, event.Start, event.End, 0 });
+		}
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <Debut/Core/Instrumentor.h>
+
+#include <string>
+#include <vector>
+#include <mutex>
+
+/*
+	Live profiler: listens to the instrumentation events and keeps the last frames in a rolling history.
+
+	A frame is a DBT_PROFILE_FRAME scope, the scopes of the same thread that started after it are its children.
+	Frames are built on the instrumentation writer thread, so the history is only accessed under a lock and
+	copied out for the UI.
+*/
+
+namespace Debut
+{
+	struct ProfiledScope
+	{
+		const char* Name;
+		uint64_t Start;
+		uint64_t End;
+		// 0 is the frame itself
+		uint32_t Depth;
+	};
+
+	struct ProfiledFrame
+	{
+		uint64_t Index = 0;
+		// Sorted by start time, parents come before their children
+		std::vector<ProfiledScope> Scopes;
+
+		inline uint64_t GetStart() const { return Scopes.size() > 0 ? Scopes[0].Start : 0; }
+		inline float GetDuration() const { return Scopes.size() > 0 ? ToMilliseconds(Scopes[0].End - Scopes[0].Start) : 0.0f; }
+
+		inline static float ToMilliseconds(uint64_t ticks) { return (float)(Instrumentor::TicksToMicroseconds(ticks) / 1000.0); }
+	};
+
+	struct ProfiledScopeStats
+	{
+		const char* Name;
+		// Milliseconds spent in the scope in a frame, summing all the calls
+		float Min;
+		float Avg;
+		float Max;
+		float Last;
+		// Number of frames in the history that contain the scope
+		uint32_t Frames;
+		// Average calls per frame
+		float Calls;
+	};
+
+	class FrameProfiler
+	{
+	public:
+		// Frames are only recorded between Init and Shutdown
+		static void Init(uint32_t historySize = 300);
+		static void Shutdown();
+		static bool IsEnabled() { return s_Enabled; }
+
+		// Builds the frames that are still waiting in the instrumentation buffers
+		static void Flush();
+
+		static void SetPaused(bool paused);
+		static bool IsPaused() { return s_Paused; }
+
+		// Durations of the frames in the history, from the oldest
+		static void GetFrameTimes(std::vector<float>& times);
+		// index is the position in the history, from the oldest
+		static bool GetFrame(uint32_t index, ProfiledFrame& frame);
+		static void GetScopeStats(std::vector<ProfiledScopeStats>& stats);
+
+		// The next frame that takes longer than thresholdMs is saved to the capture directory
+		static void CaptureNextSpike(float thresholdMs);
+		static bool IsWaitingForSpike() { return s_SpikeThreshold > 0; }
+		static bool SaveFrame(uint32_t index);
+
+		static void SetCaptureDirectory(const std::string& directory) { s_CaptureDirectory = directory; }
+
+	private:
+		class Listener : public ProfileListener
+		{
+		public:
+			virtual void OnProfileEvents(const std::vector<ProfileRecord>& records) override;
+
+		private:
+			uint32_t m_FrameThread = UINT32_MAX;
+			std::vector<ProfiledScope> m_Pending;
+		};
+
+		static void AddFrame(ProfiledFrame&& frame);
+		static bool WriteFrame(const ProfiledFrame& frame);
+
+	private:
+		static Listener s_Listener;
+		static std::mutex s_Mutex;
+
+		// Ring buffer of frames
+		static std::vector<ProfiledFrame> s_History;
+		static uint32_t s_HistoryStart;
+		static uint32_t s_MaxFrames;
+		static uint64_t s_NextFrameIndex;
+
+		static std::atomic<bool> s_Enabled;
+		static std::atomic<bool> s_Paused;
+		static std::atomic<float> s_SpikeThreshold;
+		static std::string s_CaptureDirectory;
+	};
+}
@@ -0,0 +1,262 @@
+#include <Debut/dbtpch.h>
+#include <Debut/Core/Instrumentor.h>
+
+#include <fstream>
+#include <iomanip>
+
+namespace Debut
+{
+	void Instrumentor::WriteJsonString(std::ostream& stream, const char* string)
+	{
+		stream << '"';
+		for (const char* c = string; *c; c++)
+		{
+			if (*c == '"' || *c == '\\')
+				stream << '\\';
+			stream << *c;
+		}
+		stream << '"';
+	}
+
+	Instrumentor::~Instrumentor()
+	{
+		if (m_SessionActive)
+			EndSession();
+		StopWriter();
+	}
+
+	void Instrumentor::BeginSession(const std::string& name, const std::string& filepath)
+	{
+		if (m_SessionActive)
+			EndSession();
+
+		m_SessionName = name;
+		m_OutputPath = filepath;
+		m_TempFile = fopen((filepath + ".tmp").c_str(), "wb");
+		if (!m_TempFile)
+		{
+			Log.CoreError("Couldn't open the profiling session file {0}", filepath);
+			return;
+		}
+
+		// Events left in the buffers from before the session are skipped by the drain
+		StopWriter();
+		m_StartTicks = GetTicks();
+		m_SessionActive = true;
+		StartWriter();
+	}
+
+	void Instrumentor::EndSession()
+	{
+		if (!m_SessionActive)
+			return;
+
+		// Also drains whatever has been recorded since the last time the writer woke up
+		StopWriter();
+		m_SessionActive = false;
+
+		WriteJson();
+		fclose(m_TempFile);
+		m_TempFile = nullptr;
+		std::remove((m_OutputPath + ".tmp").c_str());
+
+		if (m_Listener != nullptr)
+			StartWriter();
+	}
+
+	void Instrumentor::SetListener(ProfileListener* listener)
+	{
+		StopWriter();
+		m_Listener = listener;
+		if (m_SessionActive || m_Listener != nullptr)
+			StartWriter();
+	}
+
+	void Instrumentor::Flush()
+	{
+		if (!m_WriterRunning)
+			return;
+
+		// Stopping the writer drains the buffers
+		StopWriter();
+		StartWriter();
+	}
+
+	void Instrumentor::SetThreadName(const std::string& name)
+	{
+		ProfileThreadBuffer& buffer = GetThreadBuffer();
+		std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+		buffer.Name = name;
+	}
+
+	ProfileThreadBuffer* Instrumentor::RegisterThread()
+	{
+		std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+		// Buffers are never freed: the events of a thread that has exited may still have to be drained
+		m_Threads.push_back(std::make_unique<ProfileThreadBuffer>());
+
+		ProfileThreadBuffer* ret = m_Threads.back().get();
+		ret->ThreadIndex = (uint32_t)m_Threads.size() - 1;
+		ret->Name = "Thread " + std::to_string(ret->ThreadIndex);
+		return ret;
+	}
+
+	void Instrumentor::StartWriter()
+	{
+		if (m_WriterRunning)
+			return;
+
+		m_WriterRunning = true;
+		m_Writer = std::thread(&Instrumentor::WriterLoop, this);
+		m_Recording.store(true);
+	}
+
+	void Instrumentor::StopWriter()
+	{
+		if (!m_WriterRunning)
+			return;
+
+		m_Recording.store(false);
+		{
+			std::lock_guard<std::mutex> lock(m_WriterMutex);
+			m_WriterRunning = false;
+		}
+		m_WriterCondition.notify_one();
+		m_Writer.join();
+
+		Drain();
+	}
+
+	void Instrumentor::WriterLoop()
+	{
+		std::unique_lock<std::mutex> lock(m_WriterMutex);
+		while (m_WriterRunning)
+		{
+			m_WriterCondition.wait_for(lock, std::chrono::milliseconds(10));
+			lock.unlock();
+			Drain();
+			lock.lock();
+		}
+	}
+
+	void Instrumentor::Drain()
+	{
+		std::vector<ProfileRecord> records;
+		{
+			std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+			for (auto& buffer : m_Threads)
+			{
+				uint32_t tail = buffer->Tail.load(std::memory_order_relaxed);
+				uint32_t head = buffer->Head.load(std::memory_order_acquire);
+
+				for (uint32_t i = tail; i != head; i++)
+				{
+					const ProfileEvent& event = buffer->Events[i & (ProfileThreadBuffer::Capacity - 1)];
+					records.push_back({ event, buffer->ThreadIndex });
+				}
+
+				buffer->Tail.store(head, std::memory_order_release);
+			}
+		}
+
+		if (records.size() == 0)
+			return;
+
+		if (m_Listener != nullptr)
+			m_Listener->OnProfileEvents(records);
+
+		if (m_SessionActive)
+		{
+			for (auto& record : records)
+				if (record.Event.Start >= m_StartTicks)
+					fwrite(&record, sizeof(ProfileRecord), 1, m_TempFile);
+		}
+	}
+
+	void Instrumentor::WriteJson()
+	{
+		std::ofstream output(m_OutputPath);
+		if (!output.is_open())
+		{
+			Log.CoreError("Couldn't write the profiling session {0} to {1}", m_SessionName, m_OutputPath);
+			return;
+		}
+
+		output << std::setprecision(3) << std::fixed;
+		output << "{\"otherData\": {},\"traceEvents\":[";
+
+		// Thread names as metadata events
+		bool first = true;
+		{
+			std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+			for (auto& buffer : m_Threads)
+			{
+				if (!first)
+					output << ",";
+				first = false;
+
+				output << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->ThreadIndex;
+				output << ",\"args\":{\"name\":";
+				WriteJsonString(output, buffer->Name.c_str());
+				output << "}}";
+
+				uint32_t dropped = buffer->Dropped.exchange(0);
+				if (dropped > 0)
+					Log.CoreWarn("Profiling session {0}: {1} events of {2} were dropped", m_SessionName, dropped, buffer->Name);
+			}
+		}
+
+		// Convert the binary events
+		fflush(m_TempFile);
+		FILE* input = fopen((m_OutputPath + ".tmp").c_str(), "rb");
+		if (input)
+		{
+			ProfileRecord events[1024];
+			size_t count;
+
+			while ((count = fread(events, sizeof(ProfileRecord), 1024, input)) > 0)
+			{
+				for (size_t i = 0; i < count; i++)
+				{
+					const ProfileEvent& event = events[i].Event;
+					double ts = TicksToMicroseconds(event.Start - m_StartTicks);
+
+					if (!first)
+						output << ",";
+					first = false;
+
+					output << "{\"name\":";
+					WriteJsonString(output, event.Name);
+
+					switch (event.Type)
+					{
+					case ProfileEventType::Scope:
+					case ProfileEventType::Frame:
+						output << ",\"cat\":\"function\",\"ph\":\"X\",\"dur\":" << TicksToMicroseconds(event.End - event.Start);
+						break;
+					case ProfileEventType::Counter:
+						output << ",\"ph\":\"C\",\"args\":{\"value\":" << event.Value << "}";
+						break;
+					case ProfileEventType::FlowBegin:
+						output << ",\"cat\":\"flow\",\"ph\":\"s\",\"id\":" << event.FlowID;
+						break;
+					case ProfileEventType::FlowStep:
+						output << ",\"cat\":\"flow\",\"ph\":\"t\",\"id\":" << event.FlowID;
+						break;
+					case ProfileEventType::FlowEnd:
+						// Bind to the enclosing slice instead of the next one
+						output << ",\"cat\":\"flow\",\"ph\":\"f\",\"bp\":\"e\",\"id\":" << event.FlowID;
+						break;
+					}
+
+					output << ",\"pid\":0,\"tid\":" << events[i].ThreadIndex << ",\"ts\":" << ts << "}";
+				}
+			}
+
+			fclose(input);
+		}
+
+		output << "]}";
+		output.flush();
+	}
+}
@@ -1,101 +1,164 @@
 #pragma once
 
 #include <string>
-#include <fstream>
 #include <chrono>
 #include <thread>
-#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <memory>
+#include <cstdio>
+#include <iosfwd>
+
+/*
+    Every thread records compact binary events in its own lock free ring buffer. A background thread drains
+    the buffers while the session is running and stores the events in a temporary binary file, which is
+    converted to the Chrome trace format only when the session ends. A listener (the live frame profiler) can
+    also be fed from the writer thread, with or without a session.
+
+    Event names aren't copied: they must outlive the session (string literals, __FUNCSIG__).
+*/
 
 namespace Debut
 {
-    struct ProfileResult
+    enum class ProfileEventType : uint8_t
     {
-        std::string Name;
-        long long Start, End;
-        size_t ThreadID;
+        Scope = 0, Frame, Counter, FlowBegin, FlowStep, FlowEnd
     };
 
-    struct InstrumentationSession
+    struct ProfileEvent
     {
-        std::string Name;
+        const char* Name;
+        // Ticks of the steady clock
+        uint64_t Start;
+        union
+        {
+            uint64_t End;       // Scope, Frame
+            double Value;       // Counter
+            uint64_t FlowID;    // Flows
+        };
+        ProfileEventType Type;
     };
 
-    class Instrumentor
+    struct ProfileRecord
+    {
+        ProfileEvent Event;
+        uint32_t ThreadIndex;
+    };
+
+    // Receives the drained events on the writer thread, in order for each thread
+    class ProfileListener
     {
-    private:
-        InstrumentationSession* m_CurrentSession;
-        std::ofstream m_OutputStream;
-        int m_ProfileCount;
     public:
-        Instrumentor()
-            : m_CurrentSession(nullptr), m_ProfileCount(0)
-        {
-        }
+        virtual void OnProfileEvents(const std::vector<ProfileRecord>& records) = 0;
+    };
 
-        void BeginSession(const std::string& name, const std::string& filepath = "results.json")
-        {
-            m_OutputStream.open(filepath);
-            m_ProfileCount = 0;
-            WriteHeader();
-            m_CurrentSession = new InstrumentationSession{ name };
-        }
+    // Single producer (the owner thread), single consumer (the writer thread)
+    struct ProfileThreadBuffer
+    {
+        static constexpr uint32_t Capacity = 1 << 16;
 
-        void EndSession()
-        {
-            WriteFooter();
-            m_OutputStream.close();
-            delete m_CurrentSession;
-            m_CurrentSession = nullptr;
-            m_ProfileCount = 0;
-        }
+        ProfileEvent Events[Capacity];
+        std::atomic<uint32_t> Head = 0;
+        std::atomic<uint32_t> Tail = 0;
+        std::atomic<uint32_t> Dropped = 0;
 
-        void WriteProfile(const ProfileResult& result)
+        uint32_t ThreadIndex = 0;
+        std::string Name;
+
+        inline void Push(const ProfileEvent& event)
         {
-            if (m_ProfileCount++ > 0)
-                m_OutputStream << ",";
-
-            std::string name = result.Name;
-            std::replace(name.begin(), name.end(), '"', '\'');
-
-            m_OutputStream << "{";
-            m_OutputStream << "\"cat\":\"function\",";
-            m_OutputStream << "\"dur\":" << (result.End - result.Start) << ',';
-            m_OutputStream << "\"name\":\"" << name << "\",";
-            m_OutputStream << "\"ph\":\"X\",";
-            m_OutputStream << "\"pid\":0,";
-            m_OutputStream << "\"tid\":" << result.ThreadID << ",";
-            m_OutputStream << "\"ts\":" << result.Start;
-            m_OutputStream << "}";
-
-            m_OutputStream.flush();
+            uint32_t head = Head.load(std::memory_order_relaxed);
+            // Drop the event instead of blocking if the writer can't keep up
+            if (head - Tail.load(std::memory_order_acquire) >= Capacity)
+            {
+                Dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            Events[head & (Capacity - 1)] = event;
+            Head.store(head + 1, std::memory_order_release);
         }
+    };
 
-        inline void WriteHeader()
+    class Instrumentor
+    {
+    public:
+        void BeginSession(const std::string& name, const std::string& filepath = "results.json");
+        void EndSession();
+
+        void SetThreadName(const std::string& name);
+        // Events are recorded while a session is open or a listener is set
+        void SetListener(ProfileListener* listener);
+        // Hands everything recorded so far to the listener and the session file before returning
+        void Flush();
+
+        inline void WriteEvent(const ProfileEvent& event)
         {
-            m_OutputStream << "{\"otherData\": {},\"traceEvents\":[";
-            m_OutputStream.flush();
+            if (IsRecording())
+                GetThreadBuffer().Push(event);
         }
 
-        inline void WriteFooter()
+        inline bool IsRecording() const { return m_Recording.load(std::memory_order_relaxed); }
+
+        inline static uint64_t GetTicks() { return std::chrono::steady_clock::now().time_since_epoch().count(); }
+        static double TicksToMicroseconds(uint64_t ticks)
         {
-            m_OutputStream << "]}";
-            m_OutputStream.flush();
+            return (double)ticks * std::chrono::steady_clock::period::num * 1000000.0 / std::chrono::steady_clock::period::den;
         }
 
+        static void WriteJsonString(std::ostream& stream, const char* string);
+
         inline static Instrumentor& Get()
         {
             static Instrumentor instance;
             return instance;
         }
+
+    private:
+        Instrumentor() = default;
+        ~Instrumentor();
+
+        inline ProfileThreadBuffer& GetThreadBuffer()
+        {
+            static thread_local ProfileThreadBuffer* buffer = RegisterThread();
+            return *buffer;
+        }
+
+        ProfileThreadBuffer* RegisterThread();
+        void StartWriter();
+        void StopWriter();
+        void WriterLoop();
+        void Drain();
+        void WriteJson();
+
+    private:
+        std::string m_SessionName;
+        std::string m_OutputPath;
+        std::atomic<bool> m_Recording = false;
+        bool m_SessionActive = false;
+        ProfileListener* m_Listener = nullptr;
+
+        std::mutex m_ThreadsMutex;
+        std::vector<std::unique_ptr<ProfileThreadBuffer>> m_Threads;
+
+        std::thread m_Writer;
+        std::mutex m_WriterMutex;
+        std::condition_variable m_WriterCondition;
+        bool m_WriterRunning = false;
+
+        FILE* m_TempFile = nullptr;
+        uint64_t m_StartTicks = 0;
     };
 
     class InstrumentationTimer
     {
     public:
-        InstrumentationTimer(const char* name)
-            : m_Name(name), m_Stopped(false)
+        InstrumentationTimer(const char* name, ProfileEventType type = ProfileEventType::Scope)
+            : m_Name(name), m_Type(type), m_Stopped(false)
         {
-            m_StartTimepoint = std::chrono::high_resolution_clock::now();
+            m_Start = Instrumentor::GetTicks();
         }
 
         ~InstrumentationTimer()
@@ -106,32 +169,68 @@ namespace Debut
 
         void Stop()
         {
-            auto endTimepoint = std::chrono::high_resolution_clock::now();
-
-            long long start = std::chrono::time_point_cast<std::chrono::microseconds>(m_StartTimepoint).time_since_epoch().count();
-            long long end = std::chrono::time_point_cast<std::chrono::microseconds>(endTimepoint).time_since_epoch().count();
-
-            size_t threadID = std::hash<std::thread::id>{}(std::this_thread::get_id());
-            Instrumentor::Get().WriteProfile({ m_Name, start, end, threadID });
+            ProfileEvent event;
+            event.Name = m_Name;
+            event.Start = m_Start;
+            event.End = Instrumentor::GetTicks();
+            event.Type = m_Type;
 
+            Instrumentor::Get().WriteEvent(event);
             m_Stopped = true;
         }
     private:
         const char* m_Name;
-        std::chrono::time_point<std::chrono::high_resolution_clock> m_StartTimepoint;
+        ProfileEventType m_Type;
+        uint64_t m_Start;
         bool m_Stopped;
     };
+
+    inline void ProfileCounter(const char* name, double value)
+    {
+        ProfileEvent event;
+        event.Name = name;
+        event.Start = Instrumentor::GetTicks();
+        event.Value = value;
+        event.Type = ProfileEventType::Counter;
+
+        Instrumentor::Get().WriteEvent(event);
+    }
+
+    inline void ProfileFlow(const char* name, uint64_t id, ProfileEventType type)
+    {
+        ProfileEvent event;
+        event.Name = name;
+        event.Start = Instrumentor::GetTicks();
+        event.FlowID = id;
+        event.Type = type;
+
+        Instrumentor::Get().WriteEvent(event);
+    }
 }
 
+#define DBT_PROFILE_CONCAT_IMPL(a, b) a##b
+#define DBT_PROFILE_CONCAT(a, b) DBT_PROFILE_CONCAT_IMPL(a, b)
 
 #ifdef DBT_PROFILE
     #define DBT_PROFILE_BEGIN_SESSION(name, filepath) ::Debut::Instrumentor::Get().BeginSession(name,filepath)
     #define DBT_PROFILE_END_SESSION() ::Debut::Instrumentor::Get().EndSession()
-    #define DBT_PROFILE_SCOPE(name) ::Debut::InstrumentationTimer timer##__LINE__(name);
+    #define DBT_PROFILE_SCOPE(name) ::Debut::InstrumentationTimer DBT_PROFILE_CONCAT(timer, __LINE__)(name);
     #define DBT_PROFILE_FUNCTION() DBT_PROFILE_SCOPE(__FUNCSIG__)
+    #define DBT_PROFILE_FRAME(name) ::Debut::InstrumentationTimer DBT_PROFILE_CONCAT(timer, __LINE__)(name, ::Debut::ProfileEventType::Frame);
+    #define DBT_PROFILE_THREAD(name) ::Debut::Instrumentor::Get().SetThreadName(name)
+    #define DBT_PROFILE_COUNTER(name, value) ::Debut::ProfileCounter(name, (double)(value))
+    #define DBT_PROFILE_FLOW_BEGIN(name, id) ::Debut::ProfileFlow(name, (uint64_t)(id), ::Debut::ProfileEventType::FlowBegin)
+    #define DBT_PROFILE_FLOW_STEP(name, id) ::Debut::ProfileFlow(name, (uint64_t)(id), ::Debut::ProfileEventType::FlowStep)
+    #define DBT_PROFILE_FLOW_END(name, id) ::Debut::ProfileFlow(name, (uint64_t)(id), ::Debut::ProfileEventType::FlowEnd)
 #else
     #define DBT_PROFILE_BEGIN_SESSION(name, filepath)
     #define DBT_PROFILE_END_SESSION()
     #define DBT_PROFILE_FUNCTION()
     #define DBT_PROFILE_SCOPE(name)
-#endif
\ No newline at end of file
+    #define DBT_PROFILE_FRAME(name)
+    #define DBT_PROFILE_THREAD(name)
+    #define DBT_PROFILE_COUNTER(name, value)
+    #define DBT_PROFILE_FLOW_BEGIN(name, id)
+    #define DBT_PROFILE_FLOW_STEP(name, id)
+    #define DBT_PROFILE_FLOW_END(name, id)
+#endif
@@ -0,0 +1,300 @@
+#include <Debut/dbtpch.h>
+#include <Debut/Core/JobSystem.h>
+
+#include <deque>
+
+namespace Debut
+{
+	struct JobSystem::WorkerQueue
+	{
+		std::mutex Mutex;
+		std::deque<Job> Jobs;
+	};
+
+	// Index of the queue owned by the current thread, -1 for threads that aren't part of the system
+	static thread_local int32_t s_QueueIndex = -1;
+
+	std::vector<std::thread> JobSystem::s_Workers;
+	std::vector<Scope<JobSystem::WorkerQueue>> JobSystem::s_Queues;
+	std::atomic<bool> JobSystem::s_Running = false;
+	std::atomic<uint32_t> JobSystem::s_PendingJobs = 0;
+	std::atomic<uint32_t> JobSystem::s_SleepingWorkers = 0;
+	std::atomic<uint32_t> JobSystem::s_NextQueue = 0;
+
+	std::mutex JobSystem::s_SleepMutex;
+	std::condition_variable JobSystem::s_WakeCondition;
+
+	std::mutex JobSystem::s_MainThreadMutex;
+	std::vector<JobFunction> JobSystem::s_MainThreadJobs;
+	std::thread::id JobSystem::s_MainThreadID;
+
+	void JobSystem::Init(uint32_t nWorkers)
+	{
+		DBT_PROFILE_FUNCTION();
+		DBT_CORE_ASSERT(!s_Running, "The job system has already been initialized");
+
+		if (nWorkers == 0)
+			nWorkers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+		s_MainThreadID = std::this_thread::get_id();
+		s_QueueIndex = 0;
+		s_Running = true;
+		DBT_PROFILE_THREAD("Main thread");
+
+		for (uint32_t i = 0; i < nWorkers + 1; i++)
+			s_Queues.push_back(std::make_unique<WorkerQueue>());
+		for (uint32_t i = 0; i < nWorkers; i++)
+			s_Workers.emplace_back(WorkerLoop, i + 1);
+
+		Log.CoreInfo("Job system started with {0} workers", nWorkers);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		if (!s_Running)
+			return;
+
+		// Finish what's left before stopping the workers
+		while (RunPendingJob());
+		ProcessMainThreadJobs();
+
+		{
+			std::lock_guard<std::mutex> lock(s_SleepMutex);
+			s_Running = false;
+		}
+		s_WakeCondition.notify_all();
+
+		for (auto& worker : s_Workers)
+			worker.join();
+
+		s_Workers.clear();
+		s_Queues.clear();
+		s_QueueIndex = -1;
+	}
+
+	void JobSystem::Execute(const JobFunction& function, JobCounter* counter)
+	{
+		if (counter != nullptr)
+			counter->m_Value.fetch_add(1, std::memory_order_relaxed);
+
+		// Without workers, jobs are just function calls
+		if (!s_Running)
+		{
+			Job job = { function, counter };
+			Run(job);
+			return;
+		}
+
+		Push({ function, counter });
+	}
+
+	void JobSystem::ExecuteAfter(JobCounter& dependency, const JobFunction& function, JobCounter* counter)
+	{
+		if (counter != nullptr)
+			counter->m_Value.fetch_add(1, std::memory_order_relaxed);
+
+		{
+			// The lock makes sure that the dependency can't complete between the check and the push
+			std::lock_guard<std::mutex> lock(dependency.m_Mutex);
+			if (!dependency.IsDone())
+			{
+				dependency.m_Continuations.push_back({ function, counter });
+				return;
+			}
+		}
+
+		Job job = { function, counter };
+		if (s_Running)
+			Push(std::move(job));
+		else
+			Run(job);
+	}
+
+	void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, const ParallelForFunction& function)
+	{
+		if (count == 0)
+			return;
+
+		batchSize = std::max(batchSize, 1u);
+		uint32_t nBatches = (count + batchSize - 1) / batchSize;
+		if (nBatches == 1 || !s_Running)
+		{
+			function(0, count);
+			return;
+		}
+
+		JobCounter counter;
+		for (uint32_t i = 1; i < nBatches; i++)
+		{
+			uint32_t start = i * batchSize;
+			uint32_t end = std::min(start + batchSize, count);
+			Execute([&function, start, end]() { function(start, end); }, &counter);
+		}
+
+		function(0, std::min(batchSize, count));
+		Wait(counter);
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		while (!counter.IsDone())
+		{
+			if (!RunPendingJob())
+				std::this_thread::yield();
+		}
+
+		// Wait for the last job to release the counter
+		std::lock_guard<std::mutex> lock(counter.m_Mutex);
+	}
+
+	void JobSystem::ExecuteOnMainThread(const JobFunction& function)
+	{
+		if (IsMainThread())
+		{
+			function();
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(s_MainThreadMutex);
+		s_MainThreadJobs.push_back(function);
+	}
+
+	void JobSystem::ProcessMainThreadJobs()
+	{
+		DBT_PROFILE_FUNCTION();
+		std::vector<JobFunction> jobs;
+		{
+			std::lock_guard<std::mutex> lock(s_MainThreadMutex);
+			jobs.swap(s_MainThreadJobs);
+		}
+
+		for (auto& job : jobs)
+			job();
+	}
+
+	bool JobSystem::IsMainThread()
+	{
+		return !s_Running || std::this_thread::get_id() == s_MainThreadID;
+	}
+
+	bool JobSystem::RunPendingJob()
+	{
+		Job job;
+		if (!Pop(job))
+			return false;
+
+		Run(job);
+		return true;
+	}
+
+	void JobSystem::Push(Job&& job)
+	{
+		// Threads that don't own a queue spread their jobs over the workers
+		uint32_t queueIndex = s_QueueIndex >= 0 ? s_QueueIndex : s_NextQueue.fetch_add(1, std::memory_order_relaxed) % s_Queues.size();
+		s_PendingJobs.fetch_add(1);
+		{
+			WorkerQueue& queue = *s_Queues[queueIndex];
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			queue.Jobs.push_back(std::move(job));
+		}
+
+		if (s_SleepingWorkers.load() > 0)
+		{
+			// Taking the lock avoids waking up a worker that's about to go to sleep
+			{ std::lock_guard<std::mutex> lock(s_SleepMutex); }
+			s_WakeCondition.notify_one();
+		}
+	}
+
+	bool JobSystem::Pop(Job& job)
+	{
+		if (s_PendingJobs.load(std::memory_order_relaxed) == 0)
+			return false;
+
+		uint32_t nQueues = (uint32_t)s_Queues.size();
+		uint32_t ownIndex = s_QueueIndex >= 0 ? s_QueueIndex : 0;
+
+		// Newest job from our own queue first, it's the most likely to still be in cache
+		if (s_QueueIndex >= 0)
+		{
+			WorkerQueue& queue = *s_Queues[ownIndex];
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			if (!queue.Jobs.empty())
+			{
+				job = std::move(queue.Jobs.back());
+				queue.Jobs.pop_back();
+				s_PendingJobs.fetch_sub(1);
+				return true;
+			}
+		}
+
+		// Steal the oldest job from someone else
+		for (uint32_t i = 1; i <= nQueues; i++)
+		{
+			WorkerQueue& queue = *s_Queues[(ownIndex + i) % nQueues];
+			std::unique_lock<std::mutex> lock(queue.Mutex, std::try_to_lock);
+			if (lock.owns_lock() && !queue.Jobs.empty())
+			{
+				job = std::move(queue.Jobs.front());
+				queue.Jobs.pop_front();
+				s_PendingJobs.fetch_sub(1);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void JobSystem::Run(Job& job)
+	{
+		job.Function();
+
+		JobCounter* counter = job.Counter;
+		if (counter == nullptr)
+			return;
+
+		// The counter is only decremented while holding its lock: Wait takes it too before returning, so the
+		// counter can't be destroyed while we're still using it
+		std::vector<Job> continuations;
+		{
+			std::lock_guard<std::mutex> lock(counter->m_Mutex);
+			if (counter->m_Value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				continuations.swap(counter->m_Continuations);
+		}
+
+		for (auto& continuation : continuations)
+		{
+			if (s_Running)
+				Push(std::move(continuation));
+			else
+				Run(continuation);
+		}
+	}
+
+	void JobSystem::WorkerLoop(uint32_t index)
+	{
+		s_QueueIndex = index;
+		DBT_PROFILE_THREAD("Worker " + std::to_string(index));
+
+		while (s_Running)
+		{
+			if (RunPendingJob())
+				continue;
+
+			// Spin a little before going to sleep, jobs often come in bursts
+			bool found = false;
+			for (uint32_t i = 0; i < 64 && !found; i++)
+			{
+				std::this_thread::yield();
+				found = RunPendingJob();
+			}
+			if (found)
+				continue;
+
+			std::unique_lock<std::mutex> lock(s_SleepMutex);
+			s_SleepingWorkers.fetch_add(1);
+			s_WakeCondition.wait(lock, []() { return s_PendingJobs.load() > 0 || !s_Running; });
+			s_SleepingWorkers.fetch_sub(1);
+		}
+	}
+}
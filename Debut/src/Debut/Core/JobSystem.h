@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Debut/Core/Core.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+
+/*
+	Engine wide job system. Every worker owns a deque: it pushes and pops its own jobs from the back and
+	steals from the front of the other ones when it runs out of work. The main thread doesn't run a loop,
+	but it helps with the jobs while waiting on a counter.
+
+	USAGE:
+		JobCounter counter;
+		JobSystem::Execute([]() { ... }, &counter);
+		JobSystem::ExecuteAfter(counter, []() { ... });		// Starts once the first job is done
+		JobSystem::Wait(counter);
+
+		JobSystem::ParallelFor(count, 64, [&](uint32_t start, uint32_t end) { ... });
+		JobSystem::ExecuteOnMainThread([]() { ... });			// Runs at the beginning of the next frame
+*/
+
+namespace Debut
+{
+	using JobFunction = std::function<void()>;
+	using ParallelForFunction = std::function<void(uint32_t start, uint32_t end)>;
+
+	class JobCounter;
+
+	struct Job
+	{
+		JobFunction Function;
+		JobCounter* Counter = nullptr;
+	};
+
+	// Keeps track of the jobs that still have to complete. Jobs can be scheduled to start once it reaches 0
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		inline bool IsDone() const { return m_Value.load(std::memory_order_acquire) == 0; }
+		inline uint32_t GetValue() const { return m_Value.load(std::memory_order_acquire); }
+
+	private:
+		friend class JobSystem;
+
+		std::atomic<uint32_t> m_Value = 0;
+		std::mutex m_Mutex;
+		std::vector<Job> m_Continuations;
+	};
+
+	class JobSystem
+	{
+	public:
+		// 0 workers means one for each hardware thread, except the main one
+		static void Init(uint32_t nWorkers = 0);
+		static void Shutdown();
+
+		static void Execute(const JobFunction& function, JobCounter* counter = nullptr);
+		static void ExecuteAfter(JobCounter& dependency, const JobFunction& function, JobCounter* counter = nullptr);
+		// Splits [0, count) in batches and blocks until all of them are done. The calling thread runs a batch too
+		static void ParallelFor(uint32_t count, uint32_t batchSize, const ParallelForFunction& function);
+		// Runs pending jobs until the counter reaches 0
+		static void Wait(JobCounter& counter);
+
+		static void ExecuteOnMainThread(const JobFunction& function);
+		static void ProcessMainThreadJobs();
+
+		// Runs a single pending job, returns false if there wasn't any
+		static bool RunPendingJob();
+
+		static bool IsMainThread();
+		static bool IsInitialized() { return s_Running; }
+		static uint32_t GetWorkerCount() { return (uint32_t)s_Workers.size(); }
+
+	private:
+		static void Push(Job&& job);
+		static bool Pop(Job& job);
+		static void Run(Job& job);
+		static void WorkerLoop(uint32_t index);
+
+	private:
+		struct WorkerQueue;
+
+		static std::vector<std::thread> s_Workers;
+		// One queue per worker plus the one used by the main thread
+		static std::vector<Scope<WorkerQueue>> s_Queues;
+		static std::atomic<bool> s_Running;
+		static std::atomic<uint32_t> s_PendingJobs;
+		static std::atomic<uint32_t> s_SleepingWorkers;
+		static std::atomic<uint32_t> s_NextQueue;
+
+		static std::mutex s_SleepMutex;
+		static std::condition_variable s_WakeCondition;
+
+		static std::mutex s_MainThreadMutex;
+		static std::vector<JobFunction> s_MainThreadJobs;
+		static std::thread::id s_MainThreadID;
+	};
+}
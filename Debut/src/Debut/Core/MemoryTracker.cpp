@@ -0,0 +1,144 @@
+#include <Debut/dbtpch.h>
+#include <Debut/Core/MemoryTracker.h>
+#include <Debut/Core/Log.h>
+
+#include <yaml-cpp/yaml.h>
+
+namespace Debut
+{
+	MemoryTracker::Counter MemoryTracker::s_Counters[(int)MemoryTag::Count][(int)MemoryType::Count];
+	thread_local MemoryTag MemoryTracker::s_CurrentTag = MemoryTag::Other;
+	std::string MemoryTracker::s_BudgetsPath;
+
+	static const char* s_TagNames[] = { "Other", "Renderer2D", "Renderer3D", "RendererDebug", "DynamicGeometry",
+		"FrameBuffers", "FrameAllocator", "Meshes", "Textures", "Skyboxes" };
+	static const char* s_TypeNames[] = { "CPU", "GPU" };
+
+	static_assert(sizeof(s_TagNames) / sizeof(s_TagNames[0]) == (size_t)MemoryTag::Count, "Missing memory tag name");
+
+	void MemoryTracker::Allocate(MemoryTag tag, MemoryType type, uint64_t bytes)
+	{
+		Update(tag, type, (int64_t)bytes, 1);
+	}
+
+	void MemoryTracker::Free(MemoryTag tag, MemoryType type, uint64_t bytes)
+	{
+		Update(tag, type, -(int64_t)bytes, -1);
+	}
+
+	void MemoryTracker::Update(MemoryTag tag, MemoryType type, int64_t bytes, int32_t allocations)
+	{
+		Counter& counter = s_Counters[(int)tag][(int)type];
+		counter.Allocations.fetch_add(allocations, std::memory_order_relaxed);
+		uint64_t current = counter.Bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+		uint64_t peak = counter.PeakBytes.load(std::memory_order_relaxed);
+		while (current > peak && !counter.PeakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed));
+
+		// Only warn when going over the budget, not for every allocation after that
+		uint64_t budget = counter.Budget.load(std::memory_order_relaxed);
+		bool overBudget = budget > 0 && current > budget;
+		if (counter.OverBudget.exchange(overBudget, std::memory_order_relaxed) != overBudget && overBudget)
+			Log.CoreWarn("{0} {1} memory is over budget: {2:.2f} MB of {3:.2f} MB", s_TagNames[(int)tag], s_TypeNames[(int)type],
+				current / (1024.0 * 1024.0), budget / (1024.0 * 1024.0));
+	}
+
+	MemoryStats MemoryTracker::GetStats(MemoryTag tag, MemoryType type)
+	{
+		Counter& counter = s_Counters[(int)tag][(int)type];
+		MemoryStats ret;
+
+		ret.Bytes = counter.Bytes.load(std::memory_order_relaxed);
+		ret.PeakBytes = counter.PeakBytes.load(std::memory_order_relaxed);
+		ret.Allocations = counter.Allocations.load(std::memory_order_relaxed);
+		ret.Budget = counter.Budget.load(std::memory_order_relaxed);
+
+		return ret;
+	}
+
+	uint64_t MemoryTracker::GetTotal(MemoryType type)
+	{
+		uint64_t ret = 0;
+		for (uint32_t i = 0; i < (uint32_t)MemoryTag::Count; i++)
+			ret += s_Counters[i][(int)type].Bytes.load(std::memory_order_relaxed);
+		return ret;
+	}
+
+	const char* MemoryTracker::GetTagName(MemoryTag tag)
+	{
+		return s_TagNames[(int)tag];
+	}
+
+	void MemoryTracker::SetBudget(MemoryTag tag, MemoryType type, uint64_t bytes)
+	{
+		s_Counters[(int)tag][(int)type].Budget.store(bytes, std::memory_order_relaxed);
+		// Warn again if the tag is already over the new budget
+		Update(tag, type, 0, 0);
+	}
+
+	bool MemoryTracker::LoadBudgets(const std::string& path)
+	{
+		s_BudgetsPath = path;
+		std::ifstream file(path);
+		if (!file.good())
+			return false;
+
+		try
+		{
+			YAML::Node budgets = YAML::Load(file)["Budgets"];
+			for (uint32_t i = 0; i < (uint32_t)MemoryTag::Count; i++)
+			{
+				YAML::Node tagBudgets = budgets[s_TagNames[i]];
+				if (!tagBudgets)
+					continue;
+
+				for (uint32_t j = 0; j < (uint32_t)MemoryType::Count; j++)
+					if (tagBudgets[s_TypeNames[j]])
+						SetBudget((MemoryTag)i, (MemoryType)j, tagBudgets[s_TypeNames[j]].as<uint64_t>());
+			}
+		}
+		catch (const YAML::Exception& e)
+		{
+			Log.CoreError("Couldn't load the memory budgets from {0}: {1}", path, e.what());
+			return false;
+		}
+
+		return true;
+	}
+
+	bool MemoryTracker::SaveBudgets()
+	{
+		if (s_BudgetsPath.empty())
+			return false;
+
+		YAML::Emitter emitter;
+		emitter << YAML::BeginMap << YAML::Key << "Budgets" << YAML::Value << YAML::BeginMap;
+		for (uint32_t i = 0; i < (uint32_t)MemoryTag::Count; i++)
+		{
+			emitter << YAML::Key << s_TagNames[i] << YAML::Value << YAML::BeginMap;
+			for (uint32_t j = 0; j < (uint32_t)MemoryType::Count; j++)
+				emitter << YAML::Key << s_TypeNames[j] << YAML::Value << s_Counters[i][j].Budget.load(std::memory_order_relaxed);
+			emitter << YAML::EndMap;
+		}
+		emitter << YAML::EndMap << YAML::EndMap;
+
+		std::ofstream file(s_BudgetsPath);
+		file << emitter.c_str();
+		return file.good();
+	}
+
+	void TrackedMemory::Resize(uint64_t bytes)
+	{
+		if (bytes == m_Bytes)
+			return;
+
+		int32_t allocations = 0;
+		if (m_Bytes == 0)
+			allocations = 1;
+		else if (bytes == 0)
+			allocations = -1;
+
+		MemoryTracker::Update(m_Tag, m_Type, (int64_t)bytes - (int64_t)m_Bytes, allocations);
+		m_Bytes = bytes;
+	}
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <Debut/Core/Core.h>
+
+#include <atomic>
+#include <string>
+
+/*
+	Memory accounting by subsystem and asset type. The owners of the big allocations report them; GPU sizes are
+	estimated from the size of buffers, textures and render targets.
+
+	GPU resources are counted under the tag of the innermost MemoryTagScope of the thread that creates them, so
+	that generic classes like the vertex buffers don't need to know who owns them. Budgets are checked on every
+	allocation, a warning is logged when a tag goes over its budget.
+
+	USAGE:
+		MemoryTagScope scope(MemoryTag::Renderer2D);
+		Ref<VertexBuffer> buffer = VertexBuffer::Create(vertices, count);	// Counted as Renderer2D GPU memory
+
+		TrackedMemory m_Memory = { MemoryTag::Meshes, MemoryType::CPU };
+		m_Memory.Resize(m_Vertices.capacity() * sizeof(float));
+*/
+
+namespace Debut
+{
+	enum class MemoryTag
+	{
+		Other = 0,
+		// Subsystems
+		Renderer2D, Renderer3D, RendererDebug, DynamicGeometry, FrameBuffers, FrameAllocator,
+		// Assets
+		Meshes, Textures, Skyboxes,
+
+		Count
+	};
+
+	enum class MemoryType { CPU = 0, GPU, Count };
+
+	struct MemoryStats
+	{
+		uint64_t Bytes = 0;
+		uint64_t PeakBytes = 0;
+		// Live allocations
+		uint32_t Allocations = 0;
+		// 0 if the tag doesn't have a budget
+		uint64_t Budget = 0;
+	};
+
+	class MemoryTracker
+	{
+		friend class MemoryTagScope;
+		friend class TrackedMemory;
+	public:
+		static void Allocate(MemoryTag tag, MemoryType type, uint64_t bytes);
+		static void Free(MemoryTag tag, MemoryType type, uint64_t bytes);
+
+		static MemoryStats GetStats(MemoryTag tag, MemoryType type);
+		static uint64_t GetTotal(MemoryType type);
+		static const char* GetTagName(MemoryTag tag);
+		static inline MemoryTag GetCurrentTag() { return s_CurrentTag; }
+
+		static void SetBudget(MemoryTag tag, MemoryType type, uint64_t bytes);
+		// Budgets are saved to the last file they were loaded from
+		static bool LoadBudgets(const std::string& path);
+		static bool SaveBudgets();
+
+	private:
+		static void Update(MemoryTag tag, MemoryType type, int64_t bytes, int32_t allocations);
+
+	private:
+		struct Counter
+		{
+			std::atomic<uint64_t> Bytes = 0;
+			std::atomic<uint64_t> PeakBytes = 0;
+			std::atomic<uint32_t> Allocations = 0;
+			std::atomic<uint64_t> Budget = 0;
+			std::atomic<bool> OverBudget = false;
+		};
+
+		static Counter s_Counters[(int)MemoryTag::Count][(int)MemoryType::Count];
+		static thread_local MemoryTag s_CurrentTag;
+		static std::string s_BudgetsPath;
+	};
+
+	// Sets the tag of the GPU resources created by this thread until the end of the scope
+	class MemoryTagScope
+	{
+	public:
+		MemoryTagScope(MemoryTag tag) : m_Previous(MemoryTracker::s_CurrentTag) { MemoryTracker::s_CurrentTag = tag; }
+		~MemoryTagScope() { MemoryTracker::s_CurrentTag = m_Previous; }
+
+		MemoryTagScope(const MemoryTagScope&) = delete;
+		MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+	private:
+		MemoryTag m_Previous;
+	};
+
+	// Size of a resource, reported to the tracker when it changes and when the owner is destroyed
+	class TrackedMemory
+	{
+	public:
+		// Uses the tag of the current scope
+		TrackedMemory(MemoryType type) : m_Tag(MemoryTracker::GetCurrentTag()), m_Type(type) {}
+		TrackedMemory(MemoryTag tag, MemoryType type) : m_Tag(tag), m_Type(type) {}
+		// Copies of the owner own a copy of the memory
+		TrackedMemory(const TrackedMemory& other) : m_Tag(other.m_Tag), m_Type(other.m_Type) { Resize(other.m_Bytes); }
+		~TrackedMemory() { Resize(0); }
+
+		TrackedMemory& operator=(const TrackedMemory& other)
+		{
+			if (this != &other)
+			{
+				Resize(0);
+				m_Tag = other.m_Tag;
+				m_Type = other.m_Type;
+				Resize(other.m_Bytes);
+			}
+			return *this;
+		}
+
+		void Resize(uint64_t bytes);
+		inline uint64_t GetBytes() const { return m_Bytes; }
+
+	private:
+		MemoryTag m_Tag;
+		MemoryType m_Type;
+		uint64_t m_Bytes = 0;
+	};
+}
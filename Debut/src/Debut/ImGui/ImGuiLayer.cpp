@@ -7,6 +7,9 @@
 #include <glad/glad.h>
 #include "ImGuizmo.h"
 #include <Debut/ImGui/ProgressPanel.h>
+#include <Debut/ImGui/ProfilerPanel.h>
+#include <Debut/ImGui/MemoryPanel.h>
+#include <Debut/Rendering/Renderer/RenderStateCache.h>
 #include <Debut/Core/Window.h>
 #include <stb_image.h>
 #include <stb_image_resize.h>
@@ -178,6 +181,8 @@ namespace Debut
 	void ImGuiLayer::OnImGuiRender()
 	{
 		ProgressPanel::OnImGuiRender();
+		ProfilerPanel::OnImGuiRender();
+		MemoryPanel::OnImGuiRender();
 		static bool showDemo = false;
 		//ImGui::ShowDemoWindow(&showDemo);
 	}
@@ -192,6 +197,8 @@ namespace Debut
 
 		ImGui::Render();
 		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		// ImGui talks to OpenGL directly
+		RenderStateCache::Invalidate();
 
 		if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
 		{
@@ -0,0 +1,79 @@
+#include <Debut/dbtpch.h>
+#include <Debut/ImGui/MemoryPanel.h>
+#include <Debut/ImGui/ImGuiUtils.h>
+#include <imgui.h>
+
+namespace Debut
+{
+	bool MemoryPanel::s_Open = false;
+
+	static float ToMegabytes(uint64_t bytes)
+	{
+		return bytes / (1024.0f * 1024.0f);
+	}
+
+	void MemoryPanel::OnImGuiRender()
+	{
+		if (!s_Open)
+			return;
+
+		ImGui::Begin("Memory", &s_Open);
+
+		ImGui::Text("CPU: %.2f MB  GPU: %.2f MB", ToMegabytes(MemoryTracker::GetTotal(MemoryType::CPU)),
+			ToMegabytes(MemoryTracker::GetTotal(MemoryType::GPU)));
+		ImGui::SameLine();
+		if (ImGui::Button("Save budgets") && !MemoryTracker::SaveBudgets())
+			Log.CoreError("Couldn't save the memory budgets");
+		ImGui::Separator();
+
+		if (ImGui::CollapsingHeader("CPU", ImGuiTreeNodeFlags_DefaultOpen))
+			DrawType(MemoryType::CPU);
+		if (ImGui::CollapsingHeader("GPU", ImGuiTreeNodeFlags_DefaultOpen))
+			DrawType(MemoryType::GPU);
+
+		ImGui::End();
+	}
+
+	void MemoryPanel::DrawType(MemoryType type)
+	{
+		uint32_t valueWidth = 85;
+		uint32_t nameWidth = (uint32_t)std::max(ImGui::GetContentRegionAvail().x - valueWidth * 4, 100.0f);
+
+		ImGui::PushID((int)type);
+		ImGuiUtils::StartColumns(5, { nameWidth, valueWidth, valueWidth, valueWidth, valueWidth });
+		ImGui::Text("Tag"); ImGuiUtils::NextColumn();
+		ImGui::Text("Size (MB)"); ImGuiUtils::NextColumn();
+		ImGui::Text("Peak (MB)"); ImGuiUtils::NextColumn();
+		ImGui::Text("Allocations"); ImGuiUtils::NextColumn();
+		ImGui::Text("Budget (MB)"); ImGuiUtils::NextColumn();
+		ImGui::Separator();
+
+		for (uint32_t i = 0; i < (uint32_t)MemoryTag::Count; i++)
+		{
+			MemoryTag tag = (MemoryTag)i;
+			MemoryStats stats = MemoryTracker::GetStats(tag, type);
+			bool overBudget = stats.Budget > 0 && stats.Bytes > stats.Budget;
+
+			ImGui::Text("%s", MemoryTracker::GetTagName(tag)); ImGuiUtils::NextColumn();
+			if (overBudget)
+				ImGui::TextColored({ 0.9f, 0.3f, 0.25f, 1.0f }, "%.2f", ToMegabytes(stats.Bytes));
+			else
+				ImGui::Text("%.2f", ToMegabytes(stats.Bytes));
+			ImGuiUtils::NextColumn();
+			ImGui::Text("%.2f", ToMegabytes(stats.PeakBytes)); ImGuiUtils::NextColumn();
+			ImGui::Text("%u", stats.Allocations); ImGuiUtils::NextColumn();
+
+			// 0 removes the budget
+			float budget = ToMegabytes(stats.Budget);
+			ImGui::PushID(i);
+			ImGui::SetNextItemWidth(-1);
+			if (ImGui::DragFloat("##Budget", &budget, 1.0f, 0.0f, 65536.0f, "%.1f"))
+				MemoryTracker::SetBudget(tag, type, (uint64_t)(budget * 1024.0 * 1024.0));
+			ImGui::PopID();
+			ImGuiUtils::NextColumn();
+		}
+
+		ImGuiUtils::ResetColumns();
+		ImGui::PopID();
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <Debut/Core/MemoryTracker.h>
+
+namespace Debut
+{
+	class MemoryPanel
+	{
+	public:
+		static void OnImGuiRender();
+
+		static void SetOpen(bool open) { s_Open = open; }
+		static bool IsOpen() { return s_Open; }
+
+	private:
+		static void DrawType(MemoryType type);
+
+	private:
+		static bool s_Open;
+	};
+}
@@ -0,0 +1,269 @@
+#include <Debut/dbtpch.h>
+#include <Debut/ImGui/ProfilerPanel.h>
+#include <Debut/ImGui/ImGuiUtils.h>
+#include <imgui.h>
+
+namespace Debut
+{
+	bool ProfilerPanel::s_Open = false;
+	int ProfilerPanel::s_SelectedFrame = -1;
+	float ProfilerPanel::s_SpikeThreshold = 33.3f;
+
+	std::vector<float> ProfilerPanel::s_FrameTimes;
+	ProfiledFrame ProfilerPanel::s_Frame;
+	std::vector<ProfiledScopeStats> ProfilerPanel::s_Stats;
+
+	static ImU32 GetScopeColor(const char* name)
+	{
+		// Same scope, same color
+		uint32_t hash = (uint32_t)(((uintptr_t)name >> 3) * 2654435761u);
+		return ImColor::HSV((hash % 360) / 360.0f, 0.45f, 0.75f);
+	}
+
+	static uint32_t DrawScopeNode(const ProfiledFrame& frame, uint32_t index)
+	{
+		const ProfiledScope& scope = frame.Scopes[index];
+		uint32_t next = index + 1;
+		bool leaf = next >= frame.Scopes.size() || frame.Scopes[next].Depth <= scope.Depth;
+
+		ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_OpenOnArrow;
+		if (leaf)
+			flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+		if (scope.Depth < 2)
+			flags |= ImGuiTreeNodeFlags_DefaultOpen;
+
+		float duration = ProfiledFrame::ToMilliseconds(scope.End - scope.Start);
+		bool open = ImGui::TreeNodeEx((void*)(intptr_t)index, flags, "%s", scope.Name);
+
+		ImGui::SameLine(ImGui::GetWindowContentRegionMax().x - 160);
+		ImGui::Text("%8.3f ms %6.1f%%", duration, duration / frame.GetDuration() * 100.0f);
+
+		if (leaf)
+			return next;
+
+		// Scopes are in pre order, the children are the following deeper scopes
+		if (open)
+		{
+			while (next < frame.Scopes.size() && frame.Scopes[next].Depth > scope.Depth)
+				next = DrawScopeNode(frame, next);
+			ImGui::TreePop();
+		}
+		else
+		{
+			while (next < frame.Scopes.size() && frame.Scopes[next].Depth > scope.Depth)
+				next++;
+		}
+
+		return next;
+	}
+
+	void ProfilerPanel::OnImGuiRender()
+	{
+		if (!s_Open)
+			return;
+
+		ImGui::Begin("Profiler", &s_Open);
+
+		FrameProfiler::GetFrameTimes(s_FrameTimes);
+		if (s_SelectedFrame >= (int)s_FrameTimes.size())
+			s_SelectedFrame = -1;
+		int frameIndex = s_SelectedFrame < 0 ? (int)s_FrameTimes.size() - 1 : s_SelectedFrame;
+		bool hasFrame = frameIndex >= 0 && FrameProfiler::GetFrame(frameIndex, s_Frame);
+
+		// Toolbar
+		bool recording = FrameProfiler::IsEnabled();
+		if (ImGui::Checkbox("Record", &recording))
+		{
+			if (recording)
+				FrameProfiler::Init();
+			else
+				FrameProfiler::Shutdown();
+		}
+		ImGui::SameLine();
+		bool paused = FrameProfiler::IsPaused();
+		if (ImGui::Checkbox("Pause", &paused))
+			FrameProfiler::SetPaused(paused);
+		ImGui::SameLine();
+		if (ImGui::Button("Latest"))
+			s_SelectedFrame = -1;
+		ImGui::SameLine();
+		if (ImGui::Button("Save frame") && hasFrame)
+			FrameProfiler::SaveFrame(frameIndex);
+
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(80);
+		ImGui::DragFloat("Spike threshold (ms)", &s_SpikeThreshold, 0.5f, 1.0f, 1000.0f, "%.1f");
+		ImGui::SameLine();
+		if (FrameProfiler::IsWaitingForSpike())
+		{
+			if (ImGui::Button("Cancel capture"))
+				FrameProfiler::CaptureNextSpike(0.0f);
+		}
+		else if (ImGui::Button("Capture next spike"))
+			FrameProfiler::CaptureNextSpike(s_SpikeThreshold);
+
+		DrawFrameGraph();
+
+		if (hasFrame)
+			ImGui::Text("Frame %llu: %.3f ms", (unsigned long long)s_Frame.Index, s_Frame.GetDuration());
+		else
+			ImGui::Text(FrameProfiler::IsEnabled() ? "No profiled frames" : "Recording is off, check Record or start with --profile");
+		ImGuiUtils::Separator();
+
+		if (ImGui::BeginTabBar("ProfilerTabs"))
+		{
+			if (ImGui::BeginTabItem("Breakdown"))
+			{
+				if (hasFrame)
+					DrawBreakdown();
+				ImGui::EndTabItem();
+			}
+			if (ImGui::BeginTabItem("Flame"))
+			{
+				if (hasFrame)
+					DrawFlame();
+				ImGui::EndTabItem();
+			}
+			if (ImGui::BeginTabItem("Statistics"))
+			{
+				DrawStats();
+				ImGui::EndTabItem();
+			}
+
+			ImGui::EndTabBar();
+		}
+
+		ImGui::End();
+	}
+
+	void ProfilerPanel::DrawFrameGraph()
+	{
+		ImVec2 size = { ImGui::GetContentRegionAvail().x, 80 };
+		ImVec2 origin = ImGui::GetCursorScreenPos();
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+		ImGui::InvisibleButton("FrameGraph", size);
+		drawList->AddRectFilled(origin, { origin.x + size.x, origin.y + size.y }, IM_COL32(30, 30, 30, 255));
+		if (s_FrameTimes.size() == 0)
+			return;
+
+		float maxTime = s_SpikeThreshold * 1.2f;
+		for (float time : s_FrameTimes)
+			maxTime = std::max(maxTime, time);
+
+		float barWidth = size.x / s_FrameTimes.size();
+		int selected = s_SelectedFrame < 0 ? (int)s_FrameTimes.size() - 1 : s_SelectedFrame;
+		int hovered = -1;
+		if (ImGui::IsItemHovered())
+			hovered = std::min((int)((ImGui::GetMousePos().x - origin.x) / barWidth), (int)s_FrameTimes.size() - 1);
+
+		for (uint32_t i = 0; i < s_FrameTimes.size(); i++)
+		{
+			float height = s_FrameTimes[i] / maxTime * size.y;
+			ImU32 color = s_FrameTimes[i] > s_SpikeThreshold ? IM_COL32(220, 70, 60, 255) : IM_COL32(90, 180, 90, 255);
+			if ((int)i == selected || (int)i == hovered)
+				color = IM_COL32(240, 240, 240, 255);
+
+			drawList->AddRectFilled({ origin.x + i * barWidth, origin.y + size.y - height },
+				{ origin.x + (i + 1) * barWidth - (barWidth > 3 ? 1 : 0), origin.y + size.y }, color);
+		}
+
+		// Spike threshold
+		float thresholdY = origin.y + size.y - s_SpikeThreshold / maxTime * size.y;
+		drawList->AddLine({ origin.x, thresholdY }, { origin.x + size.x, thresholdY }, IM_COL32(220, 70, 60, 160));
+
+		if (hovered >= 0)
+		{
+			ImGui::SetTooltip("%.3f ms", s_FrameTimes[hovered]);
+			if (ImGui::IsItemClicked())
+			{
+				s_SelectedFrame = hovered;
+				FrameProfiler::SetPaused(true);
+			}
+		}
+	}
+
+	void ProfilerPanel::DrawBreakdown()
+	{
+		ImGui::BeginChild("Breakdown");
+		DrawScopeNode(s_Frame, 0);
+		ImGui::EndChild();
+	}
+
+	void ProfilerPanel::DrawFlame()
+	{
+		float rowHeight = ImGui::GetTextLineHeight() + 4;
+		uint32_t maxDepth = 0;
+		for (auto& scope : s_Frame.Scopes)
+			maxDepth = std::max(maxDepth, scope.Depth);
+
+		ImGui::BeginChild("Flame", { 0, 0 }, false, ImGuiWindowFlags_HorizontalScrollbar);
+
+		ImVec2 size = { ImGui::GetContentRegionAvail().x, (maxDepth + 1) * rowHeight };
+		ImVec2 origin = ImGui::GetCursorScreenPos();
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+		ImGui::InvisibleButton("FlameGraph", size);
+
+		bool hovered = ImGui::IsItemHovered();
+		ImVec2 mouse = ImGui::GetMousePos();
+		uint64_t frameStart = s_Frame.GetStart();
+		float scale = size.x / (float)std::max<uint64_t>(s_Frame.Scopes[0].End - frameStart, 1);
+
+		for (auto& scope : s_Frame.Scopes)
+		{
+			ImVec2 min = { origin.x + (scope.Start - frameStart) * scale, origin.y + scope.Depth * rowHeight };
+			ImVec2 max = { origin.x + (scope.End - frameStart) * scale, min.y + rowHeight - 1 };
+			// Scopes narrower than a pixel would just be noise
+			if (max.x - min.x < 1.0f)
+				continue;
+
+			drawList->AddRectFilled(min, max, GetScopeColor(scope.Name));
+			if (max.x - min.x > 20.0f)
+			{
+				drawList->PushClipRect(min, max, true);
+				drawList->AddText({ min.x + 2, min.y + 2 }, IM_COL32(0, 0, 0, 255), scope.Name);
+				drawList->PopClipRect();
+			}
+
+			if (hovered && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y)
+				ImGui::SetTooltip("%s\n%.3f ms", scope.Name, ProfiledFrame::ToMilliseconds(scope.End - scope.Start));
+		}
+
+		ImGui::EndChild();
+	}
+
+	void ProfilerPanel::DrawStats()
+	{
+		FrameProfiler::GetScopeStats(s_Stats);
+
+		ImGui::BeginChild("Statistics");
+		uint32_t valueWidth = 75;
+		uint32_t nameWidth = (uint32_t)std::max(ImGui::GetContentRegionAvail().x - valueWidth * 5, 100.0f);
+
+		ImGuiUtils::StartColumns(6, { nameWidth, valueWidth, valueWidth, valueWidth, valueWidth, valueWidth });
+		ImGui::Text("Scope"); ImGuiUtils::NextColumn();
+		ImGui::Text("Avg (ms)"); ImGuiUtils::NextColumn();
+		ImGui::Text("Min (ms)"); ImGuiUtils::NextColumn();
+		ImGui::Text("Max (ms)"); ImGuiUtils::NextColumn();
+		ImGui::Text("Last (ms)"); ImGuiUtils::NextColumn();
+		ImGui::Text("Calls"); ImGuiUtils::NextColumn();
+		ImGui::Separator();
+
+		for (auto& stat : s_Stats)
+		{
+			ImGui::Text("%s", stat.Name);
+			if (ImGui::IsItemHovered())
+				ImGui::SetTooltip("%s\nIn %u of the last %u frames", stat.Name, stat.Frames, (uint32_t)s_FrameTimes.size());
+			ImGuiUtils::NextColumn();
+
+			ImGui::Text("%.3f", stat.Avg); ImGuiUtils::NextColumn();
+			ImGui::Text("%.3f", stat.Min); ImGuiUtils::NextColumn();
+			ImGui::Text("%.3f", stat.Max); ImGuiUtils::NextColumn();
+			ImGui::Text("%.3f", stat.Last); ImGuiUtils::NextColumn();
+			ImGui::Text("%.1f", stat.Calls); ImGuiUtils::NextColumn();
+		}
+
+		ImGuiUtils::ResetColumns();
+		ImGui::EndChild();
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Debut/Core/FrameProfiler.h>
+
+#include <vector>
+
+namespace Debut
+{
+	class ProfilerPanel
+	{
+	public:
+		static void OnImGuiRender();
+
+		static void SetOpen(bool open) { s_Open = open; }
+		static bool IsOpen() { return s_Open; }
+
+	private:
+		static void DrawFrameGraph();
+		static void DrawBreakdown();
+		static void DrawFlame();
+		static void DrawStats();
+
+	private:
+		static bool s_Open;
+		// Position in the history, -1 follows the latest frame
+		static int s_SelectedFrame;
+		static float s_SpikeThreshold;
+
+		static std::vector<float> s_FrameTimes;
+		static ProfiledFrame s_Frame;
+		static std::vector<ProfiledScopeStats> s_Stats;
+	};
+}
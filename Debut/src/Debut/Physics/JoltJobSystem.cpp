@@ -0,0 +1,116 @@
+#include <Debut/dbtpch.h>
+#include <Debut/Physics/JoltJobSystem.h>
+#include <Debut/Core/JobSystem.h>
+
+namespace Debut
+{
+	JoltJobSystem::JoltJobSystem(uint32_t maxBarriers) : m_Barriers(maxBarriers) {}
+
+	JoltJobSystem::~JoltJobSystem()
+	{
+		for (auto& barrier : m_Barriers)
+			DBT_CORE_ASSERT(!barrier.InUse, "A physics barrier is still in use");
+	}
+
+	int JoltJobSystem::GetMaxConcurrency() const
+	{
+		// Workers + the thread that steps the simulation
+		return (int)Debut::JobSystem::GetWorkerCount() + 1;
+	}
+
+	JPH::JobSystem::JobHandle JoltJobSystem::CreateJob(const char* inName, JPH::ColorArg inColor, const JobFunction& inJobFunction, JPH::uint32 inNumDependencies)
+	{
+		Job* job = new Job(inName, inColor, this, inJobFunction, inNumDependencies);
+		JobHandle handle(job);
+
+		// Jobs with dependencies are queued by Jolt once the last one is removed
+		if (inNumDependencies == 0)
+			QueueJob(job);
+
+		return handle;
+	}
+
+	void JoltJobSystem::QueueJob(Job* inJob)
+	{
+		// Keep the job alive until it has been executed
+		inJob->AddRef();
+		Debut::JobSystem::Execute([inJob]()
+		{
+			inJob->Execute();
+			inJob->Release();
+		});
+	}
+
+	void JoltJobSystem::QueueJobs(Job** inJobs, JPH::uint inNumJobs)
+	{
+		for (JPH::uint i = 0; i < inNumJobs; i++)
+			QueueJob(inJobs[i]);
+	}
+
+	void JoltJobSystem::FreeJob(Job* inJob)
+	{
+		delete inJob;
+	}
+
+	JPH::JobSystem::Barrier* JoltJobSystem::CreateBarrier()
+	{
+		std::lock_guard<std::mutex> lock(m_BarrierMutex);
+		for (auto& barrier : m_Barriers)
+		{
+			if (!barrier.InUse)
+			{
+				barrier.InUse = true;
+				return &barrier;
+			}
+		}
+
+		DBT_CORE_ASSERT(false, "Ran out of physics barriers");
+		return nullptr;
+	}
+
+	void JoltJobSystem::DestroyBarrier(Barrier* inBarrier)
+	{
+		std::lock_guard<std::mutex> lock(m_BarrierMutex);
+		((JoltBarrier*)inBarrier)->InUse = false;
+	}
+
+	void JoltJobSystem::WaitForJobs(Barrier* inBarrier)
+	{
+		((JoltBarrier*)inBarrier)->Wait();
+	}
+
+	void JoltJobSystem::JoltBarrier::AddJob(const JobHandle& inJob)
+	{
+		// SetBarrier fails if the job has already been executed
+		if (!inJob->SetBarrier(this))
+			return;
+
+		m_NumPending.fetch_add(1);
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Jobs.push_back(inJob);
+	}
+
+	void JoltJobSystem::JoltBarrier::AddJobs(const JobHandle* inHandles, JPH::uint inNumHandles)
+	{
+		for (JPH::uint i = 0; i < inNumHandles; i++)
+			AddJob(inHandles[i]);
+	}
+
+	void JoltJobSystem::JoltBarrier::OnJobFinished(Job* inJob)
+	{
+		m_NumPending.fetch_sub(1);
+	}
+
+	void JoltJobSystem::JoltBarrier::Wait()
+	{
+		// Help with the work instead of just sleeping, the physics jobs are in the same queues
+		while (m_NumPending.load() > 0)
+		{
+			if (!Debut::JobSystem::RunPendingJob())
+				std::this_thread::yield();
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Jobs.clear();
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/JobSystem.h>
+
+#include <mutex>
+#include <atomic>
+#include <vector>
+
+/*
+	Runs Jolt's jobs on the engine job system instead of letting Jolt create its own thread pool
+*/
+
+namespace Debut
+{
+	class JoltJobSystem : public JPH::JobSystem
+	{
+	public:
+		JoltJobSystem(uint32_t maxBarriers);
+		virtual ~JoltJobSystem();
+
+		virtual int GetMaxConcurrency() const override;
+		virtual JobHandle CreateJob(const char* inName, JPH::ColorArg inColor, const JobFunction& inJobFunction, JPH::uint32 inNumDependencies = 0) override;
+
+		virtual Barrier* CreateBarrier() override;
+		virtual void DestroyBarrier(Barrier* inBarrier) override;
+		virtual void WaitForJobs(Barrier* inBarrier) override;
+
+	protected:
+		virtual void QueueJob(Job* inJob) override;
+		virtual void QueueJobs(Job** inJobs, JPH::uint inNumJobs) override;
+		virtual void FreeJob(Job* inJob) override;
+
+	private:
+		class JoltBarrier : public Barrier
+		{
+		public:
+			void Wait();
+			bool InUse = false;
+
+		protected:
+			virtual void AddJob(const JobHandle& inJob) override;
+			virtual void AddJobs(const JobHandle* inHandles, JPH::uint inNumHandles) override;
+			virtual void OnJobFinished(Job* inJob) override;
+
+		private:
+			std::mutex m_Mutex;
+			std::vector<JobHandle> m_Jobs;
+			std::atomic<int32_t> m_NumPending = 0;
+		};
+
+		std::vector<JoltBarrier> m_Barriers;
+		std::mutex m_BarrierMutex;
+	};
+}
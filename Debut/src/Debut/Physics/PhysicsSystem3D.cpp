@@ -5,11 +5,11 @@
 #include <Debut/Rendering/Resources/Mesh.h>
 #include <Debut/Physics/PhysicsMaterial3D.h>
 #include <Debut/Physics/PhysicsSystem3D.h>
+#include <Debut/Physics/JoltJobSystem.h>
 
 #include <Jolt/RegisterTypes.h>
 #include <Jolt/Core/Factory.h>
 #include <Jolt/Core/TempAllocator.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/Physics/Collision/Shape/BoxShape.h>
 #include <Jolt/Physics/Collision/Shape/SphereShape.h>
@@ -69,7 +69,7 @@ namespace Debut
 		RegisterTypes();
 
 		m_BodyIDs.resize(settings.MaxBodies);
-		m_JobSystem = new JobSystemThreadPool(settings.MaxJobs, settings.MaxPhysicsBarriers, thread::hardware_concurrency() - 1);
+		m_JobSystem = new JoltJobSystem(settings.MaxPhysicsBarriers);
 		
 		m_BPLayerInterface = new BPLayerInterfaceImpl();
 		m_BodyActivationListener = new MyBodyActivationListener();
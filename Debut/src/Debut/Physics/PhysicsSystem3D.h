@@ -28,7 +28,6 @@ namespace Debut
 		uint32_t MaxContactConstraints = 10240;
 		uint32_t NBodyMutexes = 0;
 
-		uint32_t MaxJobs = 2048;
 		uint32_t MaxPhysicsBarriers = 8;
 		uint32_t MaxAllocatedSpace = 10 * 1024 * 1024;
 	};
@@ -170,7 +169,7 @@ namespace Debut
 	private:
 		PhysicsSystem* m_PhysicsSystem;
 		BPLayerInterfaceImpl* m_BPLayerInterface; 
-		JobSystem* m_JobSystem;
+		JPH::JobSystem* m_JobSystem;
 		TempAllocatorImpl* m_TempAllocator;
 
 		MyBodyActivationListener* m_BodyActivationListener;
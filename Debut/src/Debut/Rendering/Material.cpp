@@ -23,11 +23,11 @@
 
 namespace Debut
 {
-	UUID Material::s_PrevShader = 0;
-
 	std::vector<std::string> Material::s_DefaultUniforms = {
 		"u_ViewProjection", "u_ViewMatrix", "u_ProjectionMatrix", "u_PointLights", "u_AmbientLightColor", "u_DirectionalLightDir",
-		"u_AmbientLightIntensity", "u_CameraPosition", "u_DirectionalLightCol", "u_DirectionalLightIntensity"
+		"u_AmbientLightIntensity", "u_CameraPosition", "u_DirectionalLightCol", "u_DirectionalLightIntensity",
+		"u_ClusteredLighting", "u_ClusterDepthScale", "u_ClusterDepthBias", "u_ClusterLights", "u_ClusterRanges",
+		"u_ClusterLightIndices"
 	};
 
 	Material::Material(const std::string& path, const std::string& metaPath) : m_Path(path), m_MetaPath(metaPath)
@@ -229,14 +229,7 @@ namespace Debut
 
 	void Material::Use()
 	{
-		/* This could work, but the bound shader should be in some kind of RendererState class: the shader can be
-		*  changed by other renderers
-		if (s_PrevShader != m_RuntimeShader->GetID())
-		{
-			m_RuntimeShader->Bind();
-			s_PrevShader = m_RuntimeShader->GetID();
-		}
-		*/
+		// Binding the same shader, textures or uniform values again is dropped by the render state cache
 		if (m_RuntimeShader == nullptr)
 			m_RuntimeShader = AssetManager::Request<Shader>(m_Shader);
 		if (m_RuntimeShader == nullptr)
@@ -308,6 +301,9 @@ namespace Debut
 			case ShaderDataType::SamplerCube:
 				m_RuntimeShader->SetInt(uniform.second.Name, std::get<UUID>(uniform.second.Data));
 				break;
+			// Buffers are bound by the renderer
+			case ShaderDataType::SamplerBuffer:
+				break;
 			case ShaderDataType::None:
 				break;
 			default:
@@ -83,7 +83,6 @@ namespace Debut
 		void Load(std::ifstream& file);
 
 	private:
-		static UUID s_PrevShader;
 		UUID m_ID;
 		bool m_Valid;
 
@@ -11,6 +11,7 @@
 #include <Debut/Rendering/Resources/PostProcessing.h>
 #include <Debut/Rendering/Renderer/RenderCommand.h>
 #include <Platform/OpenGL/OpenGLRenderTexture.h>>
+#include <Platform/Null/NullRenderTexture.h>
 
 namespace Debut
 {
@@ -20,6 +21,8 @@ namespace Debut
 		{
 		case RendererAPI::API::OpenGL:
 			return CreateRef<OpenGLRenderTexture>(width, height, buffer, mode);
+		case RendererAPI::API::Null:
+			return CreateRef<NullRenderTexture>(width, height, buffer, mode);
 		default:
 			return nullptr;
 		}
@@ -1,9 +1,8 @@
 #include "Debut/dbtpch.h"
 #include "RenderCommand.h"
 #include "RendererAPI.h"
-#include "Platform/OpenGL/OpenGLRendererAPI.h"
 
 namespace Debut
 {
-	RendererAPI* RenderCommand::s_RendererAPI = new OpenGLRendererAPI();
-}
\ No newline at end of file
+	RendererAPI* RenderCommand::s_RendererAPI = nullptr;
+}
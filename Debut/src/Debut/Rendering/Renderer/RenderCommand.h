@@ -11,6 +11,9 @@ namespace Debut
 	public:
 		inline static void Init()
 		{
+			// The backend is chosen when the renderer starts, so that RendererAPI::SetAPI can select the null one
+			delete s_RendererAPI;
+			s_RendererAPI = RendererAPI::Create();
 			s_RendererAPI->Init();
 		}
 
@@ -51,6 +54,16 @@ namespace Debut
 			s_RendererAPI->DrawIndexed(va, indexCount);
 		}
 
+		inline static void DrawIndexedBaseVertex(const Ref<VertexArray>& va, uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex)
+		{
+			s_RendererAPI->DrawIndexedBaseVertex(va, indexCount, firstIndex, baseVertex);
+		}
+
+		inline static void DrawIndexedInstanced(const Ref<VertexArray>& va, uint32_t indexCount, uint32_t instanceCount)
+		{
+			s_RendererAPI->DrawIndexedInstanced(va, indexCount, instanceCount);
+		}
+
 		inline static void DrawLines(const Ref<VertexArray>& va, uint32_t vertexCount = 0)
 		{
 			s_RendererAPI->DrawLines(va, vertexCount);
@@ -0,0 +1,150 @@
+#include <Debut/dbtpch.h>
+#include <Debut/Rendering/Renderer/RenderCommandBuffer.h>
+#include <Debut/Rendering/Renderer/Renderer3D.h>
+#include <Debut/Rendering/Resources/Mesh.h>
+#include <Debut/Rendering/Material.h>
+#include <Debut/AssetManager/AssetManager.h>
+#include <Debut/Core/Instrumentor.h>
+
+#include <algorithm>
+
+namespace Debut
+{
+	RenderQueueStats RenderQueue::s_Stats;
+	RenderQueueStats RenderQueue::s_PrevStats;
+
+	void RenderCommandBuffer::DrawMesh(uint64_t sortKey, UUID mesh, UUID material, const glm::mat4& transform, int entityID, bool instanced)
+	{
+		RenderCommandPacket packet;
+		packet.DrawMesh.Mesh = mesh;
+		packet.DrawMesh.Material = material;
+		packet.DrawMesh.Transform = (uint32_t)m_Transforms.size();
+		packet.DrawMesh.EntityID = entityID;
+		packet.DrawMesh.Instanced = instanced;
+
+		m_Transforms.push_back(transform);
+		Push(sortKey, RenderCommandType::DrawMesh, packet);
+	}
+
+	void RenderCommandBuffer::Clear()
+	{
+		m_Commands.clear();
+		m_Transforms.clear();
+	}
+
+	void RenderCommandBuffer::Push(uint64_t sortKey, RenderCommandType type, RenderCommandPacket& packet)
+	{
+		packet.SortKey = sortKey;
+		packet.Type = type;
+		m_Commands.push_back(packet);
+	}
+
+	RenderCommandBuffer& RenderQueue::GetThreadBuffer()
+	{
+		std::lock_guard<std::mutex> lock(m_BuffersMutex);
+
+		Scope<RenderCommandBuffer>& buffer = m_Buffers[std::this_thread::get_id()];
+		if (buffer == nullptr)
+			buffer = std::make_unique<RenderCommandBuffer>();
+		return *buffer;
+	}
+
+	void RenderQueue::Execute()
+	{
+		DBT_PROFILE_FUNCTION();
+
+		uint32_t recordingThreads = 0;
+		{
+			DBT_PROFILE_SCOPE("RenderQueue::Sort");
+			m_Sorted.clear();
+
+			for (auto& buffer : m_Buffers)
+			{
+				if (buffer.second->m_Commands.empty())
+					continue;
+
+				recordingThreads++;
+				for (const RenderCommandPacket& command : buffer.second->m_Commands)
+					m_Sorted.push_back({ &command, buffer.second.get() });
+			}
+
+			std::sort(m_Sorted.begin(), m_Sorted.end(), [](const SortedCommand& a, const SortedCommand& b)
+				{
+					if (a.Command->SortKey != b.Command->SortKey)
+						return a.Command->SortKey < b.Command->SortKey;
+					if (a.Command->Type != b.Command->Type)
+						return a.Command->Type < b.Command->Type;
+					if (a.Command->Type == RenderCommandType::DrawMesh)
+						return a.Command->DrawMesh.EntityID < b.Command->DrawMesh.EntityID;
+					return false;
+				});
+		}
+
+		{
+			DBT_PROFILE_SCOPE("RenderQueue::Replay");
+			for (const SortedCommand& command : m_Sorted)
+				Replay(*command.Command, *command.Buffer);
+		}
+
+		s_Stats.Commands += (uint32_t)m_Sorted.size();
+		s_Stats.Executions++;
+		s_Stats.RecordingThreads = std::max(s_Stats.RecordingThreads, recordingThreads);
+	}
+
+	void RenderQueue::Replay(const RenderCommandPacket& command, const RenderCommandBuffer& buffer)
+	{
+		switch (command.Type)
+		{
+		case RenderCommandType::DrawMesh:
+		{
+			// Assets are resolved here: loading them can create backend resources, which only the render
+			// thread is allowed to do
+			const DrawMeshCommand& draw = command.DrawMesh;
+			Ref<Mesh> mesh = AssetManager::Request<Mesh>(draw.Mesh);
+			Ref<Material> material = AssetManager::Request<Material>(draw.Material);
+
+			if (mesh == nullptr)
+			{
+				Log.CoreError("Couldn't find mesh to render. Did you reimport and overwrite the model?");
+				break;
+			}
+			if (material == nullptr)
+			{
+				Log.CoreError("Couldn't find material to render with. Did you reimport and overwrite the model?");
+				break;
+			}
+
+			s_Stats.Draws++;
+			Renderer3D::DrawModel(*mesh.get(), *material.get(), buffer.m_Transforms[draw.Transform], draw.EntityID, draw.Instanced);
+			break;
+		}
+		default:
+			DBT_CORE_ASSERT(false, "Unknown render command");
+			break;
+		}
+	}
+
+	void RenderQueue::Clear()
+	{
+		std::lock_guard<std::mutex> lock(m_BuffersMutex);
+		for (auto& buffer : m_Buffers)
+			buffer.second->Clear();
+		m_Sorted.clear();
+	}
+
+	uint64_t RenderQueue::MakeDrawKey(UUID material, UUID mesh, Layer layer)
+	{
+		uint64_t materialID = material;
+		uint64_t meshID = mesh;
+		uint64_t materialBits = (materialID ^ (materialID >> 32)) & 0xFFFFFFFF;
+		uint64_t meshBits = (meshID ^ (meshID >> 24) ^ (meshID >> 48)) & 0xFFFFFF;
+
+		return ((uint64_t)layer << 56) | (materialBits << 24) | meshBits;
+	}
+
+	void RenderQueue::EndFrame()
+	{
+		s_PrevStats = s_Stats;
+		s_Stats = RenderQueueStats();
+	}
+}
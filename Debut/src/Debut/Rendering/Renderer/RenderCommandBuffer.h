@@ -0,0 +1,133 @@
+#pragma once
+
+#include <Debut/Core/Core.h>
+#include <Debut/Core/UUID.h>
+
+#include <glm/glm.hpp>
+
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/*
+	Deferred rendering commands. Commands are small POD structs that don't reference any backend object: they can
+	be recorded by any thread without touching the driver or the asset caches. Every thread records in its own
+	buffer of the queue, so recording doesn't need any synchronization.
+
+	Once the recording is over, the render thread merges the buffers, sorts the commands by key and replays them
+	against the renderer. Draws with the same key are sorted by entity, so the order doesn't depend on the thread
+	that recorded them.
+
+	Pipeline state isn't recorded: sorting would move it away from the draws it belongs to. Set it on the render
+	thread before executing the queue.
+
+	USAGE:
+		JobSystem::ParallelFor(count, 64, [&](uint32_t start, uint32_t end)
+		{
+			RenderCommandBuffer& buffer = queue.GetThreadBuffer();
+			for (uint32_t i = start; i < end; i++)
+				buffer.DrawMesh(RenderQueue::MakeDrawKey(material, mesh), mesh, material, transform, entity);
+		});
+
+		queue.Execute();
+		queue.Clear();
+*/
+
+namespace Debut
+{
+	enum class RenderCommandType : uint8_t { DrawMesh = 0 };
+
+	struct DrawMeshCommand
+	{
+		uint64_t Mesh;
+		uint64_t Material;
+		// Index in the transforms of the buffer that recorded the command
+		uint32_t Transform;
+		int32_t EntityID;
+		bool Instanced;
+	};
+
+	struct RenderCommandPacket
+	{
+		uint64_t SortKey;
+		RenderCommandType Type;
+		union
+		{
+			DrawMeshCommand DrawMesh;
+		};
+	};
+
+	static_assert(std::is_trivially_copyable<RenderCommandPacket>::value, "Render commands must be POD");
+
+	struct RenderQueueStats
+	{
+		// Last frame
+		uint32_t Commands = 0;
+		uint32_t Draws = 0;
+		uint32_t Executions = 0;
+		// Most threads that recorded in the same queue
+		uint32_t RecordingThreads = 0;
+	};
+
+	// Commands recorded by a single thread
+	class RenderCommandBuffer
+	{
+		friend class RenderQueue;
+	public:
+		void DrawMesh(uint64_t sortKey, UUID mesh, UUID material, const glm::mat4& transform, int entityID, bool instanced = false);
+
+		// Keeps the memory, so that the next frames don't allocate
+		void Clear();
+		inline uint32_t GetSize() const { return (uint32_t)m_Commands.size(); }
+
+	private:
+		void Push(uint64_t sortKey, RenderCommandType type, RenderCommandPacket& packet);
+
+	private:
+		std::vector<RenderCommandPacket> m_Commands;
+		std::vector<glm::mat4> m_Transforms;
+	};
+
+	// Per thread buffers of a pass
+	class RenderQueue
+	{
+	public:
+		// Layers are the most significant bits of the key: all the commands of a layer are executed before the
+		// ones of the next layer
+		enum Layer : uint8_t { Opaque = 0 };
+
+		// Buffer of the calling thread, created the first time the thread records in this queue
+		RenderCommandBuffer& GetThreadBuffer();
+
+		// Merges and sorts the buffers, then replays them. Must be called by the render thread once nobody is
+		// recording anymore
+		void Execute();
+		void Clear();
+
+		// Groups the draws by material first, then by mesh
+		static uint64_t MakeDrawKey(UUID material, UUID mesh, Layer layer = Layer::Opaque);
+
+		// Called once the frame is over
+		static void EndFrame();
+		static inline RenderQueueStats GetStats() { return s_PrevStats; }
+
+	private:
+		void Replay(const RenderCommandPacket& command, const RenderCommandBuffer& buffer);
+
+	private:
+		struct SortedCommand
+		{
+			const RenderCommandPacket* Command;
+			const RenderCommandBuffer* Buffer;
+		};
+
+		std::mutex m_BuffersMutex;
+		std::unordered_map<std::thread::id, Scope<RenderCommandBuffer>> m_Buffers;
+		std::vector<SortedCommand> m_Sorted;
+
+		static RenderQueueStats s_Stats;
+		static RenderQueueStats s_PrevStats;
+	};
+}
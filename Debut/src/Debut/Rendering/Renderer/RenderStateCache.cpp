@@ -0,0 +1,145 @@
+#include <Debut/dbtpch.h>
+#include <Debut/Rendering/Renderer/RenderStateCache.h>
+
+#include <cstring>
+
+namespace Debut
+{
+	RenderStateCache::State RenderStateCache::s_State;
+	RenderStateCacheStats RenderStateCache::s_Stats;
+	RenderStateCacheStats RenderStateCache::s_PrevStats;
+
+	bool UniformCache::Set(int32_t location, const void* data, uint32_t size)
+	{
+		RenderStateCacheStats& stats = RenderStateCache::s_Stats;
+		if (location < 0)
+		{
+			stats.Elided++;
+			stats.ElidedUniforms++;
+			return false;
+		}
+
+		if ((uint32_t)location >= m_Values.size())
+			m_Values.resize(location + 1);
+
+		std::vector<uint8_t>& value = m_Values[location];
+		if (value.size() == size && memcmp(value.data(), data, size) == 0)
+		{
+			stats.Elided++;
+			stats.ElidedUniforms++;
+			return false;
+		}
+
+		value.assign((const uint8_t*)data, (const uint8_t*)data + size);
+		stats.Calls++;
+		return true;
+	}
+
+	bool RenderStateCache::BindShader(uint32_t id)
+	{
+		return Set(s_State.Shader, id, s_Stats.ElidedShaderBinds);
+	}
+
+	bool RenderStateCache::BindVertexArray(uint32_t id)
+	{
+		return Set(s_State.VertexArray, id, s_Stats.ElidedVertexArrayBinds);
+	}
+
+	bool RenderStateCache::BindTexture(uint32_t slot, uint32_t id)
+	{
+		// Slots that aren't tracked always go through
+		if (slot >= s_TextureSlots)
+		{
+			s_Stats.Calls++;
+			return true;
+		}
+		return Set(s_State.Textures[slot], id, s_Stats.ElidedTextureBinds);
+	}
+
+	bool RenderStateCache::BindFrameBuffer(uint32_t id)
+	{
+		return Set(s_State.FrameBuffer, id, s_Stats.ElidedFrameBufferBinds);
+	}
+
+	bool RenderStateCache::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		return Set(s_State.Viewport, { x, y, width, height }, s_Stats.ElidedPipelineChanges);
+	}
+
+	bool RenderStateCache::SetCulling(bool enabled)
+	{
+		return Set(s_State.Culling, enabled, s_Stats.ElidedPipelineChanges);
+	}
+
+	bool RenderStateCache::SetCullFront(bool front)
+	{
+		return Set(s_State.CullFront, front, s_Stats.ElidedPipelineChanges);
+	}
+
+	bool RenderStateCache::SetDepthTest(bool enabled)
+	{
+		return Set(s_State.DepthTest, enabled, s_Stats.ElidedPipelineChanges);
+	}
+
+	bool RenderStateCache::SetDepthWrite(bool enabled)
+	{
+		return Set(s_State.DepthWrite, enabled, s_Stats.ElidedPipelineChanges);
+	}
+
+	bool RenderStateCache::SetBlending(bool enabled)
+	{
+		return Set(s_State.Blending, enabled, s_Stats.ElidedPipelineChanges);
+	}
+
+	bool RenderStateCache::SetLineWidth(float width)
+	{
+		return Set(s_State.LineWidth, width, s_Stats.ElidedPipelineChanges);
+	}
+
+	bool RenderStateCache::SetPointSize(float size)
+	{
+		return Set(s_State.PointSize, size, s_Stats.ElidedPipelineChanges);
+	}
+
+	void RenderStateCache::ForgetShader(uint32_t id)
+	{
+		if (s_State.Shader == id)
+			s_State.Shader.reset();
+	}
+
+	void RenderStateCache::ForgetVertexArray(uint32_t id)
+	{
+		if (s_State.VertexArray == id)
+			s_State.VertexArray.reset();
+	}
+
+	void RenderStateCache::ForgetTexture(uint32_t id)
+	{
+		for (uint32_t i = 0; i < s_TextureSlots; i++)
+			if (s_State.Textures[i] == id)
+				s_State.Textures[i].reset();
+	}
+
+	void RenderStateCache::ForgetTextureSlot(uint32_t slot)
+	{
+		if (slot < s_TextureSlots)
+			s_State.Textures[slot].reset();
+	}
+
+	void RenderStateCache::ForgetFrameBuffer(uint32_t id)
+	{
+		if (s_State.FrameBuffer == id)
+			s_State.FrameBuffer.reset();
+	}
+
+	void RenderStateCache::Invalidate()
+	{
+		s_State = State();
+	}
+
+	void RenderStateCache::EndFrame()
+	{
+		s_PrevStats = s_Stats;
+		s_Stats = RenderStateCacheStats();
+	}
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <Debut/Core/Core.h>
+
+#include <array>
+#include <optional>
+#include <vector>
+
+/*
+	Copy of the state of the backend, used to drop the calls that wouldn't change anything before they reach the
+	driver. Backends ask the cache before binding a resource or changing the pipeline state, and only send the call
+	if the state actually changes.
+
+	The cache must know about every change: code that talks to the driver directly has to forget the state it
+	touched, or invalidate the whole cache. Destroyed resources must be forgotten as well, since their IDs can be
+	reused by new resources.
+
+	USAGE:
+		if (RenderStateCache::BindShader(m_ProgramID))
+			glUseProgram(m_ProgramID);
+*/
+
+namespace Debut
+{
+	struct RenderStateCacheStats
+	{
+		// Last frame: calls that went through and calls that were dropped
+		uint32_t Calls = 0;
+		uint32_t Elided = 0;
+
+		uint32_t ElidedShaderBinds = 0;
+		uint32_t ElidedVertexArrayBinds = 0;
+		uint32_t ElidedTextureBinds = 0;
+		uint32_t ElidedFrameBufferBinds = 0;
+		// Viewport, culling, depth, blending and rasterization
+		uint32_t ElidedPipelineChanges = 0;
+		uint32_t ElidedUniforms = 0;
+	};
+
+	// Last values uploaded to the uniforms of a program, owned by the shader
+	class UniformCache
+	{
+	public:
+		// Returns true if the value must be uploaded. Uniforms that aren't in the program (negative locations) are
+		// always dropped
+		bool Set(int32_t location, const void* data, uint32_t size);
+
+	private:
+		std::vector<std::vector<uint8_t>> m_Values;
+	};
+
+	class RenderStateCache
+	{
+		friend class UniformCache;
+	public:
+		// All the functions return true if the call changes the state and must be sent to the driver
+		static bool BindShader(uint32_t id);
+		static bool BindVertexArray(uint32_t id);
+		static bool BindTexture(uint32_t slot, uint32_t id);
+		static bool BindFrameBuffer(uint32_t id);
+
+		static bool SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+		static bool SetCulling(bool enabled);
+		static bool SetCullFront(bool front);
+		static bool SetDepthTest(bool enabled);
+		static bool SetDepthWrite(bool enabled);
+		static bool SetBlending(bool enabled);
+		static bool SetLineWidth(float width);
+		static bool SetPointSize(float size);
+
+		static void ForgetShader(uint32_t id);
+		static void ForgetVertexArray(uint32_t id);
+		static void ForgetTexture(uint32_t id);
+		static void ForgetTextureSlot(uint32_t slot);
+		static void ForgetFrameBuffer(uint32_t id);
+		// The state is unknown, the next calls will all go through
+		static void Invalidate();
+
+		// Called once the frame is over
+		static void EndFrame();
+		static inline RenderStateCacheStats GetStats() { return s_PrevStats; }
+
+	private:
+		template <typename T>
+		static bool Set(std::optional<T>& current, const T& value, uint32_t& elided)
+		{
+			if (current.has_value() && *current == value)
+			{
+				s_Stats.Elided++;
+				elided++;
+				return false;
+			}
+
+			current = value;
+			s_Stats.Calls++;
+			return true;
+		}
+
+	private:
+		static const uint32_t s_TextureSlots = 32;
+
+		struct State
+		{
+			std::optional<uint32_t> Shader;
+			std::optional<uint32_t> VertexArray;
+			std::optional<uint32_t> FrameBuffer;
+			std::optional<uint32_t> Textures[s_TextureSlots];
+
+			std::optional<std::array<uint32_t, 4>> Viewport;
+			std::optional<bool> Culling;
+			std::optional<bool> CullFront;
+			std::optional<bool> DepthTest;
+			std::optional<bool> DepthWrite;
+			std::optional<bool> Blending;
+			std::optional<float> LineWidth;
+			std::optional<float> PointSize;
+		};
+
+		static State s_State;
+		static RenderStateCacheStats s_Stats;
+		static RenderStateCacheStats s_PrevStats;
+	};
+}
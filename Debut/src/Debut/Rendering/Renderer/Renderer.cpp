@@ -4,19 +4,36 @@
 #include "Renderer2D.h"
 #include "Renderer3D.h"
 #include "RendererDebug.h"
+#include "RenderStateCache.h"
+#include "RenderCommandBuffer.h"
+#include <Debut/Rendering/Structures/BufferArena.h>
+#include <Debut/Rendering/Structures/MeshPool.h>
+#include <Debut/Rendering/Resources/Mesh.h>
 
 namespace Debut
 {
 	RendererConfig Renderer::m_Config;
+	Ref<BufferArena> Renderer::s_DynamicGeometry;
+	Ref<MeshPool> Renderer::s_MeshPool;
 
 	void Renderer::Init()
 	{
 		RenderCommand::Init();
+		s_DynamicGeometry = BufferArena::Create(4 * 1024 * 1024);
+		// Grows when the meshes don't fit anymore
+		s_MeshPool = CreateRef<MeshPool>(Mesh::GetVertexFormat(), 64 * 1024, 192 * 1024);
 		RendererDebug::Init();
 		Renderer2D::Init();
 		Renderer3D::Init();
 	}
 
+	void Renderer::EndFrame()
+	{
+		s_DynamicGeometry->NextFrame();
+		RenderStateCache::EndFrame();
+		RenderQueue::EndFrame();
+	}
+
 	void Renderer::OnWindowResized(uint32_t width, uint32_t height)
 	{
 		RenderCommand::SetViewport(0, 0, width, height);
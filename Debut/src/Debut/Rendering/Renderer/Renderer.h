@@ -4,6 +4,9 @@
 
 namespace Debut
 {
+	class BufferArena;
+	class MeshPool;
+
 	struct RendererConfig
 	{
 		bool RenderSurfaces = true;
@@ -16,16 +19,30 @@ namespace Debut
 		};
 		RenderingMode RenderingMode = RenderingMode::Standard;
 
+		// Static shadow casters are rendered in a cached layer, only updated when they or the light change
+		bool CacheStaticShadows = true;
+		// The first cascade is updated every frame, the others every N frames, staggered between frames
+		uint32_t FarCascadeUpdateInterval = 2;
+		// Point lights are binned in view space clusters, fragments only evaluate the lights of their cluster
+		bool ClusteredLighting = true;
+		// Meshes hidden by the occluders aren't rendered. Big static meshes are used as occluders too if AutoOccluders is set
+		bool OcclusionCulling = true;
+		bool AutoOccluders = true;
+		// Sprites are sent as one compact record per quad and expanded by the vertex shader
+		bool InstancedSprites = true;
+
 		bool operator==(const RendererConfig& a) const
 		{
 			return a.RenderSurfaces == RenderSurfaces && a.RenderWireframe == RenderWireframe &&
-				a.RenderColliders == RenderColliders && a.RenderingMode == RenderingMode;
+				a.RenderColliders == RenderColliders && a.RenderingMode == RenderingMode &&
+				a.CacheStaticShadows == CacheStaticShadows && a.FarCascadeUpdateInterval == FarCascadeUpdateInterval &&
+				a.ClusteredLighting == ClusteredLighting && a.OcclusionCulling == OcclusionCulling &&
+				a.AutoOccluders == AutoOccluders && a.InstancedSprites == InstancedSprites;
 		}
 
 		bool operator!=(const RendererConfig& a) const
 		{
-			return !(a.RenderSurfaces == RenderSurfaces && a.RenderWireframe == RenderWireframe &&
-				a.RenderColliders == RenderColliders && a.RenderingMode == RenderingMode);
+			return !(*this == a);
 		}
 
 		RendererConfig() = default;
@@ -36,6 +53,8 @@ namespace Debut
 	{
 	public:
 		static void Init();
+		// Called once the frame has been presented
+		static void EndFrame();
 
 		static void OnWindowResized(uint32_t width, uint32_t height);
 
@@ -44,8 +63,15 @@ namespace Debut
 
 		inline static RendererConfig GetConfig() { return m_Config; }
 		inline static void SetConfig(const RendererConfig& config) { m_Config = config; }
+
+		// Geometry uploaded every frame by the dynamic vertex buffers
+		inline static Ref<BufferArena> GetDynamicGeometry() { return s_DynamicGeometry; }
+		// Shared buffers of the static meshes
+		inline static Ref<MeshPool> GetMeshPool() { return s_MeshPool; }
 	
 	private:
 		static RendererConfig m_Config;
+		static Ref<BufferArena> s_DynamicGeometry;
+		static Ref<MeshPool> s_MeshPool;
 	};
 }
\ No newline at end of file
@@ -14,16 +14,81 @@
 #include <Debut/Rendering/Renderer/Renderer2D.h>
 #include <Debut/Rendering/Renderer/RendererDebug.h>
 #include <Debut/Scene/Components.h>
+#include <Debut/Core/JobSystem.h>
 
 #include <glm/gtc/matrix_transform.hpp>
 
+#ifdef DBT_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
+
 namespace Debut
 {
 	Renderer2DStorage Renderer2D::s_Data;
 
+	static const glm::vec2 s_SpriteTexCoords[] = { glm::vec2(0, 0), glm::vec2(1, 0), glm::vec2(1, 1), glm::vec2(0, 1) };
+
+	// Writes the 4 vertices of a sprite. The quad has side 1 and is centered in the origin, so its corners are the
+	// translation plus or minus half of the first two columns of the transform
+	static void WriteSpriteVertices(QuadVertex* vertices, const glm::mat4& transform, const SpriteRendererComponent& src,
+		float textureIndex, int entityID)
+	{
+#ifdef DBT_SIMD_SSE
+		__m128 half = _mm_set1_ps(0.5f);
+		__m128 halfX = _mm_mul_ps(_mm_loadu_ps(&transform[0][0]), half);
+		__m128 halfY = _mm_mul_ps(_mm_loadu_ps(&transform[1][0]), half);
+		__m128 origin = _mm_loadu_ps(&transform[3][0]);
+
+		__m128 corners[4] = {
+			_mm_sub_ps(_mm_sub_ps(origin, halfX), halfY),
+			_mm_sub_ps(_mm_add_ps(origin, halfX), halfY),
+			_mm_add_ps(_mm_add_ps(origin, halfX), halfY),
+			_mm_add_ps(_mm_sub_ps(origin, halfX), halfY)
+		};
+#else
+		glm::vec3 halfX = glm::vec3(transform[0]) * 0.5f;
+		glm::vec3 halfY = glm::vec3(transform[1]) * 0.5f;
+		glm::vec3 origin = glm::vec3(transform[3]);
+
+		glm::vec3 corners[4] = { origin - halfX - halfY, origin + halfX - halfY, origin + halfX + halfY, origin - halfX + halfY };
+#endif
+
+		for (uint32_t i = 0; i < 4; i++)
+		{
+#ifdef DBT_SIMD_SSE
+			float corner[4];
+			_mm_storeu_ps(corner, corners[i]);
+			vertices[i].Position = { corner[0], corner[1], corner[2] };
+#else
+			vertices[i].Position = corners[i];
+#endif
+			vertices[i].TexCoord = s_SpriteTexCoords[i];
+			vertices[i].Color = src.Color;
+			vertices[i].TexIndex = textureIndex;
+			vertices[i].TilingFactor = src.TilingFactor;
+			vertices[i].EntityID = entityID;
+		}
+	}
+
+	// Sprites use the whole texture. The sides are the full columns, the shader offsets the center by half of them
+	static void WriteSpriteInstance(QuadInstance& instance, const glm::mat4& transform, const SpriteRendererComponent& src,
+		int textureIndex, int entityID)
+	{
+		instance.Origin = glm::vec3(transform[3]);
+		instance.AxisX = glm::vec3(transform[0]);
+		instance.AxisY = glm::vec3(transform[1]);
+		instance.TexCoordMin = 0x00000000;
+		instance.TexCoordMax = 0xFFFFFFFF;
+		instance.Color = src.Color;
+		instance.TilingFactor = src.TilingFactor;
+		instance.TexIndex = textureIndex;
+		instance.EntityID = entityID;
+	}
+
 	void Renderer2D::Init()
 	{
 		DBT_PROFILE_FUNCTION();
+		MemoryTagScope memoryTag(MemoryTag::Renderer2D);
 
 		// Initialize index buffer
 		int* quadIndices = new int[s_Data.MaxIndices];
@@ -44,7 +109,7 @@ namespace Debut
 		delete[] quadIndices;
 
 		// Initialize vertex buffer
-		s_Data.QuadVertexBuffer = VertexBuffer::Create((uint32_t)0, s_Data.MaxVertices * sizeof(QuadVertex));
+		s_Data.QuadVertexBuffer = VertexBuffer::Create((uint32_t)0);
 		s_Data.QuadVertexArray = VertexArray::Create();
 		BufferLayout squareLayout = {
 			{ShaderDataType::Float3, "a_Position", false},
@@ -61,6 +126,26 @@ namespace Debut
 		s_Data.QuadVertexArray->AddIndexBuffer(textIndBuffer);
 		s_Data.QuadVertexBufferBase = new QuadVertex[s_Data.MaxVertices];
 
+		// Instances are expanded with the indices of the first quad
+		s_Data.InstanceBuffer = VertexBuffer::Create((uint32_t)0);
+		s_Data.InstanceVertexArray = VertexArray::Create();
+		BufferLayout instanceLayout = {
+			{ShaderDataType::Float3, "a_Origin", false},
+			{ShaderDataType::Float3, "a_AxisX", false},
+			{ShaderDataType::Float3, "a_AxisY", false},
+			{ShaderDataType::Int2, "a_UVRect", false},
+			{ShaderDataType::Float4, "a_Color", false},
+			{ShaderDataType::Float, "a_TilingFactor", false},
+			{ShaderDataType::Int, "a_TexIndex", false},
+			{ShaderDataType::Int, "a_EntityID", false}
+		};
+		s_Data.InstanceBuffer->SetLayout(instanceLayout);
+		s_Data.InstanceVertexArray->AddVertexBuffer(s_Data.InstanceBuffer, true);
+		s_Data.InstanceVertexArray->AddIndexBuffer(textIndBuffer);
+		s_Data.InstanceBufferBase = new QuadInstance[s_Data.MaxQuads];
+
+		s_Data.CPUMemory.Resize(s_Data.MaxVertices * sizeof(QuadVertex) + s_Data.MaxQuads * sizeof(QuadInstance));
+
 		s_Data.WhiteTexture = Texture2D::Create(1, 1);
 		uint32_t data = 0xffffffff;
 		s_Data.WhiteTexture->SetData(&data, sizeof(data));
@@ -73,6 +158,9 @@ namespace Debut
 		s_Data.TextureShader = Shader::Create("assets/shaders/texture.glsl");
 		s_Data.TextureShader->Bind();
 		s_Data.TextureShader->SetIntArray("u_Textures", samplers, s_Data.MaxTextureSlots);
+		s_Data.InstancedTextureShader = Shader::Create("assets/shaders/texture-instanced.glsl");
+		s_Data.InstancedTextureShader->Bind();
+		s_Data.InstancedTextureShader->SetIntArray("u_Textures", samplers, s_Data.MaxTextureSlots);
 
 		s_Data.TextureSlots[0] = s_Data.WhiteTexture;
 
@@ -86,6 +174,8 @@ namespace Debut
 	{
 		DBT_PROFILE_FUNCTION();
 		delete[] s_Data.QuadVertexBufferBase;
+		delete[] s_Data.InstanceBufferBase;
+		s_Data.CPUMemory.Resize(0);
 	}
 
 	void Renderer2D::BeginScene(SceneCamera& camera, const glm::mat4& view)
@@ -102,12 +192,24 @@ namespace Debut
 		s_Data.TextureShader->SetFloat("u_TilingFactor", 1.0f);
 		s_Data.TextureShader->Unbind();
 
+		s_Data.InstancedTextureShader->Bind();
+		s_Data.InstancedTextureShader->SetMat4("u_ViewProjection", viewProj);
+		s_Data.InstancedTextureShader->Unbind();
+
+		// Assets can be reloaded between frames
+		s_Data.SpriteTextures.clear();
 		StartBatch();
 	}
 
 	void Renderer2D::EndScene()
 	{
 		DBT_PROFILE_FUNCTION();
+		SubmitBatch();
+		RenderCommand::EnableCulling();
+	}
+
+	void Renderer2D::SubmitBatch()
+	{
 		if (s_Data.QuadIndexCount)
 		{
 			uint64_t dataSize = (uint8_t*)s_Data.QuadVertexBufferPtr - (uint8_t*)s_Data.QuadVertexBufferBase;
@@ -119,16 +221,22 @@ namespace Debut
 			if (Renderer::GetConfig().RenderingMode != RendererConfig::RenderingMode::None)
 				s_Data.TextureShader->Unbind();
 		}
+		else if (s_Data.InstanceCount)
+		{
+			s_Data.InstanceBuffer->SetData(s_Data.InstanceBufferBase, (uint64_t)s_Data.InstanceCount * sizeof(QuadInstance));
 
-		RenderCommand::EnableCulling();
+			if (Renderer::GetConfig().RenderingMode != RendererConfig::RenderingMode::None)
+				s_Data.InstancedTextureShader->Bind();
+			Flush();
+			if (Renderer::GetConfig().RenderingMode != RendererConfig::RenderingMode::None)
+				s_Data.InstancedTextureShader->Unbind();
+		}
 	}
 
 	void Renderer2D::FlushAndReset()
 	{
-		EndScene();
-
-		s_Data.QuadIndexCount = 0;
-		s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
+		SubmitBatch();
+		StartBatch();
 	}
 
 	void Renderer2D::Flush()
@@ -138,7 +246,10 @@ namespace Debut
 			s_Data.TextureSlots[i]->Bind(i);
 
 		// Draw call
-		RenderCommand::DrawIndexed(s_Data.QuadVertexArray, s_Data.QuadIndexCount);
+		if (s_Data.QuadIndexCount)
+			RenderCommand::DrawIndexed(s_Data.QuadVertexArray, s_Data.QuadIndexCount);
+		else
+			RenderCommand::DrawIndexedInstanced(s_Data.InstanceVertexArray, 6, s_Data.InstanceCount);
 		s_Data.Stats.DrawCalls++;
 	}
 
@@ -146,8 +257,8 @@ namespace Debut
 	{
 		DBT_PROFILE_FUNCTION();
 
-		// If we have drawn too many quads, we start a new batch
-		if (s_Data.QuadIndexCount >= s_Data.MaxIndices)
+		// If we have drawn too many quads, or the batch holds instances, we start a new batch
+		if (s_Data.QuadIndexCount >= s_Data.MaxIndices || s_Data.InstanceCount > 0)
 			FlushAndReset();
 
 		// Use the white texture
@@ -174,25 +285,11 @@ namespace Debut
 	{
 		DBT_PROFILE_FUNCTION();
 
-		// If we have drawn too many quads, we start a new batch
-		if (s_Data.QuadIndexCount >= s_Data.MaxIndices)
+		// If we have drawn too many quads, or the batch holds instances, we start a new batch
+		if (s_Data.QuadIndexCount >= s_Data.MaxIndices || s_Data.InstanceCount > 0)
 			FlushAndReset();
 
-		float textureIndex = 0.0f;
-		for (uint32_t i = 0; i < s_Data.TextureSlotIndex; i++)
-		{
-			if (*s_Data.TextureSlots[i].get() == *texture.get())
-			{
-				textureIndex = (float)i;
-				break;
-			}
-		}
-		if (textureIndex == 0.0f)
-		{
-			textureIndex = (float)s_Data.TextureSlotIndex;
-			s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-			s_Data.TextureSlotIndex++;
-		}
+		float textureIndex = (float)GetTextureSlot(texture);
 
 		const glm::vec4 color = glm::vec4(1.0, 1.0, 1.0, 1.0);
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) *
@@ -220,48 +317,109 @@ namespace Debut
 	{
 		DBT_PROFILE_FUNCTION();
 
-		// If we have drawn too many quads, we start a new batch
-		if (s_Data.QuadIndexCount >= s_Data.MaxIndices)
+		// If we have drawn too many quads, or the batch holds instances, we start a new batch
+		if (s_Data.QuadIndexCount >= s_Data.MaxIndices || s_Data.InstanceCount > 0)
+			FlushAndReset();
+
+		uint32_t textureIndex;
+		if (!FindSpriteTextureSlot(src.Texture, textureIndex))
+		{
+			FlushAndReset();
+			s_Data.Stats.TextureFlushes++;
+			FindSpriteTextureSlot(src.Texture, textureIndex);
+		}
+
+		WriteSpriteVertices(s_Data.QuadVertexBufferPtr, transform, src, (float)textureIndex, entityID);
+		s_Data.QuadVertexBufferPtr += 4;
+		s_Data.QuadIndexCount += 6;
+		s_Data.Stats.QuadCount++;
+
+		if (Renderer::GetConfig().RenderWireframe)
+			DrawQuad(transform, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+	}
+
+	void Renderer2D::DrawSprites(const glm::mat4* transforms, const SpriteRendererComponent* renderers, const int32_t* entityIDs,
+		const uint32_t* order, uint32_t count)
+	{
+		DBT_PROFILE_FUNCTION();
+
+		// Batches can't mix vertices and instances
+		bool instanced = Renderer::GetConfig().InstancedSprites;
+		if (instanced ? s_Data.QuadIndexCount > 0 : s_Data.InstanceCount > 0)
 			FlushAndReset();
 
-		float textureIndex = 0.0f;
-		if (src.Texture)
+		uint32_t first = 0;
+		while (first < count)
 		{
-			Ref<Texture2D> texture = AssetManager::Request<Texture2D>(src.Texture);
-			for (uint32_t i = 0; i < s_Data.TextureSlotIndex; i++)
+			uint32_t batchQuads = instanced ? s_Data.InstanceCount : s_Data.QuadIndexCount / 6;
+			if (batchQuads >= s_Data.MaxQuads)
 			{
-				if (*s_Data.TextureSlots[i].get() == *(texture.get()))
+				FlushAndReset();
+				batchQuads = 0;
+			}
+
+			// Textures are assigned serially, the batch ends when the quads or the texture slots run out
+			uint32_t capacity = s_Data.MaxQuads - batchQuads;
+			uint32_t last = first;
+			s_Data.SpriteTextureIndices.resize(std::max((uint32_t)s_Data.SpriteTextureIndices.size(), capacity));
+			{
+				DBT_PROFILE_SCOPE("Renderer2D::AssignTextures");
+				for (; last < count && last - first < capacity; last++)
 				{
-					textureIndex = (float)i;
-					break;
+					uint32_t slot;
+					if (!FindSpriteTextureSlot(renderers[order != nullptr ? order[last] : last].Texture, slot))
+						break;
+					s_Data.SpriteTextureIndices[last - first] = (float)slot;
 				}
 			}
-			if (textureIndex == 0.0f)
+
+			// Not even a sprite fit, all the slots are used
+			if (last == first)
 			{
-				textureIndex = (float)s_Data.TextureSlotIndex;
-				s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-				s_Data.TextureSlotIndex++;
+				FlushAndReset();
+				s_Data.Stats.TextureFlushes++;
+				continue;
 			}
-		}
-
-		glm::vec2 texCoords[] = { glm::vec2(0, 0), glm::vec2(1, 0), glm::vec2(1, 1), glm::vec2(0, 1) };
 
-		for (int i = 0; i < 4; i++)
-		{
-			s_Data.QuadVertexBufferPtr->Position = glm::vec3(transform * s_Data.QuadVertexPositions[i]);
-			s_Data.QuadVertexBufferPtr->Color = src.Color;
-			s_Data.QuadVertexBufferPtr->TexCoord = texCoords[i];
-			s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-			s_Data.QuadVertexBufferPtr->TilingFactor = src.TilingFactor;
-			s_Data.QuadVertexBufferPtr->EntityID = entityID;
-			s_Data.QuadVertexBufferPtr++;
+			// Every worker writes its own range of the vertex or instance buffer
+			if (instanced)
+			{
+				QuadInstance* instances = s_Data.InstanceBufferBase + s_Data.InstanceCount;
+				JobSystem::ParallelFor(last - first, 1024, [&](uint32_t start, uint32_t end)
+					{
+						for (uint32_t i = start; i < end; i++)
+						{
+							uint32_t sprite = order != nullptr ? order[first + i] : first + i;
+							WriteSpriteInstance(instances[i], transforms[sprite], renderers[sprite], (int)s_Data.SpriteTextureIndices[i],
+								entityIDs[sprite]);
+						}
+					});
+
+				s_Data.InstanceCount += last - first;
+			}
+			else
+			{
+				QuadVertex* vertices = s_Data.QuadVertexBufferPtr;
+				JobSystem::ParallelFor(last - first, 1024, [&](uint32_t start, uint32_t end)
+					{
+						for (uint32_t i = start; i < end; i++)
+						{
+							uint32_t sprite = order != nullptr ? order[first + i] : first + i;
+							WriteSpriteVertices(vertices + i * 4, transforms[sprite], renderers[sprite], s_Data.SpriteTextureIndices[i],
+								entityIDs[sprite]);
+						}
+					});
+
+				s_Data.QuadVertexBufferPtr += (last - first) * 4;
+				s_Data.QuadIndexCount += (last - first) * 6;
+			}
+			s_Data.Stats.QuadCount += last - first;
+			first = last;
 		}
 
-		s_Data.QuadIndexCount += 6;
-		s_Data.Stats.QuadCount++;
-
 		if (Renderer::GetConfig().RenderWireframe)
-			DrawQuad(transform, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+			for (uint32_t i = 0; i < count; i++)
+				DrawQuad(transforms[order != nullptr ? order[i] : i], glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
 	}
 
 	void Renderer2D::ResetStats()
@@ -272,7 +430,66 @@ namespace Debut
 	void Renderer2D::StartBatch()
 	{
 		s_Data.TextureSlotIndex = 1;
+		s_Data.TextureSlotMap.clear();
+		s_Data.LastSpriteTexture = 0;
 		s_Data.QuadIndexCount = 0;
 		s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
+		s_Data.InstanceCount = 0;
+	}
+
+	uint32_t Renderer2D::GetTextureSlot(const Ref<Texture>& texture)
+	{
+		uint32_t slot;
+		if (!FindTextureSlot(texture, slot))
+		{
+			FlushAndReset();
+			s_Data.Stats.TextureFlushes++;
+			FindTextureSlot(texture, slot);
+		}
+
+		return slot;
+	}
+
+	bool Renderer2D::FindTextureSlot(const Ref<Texture>& texture, uint32_t& slot)
+	{
+		auto found = s_Data.TextureSlotMap.find(texture.get());
+		if (found != s_Data.TextureSlotMap.end())
+		{
+			slot = found->second;
+			return true;
+		}
+
+		if (s_Data.TextureSlotIndex == s_Data.MaxTextureSlots)
+			return false;
+
+		slot = s_Data.TextureSlotIndex++;
+		s_Data.TextureSlots[slot] = texture;
+		s_Data.TextureSlotMap[texture.get()] = slot;
+		return true;
+	}
+
+	bool Renderer2D::FindSpriteTextureSlot(UUID texture, uint32_t& slot)
+	{
+		slot = 0;
+		if (texture == 0)
+			return true;
+
+		if (texture != s_Data.LastSpriteTexture)
+		{
+			auto cached = s_Data.SpriteTextures.find(texture);
+			if (cached == s_Data.SpriteTextures.end())
+				cached = s_Data.SpriteTextures.emplace(texture, AssetManager::Request<Texture2D>(texture)).first;
+
+			// Missing textures use the white one
+			uint32_t textureSlot = 0;
+			if (cached->second != nullptr && !FindTextureSlot(cached->second, textureSlot))
+				return false;
+
+			s_Data.LastSpriteTexture = texture;
+			s_Data.LastSpriteTextureSlot = textureSlot;
+		}
+
+		slot = s_Data.LastSpriteTextureSlot;
+		return true;
 	}
-}
\ No newline at end of file
+}
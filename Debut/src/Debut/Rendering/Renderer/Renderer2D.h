@@ -1,7 +1,11 @@
 #pragma once
 
+#include <Debut/Core/MemoryTracker.h>
+#include <Debut/Core/UUID.h>
 #include <glm/glm.hpp>
 #include <array>
+#include <unordered_map>
+#include <vector>
 
 namespace Debut
 {
@@ -11,6 +15,7 @@ namespace Debut
 
 	class Shader;
 	class Texture;
+	class Texture2D;
 	class SubTexture2D;
 	class SceneCamera;
 
@@ -28,10 +33,31 @@ namespace Debut
 		int EntityID = -1;
 	};
 
+	// Instanced quad, less than half the size of its 4 vertices. The vertex shader builds the corners
+	struct QuadInstance
+	{
+		// Center of the quad and its sides, the first two columns of the transform
+		glm::vec3 Origin;
+		glm::vec3 AxisX;
+		glm::vec3 AxisY;
+		// Min and max texture coordinates, 16 bit normalized, u in the low half
+		uint32_t TexCoordMin;
+		uint32_t TexCoordMax;
+		// Full range, HDR tints can go over 1
+		glm::vec4 Color;
+		float TilingFactor;
+		int TexIndex;
+
+		// Editor only
+		int EntityID = -1;
+	};
+
 	struct Render2DStats
 	{
 		uint32_t DrawCalls;
 		uint32_t QuadCount;
+		// Batches that were flushed because all the texture slots were used
+		uint32_t TextureFlushes;
 
 		uint32_t GetTotalVertexCount() { return QuadCount * 4; }
 		uint32_t GetIndexCount() { return QuadCount * 6; }
@@ -47,17 +73,34 @@ namespace Debut
 		Ref<VertexArray> QuadVertexArray;
 		Ref<VertexBuffer> QuadVertexBuffer;
 		Ref<Shader> TextureShader;
+		// A batch holds either vertices or instances
+		Ref<VertexArray> InstanceVertexArray;
+		Ref<VertexBuffer> InstanceBuffer;
+		Ref<Shader> InstancedTextureShader;
 		Ref<Texture> WhiteTexture;
 
 		uint32_t QuadIndexCount = 0;
 		QuadVertex* QuadVertexBufferBase = nullptr;
 		QuadVertex* QuadVertexBufferPtr = nullptr;
+		uint32_t InstanceCount = 0;
+		QuadInstance* InstanceBufferBase = nullptr;
 
 		std::array<Ref<Texture>, MaxTextureSlots> TextureSlots;
 		uint32_t TextureSlotIndex = 1; // 0 = white texture
+		// Slot of each texture in the current batch
+		std::unordered_map<const Texture*, uint32_t> TextureSlotMap;
+		// Sprite textures resolved in the current frame, so that the asset manager is only asked once per texture
+		std::unordered_map<UUID, Ref<Texture2D>> SpriteTextures;
+		// Consecutive sprites often share the texture, the last one skips the lookups
+		UUID LastSpriteTexture = 0;
+		uint32_t LastSpriteTextureSlot = 0;
+		// Texture slots of the sprites of the batch being built by DrawSprites
+		std::vector<float> SpriteTextureIndices;
 
 		glm::vec4 QuadVertexPositions[4];
 		Render2DStats Stats;
+
+		TrackedMemory CPUMemory = { MemoryTag::Renderer2D, MemoryType::CPU };
 	};
 
 	class Renderer2D
@@ -73,6 +116,10 @@ namespace Debut
 		static void DrawQuad(const glm::mat4& transform, const glm::vec4 color);
 		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, float rotationAngle, const Ref<Texture>& texture, float tilingFactor = 1);
 		static void DrawSprite(const glm::mat4& transform, const SpriteRendererComponent& src, int entityID);
+		// Draws packed sprites, in the specified order if there's one. The vertices, or the instances if
+		// RendererConfig::InstancedSprites is set, are built on the workers
+		static void DrawSprites(const glm::mat4* transforms, const SpriteRendererComponent* renderers, const int32_t* entityIDs,
+			const uint32_t* order, uint32_t count);
 
 		static void ResetStats();
 		static Render2DStats GetStats() { return s_Data.Stats; }
@@ -81,6 +128,14 @@ namespace Debut
 		static void Flush();
 		static void FlushAndReset();
 		static void StartBatch();
+		// Uploads the vertices or the instances of the batch and draws them
+		static void SubmitBatch();
+		// Slot of the texture in the current batch, the batch is flushed if there are no free slots
+		static uint32_t GetTextureSlot(const Ref<Texture>& texture);
+		// Same as GetTextureSlot, but returns false instead of flushing
+		static bool FindTextureSlot(const Ref<Texture>& texture, uint32_t& slot);
+		// Slot of the texture of a sprite, 0 if it doesn't have one. Returns false if there are no free slots
+		static bool FindSpriteTextureSlot(UUID texture, uint32_t& slot);
 
 	private:
 		static Renderer2DStorage s_Data;
@@ -9,6 +9,7 @@
 #include <Debut/Rendering/Structures/VertexArray.h>
 #include <Debut/Rendering/Structures/Buffer.h>
 #include <Debut/Rendering/Structures/ShadowMap.h>
+#include <Debut/Rendering/Structures/TextureBuffer.h>
 #include <Debut/Rendering/Resources/Mesh.h>
 #include <Debut/Scene/Components.h>
 
@@ -17,6 +18,7 @@
 #include <Debut/Rendering/Renderer/Renderer3D.h>
 #include <Debut/Rendering/Renderer/RendererDebug.h>
 #include <Debut/Core/Instrumentor.h>
+#include <Debut/Core/MemoryTracker.h>
 #include <Debut/Rendering/Renderer/RenderCommand.h>
 
 
@@ -26,9 +28,13 @@ namespace Debut
 	Renderer3DStats Renderer3D::s_Stats;
 	Renderer3DStats Renderer3D::s_PrevStats;
 
+	// Point lights don't have a hard cutoff: past this many radii their contribution is below 1/500
+	static const float s_LightRangeScale = 4.0f;
+
 	void Renderer3D::Init()
 	{
 		DBT_PROFILE_FUNCTION();
+		MemoryTagScope memoryTag(MemoryTag::Renderer3D);
 
 		// Reserve space for the textures
 		s_Data.Textures.resize(s_Data.MaxTextures);
@@ -45,9 +51,9 @@ namespace Debut
 			std::string attribNames[] = { "a_Position", "a_Color", "a_Normal", "a_Tangent", "a_Bitangent", "a_TexCoords0"};
 			std::string names[] = { "Positions", "Colors", "Normals", "Tangents", "Bitangents", "TexCoords0"};
 
-			for (uint32_t i = 0; i < sizeof(types); i++)
+			for (uint32_t i = 0; i < sizeof(types) / sizeof(types[0]); i++)
 			{
-				s_Data.VertexBuffers[names[i]] = VertexBuffer::Create(s_Data.StartupBufferSize * sizeof(float), s_Data.MaxVerticesPerBatch * sizeof(float));
+				s_Data.VertexBuffers[names[i]] = VertexBuffer::Create(s_Data.StartupBufferSize * sizeof(float));
 				s_Data.VertexBuffers[names[i]]->SetLayout({ {types[i], attribNames[i], false} });
 				s_Data.VertexArray->AddVertexBuffer(s_Data.VertexBuffers[names[i]]);
 			}
@@ -71,11 +77,15 @@ namespace Debut
 				s_Data.DepthmapMaterial->SetShader(AssetManager::Request<Shader>("assets\\shaders\\depth.glsl"));
 			}
 		}
+
+		s_Data.ClusterLights = TextureBuffer::Create(TextureBufferFormat::RGBA32F);
+		s_Data.ClusterRanges = TextureBuffer::Create(TextureBufferFormat::RG32UI);
+		s_Data.ClusterLightIndices = TextureBuffer::Create(TextureBufferFormat::R32UI);
 	}
 
 	void Renderer3D::BeginScene(SceneCamera& camera, Ref<Skybox> skybox, const glm::mat4& cameraView,
-		std::vector<LightComponent*>& lights, std::vector<ShaderUniform>& globalUniforms, 
-		std::vector<Ref<ShadowMap>> shadowMaps)
+		const FrameVector<LightComponent*>& lights, const std::vector<ShaderUniform>& globalUniforms,
+		const std::vector<Ref<ShadowMap>>& shadowMaps)
 	{
 		// Reset storage
 		s_Data.CameraView = camera.GetView();
@@ -84,10 +94,15 @@ namespace Debut
 		s_Data.CameraFar = camera.GetFarPlane();
 		s_Data.CameraFrustum = Frustum(camera);
 		
-		s_Data.Lights = lights;
+		// Assigning keeps the memory of the previous frame
+		s_Data.Lights.assign(lights.begin(), lights.end());
 		s_Data.GlobalUniforms = globalUniforms;
 		s_Data.ShadowMaps = shadowMaps;		
 
+		s_Data.ClusteredLighting = Renderer::GetConfig().ClusteredLighting;
+		if (s_Data.ClusteredLighting)
+			BuildLightClusters();
+
 		RenderCommand::DisableCulling();
 
 		// Draw the skybox
@@ -120,40 +135,6 @@ namespace Debut
 		RenderCommand::CullBack();
 	}
 
-	void Renderer3D::DrawModel(const MeshRendererComponent& meshComponent, const glm::mat4& transform, int entityID)
-	{
-		DBT_PROFILE_FUNCTION();
-
-		if (!s_Data.CameraFrustum.TestAABB(meshComponent.GetAABB(), transform))
-			return;
-
-		Ref<Mesh> mesh;
-		Ref<Material> material;
-
-		{
-			DBT_PROFILE_SCOPE("Renderer3D::GetMesh");
-			mesh = AssetManager::Request<Mesh>(meshComponent.Mesh);
-		}
-
-		{
-			DBT_PROFILE_SCOPE("Renderer3D::GetMaterial");
-			material = AssetManager::Request<Material>(meshComponent.Material);
-		}
-
-		if (mesh == nullptr)
-		{
-			Log.CoreError("Couldn't find mesh to render. Did you reimport and overwrite the model?");
-			return;
-		}
-		if (material == nullptr)
-		{
-			Log.CoreError("Couldn't find material to render with. Did you reimport and overwrite the model?");
-			return;
-		}
-
-		DrawModel(*mesh.get(), *material.get(), transform, entityID, meshComponent.Instanced);
-	}
-
 	void Renderer3D::DrawModel(Mesh& mesh, Material& material, const glm::mat4& transform, int entityID, bool instanced /* = false*/)
 	{
 		DBT_PROFILE_FUNCTION();
@@ -195,9 +176,6 @@ namespace Debut
 					materialToUse = material;
 					break;
 				}
-
-				SendLights(materialToUse);
-				SendGlobals(materialToUse);
 			}
 			else
 			{
@@ -221,22 +199,21 @@ namespace Debut
 					materialToUse.GetRuntimeShader()->SetInt("u_EntityID", entityID);
 				}
 
-				if (s_Data.CurrentPass != RenderingPass::Shadow)
+				if (s_Data.CurrentPass != RenderingPass::Shadow && materialToUse.GetRuntimeShader() != nullptr)
 				{
+					SendLights(materialToUse);
+					SendGlobals(materialToUse);
+
 					// Set shadowmaps
 					for (uint32_t i = 0; i < s_Data.ShadowMaps.size(); i++)
 					{
-						std::stringstream ss;
-						ss << "u_ShadowMaps[" << i << "]";
-
-						if (materialToUse.GetRuntimeShader() != nullptr)
-						{
-							materialToUse.GetRuntimeShader()->SetMat4(ss.str() + ".LightMatrix", s_Data.ShadowMaps[i]->GetMatrix());
-							materialToUse.GetRuntimeShader()->SetInt(ss.str() + ".Sampler", materialToUse.GetCurrentTextureSlot() + i);
-							materialToUse.GetRuntimeShader()->SetFloat(ss.str() + ".Near", s_Data.ShadowMaps[i]->GetNear());
-							materialToUse.GetRuntimeShader()->SetFloat(ss.str() + ".Far", s_Data.ShadowMaps[i]->GetFar());
-							s_Data.ShadowMaps[i]->BindAsTexture(materialToUse.GetCurrentTextureSlot() + i);
-						}
+						const ShadowMapUniformNames& names = GetShadowMapNames(i);
+
+						materialToUse.GetRuntimeShader()->SetMat4(names.LightMatrix, s_Data.ShadowMaps[i]->GetMatrix());
+						materialToUse.GetRuntimeShader()->SetInt(names.Sampler, materialToUse.GetCurrentTextureSlot() + i);
+						materialToUse.GetRuntimeShader()->SetFloat(names.Near, s_Data.ShadowMaps[i]->GetNear());
+						materialToUse.GetRuntimeShader()->SetFloat(names.Far, s_Data.ShadowMaps[i]->GetFar());
+						s_Data.ShadowMaps[i]->BindAsTexture(materialToUse.GetCurrentTextureSlot() + i);
 					}
 				}
 			}
@@ -244,7 +221,7 @@ namespace Debut
 
 		{
 			DBT_PROFILE_SCOPE("DrawModel::DrawIndexed");
-			RenderCommand::DrawIndexed(vertexArray, mesh.GetNumIndices());
+			RenderCommand::DrawIndexedBaseVertex(vertexArray, mesh.GetNumIndices(), mesh.GetFirstIndex(), mesh.GetBaseVertex());
 			materialToUse.Unuse();
 			if (s_Data.CurrentPass != RenderingPass::Shadow)
 				s_Data.ShadowMaps[0]->UnbindTexture(8);
@@ -309,9 +286,42 @@ namespace Debut
 
 	void Renderer3D::SendLights(Material& material)
 	{
-		std::vector<PointLightComponent> pointLights;
-		ShaderUniform::UniformData data;
+		static const std::string directionalDir = "u_DirectionalLightDir";
+		static const std::string directionalColor = "u_DirectionalLightCol";
+		static const std::string directionalIntensity = "u_DirectionalLightIntensity";
+		static const std::string nPointLights = "u_NPointLights";
+
+		Ref<Shader> shader = material.GetRuntimeShader();
+		if (shader == nullptr)
+			return;
+
+		static const std::string clusteredLighting = "u_ClusteredLighting";
+		static const std::string projection = "u_ProjectionMatrix";
+		static const std::string clusterDepthScale = "u_ClusterDepthScale";
+		static const std::string clusterDepthBias = "u_ClusterDepthBias";
+		static const std::string clusterLights = "u_ClusterLights";
+		static const std::string clusterRanges = "u_ClusterRanges";
+		static const std::string clusterLightIndices = "u_ClusterLightIndices";
 
+		shader->SetInt(clusteredLighting, s_Data.ClusteredLighting);
+		if (s_Data.ClusteredLighting)
+		{
+			// After the textures of the material and the shadow maps
+			uint32_t slot = material.GetCurrentTextureSlot() + (uint32_t)s_Data.ShadowMaps.size();
+
+			shader->SetMat4(projection, s_Data.CameraProjection);
+			shader->SetFloat(clusterDepthScale, s_Data.Clusters.GetDepthScale());
+			shader->SetFloat(clusterDepthBias, s_Data.Clusters.GetDepthBias());
+
+			shader->SetInt(clusterLights, slot);
+			s_Data.ClusterLights->Bind(slot);
+			shader->SetInt(clusterRanges, slot + 1);
+			s_Data.ClusterRanges->Bind(slot + 1);
+			shader->SetInt(clusterLightIndices, slot + 2);
+			s_Data.ClusterLightIndices->Bind(slot + 2);
+		}
+
+		uint32_t pointLightCount = 0;
 		for (LightComponent* light : s_Data.Lights)
 		{
 			switch (light->Type)
@@ -320,58 +330,124 @@ namespace Debut
 			{
 				DirectionalLightComponent* dirLight = static_cast<DirectionalLightComponent*>(light);
 
-				data = dirLight->Direction;
-				material.m_Uniforms["u_DirectionalLightDir"] = {
-					ShaderUniform("u_DirectionalLightDir", ShaderDataType::Float3, data) };
-
-				data = dirLight->Color;
-				material.m_Uniforms["u_DirectionalLightCol"] = {
-					ShaderUniform("u_DirectionalLightCol", ShaderDataType::Float3, data) };
-
-				data = dirLight->Intensity;
-				material.m_Uniforms["u_DirectionalLightIntensity"] = {
-					ShaderUniform("u_DirectionalLightIntensity", ShaderDataType::Float, data) };
+				shader->SetFloat3(directionalDir, dirLight->Direction);
+				shader->SetFloat3(directionalColor, dirLight->Color);
+				shader->SetFloat(directionalIntensity, dirLight->Intensity);
 				break;
 			}
 			case LightComponent::LightType::Point:
 			{
+				// Clustered point lights are read from the buffers
+				if (s_Data.ClusteredLighting)
+					break;
+
 				PointLightComponent* pointLight = static_cast<PointLightComponent*>(light);
-				pointLights.push_back(*pointLight);
+				const PointLightUniformNames& names = GetPointLightNames(pointLightCount++);
+
+				shader->SetFloat3(names.Color, pointLight->Color);
+				shader->SetFloat3(names.Position, pointLight->Position);
+				shader->SetFloat(names.Intensity, pointLight->Intensity);
+				shader->SetFloat(names.Radius, pointLight->Radius);
 				break;
 			}
 			}
 		}
 
-		// Send point lights
-		for (uint32_t i = 0; i < pointLights.size(); i++)
+		shader->SetInt(nPointLights, (int)pointLightCount);
+	}
+
+	void Renderer3D::BuildLightClusters()
+	{
+		DBT_PROFILE_FUNCTION();
+		s_Data.ClusterSpheres.clear();
+		s_Data.ClusterLightData.clear();
+
+		for (LightComponent* light : s_Data.Lights)
 		{
-			std::stringstream lightName;
-			lightName << "u_PointLights[" << i << "]";
-
-			data = pointLights[i].Color;
-			material.m_Uniforms[lightName.str() + ".Color"] = { ShaderUniform(lightName.str() + ".Color", ShaderDataType::Float3, data) };
-			data = pointLights[i].Position;
-			material.m_Uniforms[lightName.str() + ".Position"] = { ShaderUniform(lightName.str() + ".Position", ShaderDataType::Float3, data) };
-
-			data = pointLights[i].Intensity;
-			material.m_Uniforms[lightName.str() + ".Intensity"] = { ShaderUniform(lightName.str() + ".Intensity", ShaderDataType::Float, data) };
-			data = pointLights[i].Radius;
-			material.m_Uniforms[lightName.str() + ".Radius"] = { ShaderUniform(lightName.str() + ".Radius", ShaderDataType::Float, data) };
+			if (light->Type != LightComponent::LightType::Point)
+				continue;
+
+			PointLightComponent* pointLight = static_cast<PointLightComponent*>(light);
+			s_Data.ClusterSpheres.push_back(glm::vec4(pointLight->Position, pointLight->Radius * s_LightRangeScale));
+			s_Data.ClusterLightData.push_back(glm::vec4(pointLight->Position, pointLight->Radius));
+			s_Data.ClusterLightData.push_back(glm::vec4(pointLight->Color, pointLight->Intensity));
 		}
 
-		data = (int)pointLights.size();
-		material.m_Uniforms["u_NPointLights"] = { ShaderUniform("u_NPointLights", ShaderDataType::Int, data) };
+		s_Data.Clusters.Build(s_Data.CameraView, s_Data.CameraProjection, s_Data.CameraNear, s_Data.CameraFar,
+			s_Data.ClusterSpheres.data(), (uint32_t)s_Data.ClusterSpheres.size());
+
+		const std::vector<glm::uvec2>& ranges = s_Data.Clusters.GetRanges();
+		const std::vector<uint32_t>& indices = s_Data.Clusters.GetLightIndices();
+		s_Data.ClusterLights->SetData(s_Data.ClusterLightData.data(), (uint32_t)(s_Data.ClusterLightData.size() * sizeof(glm::vec4)));
+		s_Data.ClusterRanges->SetData(ranges.data(), (uint32_t)(ranges.size() * sizeof(glm::uvec2)));
+		s_Data.ClusterLightIndices->SetData(indices.data(), (uint32_t)(indices.size() * sizeof(uint32_t)));
+
+		s_Stats.ClusteredLights = (uint32_t)s_Data.ClusterSpheres.size();
+		s_Stats.ClusterLightIndices = (uint32_t)indices.size();
+		s_Stats.MaxClusterLights = s_Data.Clusters.GetMaxClusterLights();
 	}
 
 	void Renderer3D::SendGlobals(Material& material)
 	{
+		Ref<Shader> shader = material.GetRuntimeShader();
+		if (shader == nullptr)
+			return;
+
 		for (auto& uniform : s_Data.GlobalUniforms)
-			material.m_Uniforms[uniform.Name] = uniform;
+		{
+			switch (uniform.Type)
+			{
+			case ShaderDataType::Int:
+				shader->SetInt(uniform.Name, std::get<int>(uniform.Data));
+				break;
+			case ShaderDataType::Float:
+				shader->SetFloat(uniform.Name, std::get<float>(uniform.Data));
+				break;
+			case ShaderDataType::Float2:
+				shader->SetFloat2(uniform.Name, std::get<glm::vec2>(uniform.Data));
+				break;
+			case ShaderDataType::Float3:
+				shader->SetFloat3(uniform.Name, std::get<glm::vec3>(uniform.Data));
+				break;
+			case ShaderDataType::Float4:
+				shader->SetFloat4(uniform.Name, std::get<glm::vec4>(uniform.Data));
+				break;
+			case ShaderDataType::Mat4:
+				shader->SetMat4(uniform.Name, std::get<glm::mat4>(uniform.Data));
+				break;
+			default:
+				Log.CoreWarn("Global uniform {0} has an unsupported type", uniform.Name);
+				break;
+			}
+		}
+	}
+
+	const PointLightUniformNames& Renderer3D::GetPointLightNames(uint32_t index)
+	{
+		while (s_Data.PointLightNames.size() <= index)
+		{
+			std::string name = "u_PointLights[" + std::to_string(s_Data.PointLightNames.size()) + "]";
+			s_Data.PointLightNames.push_back({ name + ".Color", name + ".Position", name + ".Intensity", name + ".Radius" });
+		}
+
+		return s_Data.PointLightNames[index];
+	}
+
+	const ShadowMapUniformNames& Renderer3D::GetShadowMapNames(uint32_t index)
+	{
+		while (s_Data.ShadowMapNames.size() <= index)
+		{
+			std::string name = "u_ShadowMaps[" + std::to_string(s_Data.ShadowMapNames.size()) + "]";
+			s_Data.ShadowMapNames.push_back({ name + ".LightMatrix", name + ".Sampler", name + ".Near", name + ".Far" });
+		}
+
+		return s_Data.ShadowMapNames[index];
 	}
 
 	void Renderer3D::AddBatch(const UUID& id)
 	{
 		DBT_PROFILE_FUNCTION();
+		MemoryTagScope memoryTag(MemoryTag::Renderer3D);
 
 		if (s_Data.Batches.size() == s_Data.MaxBatches)
 		{
@@ -390,27 +466,27 @@ namespace Debut
 		newBatch->VertexArray->AddIndexBuffer(newBatch->IndexBuffer);
 
 		// Setup buffers
-		newBatch->Buffers["Position"] = VertexBuffer::Create(s_Data.StartupBufferSize * sizeof(float), s_Data.MaxVerticesPerBatch * sizeof(float));
+		newBatch->Buffers["Position"] = VertexBuffer::Create(s_Data.StartupBufferSize * sizeof(float));
 		newBatch->Buffers["Position"]->SetLayout({ { ShaderDataType::Float3, "a_Position", false } });
 		newBatch->VertexArray->AddVertexBuffer(newBatch->Buffers["Position"]);
 
-		newBatch->Buffers["Colors"] = VertexBuffer::Create(s_Data.StartupBufferSize * sizeof(float), s_Data.MaxVerticesPerBatch * sizeof(float));
+		newBatch->Buffers["Colors"] = VertexBuffer::Create(s_Data.StartupBufferSize * sizeof(float));
 		newBatch->Buffers["Colors"]->SetLayout({ { ShaderDataType::Float4, "a_Color", false } });
 		newBatch->VertexArray->AddVertexBuffer(newBatch->Buffers["Colors"]);
 
-		newBatch->Buffers["Normals"] = VertexBuffer::Create(s_Data.StartupBufferSize * sizeof(float), s_Data.MaxVerticesPerBatch * sizeof(float));
+		newBatch->Buffers["Normals"] = VertexBuffer::Create(s_Data.StartupBufferSize * sizeof(float));
 		newBatch->Buffers["Normals"]->SetLayout({ { ShaderDataType::Float3, "a_Normal", false } });
 		newBatch->VertexArray->AddVertexBuffer(newBatch->Buffers["Normals"]);
 
-		newBatch->Buffers["Tangents"] = VertexBuffer::Create(s_Data.StartupBufferSize * sizeof(float), s_Data.MaxVerticesPerBatch * sizeof(float));
+		newBatch->Buffers["Tangents"] = VertexBuffer::Create(s_Data.StartupBufferSize * sizeof(float));
 		newBatch->Buffers["Tangents"]->SetLayout({ { ShaderDataType::Float3, "a_Tangent", false } });
 		newBatch->VertexArray->AddVertexBuffer(newBatch->Buffers["Tangents"]);
 
-		newBatch->Buffers["Bitangents"] = VertexBuffer::Create(s_Data.StartupBufferSize * sizeof(float), s_Data.MaxVerticesPerBatch * sizeof(float));
+		newBatch->Buffers["Bitangents"] = VertexBuffer::Create(s_Data.StartupBufferSize * sizeof(float));
 		newBatch->Buffers["Bitangents"]->SetLayout({ { ShaderDataType::Float3, "a_Bitangent", false } });
 		newBatch->VertexArray->AddVertexBuffer(newBatch->Buffers["Bitangents"]);
 
-		newBatch->Buffers["TexCoords0"] = VertexBuffer::Create(s_Data.StartupBufferSize * sizeof(float), s_Data.MaxVerticesPerBatch * sizeof(float));
+		newBatch->Buffers["TexCoords0"] = VertexBuffer::Create(s_Data.StartupBufferSize * sizeof(float));
 		newBatch->Buffers["TexCoords0"]->SetLayout({ { ShaderDataType::Float2, "a_TexCoords0", false } });
 		newBatch->VertexArray->AddVertexBuffer(newBatch->Buffers["TexCoords0"]);
 		
@@ -427,5 +503,26 @@ namespace Debut
 		s_Stats.Triangles = 0;
 		s_Stats.ShadowDrawCalls = 0;
 		s_Stats.ShadowTriangles = 0;
+		s_Stats.SkippedShadowMaps = 0;
+		s_Stats.StaticShadowUpdates = 0;
+		s_Stats.ClusteredLights = 0;
+		s_Stats.ClusterLightIndices = 0;
+		s_Stats.MaxClusterLights = 0;
+		s_Stats.Occluders = 0;
+		s_Stats.OccluderTriangles = 0;
+		s_Stats.OccludedMeshes = 0;
+	}
+
+	void Renderer3D::AddShadowCacheStats(uint32_t skippedMaps, uint32_t staticUpdates)
+	{
+		s_Stats.SkippedShadowMaps += skippedMaps;
+		s_Stats.StaticShadowUpdates += staticUpdates;
+	}
+
+	void Renderer3D::AddOcclusionStats(uint32_t occluders, uint32_t triangles, uint32_t occludedMeshes)
+	{
+		s_Stats.Occluders += occluders;
+		s_Stats.OccluderTriangles += triangles;
+		s_Stats.OccludedMeshes += occludedMeshes;
 	}
 }
\ No newline at end of file
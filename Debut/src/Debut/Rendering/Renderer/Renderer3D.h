@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Debut/Rendering/Structures/Frustum.h>
+#include <Debut/Rendering/Structures/LightClusters.h>
+#include <Debut/Core/FrameAllocator.h>
 
 namespace Debut
 {
@@ -8,6 +10,7 @@ namespace Debut
 	class VertexBuffer;
 	class IndexBuffer;
 	class ShadowMap;
+	class TextureBuffer;
 
 	class Material;
 	class Skybox;
@@ -15,7 +18,6 @@ namespace Debut
 	class SceneCamera;
 	class Mesh;
 
-	struct MeshRendererComponent;
 	struct LightComponent;
 	struct ShaderUniform;
 
@@ -31,6 +33,23 @@ namespace Debut
 		Ref<Material> Material;
 	};
 
+	// Names of the array uniforms, built once: creating them for every draw call would allocate
+	struct PointLightUniformNames
+	{
+		std::string Color;
+		std::string Position;
+		std::string Intensity;
+		std::string Radius;
+	};
+
+	struct ShadowMapUniformNames
+	{
+		std::string LightMatrix;
+		std::string Sampler;
+		std::string Near;
+		std::string Far;
+	};
+
 	struct Renderer3DStats
 	{
 		uint32_t NShadowPasses = 0;
@@ -38,6 +57,17 @@ namespace Debut
 		uint32_t Triangles = 0;
 		uint32_t ShadowTriangles = 0;
 		uint32_t ShadowDrawCalls = 0;
+		// Shadow maps that kept the content of a previous frame
+		uint32_t SkippedShadowMaps = 0;
+		uint32_t StaticShadowUpdates = 0;
+		// Clustered lighting
+		uint32_t ClusteredLights = 0;
+		uint32_t ClusterLightIndices = 0;
+		uint32_t MaxClusterLights = 0;
+		// Occlusion culling
+		uint32_t Occluders = 0;
+		uint32_t OccluderTriangles = 0;
+		uint32_t OccludedMeshes = 0;
 	};
 
 	struct Renderer3DStorage
@@ -46,7 +76,6 @@ namespace Debut
 		uint32_t MaxTextures = 32;
 		uint32_t MaxBatches = 64;
 		uint32_t MaxMeshesPerBatch = 16384;
-		uint32_t MaxVerticesPerBatch = 36000000;
 
 		Ref<VertexArray> VertexArray;
 		Ref<IndexBuffer> IndexBuffer;
@@ -66,6 +95,18 @@ namespace Debut
 
 		std::vector<LightComponent*> Lights;
 		std::vector<ShaderUniform> GlobalUniforms;
+		std::vector<PointLightUniformNames> PointLightNames;
+		std::vector<ShadowMapUniformNames> ShadowMapNames;
+
+		// Clustered lighting: 2 texels per light (position and range, color and intensity), a range for each
+		// cluster and the light indices the ranges point to
+		bool ClusteredLighting = false;
+		LightClusters Clusters;
+		std::vector<glm::vec4> ClusterSpheres;
+		std::vector<glm::vec4> ClusterLightData;
+		Ref<TextureBuffer> ClusterLights;
+		Ref<TextureBuffer> ClusterRanges;
+		Ref<TextureBuffer> ClusterLightIndices;
 
 		// Extra materials for special rendering modes
 		Ref<Material> UntexturedMaterial;
@@ -85,24 +126,29 @@ namespace Debut
 		static void Shutdown();
 
 		static void BeginScene(SceneCamera& camera, Ref<Skybox> skybox, const glm::mat4& transform,
-			std::vector<LightComponent*>& lights, std::vector<ShaderUniform>& globalUniforms, std::vector<Ref<ShadowMap>> shadowMaps);
+			const FrameVector<LightComponent*>& lights, const std::vector<ShaderUniform>& globalUniforms, const std::vector<Ref<ShadowMap>>& shadowMaps);
 		static void EndScene();
 		static void Flush();
 
 		static void BeginShadow(Ref<ShadowMap> shadowMap, SceneCamera& camera);
 		static void EndShadow();
 
-		static void DrawModel(const MeshRendererComponent& model, const glm::mat4& transform, int entityID);
 		static void DrawModel(Mesh& mesh, Material& material, const glm::mat4& transform, int entityID, bool instanced = false);
 
+		// Upload the uniforms to the shader of a material that is in use
 		static void SendLights(Material& material);
 		static void SendGlobals(Material& material);
 
 		static inline Renderer3DStats GetStats() { return s_PrevStats; }
+		static void AddShadowCacheStats(uint32_t skippedMaps, uint32_t staticUpdates);
+		static void AddOcclusionStats(uint32_t occluders, uint32_t triangles, uint32_t occludedMeshes);
 		static void ResetStats();
 
 	private:
 		static void AddBatch(const UUID& material);
+		static void BuildLightClusters();
+		static const PointLightUniformNames& GetPointLightNames(uint32_t index);
+		static const ShadowMapUniformNames& GetShadowMapNames(uint32_t index);
 	private:
 		static Renderer3DStorage s_Data;
 		static Renderer3DStats s_Stats;
@@ -1,7 +1,26 @@
 #include "Debut/dbtpch.h"
 #include "RendererAPI.h"
+#include "Platform/OpenGL/OpenGLRendererAPI.h"
+#include "Platform/Null/NullRendererAPI.h"
 
 namespace Debut
 {
 	RendererAPI::API RendererAPI::s_API = RendererAPI::API::OpenGL;
-}
\ No newline at end of file
+
+	RendererAPI* RendererAPI::Create()
+	{
+		switch (s_API)
+		{
+		case RendererAPI::API::None:
+			DBT_ASSERT(false, "The renderer doesn't have an API set.");
+			return nullptr;
+		case RendererAPI::API::OpenGL:
+			return new OpenGLRendererAPI();
+		case RendererAPI::API::Null:
+			return new NullRendererAPI();
+		}
+
+		DBT_ASSERT(false, "Unsupported renderer API");
+		return nullptr;
+	}
+}
@@ -11,10 +11,11 @@ namespace Debut
 	public:
 		enum class API
 		{
-			None = 0, OpenGL = 1
+			None = 0, OpenGL = 1, Null = 2
 		};
 
 	public:
+		virtual ~RendererAPI() = default;
 		virtual void Init() = 0;
 
 		virtual void Clear() = 0;
@@ -29,11 +30,17 @@ namespace Debut
 		virtual void DrawLines(const Ref<VertexArray>& va, uint32_t vertexCount) = 0;
 		virtual void DrawPoints(const Ref<VertexArray>& va, uint32_t vertexCount = 0) = 0;
 		virtual void DrawIndexed(const Ref<VertexArray>& va, uint32_t indexCount = 0) = 0;
+		// Draws a range of a shared index buffer, indices are relative to baseVertex
+		virtual void DrawIndexedBaseVertex(const Ref<VertexArray>& va, uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex) = 0;
+		// Draws the first indexCount indices instanceCount times
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& va, uint32_t indexCount, uint32_t instanceCount) = 0;
 		
 		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
 
 		inline static API GetAPI() { return s_API; }
+		// Must be called before Renderer::Init
 		inline static void SetAPI(API val) { s_API = val; }
+		static RendererAPI* Create();
 
 		virtual void SetLineWidth(float thickness) = 0;
 		virtual void SetPointSize(float thickness) = 0;
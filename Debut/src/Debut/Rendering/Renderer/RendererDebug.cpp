@@ -9,6 +9,7 @@
 
 #include <Debut/AssetManager/AssetManager.h>
 #include <Debut/Scene/SceneCamera.h>
+#include <Debut/Core/FrameAllocator.h>
 
 namespace Debut
 {
@@ -16,6 +17,7 @@ namespace Debut
 
 	void RendererDebug::Init()
 	{
+		MemoryTagScope memoryTag(MemoryTag::RendererDebug);
 		RenderCommand::SetLineWidth(1.0f);
 		RenderCommand::SetPointSize(12.0f);
 
@@ -25,18 +27,19 @@ namespace Debut
 		};
 
 		s_Storage.LineVertexArray = VertexArray::Create();
-		s_Storage.LineVertexBuffer = VertexBuffer::Create((uint32_t)0, s_Storage.MaxLines * sizeof(LineVertex));
+		s_Storage.LineVertexBuffer = VertexBuffer::Create((uint32_t)0);
 		s_Storage.LineVertexBuffer->SetLayout(layout);
 		s_Storage.LineVertexBase = new LineVertex[s_Storage.MaxLines];
 		s_Storage.LineVertexArray->AddVertexBuffer(s_Storage.LineVertexBuffer);
 		s_Storage.CurrentLineVertex = s_Storage.LineVertexBase;
 
 		s_Storage.PointVertexArray = VertexArray::Create();
-		s_Storage.PointVertexBuffer = VertexBuffer::Create((uint32_t)0, s_Storage.MaxPoints * sizeof(PointVertex));
+		s_Storage.PointVertexBuffer = VertexBuffer::Create((uint32_t)0);
 		s_Storage.PointVertexBuffer->SetLayout(layout);
 		s_Storage.PointVertexBase = new PointVertex[s_Storage.MaxPoints];
 		s_Storage.PointVertexArray->AddVertexBuffer(s_Storage.PointVertexBuffer);
 		s_Storage.CurrentPointVertex = s_Storage.PointVertexBase;
+		s_Storage.CPUMemory.Resize(s_Storage.MaxLines * sizeof(LineVertex) + s_Storage.MaxPoints * sizeof(PointVertex));
 
 		s_Storage.LineShader = Shader::Create("assets\\shaders\\line.glsl");
 		s_Storage.PointShader = Shader::Create("assets\\shaders\\point.glsl");
@@ -46,6 +49,7 @@ namespace Debut
 	{
 		delete[] s_Storage.LineVertexBase;
 		delete[] s_Storage.PointVertexBase;
+		s_Storage.CPUMemory.Resize(0);
 	}
 
 	void RendererDebug::BeginScene(SceneCamera& camera)
@@ -292,9 +296,8 @@ namespace Debut
 		std::vector<float>& vertices = meshAsset->GetPositions();
 		std::vector<int>& indices = meshAsset->GetIndices();
 
-		std::vector<glm::vec3> transformedVertices;
+		FrameVector<glm::vec3> transformedVertices(vertices.size() / 3);
 		glm::vec3 transformedOffset = glm::mat4(glm::mat3(transform)) * glm::vec4(offset, 1.0f);
-		transformedVertices.resize(vertices.size() / 3);
 
 		for (uint32_t i = 0; i < vertices.size(); i+=3)
 			transformedVertices[i / 3] = transform * glm::vec4(vertices[i], vertices[i + 1], vertices[i + 2], 1.0f);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Debut/Core/Core.h>
+#include <Debut/Core/MemoryTracker.h>
 #include <glm/glm.hpp>
 
 #include <vector>
@@ -48,6 +49,8 @@ namespace Debut
 		uint32_t PointCount = 0;
 		PointVertex* PointVertexBase = nullptr;
 		PointVertex* CurrentPointVertex = nullptr;
+
+		TrackedMemory CPUMemory = { MemoryTag::RendererDebug, MemoryType::CPU };
 	};
 
 	struct TransformComponent;
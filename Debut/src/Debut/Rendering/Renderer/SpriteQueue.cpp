@@ -0,0 +1,76 @@
+#include <Debut/dbtpch.h>
+#include <Debut/Rendering/Renderer/SpriteQueue.h>
+#include <Debut/Core/Instrumentor.h>
+#include <Debut/Scene/Components.h>
+
+#include <cstring>
+
+namespace Debut
+{
+	uint64_t SpriteQueue::MakeKey(int32_t layer, int32_t order, float distance, UUID texture)
+	{
+		constexpr int32_t minLayer = SpriteRendererComponent::MinSortLayer, maxLayer = SpriteRendererComponent::MaxSortLayer;
+		constexpr int32_t minOrder = SpriteRendererComponent::MinOrderInLayer, maxOrder = SpriteRendererComponent::MaxOrderInLayer;
+		static_assert(maxLayer - minLayer < (1 << 8) && maxOrder - minOrder < (1 << 16), "The sort ranges don't fit in the sort key");
+
+		// The components are clamped when they're loaded or edited
+		DBT_CORE_ASSERT(layer >= minLayer && layer <= maxLayer, "The sort layer doesn't fit in the sort key");
+		DBT_CORE_ASSERT(order >= minOrder && order <= maxOrder, "The order in layer doesn't fit in the sort key");
+
+		// Signed values are biased so that they sort as unsigned
+		uint64_t layerBits = (uint64_t)(std::clamp(layer, minLayer, maxLayer) - minLayer);
+		uint64_t orderBits = (uint64_t)(std::clamp(order, minOrder, maxOrder) - minOrder);
+
+		// Floats sort like integers once the sign is handled, the highest 24 bits are enough to order sprites.
+		// The bits are inverted so that the farthest sprites come first
+		uint32_t distanceBits;
+		memcpy(&distanceBits, &distance, sizeof(float));
+		distanceBits = (distanceBits & 0x80000000) ? ~distanceBits : (distanceBits | 0x80000000);
+		uint64_t depthBits = (~distanceBits >> 8) & 0xFFFFFF;
+
+		uint64_t textureID = texture;
+		uint64_t textureBits = (textureID ^ (textureID >> 16) ^ (textureID >> 32) ^ (textureID >> 48)) & 0xFFFF;
+
+		return (layerBits << 56) | (orderBits << 40) | (depthBits << 16) | textureBits;
+	}
+
+	void SpriteQueue::Sort()
+	{
+		DBT_PROFILE_FUNCTION();
+		m_Scratch.resize(m_Keys.size());
+
+		// Least significant digit first, 8 bits per pass. The passes are stable, so equal keys keep the push order
+		for (uint32_t shift = 0; shift < 64; shift += 8)
+		{
+			uint32_t offsets[256] = {};
+			for (const SortEntry& entry : m_Keys)
+				offsets[(entry.Key >> shift) & 0xFF]++;
+
+			// All the keys have the same digit, the pass wouldn't change anything
+			if (!m_Keys.empty() && offsets[(m_Keys[0].Key >> shift) & 0xFF] == m_Keys.size())
+				continue;
+
+			uint32_t total = 0;
+			for (uint32_t& offset : offsets)
+			{
+				uint32_t count = offset;
+				offset = total;
+				total += count;
+			}
+
+			for (const SortEntry& entry : m_Keys)
+				m_Scratch[offsets[(entry.Key >> shift) & 0xFF]++] = entry;
+			m_Keys.swap(m_Scratch);
+		}
+
+		m_Order.resize(m_Keys.size());
+		for (uint32_t i = 0; i < m_Keys.size(); i++)
+			m_Order[i] = m_Keys[i].Index;
+	}
+
+	void SpriteQueue::Clear()
+	{
+		m_Keys.clear();
+		m_Order.clear();
+	}
+}
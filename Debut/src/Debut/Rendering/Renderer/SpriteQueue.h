@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Debut/Core/Core.h>
+#include <Debut/Core/UUID.h>
+
+#include <vector>
+
+/*
+	Submission order of the sprites of a frame. Sprites are alpha blended, so they must be drawn back to front, but
+	drawing them in registry order also splits the batches every time two textures interleave.
+
+	Every sprite gets a 64 bit key: the sort layer and the order in the layer come first, so that they always win,
+	then the depth from the camera (farthest first), then the texture. Sprites at the same depth end up grouped by
+	texture and share the batches. The keys are radix sorted, sprites with the same key keep their original order.
+
+	USAGE:
+		for (uint32_t i = 0; i < sprites.size(); i++)
+			queue.Push(SpriteQueue::MakeKey(layer, order, distance, texture));
+		queue.Sort();
+
+		for (uint32_t index : queue.GetOrder())
+			Renderer2D::DrawSprite(...sprites[index]...);
+*/
+
+namespace Debut
+{
+	class SpriteQueue
+	{
+	public:
+		// Distance is the distance from the camera along its forward axis
+		static uint64_t MakeKey(int32_t layer, int32_t order, float distance, UUID texture);
+
+		inline void Push(uint64_t key) { m_Keys.push_back({ key, (uint32_t)m_Keys.size() }); }
+		void Sort();
+		void Clear();
+
+		// Indices of the pushed sprites, in the order they must be drawn. Valid after Sort
+		inline const std::vector<uint32_t>& GetOrder() const { return m_Order; }
+
+	private:
+		struct SortEntry
+		{
+			uint64_t Key;
+			uint32_t Index;
+		};
+
+		std::vector<SortEntry> m_Keys;
+		std::vector<SortEntry> m_Scratch;
+		std::vector<uint32_t> m_Order;
+	};
+}
@@ -1,6 +1,8 @@
 #include <Debut/dbtpch.h>
 #include <Debut/Rendering/Structures/VertexArray.h>
 #include <Debut/Rendering/Structures/Buffer.h> 
+#include <Debut/Rendering/Structures/MeshPool.h>
+#include <Debut/Rendering/Renderer/Renderer.h>
 #include <Debut/Rendering/Resources/Mesh.h>
 #include <Debut/AssetManager/AssetManager.h>
 
@@ -17,7 +19,33 @@ namespace Debut
 
 	Mesh::~Mesh()
 	{
+		if (m_PoolHandle != 0)
+			m_Pool->Free(m_PoolHandle);
+	}
+
+	Ref<VertexArray> Mesh::GetVertexArray()
+	{
+		return m_Pool != nullptr ? m_Pool->GetVertexArray() : nullptr;
+	}
 
+	uint32_t Mesh::GetBaseVertex()
+	{
+		return m_PoolHandle != 0 ? m_Pool->GetAllocation(m_PoolHandle).BaseVertex : 0;
+	}
+
+	uint32_t Mesh::GetFirstIndex()
+	{
+		return m_PoolHandle != 0 ? m_Pool->GetAllocation(m_PoolHandle).FirstIndex : 0;
+	}
+
+	const std::vector<BufferElement>& Mesh::GetVertexFormat()
+	{
+		static std::vector<BufferElement> format = {
+			{ ShaderDataType::Float3, "a_Position", false }, { ShaderDataType::Float4, "a_Color", false },
+			{ ShaderDataType::Float3, "a_Normal", false }, { ShaderDataType::Float3, "a_Tangent", false },
+			{ ShaderDataType::Float3, "a_Bitangent", false }, { ShaderDataType::Float2, "a_TexCoords0", false }
+		};
+		return format;
 	}
 
 	template<typename T>
@@ -261,30 +289,21 @@ namespace Debut
 
 			m_Vertices = positions;
 			m_Indices = indices;
+			TrackMemory();
 		}
 	
-		// Create runtime structures
-		m_VertexArray = VertexArray::Create();
-		m_IndexBuffer = IndexBuffer::Create();
-
+		// Upload the geometry to the shared buffers
 		{
 			DBT_PROFILE_SCOPE("Mesh::CreateRuntimeBuffers");
-			// Create and attach buffers
-			ShaderDataType types[] = { ShaderDataType::Float3, ShaderDataType::Float4, ShaderDataType::Float3,
-				ShaderDataType::Float3, ShaderDataType::Float3, ShaderDataType::Float2/*, ShaderDataType::Int*/ };
-			std::string attribNames[] = { "a_Position", "a_Color", "a_Normal", "a_Tangent", "a_Bitangent", "a_TexCoords0"/*, "a_EntityID" */ };
-			std::string names[] = { "Positions", "Colors", "Normals", "Tangents", "Bitangents", "TexCoords0" /*, "EntityID"*/ };
-			std::vector<std::vector<float>> floatBuffers = { positions, colors, normals, tangents, bitangents, texCoords };
-
-			for (uint32_t i = 0; i < floatBuffers.size(); i++)
-			{
-				m_VertexBuffers[names[i]] = VertexBuffer::Create(floatBuffers[i].data(), floatBuffers[i].size());
-				m_VertexBuffers[names[i]]->SetLayout({ {types[i], attribNames[i], false} });
-				m_VertexArray->AddVertexBuffer(m_VertexBuffers[names[i]]);
-			}
+			if (m_PoolHandle != 0)
+				m_Pool->Free(m_PoolHandle);
+
+			// Streams in the order of the vertex format
+			std::vector<const void*> streams = { positions.data(), colors.data(), normals.data(), tangents.data(),
+				bitangents.data(), texCoords.data() };
 
-			m_IndexBuffer->SetData(indices.data(), indices.size());
-			m_VertexArray->AddIndexBuffer(m_IndexBuffer);
+			m_Pool = Renderer::GetMeshPool();
+			m_PoolHandle = m_Pool->Allocate(streams, m_NumVertices / 3, indices.data(), m_NumIndices);
 		}
 	}
 
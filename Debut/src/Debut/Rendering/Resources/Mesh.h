@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Debut/Core/UUID.h>
+#include <Debut/Core/MemoryTracker.h>
 #include <Debut/Rendering/Structures/Frustum.h>
 #include <glm/glm.hpp>
 
@@ -9,8 +10,8 @@
 namespace Debut
 {
 	class VertexArray;
-	class VertexBuffer;
-	class IndexBuffer;
+	class MeshPool;
+	struct BufferElement;
 
 	struct MeshMetadata
 	{
@@ -26,6 +27,10 @@ namespace Debut
 		Mesh(const std::string& path, const std::string& metaPath);
 		~Mesh();
 
+		// The geometry is owned by the mesh pool, copies would free it twice
+		Mesh(const Mesh&) = delete;
+		Mesh& operator=(const Mesh&) = delete;
+
 		void SaveSettings(std::vector<float>& positions, std::vector<float>& colors, std::vector<float>& normals, 
 			std::vector<float>& tangents, std::vector<float>& bitangents, std::vector<std::vector<float>>& texcoords,
 			std::vector<int>& indices);
@@ -37,14 +42,18 @@ namespace Debut
 		inline std::vector<float>& GetPositions() { return m_Vertices; }
 		inline std::vector<int>& GetIndices() { return m_Indices; }
 
-		inline Ref<VertexArray> GetVertexArray() { return m_VertexArray; }
+		// Vertex array of the pool the mesh is stored in, shared with the other meshes
+		Ref<VertexArray> GetVertexArray();
+		// Position of the geometry in the pool, can change when the pool is compacted
+		uint32_t GetBaseVertex();
+		uint32_t GetFirstIndex();
 		inline glm::mat4& GetTransform() { return m_Transform; }
 		inline uint32_t GetNumIndices() { return m_NumIndices; }
 		inline uint32_t GetNumVertices() { return m_NumVertices; }
 		inline AABB GetAABB() { return m_AABB; }
 
-		inline void SetPositions(const std::vector<float>& vertices) { m_Vertices = vertices; }
-		inline void SetIndices(const std::vector<int>& indices) { m_Indices = indices; }
+		inline void SetPositions(const std::vector<float>& vertices) { m_Vertices = vertices; TrackMemory(); }
+		inline void SetIndices(const std::vector<int>& indices) { m_Indices = indices; TrackMemory(); }
 		inline void SetTransform(glm::mat4& transform) { m_Transform = transform; }
 		inline void SetName(const std::string& name) { m_Name = name; }
 		inline void SetPath(const std::string& path) { m_Path = path; }
@@ -55,9 +64,12 @@ namespace Debut
 		void Load(const std::string& path);
 
 		static MeshMetadata GetMetadata(UUID id);
+		// Attributes of the meshes, in the order they're uploaded to the mesh pool
+		static const std::vector<BufferElement>& GetVertexFormat();
 
 	private:
 		void Load(std::ifstream& inFile);
+		inline void TrackMemory() { m_CPUMemory.Resize(m_Vertices.capacity() * sizeof(float) + m_Indices.capacity() * sizeof(int)); }
 		
 	private:
 		UUID m_ID;
@@ -70,14 +82,16 @@ namespace Debut
 		std::string m_Path;
 		std::string m_MetaPath;
 
-		std::unordered_map<std::string, Ref<VertexBuffer>> m_VertexBuffers;
-		Ref<IndexBuffer> m_IndexBuffer;
-		Ref<VertexArray> m_VertexArray;
+		Ref<MeshPool> m_Pool;
+		uint32_t m_PoolHandle = 0;
 
 		std::vector<float> m_Vertices;
 		std::vector<int> m_Indices;
 
 		glm::mat4 m_Transform = glm::mat4(1.0f);
 		AABB m_AABB;
+
+		// The copy of the positions and indices kept for the physics and the editor
+		TrackedMemory m_CPUMemory = { MemoryTag::Meshes, MemoryType::CPU };
 	};
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <Debut/Rendering/Texture.h>
 
 #include <Platform/OpenGL/OpenGLSkybox.h>
+#include <Platform/Null/NullSkybox.h>
 
 #include <yaml-cpp/yaml.h>
 #include "Debut/Rendering/Renderer/Renderer.h"
@@ -29,6 +30,10 @@ namespace Debut
 					AssetManager::GetPath(config.Textures[SkyboxTexture::Bottom]), AssetManager::GetPath(config.Textures[SkyboxTexture::Left]), 
 					AssetManager::GetPath(config.Textures[SkyboxTexture::Right]), AssetManager::GetPath(config.Textures[SkyboxTexture::Up]),
 					AssetManager::GetPath(config.Textures[SkyboxTexture::Down]));
+				break;
+			case RendererAPI::API::Null:
+				ret = CreateRef<NullSkybox>();
+				break;
 			}
 		}
 		else
@@ -37,6 +42,10 @@ namespace Debut
 			{
 			case RendererAPI::API::OpenGL:
 				ret = CreateRef<OpenGLSkybox>();
+				break;
+			case RendererAPI::API::Null:
+				ret = CreateRef<NullSkybox>();
+				break;
 			}
 		}
 
@@ -5,6 +5,7 @@
 #include <Debut/Rendering/Renderer/Renderer.h>
 #include <Debut/Rendering/Shader.h>
 #include <Platform/OpenGL/OpenGLShader.h>
+#include <Platform/Null/NullShader.h>
 #include <yaml-cpp/yaml.h>
 
 namespace Debut
@@ -22,6 +23,8 @@ namespace Debut
 			return nullptr;
 		case RendererAPI::API::OpenGL:
 			return CreateRef<OpenGLShader>(filePath);
+		case RendererAPI::API::Null:
+			return CreateRef<NullShader>(filePath);
 		}
 
 		DBT_ASSERT(false, "Unsupported renderer API");
@@ -37,6 +40,8 @@ namespace Debut
 			return nullptr;
 		case RendererAPI::API::OpenGL:
 			return CreateRef<OpenGLShader>(name, vertSrc, fragSrc);
+		case RendererAPI::API::Null:
+			return CreateRef<NullShader>(name, vertSrc, fragSrc);
 		}
 
 		DBT_ASSERT(false, "Unsupported renderer API");
@@ -16,7 +16,7 @@ namespace Debut
 		Int, Int2, Int3, Int4, 
 		Bool,
 		Mat3, Mat4, Struct,
-		Sampler2D, SamplerCube,
+		Sampler2D, SamplerCube, SamplerBuffer,
 		IntArray, FloatArray
 	};
 
@@ -51,6 +51,7 @@ namespace Debut
 		case ShaderDataType::FloatArray: return "FloatArray";
 		case ShaderDataType::Sampler2D: return "Texture";
 		case ShaderDataType::SamplerCube: return "Skybox";
+		case ShaderDataType::SamplerBuffer: return "Buffer";
 		}
 
 		return "None";
@@ -6,6 +6,7 @@
 #include <Debut/Rendering/Renderer/Renderer.h>
 #include <Debut/Rendering/Renderer/RendererAPI.h>
 #include <Platform/OpenGL/OpenGLBuffer.h>
+#include <Platform/Null/NullBuffer.h>
 #include <Debut/Rendering/Structures/Buffer.h>
 
 namespace Debut
@@ -19,13 +20,15 @@ namespace Debut
 			return nullptr;
 		case RendererAPI::API::OpenGL:
 			return CreateRef<OpenGLVertexBuffer>(vertices, count);
+		case RendererAPI::API::Null:
+			return CreateRef<NullVertexBuffer>(vertices, count);
 		}
 
 		DBT_ASSERT(false, "Unsupported renderer API");
 		return nullptr;
 	}
 
-	Ref<VertexBuffer> VertexBuffer::Create(uint32_t size, uint32_t bufferSize)
+	Ref<VertexBuffer> VertexBuffer::Create(uint32_t size)
 	{
 		switch (Renderer::GetAPI())
 		{
@@ -33,7 +36,9 @@ namespace Debut
 			DBT_ASSERT(false, "The renderer doesn't have an API set.");
 			return nullptr;
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLVertexBuffer>((uint32_t)size, bufferSize);
+			return CreateRef<OpenGLVertexBuffer>(size);
+		case RendererAPI::API::Null:
+			return CreateRef<NullVertexBuffer>(size);
 		}
 
 		DBT_ASSERT(false, "Unsupported renderer API");
@@ -49,6 +54,8 @@ namespace Debut
 			return nullptr;
 		case RendererAPI::API::OpenGL:
 			return CreateRef<OpenGLIndexBuffer>(indices, count);
+		case RendererAPI::API::Null:
+			return CreateRef<NullIndexBuffer>(indices, count);
 		}
 
 		DBT_ASSERT(false, "Unsupported renderer API");
@@ -64,6 +71,8 @@ namespace Debut
 			return nullptr;
 		case RendererAPI::API::OpenGL:
 			return CreateRef<OpenGLIndexBuffer>();
+		case RendererAPI::API::Null:
+			return CreateRef<NullIndexBuffer>();
 		}
 
 		DBT_ASSERT(false, "Unsupported renderer API");
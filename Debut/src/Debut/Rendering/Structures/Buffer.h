@@ -123,8 +123,18 @@ namespace Debut
 		virtual void SetData(const void* data, uint32_t size) = 0;
 		virtual void PushData(const void* data, uint32_t size) = 0;
 		virtual void SubmitData() = 0;
-
-		static Ref<VertexBuffer> Create(uint32_t size, uint32_t bufferSize);
+		// Only for static buffers, offsets and sizes are in bytes
+		virtual void SetSubData(const void* data, uint32_t size, uint32_t offset) = 0;
+		virtual void CopySubData(const Ref<VertexBuffer>& source, uint32_t sourceOffset, uint32_t offset, uint32_t size) = 0;
+
+		// Where the data is stored: dynamic buffers move in the dynamic geometry arena every time they're updated
+		virtual uint32_t GetRendererID() const = 0;
+		virtual uint32_t GetOffset() const = 0;
+
+		// Dynamic buffer, the data is only valid until the end of the frame. Size is the memory initially
+		// reserved for PushData
+		static Ref<VertexBuffer> Create(uint32_t size);
+		// Static buffer of count floats, left uninitialized if vertices is null
 		static Ref<VertexBuffer> Create(float* vertices, unsigned int count);
 	private:
 	};
@@ -139,8 +149,12 @@ namespace Debut
 		virtual void Unbind() const = 0;
 		
 		virtual uint32_t GetCount() const = 0;
+		virtual uint32_t GetRendererID() const = 0;
 
 		virtual void SetData(const void* data, uint32_t count) = 0;
+		// Offsets and sizes are in indices
+		virtual void SetSubData(const void* data, uint32_t count, uint32_t first) = 0;
+		virtual void CopySubData(const Ref<IndexBuffer>& source, uint32_t sourceFirst, uint32_t first, uint32_t count) = 0;
 
 		static Ref<IndexBuffer> Create(int* indices, unsigned int count);
 		static Ref<IndexBuffer> Create();
@@ -0,0 +1,95 @@
+#include "Debut/dbtpch.h"
+
+#include <Debut/Rendering/Renderer/Renderer.h>
+#include <Debut/Rendering/Renderer/RendererAPI.h>
+#include <Debut/Rendering/Structures/BufferArena.h>
+#include <Platform/OpenGL/OpenGLBufferArena.h>
+#include <Platform/Null/NullBufferArena.h>
+
+namespace Debut
+{
+	Ref<BufferArena> BufferArena::Create(uint32_t regionSize)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:
+			DBT_ASSERT(false, "The renderer doesn't have an API set.");
+			return nullptr;
+		case RendererAPI::API::OpenGL:
+			return CreateRef<OpenGLBufferArena>(regionSize);
+		case RendererAPI::API::Null:
+			return CreateRef<NullBufferArena>(regionSize);
+		}
+
+		DBT_ASSERT(false, "Unsupported renderer API");
+		return nullptr;
+	}
+
+	BufferAllocation BufferArena::Allocate(const void* data, uint32_t size, uint32_t alignment)
+	{
+		DBT_PROFILE_FUNCTION();
+		uint64_t start = (m_Head + alignment - 1) / alignment * alignment;
+
+		// The frame doesn't fit: the allocations made until now stay in the old storage, which is only destroyed
+		// once the GPU is done with it
+		if (start + size > m_RegionSize)
+		{
+			uint64_t regionSize = m_RegionSize * 2;
+			while (regionSize < size)
+				regionSize *= 2;
+
+			Resize(regionSize);
+			m_Stats.Grows++;
+			start = 0;
+		}
+
+		uint64_t offset = m_Region * m_RegionSize + start;
+		Upload(offset, data, size);
+		m_Head = start + size;
+
+		m_Stats.Allocations++;
+		m_Stats.AllocatedBytes += size;
+
+		return { m_RendererID, (uint32_t)offset, size };
+	}
+
+	void BufferArena::NextFrame()
+	{
+		DBT_PROFILE_FUNCTION();
+		EndRegion(m_Region);
+
+		m_Stats.PeakBytes = std::max(m_Stats.PeakBytes, m_Stats.AllocatedBytes);
+		m_Stats.RegionSize = m_RegionSize;
+		if (m_Stats.AllocatedBytes * 4 < m_RegionSize && m_RegionSize > m_MinRegionSize)
+			m_SmallFrames++;
+		else
+			m_SmallFrames = 0;
+		bool shrink = m_SmallFrames >= s_ShrinkFrames;
+
+		m_PrevStats = m_Stats;
+		m_Stats.Allocations = 0;
+		m_Stats.AllocatedBytes = 0;
+		m_Head = 0;
+
+		if (shrink)
+		{
+			Resize(std::max(m_RegionSize / 2, m_MinRegionSize));
+			m_Stats.Shrinks++;
+			m_SmallFrames = 0;
+			return;
+		}
+
+		m_Region = (m_Region + 1) % s_Frames;
+		if (BeginRegion(m_Region))
+			m_Stats.Stalls++;
+	}
+
+	void BufferArena::Resize(uint64_t regionSize)
+	{
+		m_RegionSize = regionSize;
+		m_Region = 0;
+		m_Head = 0;
+		m_RendererID = CreateStorage(m_RegionSize * s_Frames);
+		m_GPUMemory.Resize(m_RegionSize * s_Frames);
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Debut/Core/Core.h>
+#include <Debut/Core/MemoryTracker.h>
+
+/*
+	Buffer for the geometry that changes every frame. The buffer is split in a region per frame in flight, the data
+	of a frame is sub-allocated linearly in its region so that the CPU never writes memory the GPU is still reading.
+	Uploaded data is only valid until the end of the frame.
+
+	Regions grow when a frame doesn't fit and shrink when the frames have been using a small part of them for a
+	while, so that the memory follows the amount of geometry that is actually drawn.
+*/
+
+namespace Debut
+{
+	struct BufferArenaStats
+	{
+		// Last frame
+		uint32_t Allocations = 0;
+		uint64_t AllocatedBytes = 0;
+		// Most bytes allocated in a frame since the creation of the arena
+		uint64_t PeakBytes = 0;
+
+		uint64_t RegionSize = 0;
+		uint32_t Grows = 0;
+		uint32_t Shrinks = 0;
+		// Frames that had to wait for the GPU to be done with their region
+		uint32_t Stalls = 0;
+	};
+
+	struct BufferAllocation
+	{
+		uint32_t RendererID = 0;
+		uint32_t Offset = 0;
+		uint32_t Size = 0;
+	};
+
+	class BufferArena
+	{
+	public:
+		virtual ~BufferArena() {}
+
+		// Copies the data in the region of the current frame
+		BufferAllocation Allocate(const void* data, uint32_t size, uint32_t alignment = 16);
+		// Called once all the commands of the frame have been submitted
+		void NextFrame();
+
+		inline uint32_t GetRendererID() const { return m_RendererID; }
+		inline BufferArenaStats GetStats() const { return m_PrevStats; }
+
+		static Ref<BufferArena> Create(uint32_t regionSize);
+
+	protected:
+		// Replaces the storage with a new one, returns its renderer ID
+		virtual uint32_t CreateStorage(uint64_t size) = 0;
+		virtual void Upload(uint64_t offset, const void* data, uint32_t size) = 0;
+		// Called when the frame using the region is over, and before writing to it again. Returns true if it had to
+		// wait for the GPU
+		virtual void EndRegion(uint32_t region) = 0;
+		virtual bool BeginRegion(uint32_t region) = 0;
+
+		void Resize(uint64_t regionSize);
+
+	protected:
+		static const uint32_t s_Frames = 3;
+		// Frames using less than a quarter of the region before shrinking it
+		static const uint32_t s_ShrinkFrames = 300;
+
+		uint32_t m_RendererID = 0;
+		uint64_t m_RegionSize = 0;
+		uint64_t m_MinRegionSize = 0;
+
+		uint32_t m_Region = 0;
+		uint64_t m_Head = 0;
+		uint32_t m_SmallFrames = 0;
+
+		BufferArenaStats m_Stats;
+		BufferArenaStats m_PrevStats;
+		TrackedMemory m_GPUMemory = { MemoryTag::DynamicGeometry, MemoryType::GPU };
+	};
+}
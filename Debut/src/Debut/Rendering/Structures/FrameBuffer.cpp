@@ -2,6 +2,7 @@
 #include <Debut/Rendering/Structures/FrameBuffer.h>
 #include <Debut/Rendering/Renderer/RendererAPI.h>
 #include <Platform/OpenGL/OpenGLFrameBuffer.h>
+#include <Platform/Null/NullFrameBuffer.h>
 
 namespace Debut
 {
@@ -11,6 +12,8 @@ namespace Debut
 		{
 		case RendererAPI::API::OpenGL:
 			return CreateRef<OpenGLFrameBuffer>(specs);
+		case RendererAPI::API::Null:
+			return CreateRef<NullFrameBuffer>(specs);
 		case RendererAPI::API::None:
 			DBT_ASSERT(false, "The renderer doesn't have an API set.");
 			break;
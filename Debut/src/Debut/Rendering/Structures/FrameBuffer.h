@@ -70,6 +70,8 @@ namespace Debut
 		virtual void Invalidate() = 0;
 		virtual void Resize(uint32_t x, uint32_t y) = 0;
 		virtual void ClearAttachment(uint32_t index, int value) = 0;
+		// Copies the depth attachment of a frame buffer with the same size and depth format
+		virtual void CopyDepth(const Ref<FrameBuffer>& source) = 0;
 
 		virtual int ReadRedPixel(uint32_t attachmentIndex, int x, int y) = 0;
 		virtual int ReadDepthPixel(uint32_t index, int x, int y) = 0;
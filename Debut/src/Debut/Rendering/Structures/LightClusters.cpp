@@ -0,0 +1,221 @@
+#include <Debut/dbtpch.h>
+#include <Debut/Rendering/Structures/LightClusters.h>
+#include <Debut/Core/JobSystem.h>
+#include <Debut/Core/Instrumentor.h>
+
+#include <cfloat>
+#include <cmath>
+
+#ifdef DBT_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
+
+namespace Debut
+{
+	// Position of the spheres used as padding: they're too far to touch anything
+	static const float s_PaddingPosition = 1e30f;
+
+	// Tests 4 spheres against a box, bit i of the result is set if sphere i touches it
+	static uint32_t TestSpheres(const float* x, const float* y, const float* z, const float* radius, const glm::vec3& min, const glm::vec3& max)
+	{
+#ifdef DBT_SIMD_SSE
+		__m128 zero = _mm_setzero_ps();
+		__m128 centerX = _mm_loadu_ps(x);
+		__m128 centerY = _mm_loadu_ps(y);
+		__m128 centerZ = _mm_loadu_ps(z);
+		__m128 r = _mm_loadu_ps(radius);
+
+		// Distance between the centers and the closest points of the box, per axis
+		__m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(min.x), centerX), _mm_sub_ps(centerX, _mm_set1_ps(max.x))), zero);
+		__m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(min.y), centerY), _mm_sub_ps(centerY, _mm_set1_ps(max.y))), zero);
+		__m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(min.z), centerZ), _mm_sub_ps(centerZ, _mm_set1_ps(max.z))), zero);
+		__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+		return (uint32_t)_mm_movemask_ps(_mm_cmple_ps(distance, _mm_mul_ps(r, r)));
+#else
+		uint32_t mask = 0;
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			float dx = std::max(std::max(min.x - x[i], x[i] - max.x), 0.0f);
+			float dy = std::max(std::max(min.y - y[i], y[i] - max.y), 0.0f);
+			float dz = std::max(std::max(min.z - z[i], z[i] - max.z), 0.0f);
+
+			if (dx * dx + dy * dy + dz * dz <= radius[i] * radius[i])
+				mask |= 1 << i;
+		}
+		return mask;
+#endif
+	}
+
+	void LightClusters::SliceLights::Clear()
+	{
+		X.clear();
+		Y.clear();
+		Z.clear();
+		Radius.clear();
+		Indices.clear();
+		ClusterLights.clear();
+	}
+
+	void LightClusters::SliceLights::PushBack(float x, float y, float z, float radius, uint32_t index)
+	{
+		X.push_back(x);
+		Y.push_back(y);
+		Z.push_back(z);
+		Radius.push_back(radius);
+		Indices.push_back(index);
+	}
+
+	void LightClusters::SliceLights::Pad()
+	{
+		while (X.size() % 4 != 0)
+			PushBack(s_PaddingPosition, s_PaddingPosition, s_PaddingPosition, 0.0f, 0);
+	}
+
+	void LightClusters::Build(const glm::mat4& view, const glm::mat4& projection, float near, float far, const glm::vec4* lights, uint32_t count)
+	{
+		DBT_PROFILE_FUNCTION();
+
+		// The slices are exponential, the near plane can't be at 0
+		near = std::max(near, 0.01f);
+		far = std::max(far, near * 2.0f);
+		if (projection != m_Projection || near != m_Near || far != m_Far)
+			BuildBounds(projection, near, far);
+
+		{
+			DBT_PROFILE_SCOPE("LightClusters::TransformLights");
+			m_Lights.Clear();
+			for (uint32_t i = 0; i < count; i++)
+			{
+				glm::vec3 center = view * glm::vec4(glm::vec3(lights[i]), 1.0f);
+				m_Lights.PushBack(center.x, center.y, center.z, lights[i].w, i);
+			}
+			m_Lights.Pad();
+		}
+
+		m_Slices.resize(s_ClustersZ);
+		JobSystem::ParallelFor(s_ClustersZ, 1, [&](uint32_t start, uint32_t end)
+			{
+				for (uint32_t slice = start; slice < end; slice++)
+					BinSlice(slice);
+			});
+
+		// Put the lists of the slices one after the other
+		DBT_PROFILE_SCOPE("LightClusters::Compact");
+		const uint32_t sliceClusters = s_ClustersX * s_ClustersY;
+		m_Ranges.resize(s_ClusterCount);
+		m_LightIndices.clear();
+		m_MaxClusterLights = 0;
+
+		for (uint32_t z = 0; z < s_ClustersZ; z++)
+		{
+			const SliceLights& slice = m_Slices[z];
+			uint32_t base = (uint32_t)m_LightIndices.size();
+			m_LightIndices.insert(m_LightIndices.end(), slice.ClusterLights.begin(), slice.ClusterLights.end());
+
+			for (uint32_t c = 0; c < sliceClusters; c++)
+			{
+				glm::uvec2 range = slice.ClusterRanges[c];
+				m_Ranges[z * sliceClusters + c] = { base + range.x, range.y };
+				m_MaxClusterLights = std::max(m_MaxClusterLights, range.y);
+			}
+		}
+	}
+
+	void LightClusters::BuildBounds(const glm::mat4& projection, float near, float far)
+	{
+		DBT_PROFILE_FUNCTION();
+		m_Projection = projection;
+		m_Near = near;
+		m_Far = far;
+
+		float logRatio = std::log(far / near);
+		m_DepthScale = s_ClustersZ / logRatio;
+		m_DepthBias = -(float)s_ClustersZ * std::log(near) / logRatio;
+
+		m_ClusterMin.resize(s_ClusterCount);
+		m_ClusterMax.resize(s_ClusterCount);
+		m_SliceMin.assign(s_ClustersZ, glm::vec3(FLT_MAX));
+		m_SliceMax.assign(s_ClustersZ, glm::vec3(-FLT_MAX));
+
+		glm::mat4 inverse = glm::inverse(projection);
+		for (uint32_t y = 0; y < s_ClustersY; y++)
+		{
+			for (uint32_t x = 0; x < s_ClustersX; x++)
+			{
+				// Corners of the tile on the near and on the far plane, in view space
+				glm::vec3 nearCorners[4], farCorners[4];
+				for (uint32_t c = 0; c < 4; c++)
+				{
+					glm::vec2 ndc = { -1.0f + 2.0f * (x + (c & 1)) / s_ClustersX, -1.0f + 2.0f * (y + (c >> 1)) / s_ClustersY };
+					glm::vec4 nearCorner = inverse * glm::vec4(ndc, -1.0f, 1.0f);
+					glm::vec4 farCorner = inverse * glm::vec4(ndc, 1.0f, 1.0f);
+
+					nearCorners[c] = glm::vec3(nearCorner) / nearCorner.w;
+					farCorners[c] = glm::vec3(farCorner) / farCorner.w;
+				}
+
+				for (uint32_t z = 0; z < s_ClustersZ; z++)
+				{
+					float depths[2] = { near * std::pow(far / near, (float)z / s_ClustersZ),
+						near * std::pow(far / near, (float)(z + 1) / s_ClustersZ) };
+					glm::vec3 min = glm::vec3(FLT_MAX), max = glm::vec3(-FLT_MAX);
+
+					// The edges of the tile are straight lines in view space, the cluster is bounded by their points
+					// at the depths of the slice
+					for (uint32_t c = 0; c < 4; c++)
+					{
+						for (float depth : depths)
+						{
+							float t = (depth + nearCorners[c].z) / (nearCorners[c].z - farCorners[c].z);
+							glm::vec3 point = glm::mix(nearCorners[c], farCorners[c], t);
+
+							min = glm::min(min, point);
+							max = glm::max(max, point);
+						}
+					}
+
+					uint32_t cluster = GetClusterIndex(x, y, z);
+					m_ClusterMin[cluster] = min;
+					m_ClusterMax[cluster] = max;
+					m_SliceMin[z] = glm::min(m_SliceMin[z], min);
+					m_SliceMax[z] = glm::max(m_SliceMax[z], max);
+				}
+			}
+		}
+	}
+
+	void LightClusters::BinSlice(uint32_t z)
+	{
+		SliceLights& slice = m_Slices[z];
+		slice.Clear();
+
+		// Keep the lights that touch the slice
+		for (uint32_t i = 0; i < m_Lights.X.size(); i += 4)
+		{
+			uint32_t mask = TestSpheres(&m_Lights.X[i], &m_Lights.Y[i], &m_Lights.Z[i], &m_Lights.Radius[i], m_SliceMin[z], m_SliceMax[z]);
+			for (uint32_t bit = 0; mask != 0; bit++, mask >>= 1)
+				if (mask & 1)
+					slice.PushBack(m_Lights.X[i + bit], m_Lights.Y[i + bit], m_Lights.Z[i + bit], m_Lights.Radius[i + bit], m_Lights.Indices[i + bit]);
+		}
+		slice.Pad();
+
+		// Test them against the clusters of the slice
+		slice.ClusterRanges.resize(s_ClustersX * s_ClustersY);
+		for (uint32_t c = 0; c < s_ClustersX * s_ClustersY; c++)
+		{
+			uint32_t cluster = z * s_ClustersX * s_ClustersY + c;
+			uint32_t offset = (uint32_t)slice.ClusterLights.size();
+
+			for (uint32_t i = 0; i < slice.X.size(); i += 4)
+			{
+				uint32_t mask = TestSpheres(&slice.X[i], &slice.Y[i], &slice.Z[i], &slice.Radius[i], m_ClusterMin[cluster], m_ClusterMax[cluster]);
+				for (uint32_t bit = 0; mask != 0; bit++, mask >>= 1)
+					if (mask & 1)
+						slice.ClusterLights.push_back(slice.Indices[i + bit]);
+			}
+
+			slice.ClusterRanges[c] = { offset, (uint32_t)slice.ClusterLights.size() - offset };
+		}
+	}
+}
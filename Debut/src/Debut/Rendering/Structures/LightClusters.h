@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Debut/Core/Core.h>
+
+#include <glm/glm.hpp>
+#include <vector>
+
+/*
+	Clustered light assignment. The view frustum is split in a grid of clusters: tiles in screen space and slices
+	that are exponentially spaced in depth, so that clusters far from the camera aren't too long. Every frame the
+	point lights are binned in the clusters their sphere touches, so that a fragment only evaluates the lights of
+	its cluster.
+
+	The result is a range (offset, count) for each cluster in a compact list of light indices. Binning only depends
+	on the camera and on the light spheres, it doesn't touch the renderer. Depth slices are binned in parallel: each
+	slice first keeps the lights that touch it, then tests them against its clusters 4 at a time.
+
+	USAGE:
+		clusters.Build(view, projection, near, far, spheres.data(), spheres.size());
+
+		uint32_t cluster = LightClusters::GetClusterIndex(x, y, z);
+		glm::uvec2 range = clusters.GetRanges()[cluster];
+		for (uint32_t i = 0; i < range.y; i++)
+			Shade(lights[clusters.GetLightIndices()[range.x + i]]);
+*/
+
+namespace Debut
+{
+	class LightClusters
+	{
+	public:
+		static const uint32_t s_ClustersX = 16;
+		static const uint32_t s_ClustersY = 9;
+		static const uint32_t s_ClustersZ = 24;
+		static const uint32_t s_ClusterCount = s_ClustersX * s_ClustersY * s_ClustersZ;
+
+		// Lights are world space spheres: xyz is the center, w is the radius
+		void Build(const glm::mat4& view, const glm::mat4& projection, float near, float far, const glm::vec4* lights, uint32_t count);
+
+		// Offset in the light indices and number of lights of each cluster
+		inline const std::vector<glm::uvec2>& GetRanges() const { return m_Ranges; }
+		inline const std::vector<uint32_t>& GetLightIndices() const { return m_LightIndices; }
+		inline uint32_t GetMaxClusterLights() const { return m_MaxClusterLights; }
+
+		// The slice of a fragment is log(depth) * scale + bias
+		inline float GetDepthScale() const { return m_DepthScale; }
+		inline float GetDepthBias() const { return m_DepthBias; }
+
+		static inline uint32_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t z) { return x + y * s_ClustersX + z * s_ClustersX * s_ClustersY; }
+
+	private:
+		void BuildBounds(const glm::mat4& projection, float near, float far);
+		void BinSlice(uint32_t slice);
+
+	private:
+		// Lights of a slice, split by component and padded to a multiple of 4 for the SIMD tests
+		struct SliceLights
+		{
+			std::vector<float> X, Y, Z, Radius;
+			std::vector<uint32_t> Indices;
+
+			// Lights of the clusters of the slice, one after the other
+			std::vector<uint32_t> ClusterLights;
+			// Offset in ClusterLights and count of each cluster of the slice
+			std::vector<glm::uvec2> ClusterRanges;
+
+			void Clear();
+			void PushBack(float x, float y, float z, float radius, uint32_t index);
+			void Pad();
+		};
+
+		// The bounds only change with the projection
+		glm::mat4 m_Projection = glm::mat4(0.0f);
+		float m_Near = 0.0f;
+		float m_Far = 0.0f;
+		float m_DepthScale = 0.0f;
+		float m_DepthBias = 0.0f;
+
+		// View space bounds of the clusters and of the slices
+		std::vector<glm::vec3> m_ClusterMin;
+		std::vector<glm::vec3> m_ClusterMax;
+		std::vector<glm::vec3> m_SliceMin;
+		std::vector<glm::vec3> m_SliceMax;
+
+		// View space lights of the frame
+		SliceLights m_Lights;
+		std::vector<SliceLights> m_Slices;
+
+		std::vector<glm::uvec2> m_Ranges;
+		std::vector<uint32_t> m_LightIndices;
+		uint32_t m_MaxClusterLights = 0;
+	};
+}
@@ -0,0 +1,266 @@
+#include <Debut/dbtpch.h>
+#include <Debut/Rendering/Structures/MeshPool.h>
+#include <Debut/Rendering/Structures/VertexArray.h>
+#include <Debut/Core/Instrumentor.h>
+#include <Debut/Core/MemoryTracker.h>
+
+#include <algorithm>
+
+namespace Debut
+{
+	MeshPool::MeshPool(const std::vector<BufferElement>& format, uint32_t vertexCapacity, uint32_t indexCapacity) : m_Format(format)
+	{
+		Rebuild(vertexCapacity, indexCapacity);
+	}
+
+	uint32_t MeshPool::Allocate(const std::vector<const void*>& streams, uint32_t vertexCount, const int* indices, uint32_t indexCount)
+	{
+		DBT_PROFILE_FUNCTION();
+		DBT_CORE_ASSERT(streams.size() == m_Format.size(), "The mesh doesn't have the vertex format of the pool");
+
+		MeshAllocation allocation;
+		allocation.VertexCount = vertexCount;
+		allocation.IndexCount = indexCount;
+
+		bool verticesFit = m_Vertices.Allocate(vertexCount, allocation.BaseVertex);
+		bool indicesFit = verticesFit && m_Indices.Allocate(indexCount, allocation.FirstIndex);
+
+		if (!indicesFit)
+		{
+			if (verticesFit)
+				m_Vertices.Free(allocation.BaseVertex, vertexCount);
+
+			// Grow only if the mesh doesn't fit in the free memory, otherwise compacting the pool is enough
+			uint32_t usedVertices = m_Vertices.GetCapacity() - m_Vertices.GetFreeSize() + vertexCount;
+			uint32_t usedIndices = m_Indices.GetCapacity() - m_Indices.GetFreeSize() + indexCount;
+			uint32_t vertexCapacity = std::max(m_Vertices.GetCapacity(), 1u);
+			uint32_t indexCapacity = std::max(m_Indices.GetCapacity(), 1u);
+
+			while (vertexCapacity < usedVertices)
+				vertexCapacity *= 2;
+			while (indexCapacity < usedIndices)
+				indexCapacity *= 2;
+
+			if (vertexCapacity > m_Vertices.GetCapacity() || indexCapacity > m_Indices.GetCapacity())
+				m_Grows++;
+			else
+				m_Defragmentations++;
+
+			Rebuild(vertexCapacity, indexCapacity);
+
+			// The free memory is contiguous after a rebuild
+			m_Vertices.Allocate(vertexCount, allocation.BaseVertex);
+			m_Indices.Allocate(indexCount, allocation.FirstIndex);
+		}
+
+		{
+			DBT_PROFILE_SCOPE("MeshPool::Upload");
+			for (uint32_t i = 0; i < m_Format.size(); i++)
+				if (streams[i] != nullptr && vertexCount > 0)
+					m_VertexBuffers[i]->SetSubData(streams[i], vertexCount * m_Format[i].Size, allocation.BaseVertex * m_Format[i].Size);
+			if (indices != nullptr && indexCount > 0)
+				m_IndexBuffer->SetSubData(indices, indexCount, allocation.FirstIndex);
+		}
+
+		uint32_t handle;
+		if (!m_FreeHandles.empty())
+		{
+			handle = m_FreeHandles.back();
+			m_FreeHandles.pop_back();
+		}
+		else
+		{
+			m_Allocations.emplace_back();
+			m_Live.push_back(false);
+			handle = (uint32_t)m_Allocations.size();
+		}
+
+		m_Allocations[handle - 1] = allocation;
+		m_Live[handle - 1] = true;
+
+		return handle;
+	}
+
+	void MeshPool::Free(uint32_t handle)
+	{
+		DBT_CORE_ASSERT(handle > 0 && handle <= m_Allocations.size() && m_Live[handle - 1], "Invalid mesh pool handle");
+
+		MeshAllocation& allocation = m_Allocations[handle - 1];
+		m_Vertices.Free(allocation.BaseVertex, allocation.VertexCount);
+		m_Indices.Free(allocation.FirstIndex, allocation.IndexCount);
+
+		m_Live[handle - 1] = false;
+		m_FreeHandles.push_back(handle);
+	}
+
+	void MeshPool::Defragment()
+	{
+		m_Defragmentations++;
+		Rebuild(m_Vertices.GetCapacity(), m_Indices.GetCapacity());
+	}
+
+	void MeshPool::Rebuild(uint32_t vertexCapacity, uint32_t indexCapacity)
+	{
+		DBT_PROFILE_FUNCTION();
+		MemoryTagScope memoryTag(MemoryTag::Meshes);
+
+		std::vector<Ref<VertexBuffer>> vertexBuffers(m_Format.size());
+		for (uint32_t i = 0; i < m_Format.size(); i++)
+		{
+			vertexBuffers[i] = VertexBuffer::Create(nullptr, vertexCapacity * m_Format[i].Size / sizeof(float));
+			vertexBuffers[i]->SetLayout({ m_Format[i] });
+		}
+		Ref<IndexBuffer> indexBuffer = IndexBuffer::Create(nullptr, indexCapacity);
+
+		std::vector<uint32_t> live;
+		for (uint32_t i = 0; i < m_Allocations.size(); i++)
+			if (m_Live[i])
+				live.push_back(i);
+
+		// Moves the ranges of the live meshes at the start of the new buffers. Meshes are sorted by offset, so that
+		// meshes that were next to each other can be moved with a single copy
+		auto compact = [&](uint32_t MeshAllocation::* offset, uint32_t MeshAllocation::* count, auto copy)
+		{
+			std::sort(live.begin(), live.end(), [&](uint32_t a, uint32_t b) { return m_Allocations[a].*offset < m_Allocations[b].*offset; });
+
+			uint32_t head = 0, runSource = 0, runDest = 0, runSize = 0;
+			for (uint32_t index : live)
+			{
+				MeshAllocation& allocation = m_Allocations[index];
+				if (allocation.*offset != runSource + runSize)
+				{
+					if (runSize > 0)
+						copy(runSource, runDest, runSize);
+					runSource = allocation.*offset;
+					runDest = head;
+					runSize = 0;
+				}
+
+				runSize += allocation.*count;
+				allocation.*offset = head;
+				head += allocation.*count;
+			}
+
+			if (runSize > 0)
+				copy(runSource, runDest, runSize);
+			return head;
+		};
+
+		uint32_t usedVertices = compact(&MeshAllocation::BaseVertex, &MeshAllocation::VertexCount,
+			[&](uint32_t source, uint32_t dest, uint32_t size)
+			{
+				for (uint32_t i = 0; i < m_Format.size(); i++)
+					vertexBuffers[i]->CopySubData(m_VertexBuffers[i], source * m_Format[i].Size, dest * m_Format[i].Size, size * m_Format[i].Size);
+			});
+		uint32_t usedIndices = compact(&MeshAllocation::FirstIndex, &MeshAllocation::IndexCount,
+			[&](uint32_t source, uint32_t dest, uint32_t size) { indexBuffer->CopySubData(m_IndexBuffer, source, dest, size); });
+
+		m_VertexBuffers = vertexBuffers;
+		m_IndexBuffer = indexBuffer;
+		m_Vertices.Reset(vertexCapacity, usedVertices);
+		m_Indices.Reset(indexCapacity, usedIndices);
+
+		m_VertexArray = VertexArray::Create();
+		for (auto& buffer : m_VertexBuffers)
+			m_VertexArray->AddVertexBuffer(buffer);
+		m_VertexArray->AddIndexBuffer(m_IndexBuffer);
+	}
+
+	MeshPoolStats MeshPool::GetStats() const
+	{
+		MeshPoolStats ret;
+
+		ret.Meshes = (uint32_t)(m_Allocations.size() - m_FreeHandles.size());
+		ret.VertexCapacity = m_Vertices.GetCapacity();
+		ret.UsedVertices = m_Vertices.GetCapacity() - m_Vertices.GetFreeSize();
+		ret.IndexCapacity = m_Indices.GetCapacity();
+		ret.UsedIndices = m_Indices.GetCapacity() - m_Indices.GetFreeSize();
+
+		ret.FreeVertexRanges = m_Vertices.GetFreeRanges();
+		ret.FreeIndexRanges = m_Indices.GetFreeRanges();
+		ret.VertexFragmentation = m_Vertices.GetFragmentation();
+		ret.IndexFragmentation = m_Indices.GetFragmentation();
+
+		ret.Grows = m_Grows;
+		ret.Defragmentations = m_Defragmentations;
+
+		return ret;
+	}
+
+	void MeshPool::RangeAllocator::Reset(uint32_t capacity, uint32_t used)
+	{
+		m_FreeRanges.clear();
+		m_Capacity = capacity;
+		m_FreeSize = capacity - used;
+
+		if (m_FreeSize > 0)
+			m_FreeRanges[used] = m_FreeSize;
+	}
+
+	bool MeshPool::RangeAllocator::Allocate(uint32_t size, uint32_t& offset)
+	{
+		if (size == 0)
+		{
+			offset = 0;
+			return true;
+		}
+
+		// First fit: meshes are usually loaded together, so they're kept at the start of the buffer
+		for (auto it = m_FreeRanges.begin(); it != m_FreeRanges.end(); it++)
+		{
+			if (it->second < size)
+				continue;
+
+			offset = it->first;
+			uint32_t remaining = it->second - size;
+			m_FreeRanges.erase(it);
+			if (remaining > 0)
+				m_FreeRanges[offset + size] = remaining;
+
+			m_FreeSize -= size;
+			return true;
+		}
+
+		return false;
+	}
+
+	void MeshPool::RangeAllocator::Free(uint32_t offset, uint32_t size)
+	{
+		if (size == 0)
+			return;
+		m_FreeSize += size;
+
+		// Merge with the following range
+		auto next = m_FreeRanges.lower_bound(offset);
+		if (next != m_FreeRanges.end() && offset + size == next->first)
+		{
+			size += next->second;
+			next = m_FreeRanges.erase(next);
+		}
+
+		// Merge with the previous range
+		if (next != m_FreeRanges.begin())
+		{
+			auto prev = std::prev(next);
+			if (prev->first + prev->second == offset)
+			{
+				prev->second += size;
+				return;
+			}
+		}
+
+		m_FreeRanges.emplace_hint(next, offset, size);
+	}
+
+	float MeshPool::RangeAllocator::GetFragmentation() const
+	{
+		if (m_FreeSize == 0)
+			return 0.0f;
+
+		uint32_t largest = 0;
+		for (auto& range : m_FreeRanges)
+			largest = std::max(largest, range.second);
+
+		return 1.0f - (float)largest / m_FreeSize;
+	}
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <Debut/Core/Core.h>
+#include <Debut/Rendering/Structures/Buffer.h>
+
+#include <map>
+#include <vector>
+
+/*
+	Shared vertex and index storage for the static meshes that use the same vertex format. Every attribute has its
+	own big vertex buffer, meshes are sub-allocated from them and from a single index buffer, so that all the meshes
+	of a pool are drawn with the same vertex array and only differ by base vertex and first index.
+
+	Freed ranges are reused by the next allocations. When an allocation doesn't fit, the live meshes are compacted
+	at the start of new buffers, which are bigger if the pool is actually full.
+
+	USAGE:
+		uint32_t handle = pool->Allocate({ positions.data(), colors.data() }, vertexCount, indices.data(), indexCount);
+		MeshAllocation allocation = pool->GetAllocation(handle);
+		RenderCommand::DrawIndexedBaseVertex(pool->GetVertexArray(), allocation.IndexCount, allocation.FirstIndex,
+			allocation.BaseVertex);
+		pool->Free(handle);
+*/
+
+namespace Debut
+{
+	class VertexArray;
+
+	struct MeshPoolStats
+	{
+		uint32_t Meshes = 0;
+
+		uint32_t VertexCapacity = 0;
+		uint32_t UsedVertices = 0;
+		uint32_t IndexCapacity = 0;
+		uint32_t UsedIndices = 0;
+
+		uint32_t FreeVertexRanges = 0;
+		uint32_t FreeIndexRanges = 0;
+		// 0 if the free memory is contiguous, close to 1 if it's split in many small ranges
+		float VertexFragmentation = 0;
+		float IndexFragmentation = 0;
+
+		uint32_t Grows = 0;
+		uint32_t Defragmentations = 0;
+	};
+
+	struct MeshAllocation
+	{
+		uint32_t BaseVertex = 0;
+		uint32_t VertexCount = 0;
+		uint32_t FirstIndex = 0;
+		uint32_t IndexCount = 0;
+	};
+
+	class MeshPool
+	{
+	public:
+		// Every element of the format is stored in its own vertex buffer
+		MeshPool(const std::vector<BufferElement>& format, uint32_t vertexCapacity, uint32_t indexCapacity);
+
+		// Streams contains the data of each element of the format, indices are relative to the first vertex of the
+		// mesh. Returns the handle of the mesh, 0 is never a valid handle
+		uint32_t Allocate(const std::vector<const void*>& streams, uint32_t vertexCount, const int* indices, uint32_t indexCount);
+		void Free(uint32_t handle);
+		// Compacts the live meshes so that the free memory is contiguous. Moves the meshes in new buffers, so it
+		// shouldn't be called while drawing
+		void Defragment();
+
+		inline MeshAllocation GetAllocation(uint32_t handle) const { return m_Allocations[handle - 1]; }
+		inline Ref<VertexArray> GetVertexArray() const { return m_VertexArray; }
+		inline const std::vector<BufferElement>& GetFormat() const { return m_Format; }
+		MeshPoolStats GetStats() const;
+
+	private:
+		// Free list of a buffer, ranges are coalesced when they're freed
+		class RangeAllocator
+		{
+		public:
+			// The first used elements are allocated, the rest is free
+			void Reset(uint32_t capacity, uint32_t used);
+			bool Allocate(uint32_t size, uint32_t& offset);
+			void Free(uint32_t offset, uint32_t size);
+
+			inline uint32_t GetCapacity() const { return m_Capacity; }
+			inline uint32_t GetFreeSize() const { return m_FreeSize; }
+			inline uint32_t GetFreeRanges() const { return (uint32_t)m_FreeRanges.size(); }
+			float GetFragmentation() const;
+
+		private:
+			// Offset -> size
+			std::map<uint32_t, uint32_t> m_FreeRanges;
+			uint32_t m_Capacity = 0;
+			uint32_t m_FreeSize = 0;
+		};
+
+		// Moves the live meshes at the start of new buffers with the specified capacity
+		void Rebuild(uint32_t vertexCapacity, uint32_t indexCapacity);
+
+	private:
+		std::vector<BufferElement> m_Format;
+
+		std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+		Ref<IndexBuffer> m_IndexBuffer;
+		Ref<VertexArray> m_VertexArray;
+
+		RangeAllocator m_Vertices;
+		RangeAllocator m_Indices;
+
+		std::vector<MeshAllocation> m_Allocations;
+		std::vector<bool> m_Live;
+		std::vector<uint32_t> m_FreeHandles;
+
+		uint32_t m_Grows = 0;
+		uint32_t m_Defragmentations = 0;
+	};
+}
@@ -0,0 +1,264 @@
+#include <Debut/dbtpch.h>
+#include <Debut/Rendering/Structures/OcclusionBuffer.h>
+#include <Debut/Core/JobSystem.h>
+#include <Debut/Core/Instrumentor.h>
+
+#include <cfloat>
+#include <cmath>
+
+#ifdef DBT_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
+
+namespace Debut
+{
+	static const uint32_t s_TileCount = OcclusionBuffer::s_TilesX * OcclusionBuffer::s_TilesY;
+
+	static glm::vec3 ToScreen(const glm::vec4& clip)
+	{
+		glm::vec3 ndc = glm::vec3(clip) / clip.w;
+		return { (ndc.x * 0.5f + 0.5f) * OcclusionBuffer::s_Width, (ndc.y * 0.5f + 0.5f) * OcclusionBuffer::s_Height, ndc.z };
+	}
+
+	void OcclusionBuffer::Begin(const glm::mat4& viewProjection)
+	{
+		m_ViewProjection = viewProjection;
+		m_Occluders.clear();
+		m_Triangles.clear();
+	}
+
+	void OcclusionBuffer::AddOccluder(const float* positions, const int* indices, uint32_t nIndices, const glm::mat4& transform)
+	{
+		m_Occluders.push_back({ positions, indices, nIndices, m_ViewProjection * transform });
+	}
+
+	void OcclusionBuffer::Rasterize()
+	{
+		DBT_PROFILE_FUNCTION();
+		m_Depth.resize(s_Width * s_Height);
+		m_TileMaxDepth.resize(s_TileCount);
+
+		m_OccluderTriangles.resize(std::max(m_OccluderTriangles.size(), m_Occluders.size()));
+		JobSystem::ParallelFor((uint32_t)m_Occluders.size(), 1, [&](uint32_t start, uint32_t end)
+			{
+				for (uint32_t i = start; i < end; i++)
+					TransformOccluder(i);
+			});
+
+		BinTriangles();
+
+		JobSystem::ParallelFor(s_TileCount, 1, [&](uint32_t start, uint32_t end)
+			{
+				for (uint32_t tile = start; tile < end; tile++)
+					RasterizeTile(tile);
+			});
+	}
+
+	void OcclusionBuffer::TransformOccluder(uint32_t index)
+	{
+		const Occluder& occluder = m_Occluders[index];
+		std::vector<ScreenTriangle>& triangles = m_OccluderTriangles[index];
+		triangles.clear();
+
+		for (uint32_t i = 0; i + 2 < occluder.NIndices; i += 3)
+		{
+			glm::vec4 clip[3];
+			for (uint32_t v = 0; v < 3; v++)
+			{
+				const float* position = occluder.Positions + occluder.Indices[i + v] * 3;
+				clip[v] = occluder.Transform * glm::vec4(position[0], position[1], position[2], 1.0f);
+			}
+
+			// Clip against the near plane (z >= -w), the result has up to 4 vertices
+			glm::vec4 polygon[4];
+			uint32_t nVertices = 0;
+			for (uint32_t v = 0; v < 3; v++)
+			{
+				const glm::vec4& current = clip[v];
+				const glm::vec4& next = clip[(v + 1) % 3];
+				float currentDistance = current.z + current.w;
+				float nextDistance = next.z + next.w;
+
+				if (currentDistance >= 0.0f)
+					polygon[nVertices++] = current;
+				if ((currentDistance >= 0.0f) != (nextDistance >= 0.0f))
+					polygon[nVertices++] = glm::mix(current, next, currentDistance / (currentDistance - nextDistance));
+			}
+
+			for (uint32_t v = 2; v < nVertices; v++)
+				triangles.push_back({ ToScreen(polygon[0]), ToScreen(polygon[v - 1]), ToScreen(polygon[v]) });
+		}
+	}
+
+	void OcclusionBuffer::BinTriangles()
+	{
+		DBT_PROFILE_FUNCTION();
+		for (uint32_t i = 0; i < m_Occluders.size(); i++)
+			m_Triangles.insert(m_Triangles.end(), m_OccluderTriangles[i].begin(), m_OccluderTriangles[i].end());
+
+		m_Bins.resize(s_TileCount);
+		for (auto& bin : m_Bins)
+			bin.clear();
+
+		for (uint32_t i = 0; i < m_Triangles.size(); i++)
+		{
+			const glm::vec3* vertices = m_Triangles[i].Vertices;
+			glm::vec2 min = glm::min(glm::min(glm::vec2(vertices[0]), glm::vec2(vertices[1])), glm::vec2(vertices[2]));
+			glm::vec2 max = glm::max(glm::max(glm::vec2(vertices[0]), glm::vec2(vertices[1])), glm::vec2(vertices[2]));
+			if (max.x < 0.0f || max.y < 0.0f || min.x >= s_Width || min.y >= s_Height)
+				continue;
+
+			uint32_t minX = (uint32_t)std::max(min.x, 0.0f) / s_TileWidth, maxX = (uint32_t)std::min(max.x, s_Width - 1.0f) / s_TileWidth;
+			uint32_t minY = (uint32_t)std::max(min.y, 0.0f) / s_TileHeight, maxY = (uint32_t)std::min(max.y, s_Height - 1.0f) / s_TileHeight;
+			for (uint32_t y = minY; y <= maxY; y++)
+				for (uint32_t x = minX; x <= maxX; x++)
+					m_Bins[x + y * s_TilesX].push_back(i);
+		}
+	}
+
+	void OcclusionBuffer::RasterizeTile(uint32_t tile)
+	{
+		uint32_t tileX = (tile % s_TilesX) * s_TileWidth;
+		uint32_t tileY = (tile / s_TilesX) * s_TileHeight;
+
+		for (uint32_t y = tileY; y < tileY + s_TileHeight; y++)
+			std::fill(m_Depth.begin() + y * s_Width + tileX, m_Depth.begin() + y * s_Width + tileX + s_TileWidth, FLT_MAX);
+
+		for (uint32_t index : m_Bins[tile])
+		{
+			glm::vec3 v0 = m_Triangles[index].Vertices[0];
+			glm::vec3 v1 = m_Triangles[index].Vertices[1];
+			glm::vec3 v2 = m_Triangles[index].Vertices[2];
+
+			// Both windings are occluders, counter clockwise triangles have a positive area
+			float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+			if (area == 0.0f)
+				continue;
+			if (area < 0.0f)
+			{
+				std::swap(v1, v2);
+				area = -area;
+			}
+
+			// Edge functions (a * x + b * y + c), positive inside the triangle
+			glm::vec3 edges[3];
+			const glm::vec3* from[3] = { &v0, &v1, &v2 };
+			const glm::vec3* to[3] = { &v1, &v2, &v0 };
+			for (uint32_t e = 0; e < 3; e++)
+				edges[e] = { from[e]->y - to[e]->y, to[e]->x - from[e]->x, from[e]->x * to[e]->y - from[e]->y * to[e]->x };
+
+			// Depth is linear in screen space
+			float depthX = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) / area;
+			float depthY = ((v1.x - v0.x) * (v2.z - v0.z) - (v2.x - v0.x) * (v1.z - v0.z)) / area;
+			float depthC = v0.z - depthX * v0.x - depthY * v0.y;
+
+			// Pixels of the tile whose center can be in the triangle, the columns are aligned to 4
+			float minX = std::min(std::min(v0.x, v1.x), v2.x), maxX = std::max(std::max(v0.x, v1.x), v2.x);
+			float minY = std::min(std::min(v0.y, v1.y), v2.y), maxY = std::max(std::max(v0.y, v1.y), v2.y);
+			int32_t startX = std::max((int32_t)tileX, (int32_t)std::floor(minX) & ~3);
+			int32_t endX = std::min((int32_t)(tileX + s_TileWidth), (int32_t)std::ceil(maxX));
+			int32_t startY = std::max((int32_t)tileY, (int32_t)std::floor(minY));
+			int32_t endY = std::min((int32_t)(tileY + s_TileHeight), (int32_t)std::ceil(maxY));
+
+			for (int32_t y = startY; y < endY; y++)
+			{
+				float centerY = y + 0.5f;
+				float* row = &m_Depth[y * s_Width];
+
+				for (int32_t x = startX; x < endX; x += 4)
+				{
+#ifdef DBT_SIMD_SSE
+					__m128 centerX = _mm_add_ps(_mm_set1_ps(x + 0.5f), _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f));
+					__m128 inside = _mm_cmpeq_ps(centerX, centerX);
+					for (uint32_t e = 0; e < 3; e++)
+					{
+						__m128 value = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edges[e].x), centerX), _mm_set1_ps(edges[e].y * centerY + edges[e].z));
+						inside = _mm_and_ps(inside, _mm_cmpge_ps(value, _mm_setzero_ps()));
+					}
+					if (_mm_movemask_ps(inside) == 0)
+						continue;
+
+					__m128 depth = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(depthX), centerX), _mm_set1_ps(depthY * centerY + depthC));
+					__m128 current = _mm_loadu_ps(row + x);
+					__m128 closest = _mm_min_ps(current, depth);
+					_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, closest), _mm_andnot_ps(inside, current)));
+#else
+					for (int32_t i = 0; i < 4; i++)
+					{
+						float centerX = x + i + 0.5f;
+						bool inside = true;
+						for (uint32_t e = 0; e < 3; e++)
+							inside &= edges[e].x * centerX + edges[e].y * centerY + edges[e].z >= 0.0f;
+
+						if (inside)
+							row[x + i] = std::min(row[x + i], depthX * centerX + depthY * centerY + depthC);
+					}
+#endif
+				}
+			}
+		}
+
+		float maxDepth = -FLT_MAX;
+		for (uint32_t y = tileY; y < tileY + s_TileHeight; y++)
+			for (uint32_t x = tileX; x < tileX + s_TileWidth; x++)
+				maxDepth = std::max(maxDepth, m_Depth[y * s_Width + x]);
+		m_TileMaxDepth[tile] = maxDepth;
+	}
+
+	bool OcclusionBuffer::TestAABB(const AABB& aabb, const glm::mat4& transform) const
+	{
+		if (m_Triangles.empty())
+			return true;
+
+		glm::mat4 mvp = m_ViewProjection * transform;
+		glm::vec2 min = glm::vec2(FLT_MAX), max = glm::vec2(-FLT_MAX);
+		float minDepth = FLT_MAX;
+
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			glm::vec3 corner = aabb.Center + glm::vec3(
+				(i & 1) ? aabb.MaxExtents.x : aabb.MinExtents.x,
+				(i & 2) ? aabb.MaxExtents.y : aabb.MinExtents.y,
+				(i & 4) ? aabb.MaxExtents.z : aabb.MinExtents.z);
+			glm::vec4 clip = mvp * glm::vec4(corner, 1.0f);
+
+			// Boxes that cross the near plane are too close to be hidden
+			if (clip.z + clip.w < 0.0f)
+				return true;
+
+			glm::vec3 screen = ToScreen(clip);
+			min = glm::min(min, glm::vec2(screen));
+			max = glm::max(max, glm::vec2(screen));
+			minDepth = std::min(minDepth, screen.z);
+		}
+
+		// Outside of the screen, frustum culling decides
+		if (max.x < 0.0f || max.y < 0.0f || min.x >= s_Width || min.y >= s_Height)
+			return true;
+
+		// All the pixels touched by the box
+		uint32_t startX = (uint32_t)std::max(min.x, 0.0f), endX = (uint32_t)std::min(std::ceil(max.x), (float)s_Width);
+		uint32_t startY = (uint32_t)std::max(min.y, 0.0f), endY = (uint32_t)std::min(std::ceil(max.y), (float)s_Height);
+		endX = std::max(endX, startX + 1);
+		endY = std::max(endY, startY + 1);
+
+		for (uint32_t tileY = startY / s_TileHeight; tileY <= (endY - 1) / s_TileHeight; tileY++)
+		{
+			for (uint32_t tileX = startX / s_TileWidth; tileX <= (endX - 1) / s_TileWidth; tileX++)
+			{
+				// The whole tile is in front of the box
+				if (m_TileMaxDepth[tileX + tileY * s_TilesX] < minDepth)
+					continue;
+
+				uint32_t fromX = std::max(startX, tileX * s_TileWidth), toX = std::min(endX, (tileX + 1) * s_TileWidth);
+				uint32_t fromY = std::max(startY, tileY * s_TileHeight), toY = std::min(endY, (tileY + 1) * s_TileHeight);
+				for (uint32_t y = fromY; y < toY; y++)
+					for (uint32_t x = fromX; x < toX; x++)
+						if (m_Depth[y * s_Width + x] >= minDepth)
+							return true;
+			}
+		}
+
+		return false;
+	}
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Debut/Core/Core.h>
+#include <Debut/Rendering/Structures/Frustum.h>
+
+#include <glm/glm.hpp>
+#include <vector>
+
+/*
+	Software occlusion culling. A few occluders (big, simple meshes) are rasterized on the CPU in a small depth
+	buffer, then the bounds of the renderables are tested against it: a box whose closest point is behind the
+	occluders in all the pixels it covers can't be seen and doesn't need to be drawn.
+
+	The buffer is split in tiles. The triangles of the occluders are transformed and clipped against the near plane
+	on the workers, binned in the tiles they touch, then each tile is rasterized by a different job, 4 pixels at a
+	time. Every tile also keeps the farthest depth it contains, so that most tests don't need to read the pixels.
+
+	Depth is the NDC depth, smaller is closer. Pixels that aren't covered by any occluder are at FLT_MAX.
+
+	USAGE:
+		buffer.Begin(camera.GetProjection() * camera.GetView());
+		buffer.AddOccluder(mesh.GetPositions().data(), mesh.GetIndices().data(), mesh.GetNumIndices(), transform);
+		buffer.Rasterize();
+
+		if (buffer.TestAABB(aabb, transform)) ...
+*/
+
+namespace Debut
+{
+	class OcclusionBuffer
+	{
+	public:
+		static const uint32_t s_Width = 256;
+		static const uint32_t s_Height = 144;
+		static const uint32_t s_TileWidth = 32;
+		static const uint32_t s_TileHeight = 16;
+		static const uint32_t s_TilesX = s_Width / s_TileWidth;
+		static const uint32_t s_TilesY = s_Height / s_TileHeight;
+
+		// Removes the occluders of the previous frame
+		void Begin(const glm::mat4& viewProjection);
+		// Positions are packed xyz. The data isn't copied, it must stay valid until Rasterize returns
+		void AddOccluder(const float* positions, const int* indices, uint32_t nIndices, const glm::mat4& transform);
+		void Rasterize();
+
+		// False if the box is certainly hidden by the occluders
+		bool TestAABB(const AABB& aabb, const glm::mat4& transform) const;
+
+		// Row major, the first row is the bottom of the screen
+		inline const std::vector<float>& GetDepth() const { return m_Depth; }
+		inline uint32_t GetOccluderCount() const { return (uint32_t)m_Occluders.size(); }
+		inline uint32_t GetTriangleCount() const { return (uint32_t)m_Triangles.size(); }
+
+	private:
+		struct Occluder
+		{
+			const float* Positions;
+			const int* Indices;
+			uint32_t NIndices;
+			glm::mat4 Transform;
+		};
+
+		// Screen space triangle: x and y are in pixels, z is the NDC depth
+		struct ScreenTriangle
+		{
+			glm::vec3 Vertices[3];
+		};
+
+		void TransformOccluder(uint32_t occluder);
+		void BinTriangles();
+		void RasterizeTile(uint32_t tile);
+
+	private:
+		glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+		std::vector<Occluder> m_Occluders;
+		// Triangles of each occluder, so that the workers don't share the output
+		std::vector<std::vector<ScreenTriangle>> m_OccluderTriangles;
+
+		std::vector<ScreenTriangle> m_Triangles;
+		// Triangles that touch each tile
+		std::vector<std::vector<uint32_t>> m_Bins;
+
+		std::vector<float> m_Depth;
+		std::vector<float> m_TileMaxDepth;
+	};
+}
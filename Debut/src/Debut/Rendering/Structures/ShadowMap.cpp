@@ -1,3 +1,4 @@
+#include <Debut/dbtpch.h>
 #include <Debut/Rendering/Structures/ShadowMap.h>
 #include <Debut/Rendering/Structures/Frustum.h>
 #include <Debut/Scene/SceneCamera.h>
@@ -26,38 +27,41 @@ namespace Debut
 		
 		std::vector<glm::vec3> points = Frustum::GetWorldViewPoints(referenceCamera);
 
-		float left, right, top, down, front, bottom;
-		glm::vec2 xBounds = { std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
-		glm::vec2 yBounds = { xBounds.x, xBounds.y };
-		glm::vec2 zBounds = { xBounds.x, xBounds.y };
+		// The slice is fitted with a sphere, whose size doesn't change when the camera rotates
+		glm::vec3 center = glm::vec3(0.0f);
+		for (auto point : points)
+			center += point;
+		center /= points.size();
 
-		glm::vec3 lightPos;
-		glm::vec3 cameraPos = glm::vec3(0.0f);
-		
-		// Set camera point of view
+		float radius = 0.0f;
 		for (auto point : points)
-			cameraPos += point;
-		cameraPos /= points.size();
+			radius = std::max(radius, glm::length(point - center));
+		// Rounded so that the precision errors don't change the fit
+		radius = std::max(std::ceil(radius * 16.0f), 1.0f) / 16.0f;
 
-		lightPos = cameraPos + glm::normalize(lightDirection) * m_DistanceFromCamera;
+		// The center is snapped to a grid in light space, so that the projection only changes when the camera moves
+		// by a cell. A cell is a whole number of texels, the shadows don't shimmer when the projection moves. The
+		// extents are larger than the sphere by half a cell, so that it's always covered
+		float extent = radius * s_SnapCells / (s_SnapCells - 1);
+		m_SnapSize = extent * 2.0f / s_SnapCells;
 
-		// Use the camera forward instead of its position
-		float zMult = 2.0f;
-		m_View = glm::lookAt(lightPos, cameraPos, glm::vec3(0.0f, 1.0f, 0.0f));
+		glm::mat4 lightRotation = glm::lookAt(glm::vec3(0.0f), -glm::normalize(lightDirection), glm::vec3(0.0f, 1.0f, 0.0f));
+		glm::vec3 lightCenter = lightRotation * glm::vec4(center, 1.0f);
+		lightCenter = glm::round(lightCenter / m_SnapSize) * m_SnapSize;
 
-		for (auto point : points)
-		{
-			point = m_View * glm::vec4(point, 1.0f);
-
-			xBounds.x = std::min(xBounds.x, point.x);
-			xBounds.y = std::max(xBounds.y, point.x);
+		// The light looks down -z, it's placed towards +z
+		float zMult = 2.0f;
+		m_View = glm::translate(glm::mat4(1.0f), -(lightCenter + glm::vec3(0.0f, 0.0f, m_DistanceFromCamera))) * lightRotation;
 
-			yBounds.x = std::min(yBounds.x, point.y);
-			yBounds.y = std::max(yBounds.y, point.y);
+		glm::vec2 xBounds = { -extent, extent };
+		glm::vec2 yBounds = { -extent, extent };
+		glm::vec2 zBounds = { -m_DistanceFromCamera - extent, -m_DistanceFromCamera + extent };
 
-			zBounds.x = std::min(zBounds.x, point.z);
-			zBounds.y = std::max(zBounds.y, point.z);
-		}
+		// Shadows can only fall on the slice, but anything between the slice and the light can cast them
+		m_CasterVolume.LightView = m_View;
+		m_CasterVolume.XBounds = xBounds;
+		m_CasterVolume.YBounds = yBounds;
+		m_CasterVolume.ReceiversMinZ = zBounds.x;
 
 		// Pull near
 		if (zBounds.x < 0)
@@ -70,17 +74,58 @@ namespace Debut
 		else
 			zBounds.y *= zMult;
 
-		m_Projection = glm::ortho(xBounds.x, xBounds.y, yBounds.x, yBounds.y, zBounds.x, zBounds.y);
+		m_XBounds = xBounds;
+		m_YBounds = yBounds;
+		m_ZBounds = zBounds;
+		UpdateProjection(outCamera);
+	}
+
+	void ShadowMap::ExtendToCasters(float casterMaxZ, SceneCamera& outCamera)
+	{
+		// The projection covers the depths from -m_ZBounds.y to -m_ZBounds.x, the light is towards +z
+		if (m_ZBounds.x <= -casterMaxZ)
+			return;
+
+		// Rounded to the grid of the fit: the casters that move a bit, like the dynamic ones, don't change the
+		// projection and the static layer stays valid
+		m_ZBounds.x = -std::ceil(casterMaxZ / m_SnapSize) * m_SnapSize;
+		UpdateProjection(outCamera);
+	}
+
+	void ShadowMap::UpdateProjection(SceneCamera& outCamera)
+	{
+		m_Projection = glm::ortho(m_XBounds.x, m_XBounds.y, m_YBounds.x, m_YBounds.y, m_ZBounds.x, m_ZBounds.y);
 		m_ViewProjection = m_Projection * m_View;
 
 		outCamera.SetType(Camera::ProjectionType::Orthographic);
-		outCamera.SetOrthoSize(yBounds.y - yBounds.x);
-		outCamera.SetAspectRatio((xBounds.y - xBounds.x) / outCamera.GetOrthoSize());
+		outCamera.SetOrthoSize(m_YBounds.y - m_YBounds.x);
+		outCamera.SetAspectRatio((m_XBounds.y - m_XBounds.x) / outCamera.GetOrthoSize());
 		outCamera.SetView(m_View);
 		outCamera.SetProjection(m_Projection);
-		outCamera.SetOrthoBoundsX(xBounds);
-		outCamera.SetOrthoBoundsY(yBounds);
-		outCamera.SetOrthoBoundsZ(zBounds);
+		outCamera.SetOrthoBoundsX(m_XBounds);
+		outCamera.SetOrthoBoundsY(m_YBounds);
+		outCamera.SetOrthoBoundsZ(m_ZBounds);
+	}
+
+	bool ShadowCasterVolume::TestAABB(const AABB& aabb, const glm::mat4& transform, float& outMaxZ) const
+	{
+		// Light space box of the transformed bounds
+		glm::mat4 toLight = LightView * transform;
+		glm::vec3 localCenter = aabb.Center + (aabb.MinExtents + aabb.MaxExtents) * 0.5f;
+		glm::vec3 localHalf = (aabb.MaxExtents - aabb.MinExtents) * 0.5f;
+
+		glm::vec3 center = toLight * glm::vec4(localCenter, 1.0f);
+		glm::vec3 half = glm::abs(glm::mat3(toLight)[0]) * localHalf.x + glm::abs(glm::mat3(toLight)[1]) * localHalf.y +
+			glm::abs(glm::mat3(toLight)[2]) * localHalf.z;
+
+		glm::vec3 min = center - half;
+		glm::vec3 max = center + half;
+		outMaxZ = max.z;
+
+		// The shadow is cast along -z, so it can only hit the receivers that overlap in xy and aren't in front of
+		// the caster
+		return max.x >= XBounds.x && min.x <= XBounds.y && max.y >= YBounds.x && min.y <= YBounds.y &&
+			max.z >= ReceiversMinZ;
 	}
 
 	void ShadowMap::Bind()
@@ -103,6 +148,33 @@ namespace Debut
 		m_FrameBuffer->UnbindDepth(slot);
 	}
 
+	bool ShadowMap::NeedsStaticUpdate(uint64_t staticVersion) const
+	{
+		return !m_StaticValid || m_StaticVersion != staticVersion || m_StaticViewProjection != m_ViewProjection;
+	}
+
+	void ShadowMap::BindStaticLayer()
+	{
+		if (m_StaticFrameBuffer == nullptr)
+			m_StaticFrameBuffer = FrameBuffer::Create(m_FrameBuffer->GetSpecs());
+		m_StaticFrameBuffer->Bind();
+	}
+
+	void ShadowMap::EndStaticUpdate(uint64_t staticVersion)
+	{
+		m_StaticFrameBuffer->Unbind();
+
+		m_StaticViewProjection = m_ViewProjection;
+		m_StaticVersion = staticVersion;
+		m_StaticValid = true;
+	}
+
+	void ShadowMap::RestoreStaticLayer()
+	{
+		DBT_CORE_ASSERT(m_StaticValid, "The static layer of the shadow map hasn't been rendered");
+		m_FrameBuffer->CopyDepth(m_StaticFrameBuffer);
+	}
+
 	uint32_t ShadowMap::GetRendererID()
 	{
 		return m_FrameBuffer->GetDepthAttachment();
@@ -7,6 +7,24 @@ namespace Debut
 {
 	class FrameBuffer;
 	class SceneCamera;
+	struct AABB;
+
+	/*
+		Region that can cast shadows in a cascade: the slice of the view frustum covered by the cascade, extruded
+		towards the light. Everything is in light view space, where the light looks down -z.
+	*/
+	struct ShadowCasterVolume
+	{
+		glm::mat4 LightView = glm::mat4(1.0f);
+		glm::vec2 XBounds = glm::vec2(0.0f);
+		glm::vec2 YBounds = glm::vec2(0.0f);
+		// Depth of the receiver that's farthest from the light
+		float ReceiversMinZ = 0.0f;
+
+		// True if the shadow of the box can fall on the slice. The depth of the side of the box that's closest
+		// to the light is returned in outMaxZ
+		bool TestAABB(const AABB& aabb, const glm::mat4& transform, float& outMaxZ) const;
+	};
 
 	class ShadowMap
 	{
@@ -29,7 +47,13 @@ namespace Debut
 		inline void SetFar(float cameraFar) { m_Far = cameraFar; }
 		inline void SetCameraDistance(float cameraDistance) { m_DistanceFromCamera = cameraDistance; }
 
+		// Fits the cascade around the slice of the view between the near and far planes. The fit is stable: it
+		// doesn't change when the camera rotates or moves by less than a fraction of the cascade
 		void SetFromCamera(const SceneCamera& camera, SceneCamera& outCamera, const glm::vec3& lightDirection);
+		// Pulls the near plane towards the light, so that casters outside the view aren't clipped. The depth is the
+		// largest one returned by the caster volume
+		void ExtendToCasters(float casterMaxZ, SceneCamera& outCamera);
+		inline const ShadowCasterVolume& GetCasterVolume() const { return m_CasterVolume; }
 
 		void Bind();
 		void BindAsTexture(uint32_t slot);
@@ -37,8 +61,25 @@ namespace Debut
 		void Unbind();
 		void UnbindTexture(uint32_t slot);
 
+		// Static casters are rendered in a separate layer, which is copied in the shadow map before drawing the
+		// dynamic ones. The layer is only rendered again if the fit or the static casters change
+		bool NeedsStaticUpdate(uint64_t staticVersion) const;
+		// Binds the static layer, the caller clears and renders it
+		void BindStaticLayer();
+		void EndStaticUpdate(uint64_t staticVersion);
+		// Replaces the content of the shadow map with the static layer
+		void RestoreStaticLayer();
+		inline void InvalidateStaticLayer() { m_StaticValid = false; }
+
+		// False if the shadow map has to be rendered before it can be used
+		inline bool IsValid() { return m_Valid; }
+		inline void SetValid(bool valid) { m_Valid = valid; }
+
 		uint32_t GetRendererID();
 
+	private:
+		void UpdateProjection(SceneCamera& outCamera);
+
 	private:
 		uint32_t m_Index;
 		uint32_t m_Width;
@@ -52,6 +93,23 @@ namespace Debut
 		float m_Far;
 		float m_DistanceFromCamera;
 
+		// The fit is snapped to cells of this size in light space
+		float m_SnapSize = 1.0f;
+		static constexpr float s_SnapCells = 16.0f;
+
+		// Light space bounds of the projection
+		glm::vec2 m_XBounds;
+		glm::vec2 m_YBounds;
+		glm::vec2 m_ZBounds;
+		ShadowCasterVolume m_CasterVolume;
+
 		Ref<FrameBuffer> m_FrameBuffer;
+		bool m_Valid = false;
+
+		// Created the first time static casters are cached
+		Ref<FrameBuffer> m_StaticFrameBuffer;
+		glm::mat4 m_StaticViewProjection = glm::mat4(0.0f);
+		uint64_t m_StaticVersion = 0;
+		bool m_StaticValid = false;
 	};
 }
\ No newline at end of file
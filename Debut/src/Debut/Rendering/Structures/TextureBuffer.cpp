@@ -0,0 +1,24 @@
+#include "Debut/dbtpch.h"
+#include <Debut/Rendering/Structures/TextureBuffer.h>
+#include <Debut/Rendering/Renderer/RendererAPI.h>
+#include <Platform/OpenGL/OpenGLTextureBuffer.h>
+#include <Platform/Null/NullTextureBuffer.h>
+
+namespace Debut
+{
+	Ref<TextureBuffer> TextureBuffer::Create(TextureBufferFormat format)
+	{
+		switch (RendererAPI::GetAPI())
+		{
+		case RendererAPI::API::OpenGL:
+			return CreateRef<OpenGLTextureBuffer>(format);
+		case RendererAPI::API::Null:
+			return CreateRef<NullTextureBuffer>(format);
+		case RendererAPI::API::None:
+			DBT_ASSERT(false, "The renderer doesn't have an API set.");
+			break;
+		}
+
+		return nullptr;
+	}
+}
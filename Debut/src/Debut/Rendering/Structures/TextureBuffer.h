@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Debut/Core/Core.h>
+
+/*
+	Buffer that shaders read as a texture (samplerBuffer / usamplerBuffer), for arrays that are too big to be
+	uniforms. The buffer grows when the data doesn't fit, the memory is kept between frames.
+
+	USAGE:
+		Ref<TextureBuffer> buffer = TextureBuffer::Create(TextureBufferFormat::R32UI);
+		buffer->SetData(indices.data(), indices.size() * sizeof(uint32_t));
+		buffer->Bind(slot);
+*/
+
+namespace Debut
+{
+	enum class TextureBufferFormat { R32UI = 0, RG32UI, RGBA32F };
+
+	class TextureBuffer
+	{
+	public:
+		virtual ~TextureBuffer() = default;
+
+		// Replaces the content of the buffer, size is in bytes
+		virtual void SetData(const void* data, uint32_t size) = 0;
+		virtual void Bind(uint32_t slot) const = 0;
+
+		virtual uint32_t GetRendererID() const = 0;
+
+		static Ref<TextureBuffer> Create(TextureBufferFormat format);
+	};
+}
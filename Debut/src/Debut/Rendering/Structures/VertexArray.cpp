@@ -5,6 +5,7 @@
 #include <Debut/Rendering/Structures/Buffer.h>
 #include <Debut/Rendering/Structures/VertexArray.h>
 #include <Platform/OpenGL/OpenGLVertexArray.h>
+#include <Platform/Null/NullVertexArray.h>
 
 namespace Debut
 {
@@ -17,6 +18,8 @@ namespace Debut
 			return nullptr;
 		case RendererAPI::API::OpenGL:
 			return CreateRef<OpenGLVertexArray>();
+		case RendererAPI::API::Null:
+			return CreateRef<NullVertexArray>();
 		}
 
 		DBT_ASSERT(false, "Unsupported renderer API");
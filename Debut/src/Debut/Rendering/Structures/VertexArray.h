@@ -15,7 +15,8 @@ namespace Debut
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
 
-		virtual void AddVertexBuffer(const Ref<VertexBuffer>& buffer) = 0;
+		// Instanced buffers advance once per instance instead of once per vertex
+		virtual void AddVertexBuffer(const Ref<VertexBuffer>& buffer, bool instanced = false) = 0;
 		virtual void AddIndexBuffer(const Ref<IndexBuffer>& buffer) = 0;
 
 		virtual const std::vector<Ref<VertexBuffer>> GetVertexBuffers() const = 0;
@@ -2,6 +2,7 @@
 #include "Renderer/Renderer.h"
 #include "Texture.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
+#include "Platform/Null/NullTexture.h"
 #include "yaml-cpp/yaml.h"
 #include <fstream>
 
@@ -30,6 +31,8 @@ namespace Debut
 			return nullptr;
 		case RendererAPI::API::OpenGL:
 			return CreateRef<OpenGLTexture2D>(path, texParams);
+		case RendererAPI::API::Null:
+			return CreateRef<NullTexture2D>(path, texParams);
 		}
 
 		DBT_ASSERT(false, "Unsupported renderer API");
@@ -45,6 +48,8 @@ namespace Debut
 			return nullptr;
 		case RendererAPI::API::OpenGL:
 			return CreateRef<OpenGLTexture2D>(width, height);
+		case RendererAPI::API::Null:
+			return CreateRef<NullTexture2D>(width, height);
 		}
 
 		DBT_ASSERT(false, "Unsupported renderer API");
@@ -65,6 +70,10 @@ namespace Debut
 		emitter << YAML::Key << "ID" << YAML::Value << parameters.ID;
 		emitter << YAML::Key << "Filtering" << YAML::Value << Tex2DParamToString(parameters.Filtering);
 		emitter << YAML::Key << "WrapMode" << YAML::Value << Tex2DParamToString(parameters.WrapMode);
+		emitter << YAML::Key << "Mipmaps" << YAML::Value << parameters.Mipmaps;
+		emitter << YAML::Key << "sRGB" << YAML::Value << parameters.SRGB;
+		emitter << YAML::Key << "Compression" << YAML::Value << Tex2DParamToString(parameters.Compression);
+		emitter << YAML::Key << "Quality" << YAML::Value << Tex2DParamToString(parameters.Quality);
 
 		emitter << YAML::EndMap << YAML::EndDoc;
 
@@ -87,6 +96,14 @@ namespace Debut
 			texParams.Filtering = StringToTex2DParam(in["Filtering"].as<std::string>());
 			texParams.WrapMode = StringToTex2DParam(in["WrapMode"].as<std::string>());
 			texParams.ID = in["ID"] ? in["ID"].as<uint64_t>() : 0;
+			texParams.Mipmaps = in["Mipmaps"] ? in["Mipmaps"].as<bool>() : true;
+			texParams.SRGB = in["sRGB"] ? in["sRGB"].as<bool>() : true;
+			// Metas written before compression existed aren't compressed, like new textures: nothing says what they
+			// contain, and compressing a normal map as color would break it
+			if (in["Compression"])
+				texParams.Compression = StringToTex2DParam(in["Compression"].as<std::string>());
+			if (in["Quality"])
+				texParams.Quality = StringToTex2DParam(in["Quality"].as<std::string>());
 
 			return texParams;
 		}
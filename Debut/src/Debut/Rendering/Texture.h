@@ -9,7 +9,9 @@ namespace Debut
 	enum class Texture2DParameter
 	{
 		FILTERING_POINT = 0, FILTERING_LINEAR,
-		WRAP_REPEAT, WRAP_CLAMP, NONE
+		WRAP_REPEAT, WRAP_CLAMP, 
+		COMPRESSION_NONE, COMPRESSION_COLOR, COMPRESSION_MASK, COMPRESSION_NORMALMAP,
+		QUALITY_FAST, QUALITY_NORMAL, QUALITY_HIGH, NONE
 	};
 
 	struct Texture2DConfig
@@ -17,7 +19,12 @@ namespace Debut
 		Texture2DParameter Filtering = Texture2DParameter::FILTERING_LINEAR;
 		Texture2DParameter WrapMode = Texture2DParameter::WRAP_REPEAT;
 		UUID ID = 0;
-		// TODO: mip mapping
+		bool Mipmaps = true;
+		// Color textures are stored in sRGB, data textures (normal maps, masks) are linear
+		bool SRGB = true;
+		// Textures are only compressed once the user says what they contain
+		Texture2DParameter Compression = Texture2DParameter::COMPRESSION_NONE;
+		Texture2DParameter Quality = Texture2DParameter::QUALITY_NORMAL;
 	};
 
 	static std::string Tex2DParamToString(Texture2DParameter parameter)
@@ -28,6 +35,13 @@ namespace Debut
 		case Texture2DParameter::FILTERING_POINT: return "Point";
 		case Texture2DParameter::WRAP_CLAMP: return "Clamp";
 		case Texture2DParameter::WRAP_REPEAT: return "Repeat";
+		case Texture2DParameter::COMPRESSION_NONE: return "None";
+		case Texture2DParameter::COMPRESSION_COLOR: return "Color";
+		case Texture2DParameter::COMPRESSION_MASK: return "Mask";
+		case Texture2DParameter::COMPRESSION_NORMALMAP: return "NormalMap";
+		case Texture2DParameter::QUALITY_FAST: return "Fast";
+		case Texture2DParameter::QUALITY_NORMAL: return "Normal";
+		case Texture2DParameter::QUALITY_HIGH: return "High";
 		}
 
 		Log.AppWarn("Texture parameter {0} not supported", (uint32_t)parameter);
@@ -39,6 +53,13 @@ namespace Debut
 		if (param == "Point") return Texture2DParameter::FILTERING_POINT;
 		if (param == "Clamp") return Texture2DParameter::WRAP_CLAMP;
 		if (param == "Repeat") return Texture2DParameter::WRAP_REPEAT;
+		if (param == "None") return Texture2DParameter::COMPRESSION_NONE;
+		if (param == "Color") return Texture2DParameter::COMPRESSION_COLOR;
+		if (param == "Mask") return Texture2DParameter::COMPRESSION_MASK;
+		if (param == "NormalMap") return Texture2DParameter::COMPRESSION_NORMALMAP;
+		if (param == "Fast") return Texture2DParameter::QUALITY_FAST;
+		if (param == "Normal") return Texture2DParameter::QUALITY_NORMAL;
+		if (param == "High") return Texture2DParameter::QUALITY_HIGH;
 
 		Log.AppWarn("Texture parameter {0} not supported", param);
 		return Texture2DParameter::NONE;
@@ -67,6 +88,10 @@ namespace Debut
 		// Texture parameters
 		Texture2DParameter m_FilteringMode = Texture2DParameter::FILTERING_LINEAR;
 		Texture2DParameter m_WrapMode = Texture2DParameter::WRAP_CLAMP;
+		bool m_Mipmaps = true;
+		bool m_SRGB = true;
+		Texture2DParameter m_Compression = Texture2DParameter::COMPRESSION_NONE;
+		Texture2DParameter m_Quality = Texture2DParameter::QUALITY_NORMAL;
 
 		UUID m_ID;
 
@@ -78,6 +103,10 @@ namespace Debut
 
 		Texture2DParameter GetFilteringMode() { return m_FilteringMode; }
 		Texture2DParameter GetWrapMode() { return m_WrapMode; }
+		bool HasMipmaps() { return m_Mipmaps; }
+		bool IsSRGB() { return m_SRGB; }
+		Texture2DParameter GetCompression() { return m_Compression; }
+		Texture2DParameter GetQuality() { return m_Quality; }
 
 		void SetFilteringMode(Texture2DParameter param) { m_FilteringMode = param; }
 		void SetWrapMode(Texture2DParameter param) { m_WrapMode = param; }
@@ -179,6 +179,16 @@ namespace Debut
 		UUID Texture = 0;
 		float TilingFactor = 1.0f;
 
+		// Sprites of higher layers are drawn over the ones of the lower layers, the order sorts the sprites of a
+		// layer. Sprites with the same layer and order are drawn back to front
+		int SortLayer = 0;
+		int OrderInLayer = 0;
+		// Ranges that fit in the sort keys of the sprites
+		static constexpr int MinSortLayer = -128;
+		static constexpr int MaxSortLayer = 127;
+		static constexpr int MinOrderInLayer = -32768;
+		static constexpr int MaxOrderInLayer = 32767;
+
 		SpriteRendererComponent() : Color(glm::vec4(1.0f)) {}
 		SpriteRendererComponent(const SpriteRendererComponent&) = default;
 		SpriteRendererComponent(const glm::vec4& color) : Color(color) {}
@@ -193,19 +203,13 @@ namespace Debut
 		bool Instanced = false;
 		AABB BoundingBox;
 
-		inline AABB GetAABB() const
-		{
-			// Get transform
-			glm::mat4 transform = Entity::s_ExistingEntities[Owner].Transform().GetTransform();
-			AABB ret = BoundingBox;
-			
-			// Transform center
-			ret.Center = ret.Center;
-			ret.MinExtents = BoundingBox.MinExtents;
-			ret.MaxExtents = BoundingBox.MaxExtents;
+		// Occluders are rasterized on the CPU to hide what's behind them. The occluder mesh is a low poly version
+		// of the mesh used for that, the mesh itself is used if it's 0
+		bool Occluder = false;
+		UUID OccluderMesh = 0;
 
-			return ret;
-		}
+		// Bounds in mesh space, the render proxies keep the world space ones
+		inline AABB GetAABB() const { return BoundingBox; }
 
 		inline void SetAABB(AABB box) { BoundingBox = box; }
 
@@ -74,6 +74,15 @@ namespace Debut
 			return m_Scene->m_Registry.get<T>(m_EntityHandle);
 		}
 
+		// Components modified in place must be marked as changed for the observers of the registry to know,
+		// like the render proxies
+		template<typename T>
+		void MarkChanged()
+		{
+			DBT_ASSERT(HasComponent<T>(), "This entity doesn't have the required component");
+			m_Scene->m_Registry.patch<T>(m_EntityHandle);
+		}
+
 		template<typename T>
 		void RemoveComponent()
 		{
@@ -0,0 +1,263 @@
+#include <Debut/dbtpch.h>
+#include <Debut/Scene/RenderProxies.h>
+#include <Debut/Scene/Components.h>
+#include <Debut/Core/JobSystem.h>
+#include <Debut/Core/Instrumentor.h>
+
+#include <limits>
+
+namespace Debut
+{
+	std::atomic<uint64_t> RenderProxies::s_NextStaticVersion = 1;
+
+	static bool operator==(const AABB& a, const AABB& b)
+	{
+		return a.Center == b.Center && a.MinExtents == b.MinExtents && a.MaxExtents == b.MaxExtents;
+	}
+
+	static AABB GetWorldBounds(const AABB& local, const glm::mat4& transform)
+	{
+		AABB ret;
+		ret.Center = glm::vec3(0.0f);
+		ret.MinExtents = glm::vec3(std::numeric_limits<float>::max());
+		ret.MaxExtents = glm::vec3(std::numeric_limits<float>::lowest());
+
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			glm::vec3 corner = local.Center + glm::vec3(
+				(i & 1) ? local.MaxExtents.x : local.MinExtents.x,
+				(i & 2) ? local.MaxExtents.y : local.MinExtents.y,
+				(i & 4) ? local.MaxExtents.z : local.MinExtents.z);
+			glm::vec3 world = transform * glm::vec4(corner, 1.0f);
+
+			ret.MinExtents = glm::min(ret.MinExtents, world);
+			ret.MaxExtents = glm::max(ret.MaxExtents, world);
+		}
+
+		return ret;
+	}
+
+	void RenderProxyArrays::PushBack(int32_t entityID)
+	{
+		// Not a valid transform, so that the first refresh always fills the proxy
+		WorldMatrices.emplace_back(0.0f);
+		LocalBounds.push_back({ glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(0.0f) });
+		WorldBounds.push_back({ glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(0.0f) });
+		Meshes.emplace_back(0);
+		Materials.emplace_back(0);
+		OccluderMeshes.emplace_back(0);
+		Flags.push_back(RenderProxyFlags::None);
+		EntityIDs.push_back(entityID);
+		UnchangedFrames.push_back(0);
+	}
+
+	void RenderProxyArrays::RemoveAndSwap(uint32_t index)
+	{
+		uint32_t last = Size() - 1;
+		if (index != last)
+		{
+			WorldMatrices[index] = WorldMatrices[last];
+			LocalBounds[index] = LocalBounds[last];
+			WorldBounds[index] = WorldBounds[last];
+			Meshes[index] = Meshes[last];
+			Materials[index] = Materials[last];
+			OccluderMeshes[index] = OccluderMeshes[last];
+			Flags[index] = Flags[last];
+			EntityIDs[index] = EntityIDs[last];
+			UnchangedFrames[index] = UnchangedFrames[last];
+		}
+
+		WorldMatrices.pop_back();
+		LocalBounds.pop_back();
+		WorldBounds.pop_back();
+		Meshes.pop_back();
+		Materials.pop_back();
+		OccluderMeshes.pop_back();
+		Flags.pop_back();
+		EntityIDs.pop_back();
+		UnchangedFrames.pop_back();
+	}
+
+	void RenderProxyArrays::Clear()
+	{
+		WorldMatrices.clear();
+		LocalBounds.clear();
+		WorldBounds.clear();
+		Meshes.clear();
+		Materials.clear();
+		OccluderMeshes.clear();
+		Flags.clear();
+		EntityIDs.clear();
+		UnchangedFrames.clear();
+	}
+
+	void RenderProxies::Connect(entt::registry& registry)
+	{
+		registry.on_construct<MeshRendererComponent>().connect<&RenderProxies::OnConstruct>(this);
+		registry.on_update<MeshRendererComponent>().connect<&RenderProxies::OnUpdate>(this);
+		registry.on_destroy<MeshRendererComponent>().connect<&RenderProxies::OnDestroy>(this);
+		registry.on_update<TransformComponent>().connect<&RenderProxies::OnUpdate>(this);
+
+		// Renderers that were added before connecting
+		for (auto entity : registry.view<MeshRendererComponent>())
+			OnConstruct(registry, entity);
+	}
+
+	void RenderProxies::Disconnect(entt::registry& registry)
+	{
+		registry.on_construct<MeshRendererComponent>().disconnect<&RenderProxies::OnConstruct>(this);
+		registry.on_update<MeshRendererComponent>().disconnect<&RenderProxies::OnUpdate>(this);
+		registry.on_destroy<MeshRendererComponent>().disconnect<&RenderProxies::OnDestroy>(this);
+		registry.on_update<TransformComponent>().disconnect<&RenderProxies::OnUpdate>(this);
+
+		m_Arrays.Clear();
+		m_Indices.clear();
+		m_Dirty.clear();
+		m_IsDirty.clear();
+		m_StaticVersion = s_NextStaticVersion++;
+	}
+
+	void RenderProxies::Update(entt::registry& registry)
+	{
+		DBT_PROFILE_FUNCTION();
+
+		m_KeepDirty.resize(m_Dirty.size());
+		JobSystem::ParallelFor((uint32_t)m_Dirty.size(), 256, [&](uint32_t start, uint32_t end)
+			{
+				for (uint32_t i = start; i < end; i++)
+				{
+					// The entity might have been destroyed after being marked
+					uint32_t index = m_Indices[m_Dirty[i]];
+					if (index == s_NoProxy)
+					{
+						m_KeepDirty[i] = 0;
+						continue;
+					}
+
+					bool refreshAgain = Refresh(registry, index);
+
+					// Proxies become static after a few frames without changes
+					if (m_Arrays.UnchangedFrames[index] < s_StaticFrames && ++m_Arrays.UnchangedFrames[index] == s_StaticFrames)
+					{
+						m_Arrays.Flags[index] |= RenderProxyFlags::Static;
+						m_StaticChanged = true;
+					}
+
+					m_KeepDirty[i] = refreshAgain || m_Arrays.UnchangedFrames[index] < s_StaticFrames;
+				}
+			});
+
+		uint32_t kept = 0;
+		for (uint32_t i = 0; i < m_Dirty.size(); i++)
+		{
+			if (m_KeepDirty[i])
+				m_Dirty[kept++] = m_Dirty[i];
+			else
+				m_IsDirty[m_Dirty[i]] = 0;
+		}
+		m_Dirty.resize(kept);
+
+		if (m_StaticChanged.exchange(false))
+			m_StaticVersion = s_NextStaticVersion++;
+	}
+
+	void RenderProxies::MarkDirty(entt::entity entity)
+	{
+		MarkEntityDirty((uint32_t)entt::to_entity(entity));
+	}
+
+	void RenderProxies::MarkAllDirty()
+	{
+		for (uint32_t i = 0; i < m_Arrays.Size(); i++)
+			MarkEntityDirty((uint32_t)entt::to_entity((entt::entity)m_Arrays.EntityIDs[i]));
+	}
+
+	void RenderProxies::MarkEntityDirty(uint32_t number)
+	{
+		// Entities without a proxy don't need to be tracked, the children they move have a parent
+		if (number >= m_Indices.size() || m_Indices[number] == s_NoProxy || m_IsDirty[number])
+			return;
+
+		m_IsDirty[number] = 1;
+		m_Dirty.push_back(number);
+	}
+
+	void RenderProxies::OnConstruct(entt::registry& registry, entt::entity entity)
+	{
+		uint32_t number = (uint32_t)entt::to_entity(entity);
+		if (number >= m_Indices.size())
+		{
+			m_Indices.resize(number + 1, s_NoProxy);
+			m_IsDirty.resize(number + 1, 0);
+		}
+		if (m_Indices[number] != s_NoProxy)
+			return;
+
+		m_Indices[number] = m_Arrays.Size();
+		m_Arrays.PushBack((int32_t)entity);
+		// The transform might not have been added yet, the first Update fills the rest
+		MeshRendererComponent& renderer = registry.get<MeshRendererComponent>(entity);
+		m_Arrays.Meshes.back() = renderer.Mesh;
+		m_Arrays.Materials.back() = renderer.Material;
+		MarkEntityDirty(number);
+	}
+
+	void RenderProxies::OnUpdate(entt::registry& registry, entt::entity entity)
+	{
+		MarkDirty(entity);
+	}
+
+	void RenderProxies::OnDestroy(entt::registry& registry, entt::entity entity)
+	{
+		uint32_t number = (uint32_t)entt::to_entity(entity);
+		if (number >= m_Indices.size() || m_Indices[number] == s_NoProxy)
+			return;
+
+		uint32_t index = m_Indices[number];
+		uint32_t last = m_Arrays.Size() - 1;
+		if (m_Arrays.Flags[index] & RenderProxyFlags::Static)
+			m_StaticChanged = true;
+		if (index != last)
+			m_Indices[(uint32_t)entt::to_entity((entt::entity)m_Arrays.EntityIDs[last])] = index;
+
+		m_Arrays.RemoveAndSwap(index);
+		m_Indices[number] = s_NoProxy;
+	}
+
+	bool RenderProxies::Refresh(entt::registry& registry, uint32_t index)
+	{
+		entt::entity entity = (entt::entity)m_Arrays.EntityIDs[index];
+		TransformComponent* transform = registry.try_get<TransformComponent>(entity);
+		// Nothing notifies the proxies when the transform is added
+		if (transform == nullptr)
+			return true;
+		// Moving an ancestor doesn't patch the children
+		bool refreshAgain = (bool)transform->Parent;
+		MeshRendererComponent& renderer = registry.get<MeshRendererComponent>(entity);
+
+		glm::mat4 world = transform->GetTransform();
+		uint32_t flags = (renderer.Instanced ? RenderProxyFlags::Instanced : RenderProxyFlags::None) |
+			(renderer.Occluder ? RenderProxyFlags::Occluder : RenderProxyFlags::None);
+		bool changed = m_Arrays.WorldMatrices[index] != world || !(m_Arrays.LocalBounds[index] == renderer.BoundingBox) ||
+			m_Arrays.Meshes[index] != renderer.Mesh || m_Arrays.Materials[index] != renderer.Material ||
+			m_Arrays.OccluderMeshes[index] != renderer.OccluderMesh ||
+			(m_Arrays.Flags[index] & ~RenderProxyFlags::Static) != flags;
+
+		if (!changed)
+			return refreshAgain;
+
+		m_Arrays.WorldMatrices[index] = world;
+		m_Arrays.LocalBounds[index] = renderer.BoundingBox;
+		m_Arrays.WorldBounds[index] = GetWorldBounds(renderer.BoundingBox, world);
+		m_Arrays.Meshes[index] = renderer.Mesh;
+		m_Arrays.Materials[index] = renderer.Material;
+		m_Arrays.OccluderMeshes[index] = renderer.OccluderMesh;
+
+		// A static proxy that changes isn't static anymore
+		if (m_Arrays.Flags[index] & RenderProxyFlags::Static)
+			m_StaticChanged = true;
+		m_Arrays.Flags[index] = flags;
+		m_Arrays.UnchangedFrames[index] = 0;
+		return refreshAgain;
+	}
+}
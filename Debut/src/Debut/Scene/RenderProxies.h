@@ -0,0 +1,120 @@
+#pragma once
+
+#include <Debut/Core/Core.h>
+#include <Debut/Core/UUID.h>
+#include <Debut/Rendering/Structures/Frustum.h>
+
+#include <entt.hpp>
+#include <atomic>
+#include <glm/glm.hpp>
+#include <vector>
+
+/*
+	Packed mirror of the mesh renderers of a scene, one array per field, so that the renderer only iterates
+	contiguous data instead of going through the registry and the entity maps.
+
+	Proxies are added and removed through the signals of the registry, removals move the last proxy in the hole.
+	Update only refreshes the proxies that have been marked dirty, the ones that aren't static yet and the ones
+	with a parent, whose world matrix changes when any of their ancestors moves. Proxies are marked dirty when
+	their transform or mesh renderer is patched in the registry: engine code that modifies those components in
+	place must patch them (Entity::MarkChanged) or call MarkDirty. Scripts don't have to, the scene marks all the
+	proxies dirty after running them.
+
+	Proxies that haven't changed for a while are flagged as static. The static version changes every time the
+	set of static proxies does, so that the data built from them (like cached shadows) knows when to be rebuilt.
+
+	USAGE:
+		m_RenderProxies.Connect(m_Registry);
+
+		entity.Transform().Translation = position;
+		entity.MarkChanged<TransformComponent>();
+
+		m_RenderProxies.Update(m_Registry);
+		const RenderProxyArrays& proxies = m_RenderProxies.GetArrays();
+		for (uint32_t i = 0; i < proxies.Size(); i++)
+			if (frustum.TestAABB(proxies.LocalBounds[i], proxies.WorldMatrices[i])) ...
+*/
+
+namespace Debut
+{
+	namespace RenderProxyFlags
+	{
+		enum : uint32_t
+		{
+			None = 0,
+			Instanced = 1 << 0,
+			// Hasn't moved or changed for the last few frames
+			Static = 1 << 1,
+			// Flagged as an occluder by the designer
+			Occluder = 1 << 2
+		};
+	}
+
+	struct RenderProxyArrays
+	{
+		std::vector<glm::mat4> WorldMatrices;
+		// Bounds of the mesh, in mesh space
+		std::vector<AABB> LocalBounds;
+		// Box that contains the transformed local bounds, the extents are in world space and the center is 0
+		std::vector<AABB> WorldBounds;
+		std::vector<UUID> Meshes;
+		std::vector<UUID> Materials;
+		// Mesh rasterized by occluders, 0 if it's the same as the rendered one
+		std::vector<UUID> OccluderMeshes;
+		std::vector<uint32_t> Flags;
+		std::vector<int32_t> EntityIDs;
+		// Frames since the proxy last changed
+		std::vector<uint32_t> UnchangedFrames;
+
+		inline uint32_t Size() const { return (uint32_t)EntityIDs.size(); }
+
+		void PushBack(int32_t entityID);
+		// Moves the last proxy at the specified index
+		void RemoveAndSwap(uint32_t index);
+		void Clear();
+	};
+
+	class RenderProxies
+	{
+	public:
+		void Connect(entt::registry& registry);
+		void Disconnect(entt::registry& registry);
+
+		// Refreshes the matrices, the bounds and the handles of the proxies that might have changed
+		void Update(entt::registry& registry);
+		// The proxy of the entity is refreshed by the next Update
+		void MarkDirty(entt::entity entity);
+		void MarkAllDirty();
+		inline const RenderProxyArrays& GetArrays() const { return m_Arrays; }
+		// Unique between all the scenes
+		inline uint64_t GetStaticVersion() const { return m_StaticVersion; }
+
+	private:
+		void OnConstruct(entt::registry& registry, entt::entity entity);
+		void OnUpdate(entt::registry& registry, entt::entity entity);
+		void OnDestroy(entt::registry& registry, entt::entity entity);
+
+		// Returns true if the proxy must be refreshed again by the next Update, even if it isn't marked dirty
+		bool Refresh(entt::registry& registry, uint32_t index);
+		void MarkEntityDirty(uint32_t number);
+
+	private:
+		static const uint32_t s_NoProxy = 0xFFFFFFFF;
+		// Frames a proxy must stay unchanged before it's considered static
+		static const uint32_t s_StaticFrames = 8;
+
+		RenderProxyArrays m_Arrays;
+		// Index of the proxy of each entity, indexed by the entity number
+		std::vector<uint32_t> m_Indices;
+		// Numbers of the entities refreshed by the next Update. The flags tell which entities are in the list,
+		// indexed by the entity number
+		std::vector<uint32_t> m_Dirty;
+		std::vector<uint8_t> m_IsDirty;
+		// 1 for the entries of m_Dirty that stay in the list after the Update
+		std::vector<uint8_t> m_KeepDirty;
+
+		std::atomic<bool> m_StaticChanged = false;
+		uint64_t m_StaticVersion = 0;
+		static std::atomic<uint64_t> s_NextStaticVersion;
+	};
+}
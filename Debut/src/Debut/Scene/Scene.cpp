@@ -4,10 +4,14 @@
 #include <Debut/Scene/Entity.h>
 #include <Debut/Scene/Components.h>
 #include <Debut/Scene/SceneCamera.h>
+#include <Debut/Scene/SceneRenderState.h>
 #include <Debut/Rendering/Shader.h>
 #include <Debut/Rendering/Structures/FrameBuffer.h>
 #include <Debut/Rendering/Structures/ShadowMap.h>
+#include <Debut/Rendering/Structures/OcclusionBuffer.h>
 #include <Debut/Rendering/Renderer/RenderCommand.h>
+#include <Debut/Rendering/Renderer/RenderCommandBuffer.h>
+#include <Debut/Rendering/Renderer/SpriteQueue.h>
 #include <Debut/Rendering/Renderer/RendererDebug.h>
 #include <Debut/Rendering/Renderer/Renderer.h>
 #include "Debut/Rendering/Renderer/Renderer2D.h"
@@ -17,6 +21,7 @@
 #include <Debut/Physics/PhysicsSystem3D.h>
 #include <Debut/Rendering/Resources/Skybox.h>
 #include <Debut/Rendering/Structures/Frustum.h>
+#include <Debut/Core/JobSystem.h>
 #include <Debut/Utils/MathUtils.h>
 
 #include "box2d/b2_world.h"
@@ -44,10 +49,18 @@ namespace Debut
 	
 	Scene::Scene()
 	{
+		m_RenderProxies.Connect(m_Registry);
+		m_RenderQueue = CreateRef<RenderQueue>();
+		m_SpriteQueue = CreateRef<SpriteQueue>();
+		m_OcclusionBuffer = CreateRef<OcclusionBuffer>();
+		for (auto& state : m_RenderStates)
+			state = std::make_unique<SceneRenderState>();
 	}
 
 	Scene::~Scene()
 	{
+		WaitForSimulation();
+		m_RenderProxies.Disconnect(m_Registry);
 		delete m_PhysicsSystem3D;
 	}
 
@@ -174,38 +187,85 @@ namespace Debut
 		RenderingSetup(target);
 		// Clear frame buffer for mouse picking
 		target->ClearAttachment(1, -1);
+		// The editor modifies the components from everywhere, tracking each change isn't worth it there
+		m_RenderProxies.MarkAllDirty();
 		
 		// Flags
 		bool renderColliders = Renderer::GetConfig().RenderColliders;
 		glm::mat4 cameraTransform = glm::inverse(camera.GetView());
 
-		Rendering3D(camera, cameraTransform, target);
-		Rendering2D(camera, cameraTransform, target);
+		SceneRenderState& state = *m_RenderStates[0];
+		ExtractRenderState(state);
+		Rendering3D(state, camera, cameraTransform, target);
+		Rendering2D(state, camera, cameraTransform, target);
 	}
 	
 
 	void Scene::OnRuntimeUpdate(Timestep ts, Ref<FrameBuffer> target)
 	{
-		RenderingSetup(target);
-		// Clear frame buffer for mouse picking
-		target->ClearAttachment(1, -1);
-
-		// Update scripts
+		if (!m_Pipelined)
 		{
-			DBT_PROFILE_SCOPE("Scene: Script Update");
-			m_Registry.view<NativeScriptComponent>().each([=](auto entity, auto& nsc)
-				{
-					if (!nsc.Instance)
-					{
-						nsc.Instance = nsc.InstantiateScript();
-						nsc.Instance->m_Entity = { entity, this };
-						nsc.Instance->OnCreate();
-					}
+			UpdateScripts(ts);
+			UpdatePhysics(ts, m_SimulationTimings[0]);
 
-					nsc.Instance->OnUpdate(ts);
-				});
+			ExtractRenderState(*m_RenderStates[0]);
+			RenderFrame(*m_RenderStates[0], target);
+			return;
 		}
 
+		// The state extracted by the last simulation becomes the one to render, the other one can be overwritten
+		WaitForSimulation();
+		m_FrontRenderState = 1 - m_FrontRenderState;
+		SceneRenderState& front = *m_RenderStates[m_FrontRenderState];
+		SceneRenderState& back = *m_RenderStates[1 - m_FrontRenderState];
+		SimulationTimings& backTimings = m_SimulationTimings[1 - m_FrontRenderState];
+
+		// Scripts read the input, which is only available on the main thread
+		UpdateScripts(ts);
+		// Simulate the next frame while this one is rendered. The registry belongs to the job until it's done
+		JobSystem::Execute([this, ts, &back, &backTimings]()
+			{
+				DBT_PROFILE_SCOPE("Scene: Simulation");
+				UpdatePhysics(ts, backTimings);
+				ExtractRenderState(back);
+			}, &m_SimulationCounter);
+
+		RenderFrame(front, target);
+	}
+
+	void Scene::WaitForSimulation()
+	{
+		DBT_PROFILE_FUNCTION();
+		JobSystem::Wait(m_SimulationCounter);
+	}
+
+	void Scene::UpdateScripts(Timestep ts)
+	{
+		DBT_PROFILE_SCOPE("Scene: Script Update");
+		auto scripts = m_Registry.view<NativeScriptComponent>();
+		scripts.each([=](auto entity, auto& nsc)
+			{
+				if (!nsc.Instance)
+				{
+					nsc.Instance = nsc.InstantiateScript();
+					nsc.Instance->m_Entity = { entity, this };
+					nsc.Instance->OnCreate();
+				}
+
+				nsc.Instance->OnUpdate(ts);
+			});
+
+		// Scripts can modify the components of any entity in place, there's no telling which proxies changed
+		if (scripts.size() > 0)
+			m_RenderProxies.MarkAllDirty();
+	}
+
+	void Scene::UpdatePhysics(Timestep ts, SimulationTimings& timings)
+	{
+		// The profiler only sees the scopes of the frame thread, the timings are also measured here for when
+		// the simulation runs on a worker
+		uint64_t start = Instrumentor::GetTicks();
+
 		// Update physics
 		{
 			DBT_PROFILE_SCOPE("Scene: Physics2D Update");
@@ -226,9 +286,13 @@ namespace Debut
 
 				transform.Translation = { position.x, position.y, 0 };
 				transform.Rotation.z = body->GetAngle();
+				entity.MarkChanged<TransformComponent>();
 			}
 		}
 
+		uint64_t physics2DEnd = Instrumentor::GetTicks();
+		timings.Physics2D = (float)(Instrumentor::TicksToMicroseconds(physics2DEnd - start) / 1000.0);
+
 		// Update 3D physics
 		{
 			DBT_PROFILE_SCOPE("Scene: Physics3D update");
@@ -246,27 +310,88 @@ namespace Debut
 				m_PhysicsSystem3D->UpdateBody(entity.Transform(), body, *((BodyID*)body.RuntimeBody));
 				transform.Translation -= glm::vec3(glm::mat4(glm::quat(transform.Rotation)) *
 					glm::vec4(transform.Scale * body.ShapeOffset, 1.0f));
+				entity.MarkChanged<TransformComponent>();
 			}
 		}
 
-		// Render sprites
+		timings.Physics3D = (float)(Instrumentor::TicksToMicroseconds(Instrumentor::GetTicks() - physics2DEnd) / 1000.0);
+	}
+
+	void Scene::ExtractRenderState(SceneRenderState& state)
+	{
+		DBT_PROFILE_FUNCTION();
+		state.Clear();
+
 		// Find the main camera of the scene
 		Entity cameraEntity = GetPrimaryCameraEntity();
-
 		if (cameraEntity)
 		{
 			CameraComponent& cameraComp = cameraEntity.GetComponent<CameraComponent>();
-			SceneCamera* mainCamera = &cameraComp.Camera;
-			TransformComponent& transform = cameraEntity.Transform();
-			glm::mat4 cameraTransform;
+			glm::mat4 cameraTransform = cameraEntity.Transform().GetTransform();
+			cameraComp.Camera.SetView(glm::inverse(cameraTransform));
 
-			cameraTransform = transform.GetTransform();
-			mainCamera->SetView(glm::inverse(cameraTransform));
+			state.HasCamera = true;
+			state.Camera = cameraComp.Camera;
+			state.CameraTransform = cameraTransform;
+			state.PostProcessing = cameraComp.PostProcessing;
+		}
+
+		// The arrays keep their memory, copying them doesn't allocate after the first frames
+		m_RenderProxies.Update(m_Registry);
+		state.Meshes = m_RenderProxies.GetArrays();
+		state.StaticMeshesVersion = m_RenderProxies.GetStaticVersion();
+
+		// The entities are listed first, so that the transforms can be computed on the workers
+		auto sprites = m_Registry.group<TransformComponent, SpriteRendererComponent>();
+		for (auto entity : sprites)
+			state.Sprites.EntityIDs.push_back((int32_t)entity);
+		state.Sprites.Transforms.resize(state.Sprites.Size());
+		state.Sprites.Renderers.resize(state.Sprites.Size());
+
+		JobSystem::ParallelFor(state.Sprites.Size(), 256, [&](uint32_t start, uint32_t end)
+			{
+				for (uint32_t i = start; i < end; i++)
+				{
+					auto& [transform, sprite] = sprites.get<TransformComponent, SpriteRendererComponent>((entt::entity)state.Sprites.EntityIDs[i]);
+					state.Sprites.Transforms[i] = transform.GetTransform();
+					state.Sprites.Renderers[i] = sprite;
+				}
+			});
 
-			m_PostProcessingStack = AssetManager::Request<PostProcessingStack>(cameraComp.PostProcessing);
-			Rendering3D(*mainCamera, cameraTransform, target);
-			Rendering2D(*mainCamera, cameraTransform, target);
+		auto directionalLights = m_Registry.view<TransformComponent, DirectionalLightComponent>();
+		for (auto entity : directionalLights)
+			state.DirectionalLights.push_back(directionalLights.get<DirectionalLightComponent>(entity));
+		// A directional light with 0 intensity to override the previous one, if there were any
+		if (state.DirectionalLights.empty())
+		{
+			state.DirectionalLights.emplace_back();
+			state.DirectionalLights.back().Intensity = 0;
 		}
+
+		auto pointLights = m_Registry.view<TransformComponent, PointLightComponent>();
+		for (auto entity : pointLights)
+		{
+			auto& [transform, light] = pointLights.get<TransformComponent, PointLightComponent>(entity);
+			PointLightComponent& extracted = state.PointLights.emplace_back(light);
+
+			extracted.Position = transform.Translation;
+			if (transform.Parent)
+				extracted.Position = transform.Parent.Transform().GetTransform() * glm::vec4(transform.Translation, 1.0f);
+		}
+	}
+
+	void Scene::RenderFrame(SceneRenderState& state, Ref<FrameBuffer> target)
+	{
+		RenderingSetup(target);
+		// Clear frame buffer for mouse picking
+		target->ClearAttachment(1, -1);
+
+		if (!state.HasCamera)
+			return;
+
+		m_PostProcessingStack = AssetManager::Request<PostProcessingStack>(state.PostProcessing);
+		Rendering3D(state, state.Camera, state.CameraTransform, target);
+		Rendering2D(state, state.Camera, state.CameraTransform, target);
 	}
 
 	void Scene::OnEditorStart()
@@ -445,7 +570,7 @@ namespace Debut
 		m_PhysicsSystem3D->Begin();
 	}
 
-	void Scene::Rendering2D(SceneCamera& camera, const glm::mat4& cameraView, Ref<FrameBuffer> target)
+	void Scene::Rendering2D(SceneRenderState& state, SceneCamera& camera, const glm::mat4& cameraView, Ref<FrameBuffer> target)
 	{
 		Renderer2D::ResetStats();
 
@@ -456,12 +581,19 @@ namespace Debut
 			DBT_PROFILE_SCOPE("Rendering2D");
 			Renderer2D::BeginScene(camera, cameraView);
 
-			auto group = m_Registry.group<TransformComponent, SpriteRendererComponent>();
-			for (auto entity : group)
+			// Layers first, then back to front, then grouped by texture so that batches aren't split
+			glm::mat4 view = glm::inverse(cameraView);
+			m_SpriteQueue->Clear();
+			for (uint32_t i = 0; i < state.Sprites.Size(); i++)
 			{
-				auto& [transform, sprite] = group.get<TransformComponent, SpriteRendererComponent>(entity);
-				Renderer2D::DrawSprite(transform.GetTransform(), sprite, (int)entity);
+				const SpriteRendererComponent& renderer = state.Sprites.Renderers[i];
+				float distance = -(view * state.Sprites.Transforms[i][3]).z;
+				m_SpriteQueue->Push(SpriteQueue::MakeKey(renderer.SortLayer, renderer.OrderInLayer, distance, renderer.Texture));
 			}
+			m_SpriteQueue->Sort();
+
+			Renderer2D::DrawSprites(state.Sprites.Transforms.data(), state.Sprites.Renderers.data(), state.Sprites.EntityIDs.data(),
+				m_SpriteQueue->GetOrder().data(), state.Sprites.Size());
 
 			Renderer2D::EndScene();
 		}
@@ -469,62 +601,284 @@ namespace Debut
 		target->Unbind();
 	}
 
-	void Scene::Rendering3D(SceneCamera& camera, const glm::mat4& cameraTransform, Ref<FrameBuffer> target)
+	void Scene::Rendering3D(SceneRenderState& state, SceneCamera& camera, const glm::mat4& cameraTransform, Ref<FrameBuffer> target)
 	{
 		// Global variables
-		std::vector<ShaderUniform> globalUniforms = GetGlobalUniforms(cameraTransform[3]);
-		std::vector<LightComponent*> lights = GetLights();
+		const std::vector<ShaderUniform>& globalUniforms = GetGlobalUniforms(cameraTransform[3]);
+		FrameVector<LightComponent*> lights;
+		lights.reserve(state.DirectionalLights.size() + state.PointLights.size());
+		for (auto& light : state.DirectionalLights)
+			lights.push_back(&light);
+		for (auto& light : state.PointLights)
+			lights.push_back(&light);
 
 		Renderer3D::ResetStats();
 
 		// Render shadowmaps
-		for (auto light : lights)
+		RendererConfig config = Renderer::GetConfig();
+		m_ShadowFrame++;
+
+		// The shadow maps contain the last directional light that casts shadows
+		DirectionalLightComponent* shadowLight = nullptr;
+		for (auto& light : state.DirectionalLights)
+			if (light.CastShadows)
+				shadowLight = &light;
+
+		// Fit the cascades that are updated this frame
+		uint32_t updatedCascades = 0, skippedMaps = 0;
+		FrameVector<SceneCamera> shadowCameras(m_ShadowMaps.size());
+		if (shadowLight != nullptr)
 		{
-			if (light->CastShadows)
+			for (uint32_t i = 0; i < m_ShadowMaps.size(); i++)
 			{
-				if (light->Type == LightComponent::LightType::Directional)
+				// Far cascades keep the content of the previous frames, the index staggers their updates
+				uint32_t interval = i == 0 ? 1 : std::max(config.FarCascadeUpdateInterval, 1u);
+				if (m_ShadowMaps[i]->IsValid() && (m_ShadowFrame + i) % interval != 0)
 				{
-					DirectionalLightComponent* dirLight = (DirectionalLightComponent*)light;
-					DBT_PROFILE_SCOPE("ShadowPass");
+					skippedMaps++;
+					continue;
+				}
 
-					RenderCommand::DisableCulling();
-					for (uint32_t i = 0; i < m_ShadowMaps.size(); i++)
-					{
-						SceneCamera shadowCamera;
-						m_ShadowMaps[i]->SetFromCamera(camera, shadowCamera, dirLight->Direction);
-						m_ShadowMaps[i]->Bind();
+				m_ShadowMaps[i]->SetFromCamera(camera, shadowCameras[i], shadowLight->Direction);
+				updatedCascades |= 1 << i;
+			}
+		}
 
-						Renderer3D::BeginShadow(m_ShadowMaps[i], shadowCamera);
-						{
-							// Can I recycle this group to render stuff later on?
-							auto group3D = m_Registry.view<TransformComponent, MeshRendererComponent>();
-							for (auto entity : group3D)
-							{
-								auto& [transform, mesh] = group3D.get<TransformComponent, MeshRendererComponent>(entity);
-								Renderer3D::DrawModel(mesh, transform.GetTransform(), (int)entity);
-							}
-						}
-						Renderer3D::EndShadow();
-						m_ShadowMaps[i]->Unbind();
+		// The view and the casters of the cascades are culled in the same pass, the occluders only hide meshes from the view
+		bool occlusion = false;
+		if (config.OcclusionCulling)
+		{
+			// The meshes are tested against the occlusion buffer with the rest of the culling
+			DBT_PROFILE_SCOPE("Renderer3D::OcclusionCulling");
+			occlusion = RasterizeOccluders(state.Meshes, camera, cameraTransform[3], config.AutoOccluders);
+		}
+		float casterMaxZ[s_MaxShadowCascades];
+		ComputeVisibility(state.Meshes, Frustum(camera), updatedCascades, casterMaxZ, occlusion ? m_OcclusionBuffer.get() : nullptr);
+		m_OccluderMeshes.clear();
+
+		if (shadowLight != nullptr)
+		{
+			DBT_PROFILE_SCOPE("ShadowPass");
+			uint32_t staticUpdates = 0;
+
+			RenderCommand::DisableCulling();
+			for (uint32_t i = 0; i < m_ShadowMaps.size(); i++)
+			{
+				if (!(updatedCascades & (1 << i)))
+					continue;
+
+				Ref<ShadowMap> shadowMap = m_ShadowMaps[i];
+				SceneCamera& shadowCamera = shadowCameras[i];
+				uint8_t visibility = GetCascadeVisibility(i);
+				shadowMap->ExtendToCasters(casterMaxZ[i], shadowCamera);
+
+				if (config.CacheStaticShadows)
+				{
+					if (shadowMap->NeedsStaticUpdate(state.StaticMeshesVersion))
+					{
+						shadowMap->BindStaticLayer();
+						RenderCommand::ClearDepth();
+						RenderShadowCasters(shadowMap, shadowCamera, state.Meshes, visibility, RenderProxyFlags::Static, RenderProxyFlags::None);
+						shadowMap->EndStaticUpdate(state.StaticMeshesVersion);
+						staticUpdates++;
 					}
-					RenderCommand::EnableCulling();
+
+					// Dynamic casters are drawn on top of the static ones
+					shadowMap->RestoreStaticLayer();
+					shadowMap->Bind();
+					RenderShadowCasters(shadowMap, shadowCamera, state.Meshes, visibility, RenderProxyFlags::None, RenderProxyFlags::Static);
 				}
+				else
+				{
+					shadowMap->Bind();
+					RenderCommand::ClearDepth();
+					RenderShadowCasters(shadowMap, shadowCamera, state.Meshes, visibility, RenderProxyFlags::None, RenderProxyFlags::None);
+					shadowMap->InvalidateStaticLayer();
+				}
+
+				shadowMap->Unbind();
+				shadowMap->SetValid(true);
+			}
+			RenderCommand::EnableCulling();
+
+			Renderer3D::AddShadowCacheStats(skippedMaps, staticUpdates);
+		}
+		else
+		{
+			// Without shadows, the maps are cleared so that nothing is in shadow
+			for (auto& shadowMap : m_ShadowMaps)
+			{
+				shadowMap->Bind();
+				RenderCommand::ClearDepth();
+				shadowMap->Unbind();
+				shadowMap->SetValid(false);
 			}
 		}
 
+		RecordMeshes(state.Meshes, s_ViewVisibility);
+
 		target->Bind();
 		Renderer3D::BeginScene(camera, m_Skybox, cameraTransform, lights, globalUniforms, m_ShadowMaps);
 		{
 			DBT_PROFILE_SCOPE("Rendering3D");
-			auto group3D = m_Registry.view<TransformComponent, MeshRendererComponent>();
-			for (auto entity : group3D)
-			{
-				auto& [transform, mesh] = group3D.get<TransformComponent, MeshRendererComponent>(entity);
-				Renderer3D::DrawModel(mesh, transform.GetTransform(), (int)entity);
-			}
+			m_RenderQueue->Execute();
 		}
 		Renderer3D::EndScene();
 		target->Unbind();
+		m_RenderQueue->Clear();
+	}
+
+	void Scene::RenderShadowCasters(Ref<ShadowMap> shadowMap, SceneCamera& shadowCamera, const RenderProxyArrays& meshes,
+		uint8_t visibility, uint32_t requiredFlags, uint32_t excludedFlags)
+	{
+		RecordMeshes(meshes, visibility, requiredFlags, excludedFlags);
+
+		Renderer3D::BeginShadow(shadowMap, shadowCamera);
+		m_RenderQueue->Execute();
+		Renderer3D::EndShadow();
+		m_RenderQueue->Clear();
+	}
+
+	bool Scene::RasterizeOccluders(const RenderProxyArrays& meshes, SceneCamera& camera, const glm::vec3& cameraPosition, bool autoOccluders)
+	{
+		DBT_PROFILE_FUNCTION();
+		m_IsOccluder.assign(meshes.Size(), 0);
+
+		// Occluders are the flagged proxies and the static ones that look the biggest from the camera
+		Frustum frustum(camera);
+		FrameVector<std::pair<float, uint32_t>> candidates;
+		for (uint32_t i = 0; i < meshes.Size(); i++)
+		{
+			bool flagged = meshes.Flags[i] & RenderProxyFlags::Occluder;
+			if (!flagged && !(autoOccluders && (meshes.Flags[i] & RenderProxyFlags::Static)))
+				continue;
+
+			const AABB& bounds = meshes.WorldBounds[i];
+			glm::vec3 center = (bounds.MinExtents + bounds.MaxExtents) * 0.5f;
+			float size = glm::length(bounds.MaxExtents - bounds.MinExtents) / std::max(glm::length(center - cameraPosition), 0.001f);
+			if ((!flagged && size < s_MinAutoOccluderSize) || !frustum.TestAABB(meshes.LocalBounds[i], meshes.WorldMatrices[i]))
+				continue;
+
+			candidates.push_back({ flagged ? std::numeric_limits<float>::max() : size, i });
+		}
+		std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+		m_OcclusionBuffer->Begin(camera.GetProjection() * camera.GetView());
+		for (auto& candidate : candidates)
+		{
+			if (m_OcclusionBuffer->GetOccluderCount() == s_MaxOccluders)
+				break;
+
+			uint32_t i = candidate.second;
+			bool flagged = meshes.Flags[i] & RenderProxyFlags::Occluder;
+			Ref<Mesh> mesh = AssetManager::Request<Mesh>(meshes.OccluderMeshes[i] != 0 ? meshes.OccluderMeshes[i] : meshes.Meshes[i]);
+			if (mesh == nullptr || !mesh->IsValid() || mesh->GetIndices().empty())
+				continue;
+			// Detailed meshes cost more to rasterize than what they hide
+			if (!flagged && mesh->GetIndices().size() / 3 > s_MaxAutoOccluderTriangles)
+				continue;
+
+			m_OccluderMeshes.push_back(mesh);
+			m_OcclusionBuffer->AddOccluder(mesh->GetPositions().data(), mesh->GetIndices().data(), (uint32_t)mesh->GetIndices().size(),
+				meshes.WorldMatrices[i] * mesh->GetTransform());
+			m_IsOccluder[i] = 1;
+		}
+
+		if (m_OcclusionBuffer->GetOccluderCount() == 0)
+			return false;
+
+		m_OcclusionBuffer->Rasterize();
+		return true;
+	}
+
+	void Scene::ComputeVisibility(const RenderProxyArrays& meshes, const Frustum& viewFrustum, uint32_t cascades, float* casterMaxZ,
+		const OcclusionBuffer* occlusion)
+	{
+		DBT_PROFILE_FUNCTION();
+		DBT_CORE_ASSERT(m_ShadowMaps.size() <= s_MaxShadowCascades, "Too many shadow cascades");
+
+		// Copied so that the workers don't touch the shadow maps
+		uint32_t nCascades = (uint32_t)m_ShadowMaps.size();
+		ShadowCasterVolume volumes[s_MaxShadowCascades];
+		for (uint32_t c = 0; c < nCascades; c++)
+		{
+			volumes[c] = m_ShadowMaps[c]->GetCasterVolume();
+			casterMaxZ[c] = std::numeric_limits<float>::lowest();
+		}
+
+		std::mutex depthMutex;
+		uint32_t occluded = 0;
+		m_Visibility.resize(meshes.Size());
+
+		// The frame profiler only sees the scopes of the frame thread, the whole pass is measured from here
+		DBT_PROFILE_SCOPE("Renderer3D::Culling");
+		JobSystem::ParallelFor(meshes.Size(), 64, [&](uint32_t start, uint32_t end)
+			{
+				Frustum batchFrustum = viewFrustum;
+				float batchMaxZ[s_MaxShadowCascades];
+				std::fill(batchMaxZ, batchMaxZ + nCascades, std::numeric_limits<float>::lowest());
+				uint32_t batchOccluded = 0;
+
+				for (uint32_t i = start; i < end; i++)
+				{
+					uint8_t visibility = 0;
+					if (batchFrustum.TestAABB(meshes.LocalBounds[i], meshes.WorldMatrices[i]))
+						visibility |= s_ViewVisibility;
+
+					// The occluders are in the buffer, they'd hide themselves
+					if ((visibility & s_ViewVisibility) && occlusion != nullptr && !m_IsOccluder[i] &&
+						!occlusion->TestAABB(meshes.LocalBounds[i], meshes.WorldMatrices[i]))
+					{
+						visibility &= ~s_ViewVisibility;
+						batchOccluded++;
+					}
+
+					// Casters are kept if their shadow can fall in the slice of the view covered by the cascade
+					for (uint32_t c = 0; c < nCascades; c++)
+					{
+						float maxZ;
+						if ((cascades & (1 << c)) && volumes[c].TestAABB(meshes.LocalBounds[i], meshes.WorldMatrices[i], maxZ))
+						{
+							visibility |= GetCascadeVisibility(c);
+							batchMaxZ[c] = std::max(batchMaxZ[c], maxZ);
+						}
+					}
+
+					m_Visibility[i] = visibility;
+				}
+
+				std::lock_guard<std::mutex> lock(depthMutex);
+				for (uint32_t c = 0; c < nCascades; c++)
+					casterMaxZ[c] = std::max(casterMaxZ[c], batchMaxZ[c]);
+				occluded += batchOccluded;
+			});
+
+		if (occlusion != nullptr)
+			Renderer3D::AddOcclusionStats(occlusion->GetOccluderCount(), occlusion->GetTriangleCount(), occluded);
+	}
+
+	void Scene::RecordMeshes(const RenderProxyArrays& meshes, uint8_t visibility, uint32_t requiredFlags, uint32_t excludedFlags)
+	{
+		DBT_PROFILE_FUNCTION();
+
+		// Workers only read the extracted state: the assets are resolved by the render thread when the commands
+		// are replayed
+		JobSystem::ParallelFor(meshes.Size(), 64, [&](uint32_t start, uint32_t end)
+			{
+				RenderCommandBuffer& buffer = m_RenderQueue->GetThreadBuffer();
+
+				for (uint32_t i = start; i < end; i++)
+				{
+					if (!(m_Visibility[i] & visibility))
+						continue;
+					if ((meshes.Flags[i] & requiredFlags) != requiredFlags || (meshes.Flags[i] & excludedFlags) != 0)
+						continue;
+
+					buffer.DrawMesh(RenderQueue::MakeDrawKey(meshes.Materials[i], meshes.Meshes[i]), meshes.Meshes[i],
+						meshes.Materials[i], meshes.WorldMatrices[i], meshes.EntityIDs[i],
+						meshes.Flags[i] & RenderProxyFlags::Instanced);
+				}
+			});
 	}
 
 	void Scene::RenderColliders(SceneCamera& camera, const glm::mat4& cameraView)
@@ -592,17 +946,13 @@ namespace Debut
 		RenderCommand::SetClearColor(glm::vec4(0.2, 0.2, 0.4, 1));
 		RenderCommand::Clear();
 		frameBuffer->Unbind();
-
-		for (uint32_t i = 0; i < m_ShadowMaps.size(); i++)
-		{
-			m_ShadowMaps[i]->Bind();
-			RenderCommand::ClearDepth();
-			m_ShadowMaps[i]->Unbind();
-		}
+		// Shadow maps are cleared by the shadow pass: the cached ones keep their content between frames
 	}
 
 	void Scene::OnRuntimeStop()
 	{
+		// The simulation job might still be stepping the physics
+		WaitForSimulation();
 		m_Playing = false;
 
 		delete m_PhysicsWorld2D;
@@ -776,65 +1126,29 @@ namespace Debut
 		return newScene;
 	}
 
-	std::vector<ShaderUniform> Scene::GetGlobalUniforms(glm::vec3 cameraPos)
+	const std::vector<ShaderUniform>& Scene::GetGlobalUniforms(glm::vec3 cameraPos)
 	{
-		std::vector<ShaderUniform> ret;
-		ShaderUniform::UniformData data;
-
-		// Vectors and transforms
-		data = cameraPos;
-		ret.push_back(ShaderUniform("u_CameraPosition", ShaderDataType::Float3, data));
-
-		// Ambient light
-		data = m_AmbientLight;
-		ret.push_back(ShaderUniform("u_AmbientLightColor", ShaderDataType::Float3, data));
-		// Ambient light intensity
-		data = m_AmbientLightIntensity;
-		ret.push_back(ShaderUniform("u_AmbientLightIntensity", ShaderDataType::Float, data));
-
-		// Shadow fading
-		data = fadeoutStartDistance;
-		ret.push_back(ShaderUniform("u_ShadowFadeoutStart", ShaderDataType::Float, data));
-		data = fadeoutEndDistance;
-		ret.push_back(ShaderUniform("u_ShadowFadeoutEnd", ShaderDataType::Float, data));
-
-		return ret;
-	}
-
-	std::vector<LightComponent*> Scene::GetLights()
-	{
-		std::vector<LightComponent*> lights;
-		// Get directional light
-		auto lightGroup = m_Registry.view<TransformComponent, DirectionalLightComponent>();
-		bool full = false;
-		for (auto entity : lightGroup)
+		if (m_GlobalUniforms.size() == 0)
 		{
-			auto& [transform, light] = lightGroup.get<TransformComponent, DirectionalLightComponent>(entity);
-			lights.push_back(&light);
-			full = true;
-		}
-		// A directional light with 0 intensity to override the previous one, if there were any
-		DirectionalLightComponent tmpDirLight;
-		if (!full)
-		{
-			tmpDirLight.Intensity = 0;
-			lights.push_back(&tmpDirLight);
+			m_GlobalUniforms = {
+				// Vectors and transforms
+				ShaderUniform("u_CameraPosition", ShaderDataType::Float3, glm::vec3(0.0f)),
+				// Ambient light
+				ShaderUniform("u_AmbientLightColor", ShaderDataType::Float3, glm::vec3(0.0f)),
+				ShaderUniform("u_AmbientLightIntensity", ShaderDataType::Float, 0.0f),
+				// Shadow fading
+				ShaderUniform("u_ShadowFadeoutStart", ShaderDataType::Float, 0.0f),
+				ShaderUniform("u_ShadowFadeoutEnd", ShaderDataType::Float, 0.0f)
+			};
 		}
 
-		// Point lights
-		auto pointLights = m_Registry.view<TransformComponent, PointLightComponent>();
-		for (auto entity : pointLights)
-		{
-			auto& [transform, light] = pointLights.get<TransformComponent, PointLightComponent>(entity);
-			glm::vec3 translation = transform.Translation;
-			// Update light position
-			if (transform.Parent)
-				translation = transform.Parent.Transform().GetTransform() * glm::vec4(translation, 1.0f);
-			light.Position = translation;
-			lights.push_back(&light);
-		}
+		m_GlobalUniforms[0].Data = cameraPos;
+		m_GlobalUniforms[1].Data = m_AmbientLight;
+		m_GlobalUniforms[2].Data = m_AmbientLightIntensity;
+		m_GlobalUniforms[3].Data = fadeoutStartDistance;
+		m_GlobalUniforms[4].Data = fadeoutEndDistance;
 
-		return lights;
+		return m_GlobalUniforms;
 	}
 
 	void Scene::OnViewportResize(uint32_t width, uint32_t height)
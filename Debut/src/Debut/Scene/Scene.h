@@ -6,6 +6,9 @@
 
 #include <Debut/Core/Core.h>
 #include <Debut/Core/UUID.h>
+#include <Debut/Core/FrameAllocator.h>
+#include <Debut/Core/JobSystem.h>
+#include <Debut/Scene/RenderProxies.h>
 #include "Debut/Core/Time.h"
 
 class b2World;
@@ -13,7 +16,6 @@ class b2World;
 namespace Debut
 {
 	struct EntitySceneNode;
-	struct LightComponent;
 	struct ShaderUniform;
 
 	class SceneCamera;
@@ -22,6 +24,19 @@ namespace Debut
 	class PhysicsSystem3D;
 	class ShadowMap;
 	class PostProcessingStack;
+	class RenderQueue;
+	class SpriteQueue;
+	class Frustum;
+	class OcclusionBuffer;
+	class Mesh;
+	struct SceneRenderState;
+
+	// Milliseconds spent in the steps of a simulation
+	struct SimulationTimings
+	{
+		float Physics2D = 0.0f;
+		float Physics3D = 0.0f;
+	};
 
 	class Scene
 	{
@@ -43,10 +58,20 @@ namespace Debut
 		void OnRuntimeStart();
 		void OnRuntimeUpdate(Timestep ts, Ref<FrameBuffer> target);
 		void OnRuntimeStop();
+
+		// In pipelined mode, OnRuntimeUpdate renders the state of the previous frame while a job simulates the
+		// current one. The registry belongs to that job until the next OnRuntimeUpdate: code that accesses the
+		// scene in the meantime must call WaitForSimulation first
+		inline void SetPipelined(bool pipelined) { WaitForSimulation(); m_Pipelined = pipelined; }
+		inline bool IsPipelined() { return m_Pipelined; }
+		void WaitForSimulation();
+		// Timings of the simulation that produced the last rendered frame. In pipelined mode it ran on a worker
+		// during the previous frame, so its scopes aren't part of the frames of the profiler
+		inline SimulationTimings GetSimulationTimings() { return m_SimulationTimings[m_Pipelined ? m_FrontRenderState : 0]; }
 		
 		void RenderingSetup(Ref<FrameBuffer> target);
-		void Rendering2D(SceneCamera& camera, const glm::mat4& cameraTransform, Ref<FrameBuffer> target);
-		void Rendering3D(SceneCamera& camera, const glm::mat4& cameraTransform, Ref<FrameBuffer> target);
+		void Rendering2D(SceneRenderState& state, SceneCamera& camera, const glm::mat4& cameraTransform, Ref<FrameBuffer> target);
+		void Rendering3D(SceneRenderState& state, SceneCamera& camera, const glm::mat4& cameraTransform, Ref<FrameBuffer> target);
 		void RenderColliders(SceneCamera& camera, const glm::mat4& cameraTransform);
 
 		Entity CreateEmptyEntity();
@@ -64,18 +89,38 @@ namespace Debut
 		inline float GetAmbientLightIntensity() { return m_AmbientLightIntensity; }
 		inline glm::vec2 GetViewportSize() { return { m_ViewportWidth, m_ViewportHeight }; }
 		inline std::vector<Ref<ShadowMap>> GetShadowMaps() { return m_ShadowMaps; }
+		// In pipelined mode, call WaitForSimulation first
+		inline const RenderProxyArrays& GetRenderProxies() const { return m_RenderProxies.GetArrays(); }
 
 		void SetSkybox(UUID path);
 		inline void SetAmbientLight(glm::vec3 light) { m_AmbientLight = light; }
 		inline void SetAmbientLightIntensity(float light) { m_AmbientLightIntensity = light; }
 
 		static Ref<Scene> Copy(Ref<Scene> other);
-		std::vector<ShaderUniform> GetGlobalUniforms(glm::vec3 cameraPos);
-		std::vector<LightComponent*> GetLights();
+		const std::vector<ShaderUniform>& GetGlobalUniforms(glm::vec3 cameraPos);
+		// Copies what the renderer needs from the registry. In pipelined mode, call WaitForSimulation first
+		void ExtractRenderState(SceneRenderState& state);
 
 	private:
 		template<typename T>
 		void OnComponentAdded(T& component, Entity entity);
+		void UpdateScripts(Timestep ts);
+		void UpdatePhysics(Timestep ts, SimulationTimings& timings);
+		void RenderFrame(SceneRenderState& state, Ref<FrameBuffer> target);
+		// Chooses the occluders of the frame and rasterizes them in the occlusion buffer, returns false if there
+		// aren't any
+		bool RasterizeOccluders(const RenderProxyArrays& meshes, SceneCamera& camera, const glm::vec3& cameraPosition, bool autoOccluders);
+		// Culls the proxies against the view and the casters volumes of the cascades, the results are stored in
+		// m_Visibility. The light space depth of the closest caster of each cascade is returned in casterMaxZ.
+		// If an occlusion buffer is specified, the meshes hidden by the occluders aren't visible from the view
+		void ComputeVisibility(const RenderProxyArrays& meshes, const Frustum& viewFrustum, uint32_t cascades, float* casterMaxZ,
+			const OcclusionBuffer* occlusion);
+		// Only the visible meshes that have all the required flags and none of the excluded ones are recorded
+		void RecordMeshes(const RenderProxyArrays& meshes, uint8_t visibility, uint32_t requiredFlags = 0, uint32_t excludedFlags = 0);
+		void RenderShadowCasters(Ref<ShadowMap> shadowMap, SceneCamera& shadowCamera, const RenderProxyArrays& meshes,
+			uint8_t visibility, uint32_t requiredFlags, uint32_t excludedFlags);
+
+		static inline uint8_t GetCascadeVisibility(uint32_t cascade) { return (uint8_t)(1 << (cascade + 1)); }
 
 	private:
 		entt::registry m_Registry;
@@ -83,6 +128,7 @@ namespace Debut
 		uint32_t m_ViewportWidth = 0;
 		uint32_t m_ViewportHeight = 0;
 		bool m_Playing = false;
+		bool m_Pipelined = false;
 
 		// Physics
 		b2World* m_PhysicsWorld2D = nullptr;		
@@ -93,6 +139,36 @@ namespace Debut
 		glm::vec3 m_AmbientLight = glm::vec3(0.0f);
 		float m_AmbientLightIntensity = 1.0f;
 		std::vector<Ref<ShadowMap>> m_ShadowMaps;
+		// Used to stagger the updates of the far cascades
+		uint64_t m_ShadowFrame = 0;
+		// Visibility of each render proxy: the first bit is the view, the others are the cascades
+		std::vector<uint8_t> m_Visibility;
+		static const uint8_t s_ViewVisibility = 1;
+		static const uint32_t s_MaxShadowCascades = 7;
+		// Occlusion culling
+		Ref<OcclusionBuffer> m_OcclusionBuffer;
+		// Kept so that the geometry of the occluders stays valid while it's rasterized
+		std::vector<Ref<Mesh>> m_OccluderMeshes;
+		// 1 for the proxies that are occluders in the current frame, they're not tested against the buffer
+		std::vector<uint8_t> m_IsOccluder;
+		static const uint32_t s_MaxOccluders = 64;
+		// Automatic occluders can't have more triangles than this, and must be at least this big on screen
+		static const uint32_t s_MaxAutoOccluderTriangles = 1024;
+		static constexpr float s_MinAutoOccluderSize = 0.25f;
+		// Only the values change between frames, the uniforms are created once
+		std::vector<ShaderUniform> m_GlobalUniforms;
+		// Packed copy of the mesh renderers, kept in sync with the registry
+		RenderProxies m_RenderProxies;
+		// Draws of the current pass, recorded by the workers
+		Ref<RenderQueue> m_RenderQueue;
+		// Submission order of the sprites
+		Ref<SpriteQueue> m_SpriteQueue;
+		// Double buffered in pipelined mode: one is rendered while the simulation extracts the other one
+		Scope<SceneRenderState> m_RenderStates[2];
+		uint32_t m_FrontRenderState = 0;
+		JobCounter m_SimulationCounter;
+		// Written by the simulation along with the render state of the same index
+		SimulationTimings m_SimulationTimings[2];
 
 		// Other
 		Ref<PostProcessingStack> m_PostProcessingStack;
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Debut/Core/Core.h>
+#include <Debut/Core/UUID.h>
+#include <Debut/Scene/Components.h>
+#include <Debut/Scene/SceneCamera.h>
+#include <Debut/Scene/RenderProxies.h>
+
+#include <glm/glm.hpp>
+#include <vector>
+
+/*
+	Copy of the data of a scene that is needed to render a frame. It's extracted from the registry once the
+	simulation of the frame is over, so that the renderer never reads the registry: in pipelined mode the
+	simulation of the next frame modifies the registry while this state is being rendered.
+*/
+
+namespace Debut
+{
+	// Sprites of the frame, one array per field so that the vertices can be built from packed transforms
+	struct RenderedSprites
+	{
+		std::vector<glm::mat4> Transforms;
+		std::vector<SpriteRendererComponent> Renderers;
+		std::vector<int32_t> EntityIDs;
+
+		inline uint32_t Size() const { return (uint32_t)EntityIDs.size(); }
+
+		void Clear()
+		{
+			Transforms.clear();
+			Renderers.clear();
+			EntityIDs.clear();
+		}
+	};
+
+	struct SceneRenderState
+	{
+		// False if the scene didn't have a camera to render from
+		bool HasCamera = false;
+		SceneCamera Camera;
+		glm::mat4 CameraTransform = glm::mat4(1.0f);
+		UUID PostProcessing = 0;
+
+		// Copy of the render proxies of the scene
+		RenderProxyArrays Meshes;
+		uint64_t StaticMeshesVersion = 0;
+		RenderedSprites Sprites;
+
+		// There's always at least a directional light, with 0 intensity if the scene doesn't have any
+		std::vector<DirectionalLightComponent> DirectionalLights;
+		std::vector<PointLightComponent> PointLights;
+
+		// Keeps the memory, so that the next extractions don't allocate
+		void Clear()
+		{
+			HasCamera = false;
+			PostProcessing = 0;
+
+			Meshes.Clear();
+			Sprites.Clear();
+			DirectionalLights.clear();
+			PointLights.clear();
+		}
+	};
+}
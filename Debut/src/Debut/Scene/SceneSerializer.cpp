@@ -101,6 +101,8 @@ namespace Debut
 		out << YAML::Key << "Color" << YAML::Value << s.Color;
 		out << YAML::Key << "Texture" << YAML::Value << s.Texture;
 		out << YAML::Key << "TilingFactor" << YAML::Value << s.TilingFactor;
+		out << YAML::Key << "SortLayer" << YAML::Value << s.SortLayer;
+		out << YAML::Key << "OrderInLayer" << YAML::Value << s.OrderInLayer;
 	}
 
 	static void SerializeComponent(const MeshRendererComponent& s, YAML::Emitter& out)
@@ -108,6 +110,8 @@ namespace Debut
 		out << YAML::Key << "Mesh" << YAML::Value << s.Mesh;
 		out << YAML::Key << "Material" << YAML::Value << s.Material;
 		out << YAML::Key << "Instanced" << YAML::Value << s.Instanced;
+		out << YAML::Key << "Occluder" << YAML::Value << s.Occluder;
+		out << YAML::Key << "OccluderMesh" << YAML::Value << s.OccluderMesh;
 	}
 
 	static void SerializeComponent(const Rigidbody2DComponent& c, YAML::Emitter& out)
@@ -267,6 +271,19 @@ namespace Debut
 		sc.Color = in["Color"].as<glm::vec4>();
 		if (in["Texture"]) sc.Texture = in["Texture"].as<uint64_t>();
 		if (in["TilingFactor"])		sc.TilingFactor = in["TilingFactor"].as<float>();
+		if (in["SortLayer"])		sc.SortLayer = in["SortLayer"].as<int>();
+		if (in["OrderInLayer"])		sc.OrderInLayer = in["OrderInLayer"].as<int>();
+
+		// The sort keys of the sprites can't hold larger values
+		int sortLayer = std::clamp(sc.SortLayer, SpriteRendererComponent::MinSortLayer, SpriteRendererComponent::MaxSortLayer);
+		int orderInLayer = std::clamp(sc.OrderInLayer, SpriteRendererComponent::MinOrderInLayer, SpriteRendererComponent::MaxOrderInLayer);
+		if (sortLayer != sc.SortLayer || orderInLayer != sc.OrderInLayer)
+		{
+			Log.CoreWarn("The sort layer ({0}) or the order in layer ({1}) of a sprite renderer is out of range, it's been clamped",
+				sc.SortLayer, sc.OrderInLayer);
+			sc.SortLayer = sortLayer;
+			sc.OrderInLayer = orderInLayer;
+		}
 	}
 
 	template<>
@@ -279,6 +296,8 @@ namespace Debut
 		UUID mesh = in["Mesh"].as<uint64_t>();
 
 		MeshRendererComponent& mr = e.AddComponent<MeshRendererComponent>(mesh, material, e.ID(), instanced);
+		if (in["Occluder"])			mr.Occluder = in["Occluder"].as<bool>();
+		if (in["OccluderMesh"])		mr.OccluderMesh = in["OccluderMesh"].as<uint64_t>();
 	}
 
 	template<>
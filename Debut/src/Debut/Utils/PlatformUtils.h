@@ -11,4 +11,25 @@ namespace Debut
 		static std::string OpenFile(const char* filter);
 		static std::string SaveFile(const char* filter);
 	};
+
+	// Read only memory mapping of a whole file
+	class MappedFile
+	{
+	public:
+		MappedFile(const std::string& path);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		inline bool IsValid() const { return m_Data != nullptr; }
+		inline const uint8_t* GetData() const { return m_Data; }
+		inline size_t GetSize() const { return m_Size; }
+
+	private:
+		void* m_File = nullptr;
+		void* m_Mapping = nullptr;
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+	};
 }
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "Debut/dbtpch.h"
+#include "NullBuffer.h"
+#include "NullRendererAPI.h"
+#include <Debut/Rendering/Renderer/Renderer.h>
+
+namespace Debut
+{
+	////////////////////////////////////////////////////// VERTEX BUFFER /////////////////////////////////////////////////////
+
+	NullVertexBuffer::NullVertexBuffer(float* vertices, unsigned int count)
+	{
+		m_RendererID = NullRendererAPI::GenerateID();
+		NullRendererAPI::CreateResource();
+		NullRendererAPI::Upload(sizeof(float) * count);
+		m_GPUMemory.Resize(sizeof(float) * count);
+	}
+
+	NullVertexBuffer::NullVertexBuffer(uint32_t size) : m_Dynamic(true)
+	{
+		m_Data.reserve(size);
+		m_CPUMemory.Resize(m_Data.capacity());
+	}
+
+	void NullVertexBuffer::SetData(const void* data, uint32_t size)
+	{
+		if (m_Dynamic)
+			m_Allocation = Renderer::GetDynamicGeometry()->Allocate(data, size);
+		else
+			NullRendererAPI::Upload(size);
+	}
+
+	void NullVertexBuffer::PushData(const void* data, uint32_t size)
+	{
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+		m_Data.insert(m_Data.end(), bytes, bytes + size);
+		m_CPUMemory.Resize(m_Data.capacity());
+	}
+
+	void NullVertexBuffer::SubmitData()
+	{
+		if (m_Data.size() == 0)
+			return;
+
+		SetData(m_Data.data(), (uint32_t)m_Data.size());
+		m_Data.clear();
+	}
+
+	void NullVertexBuffer::SetSubData(const void* data, uint32_t size, uint32_t offset)
+	{
+		DBT_CORE_ASSERT(!m_Dynamic, "Dynamic buffers can only be updated as a whole");
+		NullRendererAPI::Upload(size);
+	}
+
+	void NullVertexBuffer::CopySubData(const Ref<VertexBuffer>& source, uint32_t sourceOffset, uint32_t offset, uint32_t size)
+	{
+		DBT_CORE_ASSERT(!m_Dynamic, "Dynamic buffers can only be updated as a whole");
+		// Copies stay in GPU memory
+		NullRendererAPI::Call();
+	}
+
+	uint32_t NullVertexBuffer::GetRendererID() const
+	{
+		if (!m_Dynamic)
+			return m_RendererID;
+		return m_Allocation.RendererID != 0 ? m_Allocation.RendererID : Renderer::GetDynamicGeometry()->GetRendererID();
+	}
+
+	uint32_t NullVertexBuffer::GetOffset() const
+	{
+		return m_Dynamic ? m_Allocation.Offset : 0;
+	}
+
+	void NullVertexBuffer::Bind() const
+	{
+		NullRendererAPI::Call();
+	}
+
+	void NullVertexBuffer::Unbind() const
+	{
+		NullRendererAPI::Call();
+	}
+
+	////////////////////////////////////////////////////// INDEX BUFFER /////////////////////////////////////////////////////
+
+	NullIndexBuffer::NullIndexBuffer(int* indices, unsigned int count)
+	{
+		m_RendererID = NullRendererAPI::GenerateID();
+		NullRendererAPI::CreateResource();
+		NullRendererAPI::Upload(sizeof(int) * count);
+
+		m_Count = count;
+		m_GPUMemory.Resize(sizeof(int) * count);
+	}
+
+	NullIndexBuffer::NullIndexBuffer()
+	{
+		m_RendererID = NullRendererAPI::GenerateID();
+		NullRendererAPI::CreateResource();
+
+		m_Count = 0;
+	}
+
+	void NullIndexBuffer::Bind() const
+	{
+		NullRendererAPI::Call();
+	}
+
+	void NullIndexBuffer::Unbind() const
+	{
+		NullRendererAPI::Call();
+	}
+
+	void NullIndexBuffer::SetData(const void* data, uint32_t count)
+	{
+		NullRendererAPI::Upload(sizeof(int) * count);
+		m_Count = count;
+		m_GPUMemory.Resize(sizeof(int) * count);
+	}
+
+	void NullIndexBuffer::SetSubData(const void* data, uint32_t count, uint32_t first)
+	{
+		NullRendererAPI::Upload(sizeof(int) * count);
+	}
+
+	void NullIndexBuffer::CopySubData(const Ref<IndexBuffer>& source, uint32_t sourceFirst, uint32_t first, uint32_t count)
+	{
+		NullRendererAPI::Call();
+	}
+}
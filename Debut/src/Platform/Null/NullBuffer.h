@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Debut/Rendering/Structures/Buffer.h"
+#include "Debut/Rendering/Structures/BufferArena.h"
+#include "Debut/Core/MemoryTracker.h"
+
+namespace Debut
+{
+	////////////////////////////////////////////////////// VERTEX BUFFER /////////////////////////////////////////////////////
+	class NullVertexBuffer : public VertexBuffer
+	{
+	public:
+		NullVertexBuffer(uint32_t size);
+		NullVertexBuffer(float* vertices, unsigned int count);
+		virtual ~NullVertexBuffer() = default;
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		virtual void SetData(const void* data, uint32_t size) override;
+		virtual void PushData(const void* data, uint32_t size) override;
+		virtual void SubmitData() override;
+		virtual void SetSubData(const void* data, uint32_t size, uint32_t offset) override;
+		virtual void CopySubData(const Ref<VertexBuffer>& source, uint32_t sourceOffset, uint32_t offset, uint32_t size) override;
+
+		virtual uint32_t GetRendererID() const override;
+		virtual uint32_t GetOffset() const override;
+
+		virtual inline void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+		virtual inline BufferLayout& GetLayout() override { return m_Layout; }
+	private:
+		BufferLayout m_Layout;
+		uint32_t m_RendererID = 0;
+
+		bool m_Dynamic = false;
+		BufferAllocation m_Allocation;
+
+		// The pushed data is still copied, so that batching costs the same as with a real backend
+		std::vector<unsigned char> m_Data;
+
+		TrackedMemory m_GPUMemory = { MemoryType::GPU };
+		TrackedMemory m_CPUMemory = { MemoryType::CPU };
+	};
+
+	////////////////////////////////////////////////////// INDEX BUFFER /////////////////////////////////////////////////////
+
+	class NullIndexBuffer : public IndexBuffer
+	{
+	public:
+		NullIndexBuffer(int* indices, unsigned int count);
+		NullIndexBuffer();
+		virtual ~NullIndexBuffer() = default;
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		virtual inline uint32_t GetCount() const override { return m_Count; }
+		virtual inline uint32_t GetRendererID() const override { return m_RendererID; }
+
+		virtual void SetData(const void* data, uint32_t count) override;
+		virtual void SetSubData(const void* data, uint32_t count, uint32_t first) override;
+		virtual void CopySubData(const Ref<IndexBuffer>& source, uint32_t sourceFirst, uint32_t first, uint32_t count) override;
+	private:
+		uint32_t m_RendererID;
+		uint32_t m_Count;
+
+		TrackedMemory m_GPUMemory = { MemoryType::GPU };
+	};
+}
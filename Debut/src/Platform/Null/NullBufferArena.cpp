@@ -0,0 +1,23 @@
+#include "Debut/dbtpch.h"
+#include "NullBufferArena.h"
+#include "NullRendererAPI.h"
+
+namespace Debut
+{
+	NullBufferArena::NullBufferArena(uint32_t regionSize)
+	{
+		m_MinRegionSize = regionSize;
+		Resize(regionSize);
+	}
+
+	uint32_t NullBufferArena::CreateStorage(uint64_t size)
+	{
+		NullRendererAPI::CreateResource();
+		return NullRendererAPI::GenerateID();
+	}
+
+	void NullBufferArena::Upload(uint64_t offset, const void* data, uint32_t size)
+	{
+		NullRendererAPI::Upload(size);
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <Debut/Rendering/Structures/BufferArena.h>
+
+namespace Debut
+{
+	class NullBufferArena : public BufferArena
+	{
+	public:
+		NullBufferArena(uint32_t regionSize);
+		virtual ~NullBufferArena() = default;
+
+	protected:
+		virtual uint32_t CreateStorage(uint64_t size) override;
+		virtual void Upload(uint64_t offset, const void* data, uint32_t size) override;
+		virtual void EndRegion(uint32_t region) override {}
+		// There's no GPU to wait for
+		virtual bool BeginRegion(uint32_t region) override { return false; }
+	};
+}
@@ -0,0 +1,112 @@
+#include "Debut/dbtpch.h"
+#include "NullFrameBuffer.h"
+#include "NullRendererAPI.h"
+
+namespace Debut
+{
+	static const unsigned int MAX_FRAME_BUFFER_SIZE = 65535;
+
+	NullFrameBuffer::NullFrameBuffer(const FrameBufferSpecifications& specs) : m_Specs(specs)
+	{
+		m_RendererID = NullRendererAPI::GenerateID();
+		Invalidate();
+	}
+
+	void NullFrameBuffer::Invalidate()
+	{
+		m_ColorAttachments.clear();
+		m_ClearValues.clear();
+		m_HasDepth = false;
+
+		for (auto& spec : m_Specs.Attachments.Attachments)
+		{
+			if (spec.TextureFormat == FrameBufferTextureFormat::DEPTH24STENCIL8)
+			{
+				m_DepthAttachment = NullRendererAPI::GenerateID();
+				m_HasDepth = true;
+			}
+			else
+			{
+				m_ColorAttachments.push_back(NullRendererAPI::GenerateID());
+				m_ClearValues.push_back(0);
+			}
+
+			NullRendererAPI::CreateResource();
+		}
+
+		NullRendererAPI::CreateResource();
+		m_GPUMemory.Resize((uint64_t)m_Specs.Width * m_Specs.Height * std::max(m_Specs.Samples, 1u) * 4 *
+			m_Specs.Attachments.Attachments.size());
+	}
+
+	void NullFrameBuffer::Resize(uint32_t x, uint32_t y)
+	{
+		if (x == 0 || y == 0 || x > MAX_FRAME_BUFFER_SIZE || y > MAX_FRAME_BUFFER_SIZE)
+		{
+			Log.CoreWarn("Attempted to resize frame buffer to incorrect size: {0}, {1}", x, y);
+			return;
+		}
+
+		m_Specs.Width = x;
+		m_Specs.Height = y;
+		Invalidate();
+	}
+
+	void NullFrameBuffer::ClearAttachment(uint32_t index, int value)
+	{
+		DBT_CORE_ASSERT(index < m_ColorAttachments.size());
+		m_ClearValues[index] = value;
+		NullRendererAPI::Call();
+	}
+
+	void NullFrameBuffer::CopyDepth(const Ref<FrameBuffer>& source)
+	{
+		NullRendererAPI::Call();
+	}
+
+	int NullFrameBuffer::ReadRedPixel(uint32_t attachmentIndex, int x, int y)
+	{
+		DBT_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size());
+		NullRendererAPI::Call();
+		return m_ClearValues[attachmentIndex];
+	}
+
+	glm::vec4 NullFrameBuffer::ReadPixel(uint32_t index, int x, int y)
+	{
+		DBT_CORE_ASSERT(index < m_ColorAttachments.size());
+		NullRendererAPI::Call();
+		return glm::vec4(0.0f);
+	}
+
+	void NullFrameBuffer::Bind()
+	{
+		NullRendererAPI::BindFrameBuffer(m_RendererID);
+		NullRendererAPI::BindViewport(0, 0, m_Specs.Width, m_Specs.Height);
+	}
+
+	void NullFrameBuffer::BindDepth(uint32_t slot)
+	{
+		NullRendererAPI::BindTexture(slot, m_DepthAttachment);
+	}
+
+	void NullFrameBuffer::UnbindDepth(uint32_t slot)
+	{
+		NullRendererAPI::BindTexture(slot, 0);
+	}
+
+	void NullFrameBuffer::BindAttachment(uint32_t slot, uint32_t index)
+	{
+		DBT_ASSERT(m_ColorAttachments.size() > index);
+		NullRendererAPI::BindTexture(slot, m_ColorAttachments[index]);
+	}
+
+	void NullFrameBuffer::BindAsTexture(uint32_t slot)
+	{
+		NullRendererAPI::BindTexture(slot, m_RendererID);
+	}
+
+	void NullFrameBuffer::Unbind()
+	{
+		NullRendererAPI::BindFrameBuffer(0);
+	}
+}
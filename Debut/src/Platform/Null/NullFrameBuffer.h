@@ -0,0 +1,46 @@
+#pragma once
+#include "Debut/Rendering/Structures/FrameBuffer.h"
+#include "Debut/Core/MemoryTracker.h"
+
+namespace Debut
+{
+	class NullFrameBuffer : public FrameBuffer
+	{
+	public:
+		NullFrameBuffer(const FrameBufferSpecifications& specs);
+		virtual ~NullFrameBuffer() = default;
+
+		virtual void Invalidate() override;
+		virtual void Resize(uint32_t x, uint32_t y) override;
+		virtual void ClearAttachment(uint32_t index, int value) override;
+		virtual void CopyDepth(const Ref<FrameBuffer>& source) override;
+
+		// Nothing is rasterized, the attachments only contain the value they have been cleared to
+		virtual int ReadRedPixel(uint32_t attachmentIndex, int x, int y) override;
+		virtual int ReadDepthPixel(uint32_t index, int x, int y) override { return 0; }
+		virtual glm::vec4 ReadPixel(uint32_t index, int x, int y) override;
+
+		virtual void Bind() override;
+		virtual void BindAsTexture(uint32_t slot) override;
+		virtual void BindDepth(uint32_t slot) override;
+		virtual void BindAttachment(uint32_t slot, uint32_t index = 0) override;
+
+		virtual void Unbind() override;
+		virtual void UnbindDepth(uint32_t slot) override;
+
+		inline virtual uint32_t GetColorAttachment(int idx = 0) const override { DBT_ASSERT(idx < m_ColorAttachments.size()); return m_ColorAttachments[idx]; }
+		inline virtual uint32_t GetDepthAttachment() const override { return m_DepthAttachment; }
+		inline virtual FrameBufferSpecifications& GetSpecs() override { return m_Specs; }
+
+	private:
+		uint32_t m_RendererID = 0;
+		FrameBufferSpecifications m_Specs;
+
+		std::vector<uint32_t> m_ColorAttachments;
+		std::vector<int> m_ClearValues;
+		uint32_t m_DepthAttachment = 0;
+		bool m_HasDepth = false;
+
+		TrackedMemory m_GPUMemory = { MemoryTag::FrameBuffers, MemoryType::GPU };
+	};
+}
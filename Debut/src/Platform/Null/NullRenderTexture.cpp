@@ -0,0 +1,56 @@
+#include "Debut/dbtpch.h"
+#include "NullRenderTexture.h"
+#include "NullRendererAPI.h"
+#include <Debut/Rendering/Structures/VertexArray.h>
+#include <Debut/Rendering/Structures/Buffer.h>
+
+namespace Debut
+{
+	NullRenderTexture::NullRenderTexture(float width, float height, Ref<FrameBuffer> buffer, RenderTextureMode mode) :
+		RenderTexture(buffer != nullptr ? buffer->GetSpecs() : FrameBufferSpecifications(false))
+	{
+		m_Mode = mode;
+
+		float vertices[16] = {
+			-1, 1, 0, 1,
+			1, 1, 1, 1,
+			1, -1, 1, 0,
+			-1, -1, 0, 0};
+		int indices[6] = { 0, 2, 1, 2, 0, 3 };
+
+		m_VertexBuffer = VertexBuffer::Create(vertices, 16);
+		m_IndexBuffer = IndexBuffer::Create(indices, 6);
+		m_VertexArray = VertexArray::Create();
+		m_FrameBuffer = buffer;
+
+		m_VertexBuffer->SetLayout(BufferLayout({
+			{ ShaderDataType::Float2, "a_Position", false },
+			{ ShaderDataType::Float2, "a_TexCoords", false}
+		}));
+
+		m_VertexArray->AddIndexBuffer(m_IndexBuffer);
+		m_VertexArray->AddVertexBuffer(m_VertexBuffer);
+	}
+
+	void NullRenderTexture::BindTexture()
+	{
+		uint32_t attachment = 0;
+
+		switch (m_Mode)
+		{
+		case RenderTextureMode::Color:
+			attachment = m_FrameBuffer->GetColorAttachment();
+			break;
+		case RenderTextureMode::Depth:
+			attachment = m_FrameBuffer->GetDepthAttachment();
+			break;
+		}
+
+		NullRendererAPI::BindTexture(0, attachment);
+	}
+
+	void NullRenderTexture::UnbindTexture()
+	{
+		NullRendererAPI::BindTexture(0, 0);
+	}
+}
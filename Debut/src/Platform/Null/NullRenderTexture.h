@@ -0,0 +1,14 @@
+#pragma once
+#include <Debut/Rendering/RenderTexture.h>
+
+namespace Debut
+{
+	class NullRenderTexture : public RenderTexture
+	{
+	public:
+		NullRenderTexture(float width, float height, Ref<FrameBuffer> buffer, RenderTextureMode mode);
+
+		virtual void BindTexture() override;
+		virtual void UnbindTexture() override;
+	};
+}
@@ -0,0 +1,181 @@
+#include "Debut/dbtpch.h"
+#include "NullRendererAPI.h"
+#include <Debut/Rendering/Structures/Buffer.h>
+#include <Debut/Rendering/Structures/VertexArray.h>
+#include <Debut/Rendering/Renderer/RenderStateCache.h>
+
+namespace Debut
+{
+	NullRendererAPI::State NullRendererAPI::s_State;
+	NullRendererStats NullRendererAPI::s_Stats;
+	uint32_t NullRendererAPI::s_NextID = 1;
+
+	void NullRendererAPI::Init()
+	{
+		s_State = State();
+		ResetStats();
+		RenderStateCache::Invalidate();
+	}
+
+	void NullRendererAPI::Clear()
+	{
+		s_Stats.Calls++;
+		s_Stats.Clears++;
+	}
+
+	void NullRendererAPI::ClearDepth()
+	{
+		s_Stats.Calls++;
+		s_Stats.Clears++;
+	}
+
+	void NullRendererAPI::SetClearColor(const glm::vec4 color)
+	{
+		SetState(s_State.ClearColor, color);
+	}
+
+	void NullRendererAPI::EnableCulling()
+	{
+		if (RenderStateCache::SetCulling(true))
+			SetState(s_State.Culling, true);
+		CullBack();
+	}
+
+	void NullRendererAPI::DisableCulling()
+	{
+		if (RenderStateCache::SetCulling(false))
+			SetState(s_State.Culling, false);
+	}
+
+	void NullRendererAPI::CullFront()
+	{
+		if (RenderStateCache::SetCullFront(true))
+			SetState(s_State.CullFront, true);
+	}
+
+	void NullRendererAPI::CullBack()
+	{
+		if (RenderStateCache::SetCullFront(false))
+			SetState(s_State.CullFront, false);
+	}
+
+	void NullRendererAPI::DrawIndexed(const Ref<VertexArray>& va, uint32_t indexCount)
+	{
+		uint64_t count = indexCount == 0 ? va->GetIndexBuffer()->GetCount() : indexCount;
+		va->Bind();
+		s_Stats.Calls++;
+		s_Stats.DrawCalls++;
+		s_Stats.Indices += count;
+	}
+
+	void NullRendererAPI::DrawIndexedBaseVertex(const Ref<VertexArray>& va, uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex)
+	{
+		va->Bind();
+		s_Stats.Calls++;
+		s_Stats.DrawCalls++;
+		s_Stats.Indices += indexCount;
+	}
+
+	void NullRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& va, uint32_t indexCount, uint32_t instanceCount)
+	{
+		va->Bind();
+		s_Stats.Calls++;
+		s_Stats.DrawCalls++;
+		s_Stats.Indices += (uint64_t)indexCount * instanceCount;
+	}
+
+	void NullRendererAPI::DrawLines(const Ref<VertexArray>& va, uint32_t vertexCount)
+	{
+		va->Bind();
+		s_Stats.Calls++;
+		s_Stats.DrawCalls++;
+		s_Stats.Vertices += vertexCount;
+	}
+
+	void NullRendererAPI::DrawPoints(const Ref<VertexArray>& va, uint32_t vertexCount)
+	{
+		va->Bind();
+		s_Stats.Calls++;
+		s_Stats.DrawCalls++;
+		s_Stats.Vertices += vertexCount;
+	}
+
+	void NullRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		BindViewport(x, y, width, height);
+	}
+
+	void NullRendererAPI::SetLineWidth(float thickness)
+	{
+		if (RenderStateCache::SetLineWidth(thickness))
+			SetState(s_State.LineWidth, thickness);
+	}
+
+	void NullRendererAPI::SetPointSize(float thickness)
+	{
+		if (RenderStateCache::SetPointSize(thickness))
+			SetState(s_State.PointSize, thickness);
+	}
+
+	void NullRendererAPI::ResetStats()
+	{
+		s_Stats = NullRendererStats();
+	}
+
+	uint32_t NullRendererAPI::GenerateID()
+	{
+		return s_NextID++;
+	}
+
+	// The resources go through the same state cache as the OpenGL ones, so that the calls are the ones a driver
+	// would receive
+	void NullRendererAPI::BindShader(uint32_t id)
+	{
+		if (RenderStateCache::BindShader(id) && SetState(s_State.Shader, id))
+			s_Stats.ShaderBinds++;
+	}
+
+	void NullRendererAPI::BindVertexArray(uint32_t id)
+	{
+		if (RenderStateCache::BindVertexArray(id) && SetState(s_State.VertexArray, id))
+			s_Stats.VertexArrayBinds++;
+	}
+
+	void NullRendererAPI::BindFrameBuffer(uint32_t id)
+	{
+		if (RenderStateCache::BindFrameBuffer(id) && SetState(s_State.FrameBuffer, id))
+			s_Stats.FrameBufferBinds++;
+	}
+
+	void NullRendererAPI::BindViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		if (RenderStateCache::SetViewport(x, y, width, height))
+			SetState(s_State.Viewport, glm::uvec4(x, y, width, height));
+	}
+
+	void NullRendererAPI::BindTexture(uint32_t slot, uint32_t id)
+	{
+		DBT_CORE_ASSERT(slot < 32, "Texture slot out of range");
+		if (RenderStateCache::BindTexture(slot, id) && SetState(s_State.Textures[slot], id))
+			s_Stats.TextureBinds++;
+	}
+
+	void NullRendererAPI::UploadUniform(uint32_t size)
+	{
+		s_Stats.Calls++;
+		s_Stats.UniformUploads++;
+		s_Stats.BytesUploaded += size;
+	}
+
+	void NullRendererAPI::Upload(uint64_t size)
+	{
+		s_Stats.Calls++;
+		s_Stats.BytesUploaded += size;
+	}
+
+	void NullRendererAPI::CreateResource()
+	{
+		s_Stats.Calls++;
+		s_Stats.ResourcesCreated++;
+	}
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include "Debut/Rendering/Renderer/RendererAPI.h"
+
+#include <glm/glm.hpp>
+
+/*
+	Headless backend: nothing is sent to a GPU, the null resources only keep the state a driver would have and
+	count what would have been submitted. Useful to benchmark the CPU side of the renderer and to run scenes on
+	machines without a GPU.
+*/
+
+namespace Debut
+{
+	struct NullRendererStats
+	{
+		// Every call that would have reached the driver
+		uint64_t Calls = 0;
+		// Calls that changed the bound resources or the pipeline state. Redundant calls are dropped by the
+		// RenderStateCache before they get here, its stats count them
+		uint64_t StateChanges = 0;
+
+		uint64_t DrawCalls = 0;
+		uint64_t Indices = 0;
+		uint64_t Vertices = 0;
+		uint64_t Clears = 0;
+
+		uint64_t ShaderBinds = 0;
+		uint64_t TextureBinds = 0;
+		uint64_t VertexArrayBinds = 0;
+		uint64_t FrameBufferBinds = 0;
+		uint64_t UniformUploads = 0;
+
+		// Buffer, texture and uniform data
+		uint64_t BytesUploaded = 0;
+		uint64_t ResourcesCreated = 0;
+	};
+
+	class NullRendererAPI : public RendererAPI
+	{
+	public:
+		virtual void Init() override;
+
+		virtual void Clear() override;
+		virtual void ClearDepth() override;
+		virtual void SetClearColor(const glm::vec4 color) override;
+
+		virtual void EnableCulling() override;
+		virtual void DisableCulling() override;
+		virtual void CullFront() override;
+		virtual void CullBack() override;
+
+		virtual void DrawIndexed(const Ref<VertexArray>& va, uint32_t indexCount = 0) override;
+		virtual void DrawIndexedBaseVertex(const Ref<VertexArray>& va, uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex) override;
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& va, uint32_t indexCount, uint32_t instanceCount) override;
+		virtual void DrawLines(const Ref<VertexArray>& va, uint32_t vertexCount) override;
+		virtual void DrawPoints(const Ref<VertexArray>& va, uint32_t vertexCount) override;
+		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+
+		virtual void SetLineWidth(float thickness) override;
+		virtual void SetPointSize(float thickness) override;
+
+		inline static const NullRendererStats& GetStats() { return s_Stats; }
+		static void ResetStats();
+
+		// Used by the null resources
+		static uint32_t GenerateID();
+		static void Call() { s_Stats.Calls++; }
+		static void BindShader(uint32_t id);
+		static void BindVertexArray(uint32_t id);
+		static void BindFrameBuffer(uint32_t id);
+		static void BindViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+		static void BindTexture(uint32_t slot, uint32_t id);
+		static void UploadUniform(uint32_t size);
+		static void Upload(uint64_t size);
+		static void CreateResource();
+
+	private:
+		// Returns true if the state has actually been changed
+		template <typename T>
+		static bool SetState(T& current, const T& value)
+		{
+			s_Stats.Calls++;
+			if (current == value)
+				return false;
+
+			current = value;
+			s_Stats.StateChanges++;
+			return true;
+		}
+
+	private:
+		struct State
+		{
+			glm::vec4 ClearColor = glm::vec4(0.0f);
+			glm::uvec4 Viewport = glm::uvec4(0);
+			bool Culling = false;
+			bool CullFront = false;
+			float LineWidth = 1.0f;
+			float PointSize = 1.0f;
+
+			uint32_t Shader = 0;
+			uint32_t VertexArray = 0;
+			uint32_t FrameBuffer = 0;
+			uint32_t Textures[32] = { 0 };
+		};
+
+		static State s_State;
+		static NullRendererStats s_Stats;
+		static uint32_t s_NextID;
+	};
+}
@@ -0,0 +1,193 @@
+#include "Debut/dbtpch.h"
+#include "NullShader.h"
+#include "NullRendererAPI.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace Debut
+{
+	static ShaderDataType GLSLToDbtUniformType(const std::string& type)
+	{
+		if (type == "float") return ShaderDataType::Float;
+		if (type == "vec2") return ShaderDataType::Float2;
+		if (type == "vec3") return ShaderDataType::Float3;
+		if (type == "vec4") return ShaderDataType::Float4;
+
+		if (type == "int") return ShaderDataType::Int;
+		if (type == "ivec2") return ShaderDataType::Int2;
+		if (type == "ivec3") return ShaderDataType::Int3;
+		if (type == "ivec4") return ShaderDataType::Int4;
+
+		if (type == "bool") return ShaderDataType::Bool;
+		if (type == "sampler2D") return ShaderDataType::Sampler2D;
+		if (type == "samplerCube") return ShaderDataType::SamplerCube;
+		if (type == "samplerBuffer" || type == "isamplerBuffer" || type == "usamplerBuffer") return ShaderDataType::SamplerBuffer;
+		if (type == "mat3") return ShaderDataType::Mat3;
+		if (type == "mat4") return ShaderDataType::Mat4;
+
+		// Structs and blocks
+		return ShaderDataType::None;
+	}
+
+	NullShader::NullShader(const std::string& filePath)
+	{
+		CreateOrLoadMeta(filePath);
+		m_RendererID = NullRendererAPI::GenerateID();
+		NullRendererAPI::CreateResource();
+
+		std::ifstream inFile(filePath, std::ios::in | std::ios::binary);
+		if (inFile)
+		{
+			std::stringstream ss;
+			ss << inFile.rdbuf();
+			ParseUniforms(ss.str());
+		}
+		else
+			Log.CoreError("Couldn't open file {0}", filePath.c_str());
+
+		// Extract shader name from the file path
+		auto last = filePath.find_last_of("/\\");
+		auto dot = filePath.rfind(".");
+		last = last == std::string::npos ? last : last + 1;
+		auto count = dot == std::string::npos ? filePath.size() - last : dot - last;
+
+		m_Name = filePath.substr(last, count);
+	}
+
+	NullShader::NullShader(const std::string& name, const std::string& vertSource, const std::string& fragSource)
+	{
+		m_Name = name;
+		m_RendererID = NullRendererAPI::GenerateID();
+		NullRendererAPI::CreateResource();
+
+		ParseUniforms(vertSource);
+		ParseUniforms(fragSource);
+	}
+
+	void NullShader::ParseUniforms(const std::string& src)
+	{
+		std::stringstream stream(src);
+		std::string line;
+
+		while (std::getline(stream, line))
+		{
+			// uniform <type> <name>[<size>];
+			std::stringstream lineStream(line);
+			std::string keyword, type, name;
+			lineStream >> keyword >> type >> name;
+
+			if (keyword != "uniform" || name.empty())
+				continue;
+
+			ShaderDataType dbtType = GLSLToDbtUniformType(type);
+			if (dbtType == ShaderDataType::None)
+				continue;
+
+			name = name.substr(0, name.find_first_of(";"));
+			// Arrays are reported by their first element, like the OpenGL reflection does
+			size_t bracket = name.find('[');
+			if (bracket != std::string::npos)
+			{
+				name = name.substr(0, bracket) + "[0]";
+				if (dbtType == ShaderDataType::Float)
+					dbtType = ShaderDataType::FloatArray;
+				else if (dbtType == ShaderDataType::Int)
+					dbtType = ShaderDataType::IntArray;
+			}
+
+			// The same uniform can be declared in more than one stage
+			if (m_UniformLocations.find(name) != m_UniformLocations.end())
+				continue;
+
+			ShaderUniform::UniformData placeHolder;
+			switch (dbtType)
+			{
+			case ShaderDataType::Bool: placeHolder = true; break;
+			case ShaderDataType::Float: placeHolder = 0.0f; break;
+			case ShaderDataType::Float2: placeHolder = glm::vec2(0.0f); break;
+			case ShaderDataType::Float3: placeHolder = glm::vec3(0.0f); break;
+			case ShaderDataType::Float4: placeHolder = glm::vec4(0.0f); break;
+			case ShaderDataType::FloatArray: placeHolder = std::vector<float>(); break;
+			case ShaderDataType::IntArray: placeHolder = std::vector<int>(); break;
+			case ShaderDataType::Int: placeHolder = 0; break;
+			case ShaderDataType::Int2: placeHolder = glm::vec2(0); break;
+			case ShaderDataType::Int3: placeHolder = glm::vec3(0); break;
+			case ShaderDataType::Int4: placeHolder = glm::vec4(0); break;
+			case ShaderDataType::Mat3: placeHolder = glm::mat4(1.0f); break;
+			case ShaderDataType::Mat4: placeHolder = glm::mat4(1.0f); break;
+			case ShaderDataType::Sampler2D: placeHolder = (UUID)0; break;
+			case ShaderDataType::SamplerCube: placeHolder = (UUID)0; break;
+			case ShaderDataType::SamplerBuffer: placeHolder = (UUID)0; break;
+			default:break;
+			}
+
+			m_UniformLocations[name] = (uint32_t)m_Uniforms.size();
+			m_Uniforms.push_back({ name, dbtType, placeHolder });
+		}
+	}
+
+	void NullShader::Upload(const std::string& name, const void* data, uint32_t size)
+	{
+		// The index of the uniform works as its location
+		auto location = m_UniformLocations.find(name);
+		if (m_UniformValues.Set(location != m_UniformLocations.end() ? (int32_t)location->second : -1, data, size))
+			NullRendererAPI::UploadUniform(size);
+	}
+
+	void NullShader::Bind() const
+	{
+		NullRendererAPI::BindShader(m_RendererID);
+	}
+
+	void NullShader::Unbind() const
+	{
+		// Programs stay bound like in the OpenGL backend
+	}
+
+	void NullShader::SetInt(const std::string& name, int value)
+	{
+		Upload(name, &value, sizeof(int));
+	}
+
+	void NullShader::SetBool(const std::string& name, bool value)
+	{
+		int intValue = value;
+		Upload(name, &intValue, sizeof(int));
+	}
+
+	void NullShader::SetIntArray(const std::string& name, int* data, uint32_t count)
+	{
+		Upload(name, data, sizeof(int) * count);
+	}
+
+	void NullShader::SetFloatArray(const std::string& name, float* data, uint32_t count)
+	{
+		Upload(name, data, sizeof(float) * count);
+	}
+
+	void NullShader::SetMat4(const std::string& name, const glm::mat4& uniform)
+	{
+		Upload(name, &uniform, sizeof(glm::mat4));
+	}
+
+	void NullShader::SetFloat(const std::string& name, float uniform)
+	{
+		Upload(name, &uniform, sizeof(float));
+	}
+
+	void NullShader::SetFloat2(const std::string& name, const glm::vec2& uniform)
+	{
+		Upload(name, &uniform, sizeof(glm::vec2));
+	}
+
+	void NullShader::SetFloat3(const std::string& name, const glm::vec3& uniform)
+	{
+		Upload(name, &uniform, sizeof(glm::vec3));
+	}
+
+	void NullShader::SetFloat4(const std::string& name, const glm::vec4& uniform)
+	{
+		Upload(name, &uniform, sizeof(glm::vec4));
+	}
+}
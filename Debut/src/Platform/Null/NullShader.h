@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Debut/Rendering/Shader.h"
+#include "Debut/Rendering/Renderer/RenderStateCache.h"
+
+#include <unordered_map>
+
+namespace Debut
+{
+	class NullShader : public Shader
+	{
+	public:
+		NullShader(const std::string& filePath);
+		NullShader(const std::string& name, const std::string& vertSource, const std::string& fragSource);
+		virtual ~NullShader() = default;
+
+		void Bind() const override;
+		void Unbind() const override;
+
+		virtual void SetInt(const std::string& name, int value) override;
+		virtual void SetBool(const std::string& name, bool value) override;
+		virtual void SetIntArray(const std::string& name, int* data, uint32_t count) override;
+		virtual void SetFloatArray(const std::string& name, float* data, uint32_t count) override;
+		virtual void SetMat4(const std::string& name, const glm::mat4& uniform) override;
+		virtual void SetFloat(const std::string& name, float uniform) override;
+		virtual void SetFloat2(const std::string& name, const glm::vec2& uniform) override;
+		virtual void SetFloat3(const std::string& name, const glm::vec3& uniform) override;
+		virtual void SetFloat4(const std::string& name, const glm::vec4& uniform) override;
+
+		const std::string& GetName() const override { return m_Name; }
+		std::vector<ShaderUniform> GetUniforms() const override { return m_Uniforms; }
+
+	private:
+		// There's no driver to reflect the program: the uniforms are read from the declarations in the source
+		void ParseUniforms(const std::string& src);
+		void Upload(const std::string& name, const void* data, uint32_t size);
+
+	private:
+		uint32_t m_RendererID;
+		std::string m_Name;
+
+		std::vector<ShaderUniform> m_Uniforms;
+		std::unordered_map<std::string, uint32_t> m_UniformLocations;
+		UniformCache m_UniformValues;
+	};
+}
@@ -0,0 +1,22 @@
+#include "Debut/dbtpch.h"
+#include "NullSkybox.h"
+#include "NullRendererAPI.h"
+
+namespace Debut
+{
+	NullSkybox::NullSkybox()
+	{
+		m_RendererID = NullRendererAPI::GenerateID();
+		NullRendererAPI::CreateResource();
+	}
+
+	void NullSkybox::Bind()
+	{
+		NullRendererAPI::BindTexture(0, m_RendererID);
+	}
+
+	void NullSkybox::Unbind()
+	{
+		NullRendererAPI::BindTexture(0, 0);
+	}
+}
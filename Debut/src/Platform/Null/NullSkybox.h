@@ -0,0 +1,21 @@
+#pragma once
+
+#include <Debut/Rendering/Resources/Skybox.h>
+
+namespace Debut
+{
+	class NullSkybox : public Skybox
+	{
+	public:
+		NullSkybox();
+
+		virtual void Bind() override;
+		virtual void Unbind() override;
+		virtual void Reload() override {}
+
+		inline uint32_t GetRendererID() const override { return m_RendererID; }
+
+	private:
+		uint32_t m_RendererID = 0;
+	};
+}
@@ -0,0 +1,61 @@
+#include "Debut/dbtpch.h"
+#include "NullTexture.h"
+#include "NullRendererAPI.h"
+#include <stb_image.h>
+
+namespace Debut
+{
+	NullTexture2D::NullTexture2D(const std::string& path, Texture2DConfig config) : m_Path(path)
+	{
+		m_RendererID = NullRendererAPI::GenerateID();
+		Load(config);
+	}
+
+	NullTexture2D::NullTexture2D(uint32_t width, uint32_t height) : m_Width(width), m_Height(height)
+	{
+		m_RendererID = NullRendererAPI::GenerateID();
+		NullRendererAPI::CreateResource();
+		NullRendererAPI::Upload((uint64_t)m_Width * m_Height * 4);
+		m_GPUMemory.Resize((uint64_t)m_Width * m_Height * 4);
+	}
+
+	void NullTexture2D::Reload()
+	{
+		Load(NullTexture2D::GetConfig(m_Path + ".meta"));
+	}
+
+	void NullTexture2D::Load(const Texture2DConfig& config)
+	{
+		m_FilteringMode = config.Filtering;
+		m_WrapMode = config.WrapMode;
+		m_Mipmaps = config.Mipmaps;
+		m_SRGB = config.SRGB;
+		m_Compression = config.Compression;
+		m_Quality = config.Quality;
+		m_ID = config.ID;
+
+		// Only the header is read: the size is needed by sprites and render targets, the pixels aren't
+		int width, height, channels;
+		if (stbi_info(m_Path.c_str(), &width, &height, &channels))
+		{
+			m_Width = width;
+			m_Height = height;
+		}
+		else
+			Log.CoreError("Couldn't read texture {0}", m_Path);
+
+		NullRendererAPI::CreateResource();
+		NullRendererAPI::Upload((uint64_t)m_Width * m_Height * 4);
+		m_GPUMemory.Resize((uint64_t)m_Width * m_Height * 4);
+	}
+
+	void NullTexture2D::SetData(void* data, uint32_t size)
+	{
+		NullRendererAPI::Upload(size);
+	}
+
+	void NullTexture2D::Bind(uint32_t slot) const
+	{
+		NullRendererAPI::BindTexture(slot, m_RendererID);
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Debut/Rendering/Texture.h"
+#include "Debut/Core/MemoryTracker.h"
+
+namespace Debut
+{
+	class NullTexture2D : public Texture2D
+	{
+	public:
+		NullTexture2D(const std::string& path, Texture2DConfig parameters =
+			{Texture2DParameter::FILTERING_LINEAR, Texture2DParameter::WRAP_CLAMP});
+		NullTexture2D(uint32_t width, uint32_t height);
+		virtual ~NullTexture2D() = default;
+
+		uint32_t GetWidth() const override { return m_Width; }
+		uint32_t GetHeight() const override { return m_Height; }
+		uint32_t GetRendererID() const override { return m_RendererID; }
+		std::string GetPath() const override { return m_Path; }
+
+		virtual void SetData(void* data, uint32_t size) override;
+		virtual void Reload() override;
+
+		virtual void Bind(uint32_t slot = 0) const override;
+
+		virtual bool operator==(const Texture& other) const override { return other.GetRendererID() == m_RendererID; }
+
+	private:
+		void Load(const Texture2DConfig& config);
+
+	private:
+		std::string m_Path;
+		uint32_t m_RendererID;
+
+		uint32_t m_Width = 1;
+		uint32_t m_Height = 1;
+
+		TrackedMemory m_GPUMemory = { MemoryTag::Textures, MemoryType::GPU };
+	};
+}
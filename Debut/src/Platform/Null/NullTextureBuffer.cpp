@@ -0,0 +1,33 @@
+#include "Debut/dbtpch.h"
+#include "NullTextureBuffer.h"
+#include "NullRendererAPI.h"
+
+namespace Debut
+{
+	NullTextureBuffer::NullTextureBuffer(TextureBufferFormat format)
+	{
+		m_RendererID = NullRendererAPI::GenerateID();
+		NullRendererAPI::CreateResource();
+		m_GPUMemory.Resize(m_Capacity);
+	}
+
+	void NullTextureBuffer::SetData(const void* data, uint32_t size)
+	{
+		// Same growth as the OpenGL buffer, so that the resources created can be compared
+		if (size > m_Capacity)
+		{
+			while (m_Capacity < size)
+				m_Capacity *= 2;
+
+			NullRendererAPI::CreateResource();
+			m_GPUMemory.Resize(m_Capacity);
+		}
+
+		NullRendererAPI::Upload(size);
+	}
+
+	void NullTextureBuffer::Bind(uint32_t slot) const
+	{
+		NullRendererAPI::BindTexture(slot, m_RendererID);
+	}
+}
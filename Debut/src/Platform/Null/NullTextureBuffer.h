@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Debut/Rendering/Structures/TextureBuffer.h"
+#include "Debut/Core/MemoryTracker.h"
+
+namespace Debut
+{
+	class NullTextureBuffer : public TextureBuffer
+	{
+	public:
+		NullTextureBuffer(TextureBufferFormat format);
+		virtual ~NullTextureBuffer() = default;
+
+		virtual void SetData(const void* data, uint32_t size) override;
+		virtual void Bind(uint32_t slot) const override;
+
+		virtual inline uint32_t GetRendererID() const override { return m_RendererID; }
+
+	private:
+		uint32_t m_RendererID;
+		uint32_t m_Capacity = 256;
+
+		TrackedMemory m_GPUMemory = { MemoryType::GPU };
+	};
+}
@@ -0,0 +1,42 @@
+#include "Debut/dbtpch.h"
+#include "NullVertexArray.h"
+#include "NullRendererAPI.h"
+#include <Debut/Rendering/Structures/Buffer.h>
+
+namespace Debut
+{
+	NullVertexArray::NullVertexArray()
+	{
+		m_RendererID = NullRendererAPI::GenerateID();
+		NullRendererAPI::CreateResource();
+	}
+
+	void NullVertexArray::Bind() const
+	{
+		NullRendererAPI::BindVertexArray(m_RendererID);
+	}
+
+	void NullVertexArray::Unbind() const
+	{
+		// Arrays stay bound like in the OpenGL backend
+	}
+
+	void NullVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& buffer, bool instanced)
+	{
+		DBT_CORE_ASSERT(buffer->GetLayout().GetElements().size(), "Vertex buffer has no layout");
+
+		// One call per attribute to describe the layout
+		for (uint32_t i = 0; i < buffer->GetLayout().GetElements().size(); i++)
+			NullRendererAPI::Call();
+		// And one to set the divisor
+		if (instanced)
+			NullRendererAPI::Call();
+		m_VertexBuffers.push_back(buffer);
+	}
+
+	void NullVertexArray::AddIndexBuffer(const Ref<IndexBuffer>& buffer)
+	{
+		NullRendererAPI::Call();
+		m_IndexBuffer = buffer;
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include "Debut/Rendering/Structures/VertexArray.h"
+
+namespace Debut
+{
+	class NullVertexArray : public VertexArray
+	{
+	public:
+		NullVertexArray();
+		virtual ~NullVertexArray() = default;
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		virtual void AddVertexBuffer(const Ref<VertexBuffer>& buffer, bool instanced = false) override;
+		virtual void AddIndexBuffer(const Ref<IndexBuffer>& buffer)  override;
+
+		virtual const std::vector<Ref<VertexBuffer>> GetVertexBuffers() const override { return m_VertexBuffers; }
+		virtual const Ref<IndexBuffer> GetIndexBuffer() const override { return m_IndexBuffer; };
+	private:
+		uint32_t m_RendererID;
+		std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+		Ref<IndexBuffer> m_IndexBuffer;
+	};
+}
@@ -2,6 +2,7 @@
 #include <glad/glad.h>
 #include "OpenGLBuffer.h"
 #include "OpenGLError.h"
+#include <Debut/Rendering/Renderer/Renderer.h>
 
 namespace Debut
 {
@@ -13,53 +14,55 @@ namespace Debut
 		GLCall(glCreateBuffers(1, &m_RendererID));
 		GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
 		GLCall(glBufferData(GL_ARRAY_BUFFER, sizeof(GL_FLOAT) * count, vertices, GL_STATIC_DRAW));
+		m_GPUMemory.Resize(sizeof(GL_FLOAT) * count);
 	}
 
-	OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t size, uint32_t maxBufferSize)
+	OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t size) : m_Dynamic(true), m_DataSize(size)
 	{
-		DBT_PROFILE_FUNCTION();
-		glCreateBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, maxBufferSize, nullptr, GL_DYNAMIC_DRAW);
-		m_DataSize = size;
-		m_Data = new unsigned char[size];
 	}
 
 	OpenGLVertexBuffer::~OpenGLVertexBuffer()
 	{
-		glDeleteBuffers(1, &m_RendererID);
+		if (!m_Dynamic)
+			glDeleteBuffers(1, &m_RendererID);
+		delete[] m_Data;
 	}
 
 	void OpenGLVertexBuffer::SetData(const void* data, uint32_t size)
 	{
 		DBT_PROFILE_FUNCTION();
-		GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
-		GLCall(glBufferSubData(GL_ARRAY_BUFFER, 0, size, data));
+		if (m_Dynamic)
+		{
+			m_Allocation = Renderer::GetDynamicGeometry()->Allocate(data, size);
+			return;
+		}
+
+		GLCall(glNamedBufferSubData(m_RendererID, 0, size, data));
 	}
 
 	void OpenGLVertexBuffer::PushData(const void* data, uint32_t size)
 	{
+		if (m_DataIndex + size > m_DataSize || m_Data == nullptr)
 		{
 			DBT_PROFILE_SCOPE("PushData::Reallocate");
-			uint32_t newDataSize = m_DataSize;
-			// Increase buffer size if necessary
-			while (m_DataIndex + size >= newDataSize)
+			// The memory is kept between submissions, so it only grows until it fits a whole frame
+			uint32_t newDataSize = std::max(m_DataSize, 4096u);
+			while (m_DataIndex + size > newDataSize)
 				newDataSize *= 2;
 
-			if (newDataSize != m_DataSize)
-			{
-				unsigned char* newData = new unsigned char[newDataSize];
-				memcpy(newData, m_Data, m_DataSize);
+			unsigned char* newData = new unsigned char[newDataSize];
+			if (m_Data != nullptr)
+				memcpy(newData, m_Data, m_DataIndex);
 
-				delete m_Data;
-				m_Data = newData;
-				m_DataSize = newDataSize;
-			}
+			delete[] m_Data;
+			m_Data = newData;
+			m_DataSize = newDataSize;
+			m_CPUMemory.Resize(newDataSize);
 		}
 
 		{
 			DBT_PROFILE_SCOPE("PushData::CopyData");
-			memcpy(m_Data + m_DataIndex, reinterpret_cast<unsigned char*>((void*)data), size);
+			memcpy(m_Data + m_DataIndex, data, size);
 			m_DataIndex += size;
 		}
 	}
@@ -71,14 +74,37 @@ namespace Debut
 
 		SetData(m_Data, m_DataIndex);
 		m_DataIndex = 0;
-		// Don't? Keep the same size and avoid reallocations
-		m_DataSize /= 2;
+	}
+
+	void OpenGLVertexBuffer::SetSubData(const void* data, uint32_t size, uint32_t offset)
+	{
+		DBT_CORE_ASSERT(!m_Dynamic, "Dynamic buffers can only be updated as a whole");
+		GLCall(glNamedBufferSubData(m_RendererID, offset, size, data));
+	}
+
+	void OpenGLVertexBuffer::CopySubData(const Ref<VertexBuffer>& source, uint32_t sourceOffset, uint32_t offset, uint32_t size)
+	{
+		DBT_CORE_ASSERT(!m_Dynamic, "Dynamic buffers can only be updated as a whole");
+		GLCall(glCopyNamedBufferSubData(source->GetRendererID(), m_RendererID, source->GetOffset() + sourceOffset, offset, size));
+	}
+
+	uint32_t OpenGLVertexBuffer::GetRendererID() const
+	{
+		if (!m_Dynamic)
+			return m_RendererID;
+		// The data stays in the storage it was uploaded to, even if the arena has grown since then
+		return m_Allocation.RendererID != 0 ? m_Allocation.RendererID : Renderer::GetDynamicGeometry()->GetRendererID();
+	}
+
+	uint32_t OpenGLVertexBuffer::GetOffset() const
+	{
+		return m_Dynamic ? m_Allocation.Offset : 0;
 	}
 
 	void OpenGLVertexBuffer::Bind() const
 	{
 		DBT_PROFILE_FUNCTION();
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		glBindBuffer(GL_ARRAY_BUFFER, GetRendererID());
 	}
 
 	void OpenGLVertexBuffer::Unbind() const
@@ -93,11 +119,12 @@ namespace Debut
 	OpenGLIndexBuffer::OpenGLIndexBuffer(int* indices, unsigned int count)
 	{
 		DBT_PROFILE_FUNCTION();
+		// Binding an element buffer would attach it to the bound vertex array, so the data is set with DSA
 		glCreateBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GL_UNSIGNED_INT) * count, indices, GL_STATIC_DRAW);
+		glNamedBufferData(m_RendererID, sizeof(GL_UNSIGNED_INT) * count, indices, GL_STATIC_DRAW);
 
 		m_Count = count;
+		m_GPUMemory.Resize(sizeof(GL_UNSIGNED_INT) * count);
 	}
 
 	OpenGLIndexBuffer::OpenGLIndexBuffer()
@@ -127,9 +154,20 @@ namespace Debut
 	void OpenGLIndexBuffer::SetData(const void* data, uint32_t count)
 	{
 		DBT_PROFILE_FUNCTION();
-		GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
-		GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GL_UNSIGNED_INT) * count, data, GL_STATIC_DRAW));
+		GLCall(glNamedBufferData(m_RendererID, sizeof(GL_UNSIGNED_INT) * count, data, GL_STATIC_DRAW));
 
 		m_Count = count;
+		m_GPUMemory.Resize(sizeof(GL_UNSIGNED_INT) * count);
+	}
+
+	void OpenGLIndexBuffer::SetSubData(const void* data, uint32_t count, uint32_t first)
+	{
+		GLCall(glNamedBufferSubData(m_RendererID, sizeof(GL_UNSIGNED_INT) * first, sizeof(GL_UNSIGNED_INT) * count, data));
+	}
+
+	void OpenGLIndexBuffer::CopySubData(const Ref<IndexBuffer>& source, uint32_t sourceFirst, uint32_t first, uint32_t count)
+	{
+		GLCall(glCopyNamedBufferSubData(source->GetRendererID(), m_RendererID, sizeof(GL_UNSIGNED_INT) * sourceFirst,
+			sizeof(GL_UNSIGNED_INT) * first, sizeof(GL_UNSIGNED_INT) * count));
 	}
-}
+}
\ No newline at end of file
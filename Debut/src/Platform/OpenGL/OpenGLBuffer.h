@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Debut/Rendering/Structures/Buffer.h"
+#include "Debut/Rendering/Structures/BufferArena.h"
+#include "Debut/Core/MemoryTracker.h"
 
 namespace Debut
 {
@@ -8,7 +10,7 @@ namespace Debut
 	class OpenGLVertexBuffer : public VertexBuffer
 	{
 	public:
-		OpenGLVertexBuffer(uint32_t size, uint32_t maxBufferSize);
+		OpenGLVertexBuffer(uint32_t size);
 		OpenGLVertexBuffer(float* vertices, unsigned int size);
 		virtual ~OpenGLVertexBuffer();
 
@@ -18,16 +20,27 @@ namespace Debut
 		virtual void SetData(const void* data, uint32_t size) override;
 		virtual void PushData(const void* data, uint32_t size) override;
 		virtual void SubmitData() override;
+		virtual void SetSubData(const void* data, uint32_t size, uint32_t offset) override;
+		virtual void CopySubData(const Ref<VertexBuffer>& source, uint32_t sourceOffset, uint32_t offset, uint32_t size) override;
+
+		virtual uint32_t GetRendererID() const override;
+		virtual uint32_t GetOffset() const override;
 
 		virtual inline void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
 		virtual inline BufferLayout& GetLayout() override { return m_Layout; }
 	private:
 		BufferLayout m_Layout;
-		unsigned int m_RendererID;
+		unsigned int m_RendererID = 0;
 
-		unsigned char* m_Data;
+		// Dynamic buffers only own the memory for PushData, the data is uploaded to the dynamic geometry arena
+		bool m_Dynamic = false;
+		BufferAllocation m_Allocation;
+		unsigned char* m_Data = nullptr;
 		uint32_t m_DataIndex = 0;
-		uint32_t m_DataSize = 4096;
+		uint32_t m_DataSize = 0;
+
+		TrackedMemory m_GPUMemory = { MemoryType::GPU };
+		TrackedMemory m_CPUMemory = { MemoryType::CPU };
 	};
 
 	////////////////////////////////////////////////////// INDEX BUFFER /////////////////////////////////////////////////////
@@ -43,11 +56,16 @@ namespace Debut
 		virtual void Unbind() const override;
 		
 		virtual inline uint32_t GetCount() const override { return m_Count; }
+		virtual inline uint32_t GetRendererID() const override { return m_RendererID; }
 
 		virtual void SetData(const void* data, uint32_t count) override;
+		virtual void SetSubData(const void* data, uint32_t count, uint32_t first) override;
+		virtual void CopySubData(const Ref<IndexBuffer>& source, uint32_t sourceFirst, uint32_t first, uint32_t count) override;
 	private:
 		unsigned int m_RendererID;
 		uint32_t m_Count;
+
+		TrackedMemory m_GPUMemory = { MemoryType::GPU };
 	};
 }
 
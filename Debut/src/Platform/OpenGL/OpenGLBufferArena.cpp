@@ -0,0 +1,166 @@
+#include "Debut/dbtpch.h"
+#include "OpenGLBufferArena.h"
+#include "OpenGLError.h"
+
+namespace Debut
+{
+	static const GLbitfield s_MapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	OpenGLBufferArena::OpenGLBufferArena(uint32_t regionSize)
+	{
+		DBT_PROFILE_FUNCTION();
+		m_Persistent = GLAD_GL_VERSION_4_4 != 0;
+		m_MinRegionSize = regionSize;
+		Resize(regionSize);
+	}
+
+	OpenGLBufferArena::~OpenGLBufferArena()
+	{
+		ReleaseRetiredStorage(true);
+		DestroyStorage();
+	}
+
+	uint32_t OpenGLBufferArena::CreateStorage(uint64_t size)
+	{
+		DBT_PROFILE_FUNCTION();
+		// Allocations made in the old storage during this frame can still be drawn
+		if (m_RendererID != 0)
+			RetireStorage();
+
+		GLCall(glCreateBuffers(1, &m_RendererID));
+		if (m_Persistent)
+		{
+			GLCall(glNamedBufferStorage(m_RendererID, size, nullptr, s_MapFlags));
+			m_Mapped = (uint8_t*)glMapNamedBufferRange(m_RendererID, 0, size, s_MapFlags);
+		}
+		else
+		{
+			GLCall(glNamedBufferData(m_RendererID, size, nullptr, GL_STREAM_DRAW));
+		}
+
+		return m_RendererID;
+	}
+
+	void OpenGLBufferArena::RetireStorage()
+	{
+		// The region fences only protect the CPU writes, the new storage hasn't been used yet
+		for (uint32_t i = 0; i < s_Frames; i++)
+		{
+			if (m_Fences[i] != nullptr)
+				glDeleteSync(m_Fences[i]);
+			m_Fences[i] = nullptr;
+		}
+
+		if (m_Mapped != nullptr)
+			glUnmapNamedBuffer(m_RendererID);
+		m_Retired.push_back({ m_RendererID, nullptr });
+
+		m_Mapped = nullptr;
+		m_RendererID = 0;
+	}
+
+	void OpenGLBufferArena::ReleaseRetiredStorage(bool wait)
+	{
+		for (uint32_t i = 0; i < m_Retired.size();)
+		{
+			RetiredStorage& storage = m_Retired[i];
+			if (!wait)
+			{
+				if (storage.Fence == nullptr)
+				{
+					i++;
+					continue;
+				}
+
+				GLenum result = glClientWaitSync(storage.Fence, 0, 0);
+				if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+				{
+					i++;
+					continue;
+				}
+			}
+
+			if (storage.Fence != nullptr)
+				glDeleteSync(storage.Fence);
+			glDeleteBuffers(1, &storage.RendererID);
+			m_Retired.erase(m_Retired.begin() + i);
+		}
+	}
+
+	void OpenGLBufferArena::DestroyStorage()
+	{
+		for (uint32_t i = 0; i < s_Frames; i++)
+		{
+			if (m_Fences[i] != nullptr)
+				glDeleteSync(m_Fences[i]);
+			m_Fences[i] = nullptr;
+		}
+
+		if (m_RendererID == 0)
+			return;
+
+		if (m_Mapped != nullptr)
+			glUnmapNamedBuffer(m_RendererID);
+		glDeleteBuffers(1, &m_RendererID);
+
+		m_Mapped = nullptr;
+		m_RendererID = 0;
+	}
+
+	void OpenGLBufferArena::Upload(uint64_t offset, const void* data, uint32_t size)
+	{
+		if (m_Mapped != nullptr)
+		{
+			memcpy(m_Mapped + offset, data, size);
+		}
+		else
+		{
+			GLCall(glNamedBufferSubData(m_RendererID, offset, size, data));
+		}
+	}
+
+	void OpenGLBufferArena::EndRegion(uint32_t region)
+	{
+		// All the commands that can use the retired storage have been submitted
+		for (RetiredStorage& storage : m_Retired)
+			if (storage.Fence == nullptr)
+				storage.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		ReleaseRetiredStorage(false);
+
+		if (!m_Persistent)
+			return;
+
+		if (m_Fences[region] != nullptr)
+			glDeleteSync(m_Fences[region]);
+		m_Fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	bool OpenGLBufferArena::BeginRegion(uint32_t region)
+	{
+		if (!m_Persistent)
+		{
+			// Orphan the storage when going back to the first region, the driver keeps the old one for the
+			// commands that are still reading it
+			if (region == 0)
+			{
+				GLCall(glNamedBufferData(m_RendererID, m_RegionSize * s_Frames, nullptr, GL_STREAM_DRAW));
+			}
+			return false;
+		}
+
+		if (m_Fences[region] == nullptr)
+			return false;
+
+		bool stalled = false;
+		GLenum result = glClientWaitSync(m_Fences[region], 0, 0);
+		while (result == GL_TIMEOUT_EXPIRED)
+		{
+			stalled = true;
+			result = glClientWaitSync(m_Fences[region], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+		}
+
+		glDeleteSync(m_Fences[region]);
+		m_Fences[region] = nullptr;
+		return stalled;
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Debut/Rendering/Structures/BufferArena.h>
+#include <glad/glad.h>
+
+namespace Debut
+{
+	class OpenGLBufferArena : public BufferArena
+	{
+	public:
+		OpenGLBufferArena(uint32_t regionSize);
+		virtual ~OpenGLBufferArena();
+
+	protected:
+		virtual uint32_t CreateStorage(uint64_t size) override;
+		virtual void Upload(uint64_t offset, const void* data, uint32_t size) override;
+		virtual void EndRegion(uint32_t region) override;
+		virtual bool BeginRegion(uint32_t region) override;
+
+	private:
+		// Keeps the current storage alive until the GPU is done with the commands of the frame
+		void RetireStorage();
+		void ReleaseRetiredStorage(bool wait);
+		void DestroyStorage();
+
+	private:
+		// Persistently mapped storage when buffer storage is supported, orphaned at every cycle otherwise
+		bool m_Persistent = false;
+		uint8_t* m_Mapped = nullptr;
+		GLsync m_Fences[s_Frames] = { nullptr };
+
+		struct RetiredStorage
+		{
+			uint32_t RendererID;
+			// Created at the end of the frame that retired the storage, the storage is deleted once it signals
+			GLsync Fence;
+		};
+		std::vector<RetiredStorage> m_Retired;
+	};
+}
@@ -2,6 +2,7 @@
 #include "OpenGLFrameBuffer.h"
 #include "OpenGLError.h"
 #include "glad/glad.h"
+#include <Debut/Rendering/Renderer/RenderStateCache.h>
 #include <glm/gtc/type_ptr.hpp>
 
 namespace Debut
@@ -52,7 +53,33 @@ namespace Debut
 
 		static void BindTextures(bool multisampled, uint32_t id)
 		{
+			// Binds to the active unit, which is always the first one
 			GLCall(glBindTexture(TextureTarget(multisampled), id));
+			RenderStateCache::ForgetTextureSlot(0);
+		}
+
+		static void BindFrameBuffer(uint32_t id)
+		{
+			if (RenderStateCache::BindFrameBuffer(id))
+			{
+				GLCall(glBindFramebuffer(GL_FRAMEBUFFER, id));
+			}
+		}
+
+		static void BindTextureUnit(uint32_t slot, uint32_t id)
+		{
+			if (RenderStateCache::BindTexture(slot, id))
+			{
+				GLCall(glBindTextureUnit(slot, id));
+			}
+		}
+
+		static void ForgetFrameBuffer(uint32_t id, const std::vector<uint32_t>& colorAttachments, uint32_t depthAttachment)
+		{
+			RenderStateCache::ForgetFrameBuffer(id);
+			for (uint32_t attachment : colorAttachments)
+				RenderStateCache::ForgetTexture(attachment);
+			RenderStateCache::ForgetTexture(depthAttachment);
 		}
 
 		static void CreateTextures(bool multiSamples, uint32_t* outID, uint32_t count)
@@ -123,6 +150,7 @@ namespace Debut
 
 	OpenGLFrameBuffer::~OpenGLFrameBuffer()
 	{
+		Utils::ForgetFrameBuffer(m_RendererID, m_ColorAttachments, m_DepthAttachment);
 		glDeleteFramebuffers(1, &m_RendererID);
 		glDeleteTextures(m_ColorAttachments.size(), m_ColorAttachments.data());
 		glDeleteTextures(1, &m_DepthAttachment);
@@ -132,6 +160,7 @@ namespace Debut
 	{
 		if (m_RendererID)
 		{
+			Utils::ForgetFrameBuffer(m_RendererID, m_ColorAttachments, m_DepthAttachment);
 			GLCall(glDeleteFramebuffers(1, &m_RendererID));
 			GLCall(glDeleteTextures(m_ColorAttachmentSpecs.size(), m_ColorAttachments.data()));
 			GLCall(glDeleteTextures(1, &m_DepthAttachment));
@@ -141,7 +170,7 @@ namespace Debut
 		}
 
 		GLCall(glCreateFramebuffers(1, &m_RendererID));
-		GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+		Utils::BindFrameBuffer(m_RendererID);
 
 		bool multiSamples = m_Specs.Samples > 1;
 		
@@ -199,7 +228,11 @@ namespace Debut
 		}
 
 		GLCall(DBT_ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Frame buffer is incomplete"));		
-		GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+		Utils::BindFrameBuffer(0);
+
+		// All the supported formats use 4 bytes per sample
+		uint32_t attachments = m_ColorAttachments.size() + (m_DepthAttachment != 0 ? 1 : 0);
+		m_GPUMemory.Resize((uint64_t)m_Specs.Width * m_Specs.Height * std::max(m_Specs.Samples, 1u) * 4 * attachments);
 	}
 
 	void OpenGLFrameBuffer::Resize(uint32_t x, uint32_t y)
@@ -267,37 +300,51 @@ namespace Debut
 		glClearTexImage(m_ColorAttachments[index], 0, Utils::TextureFormatDebutToGL(spec.TextureFormat), GL_INT, &value);
 	}
 
+	void OpenGLFrameBuffer::CopyDepth(const Ref<FrameBuffer>& source)
+	{
+		const OpenGLFrameBuffer& glSource = *(OpenGLFrameBuffer*)source.get();
+		DBT_CORE_ASSERT(glSource.m_Specs.Width == m_Specs.Width && glSource.m_Specs.Height == m_Specs.Height,
+			"Depth can only be copied between frame buffers with the same size");
+
+		// Doesn't bind anything, so the state cache is still valid
+		GLCall(glBlitNamedFramebuffer(glSource.m_RendererID, m_RendererID, 0, 0, m_Specs.Width, m_Specs.Height,
+			0, 0, m_Specs.Width, m_Specs.Height, GL_DEPTH_BUFFER_BIT, GL_NEAREST));
+	}
+
 
 	void OpenGLFrameBuffer::Bind()
 	{
 		m_Bound = true;
-		GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
-		GLCall(glViewport(0, 0, m_Specs.Width, m_Specs.Height));
+		Utils::BindFrameBuffer(m_RendererID);
+		if (RenderStateCache::SetViewport(0, 0, m_Specs.Width, m_Specs.Height))
+		{
+			GLCall(glViewport(0, 0, m_Specs.Width, m_Specs.Height));
+		}
 	}
 
 	void OpenGLFrameBuffer::BindDepth(uint32_t slot)
 	{
-		GLCall(glBindTextureUnit(slot, m_DepthAttachment))
+		Utils::BindTextureUnit(slot, m_DepthAttachment);
 	}
 	void OpenGLFrameBuffer::UnbindDepth(uint32_t slot)
 	{
-		GLCall(glBindTextureUnit(slot, 0));
+		Utils::BindTextureUnit(slot, 0);
 	}
 
 	void OpenGLFrameBuffer::BindAttachment(uint32_t slot, uint32_t index /* =0 */)
 	{
 		DBT_ASSERT(m_ColorAttachments.size() > index && index >= 0);
-		GLCall(glBindTextureUnit(slot, m_ColorAttachments[index]));
+		Utils::BindTextureUnit(slot, m_ColorAttachments[index]);
 	}
 
 	void OpenGLFrameBuffer::BindAsTexture(uint32_t slot)
 	{
-		GLCall(glBindTextureUnit(slot, m_RendererID));
+		Utils::BindTextureUnit(slot, m_RendererID);
 	}
 
 	void OpenGLFrameBuffer::Unbind()
 	{
 		m_Bound = false;
-		GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+		Utils::BindFrameBuffer(0);
 	}
 }
\ No newline at end of file
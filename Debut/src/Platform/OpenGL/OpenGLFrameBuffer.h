@@ -1,5 +1,6 @@
 #pragma once
 #include "Debut/Rendering/Structures/FrameBuffer.h"
+#include "Debut/Core/MemoryTracker.h"
 
 namespace Debut
 {
@@ -12,6 +13,7 @@ namespace Debut
 		virtual void Invalidate() override;
 		virtual void Resize(uint32_t x, uint32_t y) override;
 		virtual void ClearAttachment(uint32_t index, int value) override;
+		virtual void CopyDepth(const Ref<FrameBuffer>& source) override;
 
 		virtual int ReadRedPixel(uint32_t attachmentIndex, int x, int y) override;
 		virtual int ReadDepthPixel(uint32_t index, int x, int y) override { return 0; }
@@ -28,6 +30,7 @@ namespace Debut
 		inline virtual uint32_t GetColorAttachment(int idx = 0) const override { DBT_ASSERT(idx < m_ColorAttachments.size()); return m_ColorAttachments[idx]; }
 		inline virtual uint32_t GetDepthAttachment() const override { return m_DepthAttachment; }
 		inline virtual FrameBufferSpecifications& GetSpecs() override { return m_Specs; }
+		inline uint32_t GetRendererID() const { return m_RendererID; }
 
 	private:
 		uint32_t m_RendererID = 0;
@@ -42,5 +45,7 @@ namespace Debut
 		// Attachment formats
 		std::vector<FrameBufferTextureSpecification> m_ColorAttachmentSpecs;
 		FrameBufferTextureSpecification m_DepthAttachmentSpecs = FrameBufferTextureFormat::None;
+
+		TrackedMemory m_GPUMemory = { MemoryTag::FrameBuffers, MemoryType::GPU };
 	};
 }
@@ -3,6 +3,7 @@
 #include <Debut/Rendering/Structures/VertexArray.h>
 #include <Debut/Rendering/Structures/Buffer.h>
 #include <Platform/OpenGL/OpenGLError.h>
+#include <Debut/Rendering/Renderer/RenderStateCache.h>
 #include <glad/glad.h>
 
 namespace Debut
@@ -47,11 +48,17 @@ namespace Debut
 			break;
 		}
 
-		GLCall(glBindTextureUnit(0, attachment));
+		if (RenderStateCache::BindTexture(0, attachment))
+		{
+			GLCall(glBindTextureUnit(0, attachment));
+		}
 	}
 
 	void OpenGLRenderTexture::UnbindTexture()
 	{
-		GLCall(glBindTextureUnit(0, 0));
+		if (RenderStateCache::BindTexture(0, 0))
+		{
+			GLCall(glBindTextureUnit(0, 0));
+		}
 	}
 }
\ No newline at end of file
@@ -3,15 +3,21 @@
 #include "OpenGLError.h"
 #include <Debut/Rendering/Structures/Buffer.h>
 #include <Debut/Rendering/Structures/VertexArray.h>
+#include <Debut/Rendering/Renderer/RenderStateCache.h>
 #include <glad/glad.h>
 
 namespace Debut
 {
 	void OpenGLRendererAPI::Init()
 	{
+		RenderStateCache::Invalidate();
+
+		RenderStateCache::SetDepthTest(true);
 		GLCall(glEnable(GL_DEPTH_TEST));
 		GLCall(glEnable(GL_LINE_SMOOTH));
+		GLCall(glFrontFace(GL_CCW));
 
+		RenderStateCache::SetBlending(true);
 		GLCall(glEnable(GL_BLEND));
 		GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
 	}
@@ -34,62 +40,92 @@ namespace Debut
 	void OpenGLRendererAPI::EnableCulling()
 	{
 		DBT_PROFILE_FUNCTION();
-		GLCall(glEnable(GL_CULL_FACE));
-		GLCall(glCullFace(GL_BACK));
-		GLCall(glFrontFace(GL_CCW));
+		if (RenderStateCache::SetCulling(true))
+		{
+			GLCall(glEnable(GL_CULL_FACE));
+		}
+		CullBack();
 	}
 
 	void OpenGLRendererAPI::DisableCulling()
 	{
 		DBT_PROFILE_FUNCTION();
-		GLCall(glDisable(GL_CULL_FACE));
+		if (RenderStateCache::SetCulling(false))
+		{
+			GLCall(glDisable(GL_CULL_FACE));
+		}
 	}
 
 	void OpenGLRendererAPI::CullFront()
 	{
-		GLCall(glCullFace(GL_FRONT));
+		if (RenderStateCache::SetCullFront(true))
+		{
+			GLCall(glCullFace(GL_FRONT));
+		}
 	}
 
 	void OpenGLRendererAPI::CullBack()
 	{
-		GLCall(glCullFace(GL_BACK));
+		if (RenderStateCache::SetCullFront(false))
+		{
+			GLCall(glCullFace(GL_BACK));
+		}
 	}
 
+	// Vertex arrays aren't unbound after drawing: the next draw with the same array doesn't need to bind it again
 	void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& va, uint32_t indexCount)
 	{
-		uint64_t count = indexCount == 0 ? va->GetIndexBuffer()->GetCount() : indexCount;
+		uint32_t count = indexCount == 0 ? va->GetIndexBuffer()->GetCount() : indexCount;
+		va->Bind();
+		GLCall(glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr));
+	}
+
+	void OpenGLRendererAPI::DrawIndexedBaseVertex(const Ref<VertexArray>& va, uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex)
+	{
+		va->Bind();
+		GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, (const void*)(sizeof(uint32_t) * firstIndex), baseVertex));
+	}
+
+	void OpenGLRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& va, uint32_t indexCount, uint32_t instanceCount)
+	{
 		va->Bind();
-		GLCall(glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr));
-		va->Unbind();
+		GLCall(glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr, instanceCount));
 	}
 
 	void OpenGLRendererAPI::DrawLines(const Ref<VertexArray>& va, uint32_t vertexCount)
 	{
 		va->Bind();
 		GLCall(glDrawArrays(GL_LINES, 0, vertexCount));
-		va->Unbind();
 	}
 
 	void OpenGLRendererAPI::DrawPoints(const Ref<VertexArray>& va, uint32_t vertexCount)
 	{
 		va->Bind();
 		GLCall(glDrawArrays(GL_POINTS, 0, vertexCount));
-		va->Unbind();
 	}
 
 
 	void OpenGLRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
 	{
-		GLCall(glViewport(x, y, width, height));
+		if (RenderStateCache::SetViewport(x, y, width, height))
+		{
+			GLCall(glViewport(x, y, width, height));
+		}
 	}
 
 	void OpenGLRendererAPI::SetLineWidth(float thickness)
 	{
-		GLCall(glLineWidth(thickness));
+		if (RenderStateCache::SetLineWidth(thickness))
+		{
+			GLCall(glLineWidth(thickness));
+		}
 	}
 
 	void OpenGLRendererAPI::SetPointSize(float thickness)
 	{
-		GLCall(glPointSize(thickness));
+		if (RenderStateCache::SetPointSize(thickness))
+		{
+			GLCall(glPointSize(thickness));
+		}
 	}
 }
\ No newline at end of file
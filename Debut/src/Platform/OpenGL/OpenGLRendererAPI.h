@@ -18,6 +18,8 @@ namespace Debut
 		virtual void CullBack() override;
 
 		virtual void DrawIndexed(const Ref<VertexArray>& va, uint32_t indexCount = 0) override;
+		virtual void DrawIndexedBaseVertex(const Ref<VertexArray>& va, uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex) override;
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& va, uint32_t indexCount, uint32_t instanceCount) override;
 		virtual void DrawLines(const Ref<VertexArray>& va, uint32_t vertexCount) override;
 		virtual void DrawPoints(const Ref<VertexArray>& va, uint32_t vertexCount) override;
 		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
@@ -2,6 +2,7 @@
 #include "OpenGLShader.h"
 #include "OpenGLError.h"
 #include "Debut/Core/Log.h"
+#include "Debut/Rendering/Renderer/RenderStateCache.h"
 #include "glm/gtc/type_ptr.hpp"
 #include <array>
 #include <glad/glad.h>
@@ -34,6 +35,9 @@ namespace Debut
 		case GL_BOOL: return ShaderDataType::Bool;
 		case GL_SAMPLER_2D: return ShaderDataType::Sampler2D;
 		case GL_SAMPLER_CUBE: return ShaderDataType::SamplerCube;
+		case GL_SAMPLER_BUFFER:
+		case GL_INT_SAMPLER_BUFFER:
+		case GL_UNSIGNED_INT_SAMPLER_BUFFER: return ShaderDataType::SamplerBuffer;
 		case GL_FLOAT_MAT3: return ShaderDataType::Mat3;
 		case GL_FLOAT_MAT4: return ShaderDataType::Mat4;
 		}
@@ -148,6 +152,7 @@ namespace Debut
 	OpenGLShader::~OpenGLShader()
 	{
 		DBT_PROFILE_FUNCTION();
+		RenderStateCache::ForgetShader(m_ProgramID);
 		glDeleteProgram(m_ProgramID);
 	}
 
@@ -175,15 +180,18 @@ namespace Debut
 	void OpenGLShader::Bind() const
 	{
 		DBT_PROFILE_FUNCTION();
-		GLCall(glUseProgram(m_ProgramID));
+		if (RenderStateCache::BindShader(m_ProgramID))
+		{
+			GLCall(glUseProgram(m_ProgramID));
+		}
 	}
 
 	void OpenGLShader::Unbind() const
 	{
-		GLCall(glUseProgram(0));
+		// Uniforms are uploaded with glProgramUniform, so nothing depends on the bound program: it stays bound
+		// until another one is used, and binding it again is free
 	}
 
-	// TODO: CACHE THE UNIFORMS!!!
 	std::vector<ShaderUniform> OpenGLShader::GetUniforms() const
 	{
 		DBT_PROFILE_SCOPE("GetUniforms");
@@ -234,6 +242,7 @@ namespace Debut
 			case ShaderDataType::Mat4: placeHolder = glm::mat4(1.0f); break;
 			case ShaderDataType::Sampler2D: placeHolder = (UUID)0; break;
 			case ShaderDataType::SamplerCube: placeHolder = (UUID)0; break;
+			case ShaderDataType::SamplerBuffer: placeHolder = (UUID)0; break;
 			default:break;
 			}
 
@@ -288,84 +297,130 @@ namespace Debut
 		UploadUniformFloat4(name, uniform);
 	}
 
+	int32_t OpenGLShader::GetUniformLocation(const std::string& name)
+	{
+		auto location = m_UniformLocations.find(name);
+		if (location != m_UniformLocations.end())
+			return location->second;
+
+		GLCall(int32_t ret = glGetUniformLocation(m_ProgramID, name.c_str()));
+		m_UniformLocations[name] = ret;
+		return ret;
+	}
+
 	void OpenGLShader::UploadUniformMat3(const std::string& name, const glm::mat3& mat)
 	{
-		GLCall(GLuint location = glGetUniformLocation(m_ProgramID, name.c_str()));
-		GLCall(glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(mat)));
+		int32_t location = GetUniformLocation(name);
+		if (m_UniformValues.Set(location, glm::value_ptr(mat), sizeof(mat)))
+		{
+			GLCall(glProgramUniformMatrix3fv(m_ProgramID, location, 1, GL_FALSE, glm::value_ptr(mat)));
+		}
 	}
 
 	void OpenGLShader::UploadUniformMat4(const std::string& name, const glm::mat4& mat)
 	{
-		GLCall(GLuint location = glGetUniformLocation(m_ProgramID, name.c_str()));
-		GLCall(glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(mat)));
+		int32_t location = GetUniformLocation(name);
+		if (m_UniformValues.Set(location, glm::value_ptr(mat), sizeof(mat)))
+		{
+			GLCall(glProgramUniformMatrix4fv(m_ProgramID, location, 1, GL_FALSE, glm::value_ptr(mat)));
+		}
 	}
 
 	void OpenGLShader::UploadUniformFloat(const std::string& name, float val)
 	{
-		GLCall(GLuint location = glGetUniformLocation(m_ProgramID, name.c_str()));
-		GLCall(glUniform1f(location, val));
+		int32_t location = GetUniformLocation(name);
+		if (m_UniformValues.Set(location, &val, sizeof(val)))
+		{
+			GLCall(glProgramUniform1f(m_ProgramID, location, val));
+		}
 	}
 
 	void OpenGLShader::UploadUniformFloat2(const std::string& name, const glm::vec2& vec)
 	{
-		GLCall(GLuint location = glGetUniformLocation(m_ProgramID, name.c_str()));
-		GLCall(glUniform2f(location, vec.x, vec.y));
+		int32_t location = GetUniformLocation(name);
+		if (m_UniformValues.Set(location, &vec, sizeof(vec)))
+		{
+			GLCall(glProgramUniform2f(m_ProgramID, location, vec.x, vec.y));
+		}
 	}
 
 	void OpenGLShader::UploadUniformFloat3(const std::string& name, const glm::vec3& vec)
 	{
-		GLCall(GLuint location = glGetUniformLocation(m_ProgramID, name.c_str()));
-		GLCall(glUniform3f(location, vec.x, vec.y, vec.z));
+		int32_t location = GetUniformLocation(name);
+		if (m_UniformValues.Set(location, &vec, sizeof(vec)))
+		{
+			GLCall(glProgramUniform3f(m_ProgramID, location, vec.x, vec.y, vec.z));
+		}
 	}
 
 	void OpenGLShader::UploadUniformFloat4(const std::string& name, const glm::vec4& vec)
 	{
-		GLCall(GLuint location = glGetUniformLocation(m_ProgramID, name.c_str()));
-		GLCall(glUniform4f(location, vec.x, vec.y, vec.z, vec.w));
+		int32_t location = GetUniformLocation(name);
+		if (m_UniformValues.Set(location, &vec, sizeof(vec)))
+		{
+			GLCall(glProgramUniform4f(m_ProgramID, location, vec.x, vec.y, vec.z, vec.w));
+		}
 	}
 	
 
 	void OpenGLShader::UploadUniformBool(const std::string& name, bool val)
 	{
-		GLuint location = glGetUniformLocation(m_ProgramID, name.c_str());
-		glUniform1i(location, val);
+		UploadUniformInt(name, val);
 	}
 
 
 	void OpenGLShader::UploadUniformInt(const std::string& name, int val)
 	{
-		GLuint location = glGetUniformLocation(m_ProgramID, name.c_str());
-		glUniform1i(location, val);
+		int32_t location = GetUniformLocation(name);
+		if (m_UniformValues.Set(location, &val, sizeof(val)))
+		{
+			GLCall(glProgramUniform1i(m_ProgramID, location, val));
+		}
 	}
 
 	void OpenGLShader::UploadUniformInt2(const std::string& name, const glm::ivec2& vec)
 	{
-		GLCall(GLuint location = glGetUniformLocation(m_ProgramID, name.c_str()));
-		GLCall(glUniform2i(location, vec.x, vec.y));
+		int32_t location = GetUniformLocation(name);
+		if (m_UniformValues.Set(location, &vec, sizeof(vec)))
+		{
+			GLCall(glProgramUniform2i(m_ProgramID, location, vec.x, vec.y));
+		}
 	}
 
 	void OpenGLShader::UploadUniformInt3(const std::string& name, const glm::ivec3& vec)
 	{
-		GLCall(GLuint location = glGetUniformLocation(m_ProgramID, name.c_str()));
-		GLCall(glUniform3i(location, vec.x, vec.y, vec.z));
+		int32_t location = GetUniformLocation(name);
+		if (m_UniformValues.Set(location, &vec, sizeof(vec)))
+		{
+			GLCall(glProgramUniform3i(m_ProgramID, location, vec.x, vec.y, vec.z));
+		}
 	}
 
 	void OpenGLShader::UploadUniformInt4(const std::string& name, const glm::ivec4& vec)
 	{
-		GLCall(GLuint location = glGetUniformLocation(m_ProgramID, name.c_str()));
-		GLCall(glUniform4i(location, vec.x, vec.y, vec.z, vec.w));
+		int32_t location = GetUniformLocation(name);
+		if (m_UniformValues.Set(location, &vec, sizeof(vec)))
+		{
+			GLCall(glProgramUniform4i(m_ProgramID, location, vec.x, vec.y, vec.z, vec.w));
+		}
 	}
 
 	void OpenGLShader::UploadUniformIntArray(const std::string& name, int* data, uint32_t count)
 	{
-		GLCall(GLuint location = glGetUniformLocation(m_ProgramID, name.c_str()));
-		GLCall(glUniform1iv(location, count, data));
+		int32_t location = GetUniformLocation(name);
+		if (m_UniformValues.Set(location, data, sizeof(int) * count))
+		{
+			GLCall(glProgramUniform1iv(m_ProgramID, location, count, data));
+		}
 	}
 
 	void OpenGLShader::UploadUniformFloatArray(const std::string& name, float* data, uint32_t count)
 	{
-		GLCall(GLuint location = glGetUniformLocation(m_ProgramID, name.c_str()));
-		GLCall(glUniform1fv(location, count, data));
+		int32_t location = GetUniformLocation(name);
+		if (m_UniformValues.Set(location, data, sizeof(float) * count))
+		{
+			GLCall(glProgramUniform1fv(m_ProgramID, location, count, data));
+		}
 	}
 
 	void OpenGLShader::CheckCompileError(unsigned int shader)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Debut/Rendering/Shader.h"
+#include "Debut/Rendering/Renderer/RenderStateCache.h"
 #include <glm/glm.hpp>
 
 typedef unsigned int GLenum;
@@ -57,8 +58,13 @@ namespace Debut
 		void CheckCompileError(unsigned int shader);
 		void CheckLinkingError(unsigned int program);
 
+		int32_t GetUniformLocation(const std::string& name);
+
 	private:
 		unsigned int m_ProgramID;
 		std::string m_Name;
+
+		std::unordered_map<std::string, int32_t> m_UniformLocations;
+		UniformCache m_UniformValues;
 	};
 }
@@ -1,5 +1,6 @@
 #include <Platform/OpenGL/OpenGLSkybox.h>
 #include <Platform/OpenGL/OpenGLError.h>
+#include <Debut/Rendering/Renderer/RenderStateCache.h>
 #include <Debut/AssetManager/AssetManager.h>
 #include <stb_image.h>
 
@@ -13,14 +14,17 @@ namespace Debut
             GL_TEXTURE_CUBE_MAP_POSITIVE_X, GL_TEXTURE_CUBE_MAP_POSITIVE_Y, GL_TEXTURE_CUBE_MAP_NEGATIVE_Y };
         GLCall(glGenTextures(1, &m_RendererID));
         GLCall(glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID));
+        RenderStateCache::ForgetTextureSlot(0);
         stbi_set_flip_vertically_on_load(0);
 
         int width, height, nrChannels;
+        uint64_t gpuSize = 0;
         for (unsigned int i = 0; i < faces.size(); i++)
         {
             unsigned char* data = stbi_load(facesPaths[i].c_str(), &width, &height, &nrChannels, 0);
             if (data)
             {
+                gpuSize += (uint64_t)width * height * 4;
                 if (nrChannels == 4)
                 {
                     GLCall(glTexImage2D(faces[i], 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data));
@@ -43,24 +47,35 @@ namespace Debut
         GLCall(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
         GLCall(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
         GLCall(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE));
+        m_GPUMemory.Resize(gpuSize);
 	}
 
 	OpenGLSkybox::~OpenGLSkybox()
 	{
         Log.CoreInfo("Skybox destroyed");
+        RenderStateCache::ForgetTexture(m_RendererID);
         GLCall(glDeleteTextures(1, &m_RendererID));
 	}
 
     void OpenGLSkybox::Bind()
     {
+        // The cube map is bound to the active unit, which is always the first one
         glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
-        GLCall(glDepthMask(GL_FALSE));
+        RenderStateCache::ForgetTextureSlot(0);
+        if (RenderStateCache::SetDepthWrite(false))
+        {
+            GLCall(glDepthMask(GL_FALSE));
+        }
     }
 
     void OpenGLSkybox::Unbind()
     {
         glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
-        GLCall(glDepthMask(GL_TRUE));
+        RenderStateCache::ForgetTextureSlot(0);
+        if (RenderStateCache::SetDepthWrite(true))
+        {
+            GLCall(glDepthMask(GL_TRUE));
+        }
     }
 
     void OpenGLSkybox::Reload()
@@ -71,7 +86,10 @@ namespace Debut
         m_ID = config.ID;
 
         if (m_RendererID != 0)
+        {
+            RenderStateCache::ForgetTexture(m_RendererID);
             glDeleteTextures(1, &m_RendererID);
+        }
 
         std::vector<std::string> facesPaths = { AssetManager::GetPath(config.Textures[SkyboxTexture::Front]), 
             AssetManager::GetPath(config.Textures[SkyboxTexture::Bottom]),
@@ -84,14 +102,17 @@ namespace Debut
             GL_TEXTURE_CUBE_MAP_POSITIVE_X, GL_TEXTURE_CUBE_MAP_POSITIVE_Y, GL_TEXTURE_CUBE_MAP_NEGATIVE_Y };
         GLCall(glGenTextures(1, &m_RendererID));
         GLCall(glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID));
+        RenderStateCache::ForgetTextureSlot(0);
         stbi_set_flip_vertically_on_load(0);
 
         int width, height, nrChannels;
+        uint64_t gpuSize = 0;
         for (unsigned int i = 0; i < faces.size(); i++)
         {
             unsigned char* data = stbi_load(facesPaths[i].c_str(), &width, &height, &nrChannels, 0);
             if (data)
             {
+                gpuSize += (uint64_t)width * height * 4;
                 if (nrChannels == 4)
                 {
                     GLCall(glTexImage2D(faces[i], 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data));
@@ -114,5 +135,6 @@ namespace Debut
         GLCall(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
         GLCall(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
         GLCall(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE));
+        m_GPUMemory.Resize(gpuSize);
     }
 }
\ No newline at end of file
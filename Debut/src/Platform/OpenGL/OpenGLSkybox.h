@@ -2,6 +2,7 @@
 
 #include <glad/glad.h>
 #include <Debut/Rendering/Resources/Skybox.h>
+#include <Debut/Core/MemoryTracker.h>
 
 namespace Debut
 {
@@ -22,5 +23,6 @@ namespace Debut
 
 	private:
 		GLuint m_RendererID = 0;
+		TrackedMemory m_GPUMemory = { MemoryTag::Skyboxes, MemoryType::GPU };
 	};
 }
\ No newline at end of file
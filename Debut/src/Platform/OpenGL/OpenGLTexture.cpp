@@ -1,11 +1,35 @@
 #include "Debut/dbtpch.h"
 #include "OpenGLTexture.h"
-#include <stb_image.h>
 #include <Debut/Core/Log.h>
+#include <Debut/AssetManager/TextureImporter.h>
+#include <Debut/Utils/PlatformUtils.h>
 #include "OpenGLError.h"
+#include <Debut/Rendering/Renderer/RenderStateCache.h>
+
+// S3TC is an extension, glad only exposes the core formats
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+	#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT		0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+	#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT	0x83F3
+#endif
 
 namespace Debut
 {
+	static GLenum CookedToGLFormat(CookedTextureFormat format)
+	{
+		switch (format)
+		{
+		case CookedTextureFormat::RGBA8: return GL_RGBA8;
+		case CookedTextureFormat::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+		case CookedTextureFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		case CookedTextureFormat::BC4: return GL_COMPRESSED_RED_RGTC1;
+		case CookedTextureFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+		case CookedTextureFormat::BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+		default: DBT_ASSERT(false, "Couldn't convert cooked texture format to GL"); return GL_NONE;
+		}
+	}
+
 	static GLenum DbtToGLParameter(Texture2DParameter parameter)
 	{
 		switch (parameter)
@@ -18,98 +42,116 @@ namespace Debut
 		}
 	}
 
-	OpenGLTexture2D::OpenGLTexture2D(const std::string& path, Texture2DConfig config) : m_Path(path)
+	static GLenum DbtToGLMinFilter(Texture2DParameter parameter, bool mipmaps)
+	{
+		if (!mipmaps)
+			return DbtToGLParameter(parameter);
+		return parameter == Texture2DParameter::FILTERING_POINT ? GL_NEAREST_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_LINEAR;
+	}
+
+	OpenGLTexture2D::OpenGLTexture2D(const std::string& path, Texture2DConfig config) : m_Path(path), m_RendererID(0)
 	{
 		DBT_PROFILE_FUNCTION();
+		Load(config);
+	}
 
-		int width, height, channels;
-		stbi_uc* data = nullptr;
-		stbi_set_flip_vertically_on_load(1);
+	void OpenGLTexture2D::Reload()
+	{
+		DBT_PROFILE_FUNCTION();
+		Texture2DConfig config = OpenGLTexture2D::GetConfig(m_Path + ".meta");
 
+		if (m_RendererID != 0)
 		{
-			DBT_PROFILE_SCOPE("OpenGLTexture2D::OpenGLTexture2D(const std::string&)");
-			data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+			RenderStateCache::ForgetTexture(m_RendererID);
+			glDeleteTextures(1, &m_RendererID);
 		}
+		m_RendererID = 0;
 
-		m_Width = width;
-		m_Height = height;
+		Load(config);
+	}
+
+	void OpenGLTexture2D::Load(const Texture2DConfig& config)
+	{
 		m_FilteringMode = config.Filtering;
 		m_WrapMode = config.WrapMode;
+		m_Mipmaps = config.Mipmaps;
+		m_SRGB = config.SRGB;
+		m_Compression = config.Compression;
+		m_Quality = config.Quality;
 		m_ID = config.ID;
 
-		if (channels == 4)
+		// Use the cooked texture if it's up to date, otherwise cook it again from the source
+		std::string cookedPath = TextureImporter::GetCookedPath(m_ID);
 		{
-			m_InternalFormat = GL_RGBA8;
-			m_Format = GL_RGBA;
+			MappedFile cooked(cookedPath);
+			if (TextureImporter::IsCookedValid(m_Path, config, cooked.GetData(), cooked.GetSize()) &&
+				Upload(cooked.GetData(), cooked.GetSize()))
+				return;
 		}
-		else if (channels == 3)
+
+		if (TextureImporter::CookTexture(m_Path, config))
 		{
-			m_InternalFormat = GL_RGB8;
-			m_Format = GL_RGB;
+			MappedFile cooked(cookedPath);
+			if (Upload(cooked.GetData(), cooked.GetSize()))
+				return;
 		}
 
-		DBT_CORE_ASSERT(m_Format != 0 && m_InternalFormat != 0, "Texture format not supported");
-
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-		glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
-
-		GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, DbtToGLParameter(config.Filtering)));
-		GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, DbtToGLParameter(config.Filtering)));
-		
-		GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, DbtToGLParameter(config.WrapMode)));
-		GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, DbtToGLParameter(config.WrapMode)));
-
-		GLCall(glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_Format, GL_UNSIGNED_BYTE, data));
-		GLCall(glGenerateMipmap(GL_TEXTURE_2D));
-
-		stbi_image_free(data);
+		Log.CoreError("Couldn't load texture {0}", m_Path);
+		DBT_CORE_ASSERT(false, "Failed to load texture");
 	}
 
-	void OpenGLTexture2D::Reload()
+	bool OpenGLTexture2D::Upload(const uint8_t* data, size_t size)
 	{
-		Texture2DConfig config = OpenGLTexture2D::GetConfig(m_Path + ".meta");
-
-		m_FilteringMode = config.Filtering;
-		m_WrapMode = config.WrapMode;
-
-		int width, height, channels;
-		stbi_uc* data = nullptr;
-		stbi_set_flip_vertically_on_load(1);
-
-		{
-			DBT_PROFILE_SCOPE("OpenGLTexture2D::OpenGLTexture2D(const std::string&)");
-			data = stbi_load(m_Path.c_str(), &width, &height, &channels, 0);
-		}
-
-		DBT_CORE_ASSERT(data, "Failed to load png image");
+		DBT_PROFILE_FUNCTION();
 
-		if (channels == 4)
-		{
-			m_InternalFormat = GL_RGBA8;
-			m_Format = GL_RGBA;
-		}
-		else if (channels == 3)
-		{
-			m_InternalFormat = GL_RGB8;
-			m_Format = GL_RGB;
-		}
+		const CookedTextureHeader* header = TextureImporter::GetHeader(data, size);
+		if (header == nullptr)
+			return false;
+		const CookedTextureLevel* levels = TextureImporter::GetLevels(data);
 
-		DBT_CORE_ASSERT(m_Format != 0 && m_InternalFormat != 0, "Png texture format not supported");
-		if (m_RendererID != 0)
-			glDeleteTextures(1, &m_RendererID);
+		m_Width = header->Width;
+		m_Height = header->Height;
+		m_InternalFormat = CookedToGLFormat(header->Format);
+		m_Format = GL_RGBA;
 
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-		glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
+		glTextureStorage2D(m_RendererID, header->NumLevels, m_InternalFormat, m_Width, m_Height);
 
-		GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, DbtToGLParameter(m_FilteringMode)));
+		GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, DbtToGLMinFilter(m_FilteringMode, header->NumLevels > 1)));
 		GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, DbtToGLParameter(m_FilteringMode)));
+		GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_MAX_LEVEL, header->NumLevels - 1));
 
 		GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, DbtToGLParameter(m_WrapMode)));
 		GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, DbtToGLParameter(m_WrapMode)));
 
-		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_Format, GL_UNSIGNED_BYTE, data);
+		// Show masks as grayscale instead of red
+		if (header->Format == CookedTextureFormat::BC4)
+		{
+			GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_SWIZZLE_G, GL_RED));
+			GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_SWIZZLE_B, GL_RED));
+		}
+
+		// Levels are tightly packed RGBA rows, small levels would break the default 4 byte alignment otherwise
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		uint64_t gpuSize = 0;
+		for (uint32_t i = 0; i < header->NumLevels; i++)
+		{
+			gpuSize += levels[i].Size;
+			if (header->Format == CookedTextureFormat::RGBA8)
+			{
+				GLCall(glTextureSubImage2D(m_RendererID, i, 0, 0, levels[i].Width, levels[i].Height, m_Format, GL_UNSIGNED_BYTE,
+					data + levels[i].Offset));
+			}
+			else
+			{
+				GLCall(glCompressedTextureSubImage2D(m_RendererID, i, 0, 0, levels[i].Width, levels[i].Height, m_InternalFormat,
+					(GLsizei)levels[i].Size, data + levels[i].Offset));
+			}
+		}
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		m_GPUMemory.Resize(gpuSize);
 
-		stbi_image_free(data);
+		return true;
 	}
 
 	OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height) : m_Width(width), m_Height(height)
@@ -128,10 +170,12 @@ namespace Debut
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
 		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_Format, GL_UNSIGNED_BYTE, (void*)&data);
+		m_GPUMemory.Resize((uint64_t)m_Width * m_Height * 4);
 	}
 
 	OpenGLTexture2D::~OpenGLTexture2D()
 	{
+		RenderStateCache::ForgetTexture(m_RendererID);
 		glDeleteTextures(1, &m_RendererID);
 	}
 
@@ -142,7 +186,10 @@ namespace Debut
 
 	void OpenGLTexture2D::Bind(uint32_t slot) const
 	{
-		GLCall(glBindTextureUnit(slot, m_RendererID));
+		if (RenderStateCache::BindTexture(slot, m_RendererID))
+		{
+			GLCall(glBindTextureUnit(slot, m_RendererID));
+		}
 	}
 
 }
\ No newline at end of file
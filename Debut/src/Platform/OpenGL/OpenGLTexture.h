@@ -2,6 +2,7 @@
 
 #include <glad/glad.h>
 #include "Debut/Rendering/Texture.h"
+#include "Debut/Core/MemoryTracker.h"
 
 namespace Debut
 {
@@ -25,7 +26,9 @@ namespace Debut
 
 		virtual bool operator==(const Texture& other) const override{ return ((OpenGLTexture2D&)other).GetRendererID() == m_RendererID; }
 
-		
+	private:
+		void Load(const Texture2DConfig& config);
+		bool Upload(const uint8_t* data, size_t size);
 
 	private:
 		std::string m_Path;
@@ -35,6 +38,8 @@ namespace Debut
 		uint32_t m_Height;
 		GLenum m_InternalFormat;
 		GLenum m_Format;
+
+		TrackedMemory m_GPUMemory = { MemoryTag::Textures, MemoryType::GPU };
 	};
 }
 
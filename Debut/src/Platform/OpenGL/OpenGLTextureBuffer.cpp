@@ -0,0 +1,71 @@
+#include "Debut/dbtpch.h"
+#include <glad/glad.h>
+#include "OpenGLTextureBuffer.h"
+#include "OpenGLError.h"
+#include <Debut/Rendering/Renderer/RenderStateCache.h>
+
+namespace Debut
+{
+	static GLenum TextureBufferFormatToGL(TextureBufferFormat format)
+	{
+		switch (format)
+		{
+		case TextureBufferFormat::R32UI:	return GL_R32UI;
+		case TextureBufferFormat::RG32UI:	return GL_RG32UI;
+		case TextureBufferFormat::RGBA32F:	return GL_RGBA32F;
+		}
+
+		DBT_CORE_ASSERT(false, "Unrecognized texture buffer format");
+		return GL_R32UI;
+	}
+
+	OpenGLTextureBuffer::OpenGLTextureBuffer(TextureBufferFormat format) : m_Format(format)
+	{
+		GLCall(glCreateTextures(GL_TEXTURE_BUFFER, 1, &m_RendererID));
+		// Empty buffers can't be attached
+		Reserve(256);
+	}
+
+	OpenGLTextureBuffer::~OpenGLTextureBuffer()
+	{
+		RenderStateCache::ForgetTexture(m_RendererID);
+		glDeleteTextures(1, &m_RendererID);
+		glDeleteBuffers(1, &m_BufferID);
+	}
+
+	void OpenGLTextureBuffer::SetData(const void* data, uint32_t size)
+	{
+		DBT_PROFILE_FUNCTION();
+		if (size > m_Capacity)
+			Reserve(size);
+		if (size > 0)
+		{
+			GLCall(glNamedBufferSubData(m_BufferID, 0, size, data));
+		}
+	}
+
+	void OpenGLTextureBuffer::Bind(uint32_t slot) const
+	{
+		if (RenderStateCache::BindTexture(slot, m_RendererID))
+		{
+			GLCall(glBindTextureUnit(slot, m_RendererID));
+		}
+	}
+
+	void OpenGLTextureBuffer::Reserve(uint32_t size)
+	{
+		uint32_t capacity = std::max(m_Capacity, 256u);
+		while (capacity < size)
+			capacity *= 2;
+
+		// A new buffer is attached to the texture, the old content isn't needed
+		if (m_BufferID != 0)
+			glDeleteBuffers(1, &m_BufferID);
+		GLCall(glCreateBuffers(1, &m_BufferID));
+		GLCall(glNamedBufferData(m_BufferID, capacity, nullptr, GL_DYNAMIC_DRAW));
+		GLCall(glTextureBuffer(m_RendererID, TextureBufferFormatToGL(m_Format), m_BufferID));
+
+		m_Capacity = capacity;
+		m_GPUMemory.Resize(capacity);
+	}
+}
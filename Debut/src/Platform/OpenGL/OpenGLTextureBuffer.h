@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Debut/Rendering/Structures/TextureBuffer.h"
+#include "Debut/Core/MemoryTracker.h"
+
+namespace Debut
+{
+	class OpenGLTextureBuffer : public TextureBuffer
+	{
+	public:
+		OpenGLTextureBuffer(TextureBufferFormat format);
+		virtual ~OpenGLTextureBuffer();
+
+		virtual void SetData(const void* data, uint32_t size) override;
+		virtual void Bind(uint32_t slot) const override;
+
+		virtual inline uint32_t GetRendererID() const override { return m_RendererID; }
+
+	private:
+		void Reserve(uint32_t size);
+
+	private:
+		TextureBufferFormat m_Format;
+		// The texture is the object bound to the shaders, the buffer contains the data
+		uint32_t m_RendererID = 0;
+		uint32_t m_BufferID = 0;
+		uint32_t m_Capacity = 0;
+
+		TrackedMemory m_GPUMemory = { MemoryType::GPU };
+	};
+}
@@ -4,6 +4,7 @@
 #include <Debut/Rendering/Structures/Buffer.h>
 #include <Debut/Rendering/Shader.h>
 #include <Platform/OpenGL/OpenGLError.h>
+#include <Debut/Rendering/Renderer/RenderStateCache.h>
 
 namespace Debut
 {
@@ -38,6 +39,7 @@ namespace Debut
 
 	OpenGLVertexArray::~OpenGLVertexArray()
 	{
+		RenderStateCache::ForgetVertexArray(m_RendererID);
 		glDeleteVertexArrays(1, &m_RendererID);
 	}
 
@@ -50,25 +52,36 @@ namespace Debut
 	void OpenGLVertexArray::Bind() const
 	{
 		DBT_PROFILE_FUNCTION();
-		GLCall(glBindVertexArray(m_RendererID));
-		if (m_IndexBuffer != nullptr)
-			m_IndexBuffer->Bind();
+		if (RenderStateCache::BindVertexArray(m_RendererID))
+		{
+			GLCall(glBindVertexArray(m_RendererID));
+		}
+
+		for (uint32_t i = 0; i < m_VertexBuffers.size(); i++)
+		{
+			std::pair<uint32_t, uint32_t> binding = { m_VertexBuffers[i]->GetRendererID(), m_VertexBuffers[i]->GetOffset() };
+			if (binding != m_Bindings[i])
+			{
+				GLCall(glVertexArrayVertexBuffer(m_RendererID, i, binding.first, binding.second,
+					m_VertexBuffers[i]->GetLayout().GetStride()));
+				m_Bindings[i] = binding;
+			}
+		}
 	}
 
 	void OpenGLVertexArray::Unbind() const
 	{
-		if (m_IndexBuffer != nullptr)
-			m_IndexBuffer->Unbind();
-		glBindVertexArray(0);
+		// Arrays are only modified with DSA calls, so the bound one can stay bound until the next draw
 	}
 
-	void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& buffer)
+	void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& buffer, bool instanced)
 	{
-		GLCall(glBindVertexArray(m_RendererID));
-		buffer->Bind();
+		// Every buffer has its own binding point, the buffer is attached to it when the array is bound
+		uint32_t binding = m_VertexBuffers.size();
 
 		for (const auto& element : buffer->GetLayout())
 		{
+			GLCall(glEnableVertexArrayAttrib(m_RendererID, m_AttributeIndex));
 			switch (element.Type)
 			{
 				case ShaderDataType::Float:
@@ -78,10 +91,8 @@ namespace Debut
 				case ShaderDataType::Mat3:
 				case ShaderDataType::Mat4:
 				{
-					GLCall(glEnableVertexAttribArray(m_AttributeIndex));
-					GLCall(glVertexAttribPointer(m_AttributeIndex, element.GetComponentCount(), ShaderAttribTypeToOpenGL(element.Type),
-						element.Normalized ? GL_TRUE : GL_FALSE, buffer->GetLayout().GetStride(), (const void*)element.Offset));
-					m_AttributeIndex++;
+					GLCall(glVertexArrayAttribFormat(m_RendererID, m_AttributeIndex, element.GetComponentCount(),
+						ShaderAttribTypeToOpenGL(element.Type), element.Normalized ? GL_TRUE : GL_FALSE, element.Offset));
 				}
 				break;
 				case ShaderDataType::Int:
@@ -90,24 +101,28 @@ namespace Debut
 				case ShaderDataType::Int4:
 				case ShaderDataType::Bool:
 				{
-					glEnableVertexAttribArray(m_AttributeIndex);
-					glVertexAttribIPointer(m_AttributeIndex, element.GetComponentCount(), ShaderAttribTypeToOpenGL(element.Type),
-						buffer->GetLayout().GetStride(), (const void*)element.Offset);
-					m_AttributeIndex++;
+					GLCall(glVertexArrayAttribIFormat(m_RendererID, m_AttributeIndex, element.GetComponentCount(),
+						ShaderAttribTypeToOpenGL(element.Type), element.Offset));
 				}
 				break;
-
 			}
+
+			GLCall(glVertexArrayAttribBinding(m_RendererID, m_AttributeIndex, binding));
+			m_AttributeIndex++;
+		}
+
+		if (instanced)
+		{
+			GLCall(glVertexArrayBindingDivisor(m_RendererID, binding, 1));
 		}
+
 		m_VertexBuffers.push_back(buffer);
-		buffer->Unbind();
-		glBindVertexArray(0);
+		m_Bindings.push_back({ 0, 0 });
 	}
 	
 	void OpenGLVertexArray::AddIndexBuffer(const Ref<IndexBuffer>& buffer)
 	{
-		glBindVertexArray(m_RendererID);
 		m_IndexBuffer = buffer;
-		glBindVertexArray(0);
+		GLCall(glVertexArrayElementBuffer(m_RendererID, buffer->GetRendererID()));
 	}
 }
@@ -12,7 +12,7 @@ namespace Debut
 		virtual void Bind() const override;
 		virtual void Unbind() const override;
 
-		virtual void AddVertexBuffer(const Ref<VertexBuffer>& buffer) override;
+		virtual void AddVertexBuffer(const Ref<VertexBuffer>& buffer, bool instanced = false) override;
 		virtual void AddIndexBuffer(const Ref<IndexBuffer>& buffer)  override;
 
 		virtual const std::vector<Ref<VertexBuffer>> GetVertexBuffers() const override { return m_VertexBuffers; }
@@ -21,6 +21,8 @@ namespace Debut
 		uint32_t m_RendererID;
 		uint32_t m_AttributeIndex = 0;
 		std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+		// Buffer and offset attached to each binding point, dynamic buffers are attached again when they move
+		mutable std::vector<std::pair<uint32_t, uint32_t>> m_Bindings;
 		Ref<IndexBuffer> m_IndexBuffer;
 	};
 }
@@ -50,4 +50,35 @@ namespace Debut
 
 		return std::string();
 	}
+
+	MappedFile::MappedFile(const std::string& path)
+	{
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return;
+		m_File = file;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+			return;
+
+		m_Mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (m_Mapping == NULL)
+			return;
+
+		m_Data = (const uint8_t*)MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0);
+		if (m_Data != nullptr)
+			m_Size = (size_t)size.QuadPart;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (m_Data != nullptr)
+			UnmapViewOfFile(m_Data);
+		if (m_Mapping != nullptr)
+			CloseHandle(m_Mapping);
+		if (m_File != nullptr)
+			CloseHandle(m_File);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include <Benchmark.h>
+
+#include <Debut/AssetManager/AssetCache.h>
+#include <Debut/AssetManager/AssetManager.h>
+#include <Debut/AssetManager/TextureCompressor.h>
+#include <Debut/Rendering/Resources/Mesh.h>
+
+#include <filesystem>
+#include <cmath>
+
+namespace Debut
+{
+	// Compresses a noisy gradient, then decompresses it and checks the error of the channels stored by the format
+	static void CompressAndVerify(BenchmarkContext& context, CookedTextureFormat format, Texture2DParameter quality,
+		uint32_t channels, bool alpha, double maxError)
+	{
+		const uint32_t size = 256;
+		std::vector<uint8_t> pixels((size_t)size * size * 4);
+		for (uint32_t y = 0; y < size; y++)
+		{
+			for (uint32_t x = 0; x < size; x++)
+			{
+				uint8_t* pixel = &pixels[((size_t)y * size + x) * 4];
+				for (uint32_t c = 0; c < 4; c++)
+				{
+					int noise = (int)context.RandomInt(0, 8) - 4;
+					int gradient = c == 0 ? x : c == 1 ? y : (x + y) / 2;
+					pixel[c] = (uint8_t)std::clamp(gradient + noise, 0, 255);
+				}
+				if (!alpha)
+					pixel[3] = 255;
+			}
+		}
+
+		std::vector<uint8_t> compressed(TextureCompressor::GetCompressedSize(size, size, format));
+		context.Measure([&]()
+			{
+				TextureCompressor::Compress(pixels.data(), size, size, format, quality, compressed.data());
+			}, (uint64_t)size * size);
+
+		std::vector<uint8_t> decompressed(pixels.size());
+		TextureCompressor::Decompress(compressed.data(), size, size, format, decompressed.data());
+
+		// Root mean square error of the stored channels
+		double error = 0.0;
+		for (size_t i = 0; i < (size_t)size * size; i++)
+		{
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				if (c >= channels && !(c == 3 && alpha))
+					continue;
+				double difference = (double)pixels[i * 4 + c] - decompressed[i * 4 + c];
+				error += difference * difference;
+			}
+		}
+		error = std::sqrt(error / ((double)size * size * (channels + (alpha && channels < 4 ? 1 : 0))));
+
+		if (error > maxError)
+			context.Fail("the round trip error is " + std::to_string(error) + ", expected at most " + std::to_string(maxError));
+	}
+
+	DBT_BENCHMARK(TextureCompressBC1)
+	{
+		CompressAndVerify(context, CookedTextureFormat::BC1, Texture2DParameter::QUALITY_NORMAL, 3, false, 6.0);
+	}
+
+	DBT_BENCHMARK(TextureCompressBC3)
+	{
+		CompressAndVerify(context, CookedTextureFormat::BC3, Texture2DParameter::QUALITY_NORMAL, 3, true, 6.0);
+	}
+
+	DBT_BENCHMARK(TextureCompressBC4)
+	{
+		CompressAndVerify(context, CookedTextureFormat::BC4, Texture2DParameter::QUALITY_NORMAL, 1, false, 2.0);
+	}
+
+	DBT_BENCHMARK(TextureCompressBC5)
+	{
+		CompressAndVerify(context, CookedTextureFormat::BC5, Texture2DParameter::QUALITY_NORMAL, 2, false, 2.0);
+	}
+
+	DBT_BENCHMARK(TextureCompressBC7)
+	{
+		CompressAndVerify(context, CookedTextureFormat::BC7, Texture2DParameter::QUALITY_HIGH, 4, true, 4.0);
+	}
+
+	DBT_BENCHMARK(AssetCacheLookup)
+	{
+		const uint32_t assets = 4096;
+		const uint32_t lookups = 4096;
+		AssetCache<std::string, Ref<uint32_t>> cache("Benchmark");
+		std::vector<std::string> keys(lookups);
+
+		// Same kind of keys the asset manager uses
+		for (uint32_t i = 0; i < assets; i++)
+			cache.Put("assets\\textures\\texture-" + std::to_string(i) + ".png", CreateRef<uint32_t>(i));
+		for (uint32_t i = 0; i < lookups; i++)
+			keys[i] = "assets\\textures\\texture-" + std::to_string(context.RandomInt(0, assets - 1)) + ".png";
+
+		// Same pattern as AssetManager::Request
+		context.Measure([&]()
+			{
+				for (auto& key : keys)
+				{
+					if (cache.Has(key))
+						DoNotOptimize(cache.Get(key));
+				}
+			}, lookups);
+	}
+
+	DBT_BENCHMARK(MeshLoad)
+	{
+		const uint32_t vertices = 65536;
+		std::vector<float> positions(vertices * 3), colors(vertices * 4), normals(vertices * 3), tangents(vertices * 3),
+			bitangents(vertices * 3);
+		std::vector<std::vector<float>> texCoords = { std::vector<float>(vertices * 3) };
+		std::vector<int> indices(vertices * 3);
+
+		for (auto buffer : { &positions, &colors, &normals, &tangents, &bitangents, &texCoords[0] })
+			for (auto& value : *buffer)
+				value = context.RandomFloat(-1, 1);
+		for (auto& index : indices)
+			index = context.RandomInt(0, vertices - 1);
+
+		Mesh mesh;
+		mesh.SetID(context.GetRandom()());
+		mesh.SetPath(context.GetTempPath("Benchmark.mesh"));
+		mesh.SaveSettings(positions, colors, normals, tangents, bitangents, texCoords, indices);
+
+		// Reads and decompresses the buffers, then creates the (null) GPU buffers
+		context.Measure([&]() { mesh.Load(mesh.GetPath()); }, vertices);
+
+		std::error_code error;
+		std::filesystem::remove(AssetManager::s_MetadataDir + std::to_string(mesh.GetID()) + ".meta", error);
+	}
+}
@@ -0,0 +1,228 @@
+#include <Benchmark.h>
+
+#include <Debut/Core/Log.h>
+
+#include <atomic>
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <filesystem>
+
+static std::atomic<uint64_t> s_Allocations = 0;
+static std::atomic<uint64_t> s_AllocatedBytes = 0;
+
+static void CountAllocation(size_t size)
+{
+	s_Allocations.fetch_add(1, std::memory_order_relaxed);
+	s_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+static void* AllocateAligned(size_t size, size_t alignment)
+{
+#ifdef DBT_PLATFORM_WINDOWS
+	return _aligned_malloc(size > 0 ? size : 1, alignment);
+#else
+	// aligned_alloc wants the size to be a multiple of the alignment
+	return std::aligned_alloc(alignment, (std::max<size_t>(size, 1) + alignment - 1) / alignment * alignment);
+#endif
+}
+
+static void FreeAligned(void* ptr)
+{
+#ifdef DBT_PLATFORM_WINDOWS
+	_aligned_free(ptr);
+#else
+	std::free(ptr);
+#endif
+}
+
+void* operator new(size_t size)
+{
+	CountAllocation(size);
+
+	void* ret = std::malloc(size > 0 ? size : 1);
+	if (ret == nullptr)
+		throw std::bad_alloc();
+	return ret;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	CountAllocation(size);
+	return std::malloc(size > 0 ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept
+{
+	return operator new(size, tag);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	CountAllocation(size);
+
+	void* ret = AllocateAligned(size, (size_t)alignment);
+	if (ret == nullptr)
+		throw std::bad_alloc();
+	return ret;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return operator new(size, alignment);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	CountAllocation(size);
+	return AllocateAligned(size, (size_t)alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept
+{
+	return operator new(size, alignment, tag);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t size) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t size) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+	FreeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+	FreeAligned(ptr);
+}
+
+void operator delete(void* ptr, size_t size, std::align_val_t) noexcept
+{
+	FreeAligned(ptr);
+}
+
+void operator delete[](void* ptr, size_t size, std::align_val_t) noexcept
+{
+	FreeAligned(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	FreeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	FreeAligned(ptr);
+}
+
+namespace Debut
+{
+	uint64_t AllocationCounter::GetAllocations()
+	{
+		return s_Allocations.load(std::memory_order_relaxed);
+	}
+
+	uint64_t AllocationCounter::GetAllocatedBytes()
+	{
+		return s_AllocatedBytes.load(std::memory_order_relaxed);
+	}
+
+	void BenchmarkContext::Skip(const std::string& reason)
+	{
+		m_Result.Skipped = true;
+		Log.AppWarn("Skipping {0}: {1}", m_Result.Name, reason);
+	}
+
+	void BenchmarkContext::Fail(const std::string& reason)
+	{
+		m_Result.Failed = true;
+		Log.AppError("{0} failed: {1}", m_Result.Name, reason);
+	}
+
+	std::string BenchmarkContext::GetTempPath(const std::string& fileName)
+	{
+		return BenchmarkRegistry::GetTempDirectory() + "/" + fileName;
+	}
+
+	bool BenchmarkRegistry::Register(const char* name, BenchmarkFn function)
+	{
+		GetEntries().push_back({ name, function });
+		return true;
+	}
+
+	std::vector<BenchmarkResult> BenchmarkRegistry::Run(const std::string& filter, uint32_t seed, double minTime)
+	{
+		std::vector<BenchmarkResult> ret;
+		std::filesystem::create_directories(GetTempDirectory());
+
+		// Registration order depends on the linker, sort so that runs are always in the same order
+		std::vector<Entry> entries = GetEntries();
+		std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return strcmp(a.Name, b.Name) < 0; });
+
+		for (auto& entry : entries)
+		{
+			if (std::string(entry.Name).find(filter) == std::string::npos)
+				continue;
+
+			// Every benchmark gets the same seed, so adding one doesn't change the data of the others
+			BenchmarkContext context(entry.Name, seed, minTime);
+			entry.Function(context);
+
+			if (!context.GetResult().Skipped && context.GetResult().Items == 0)
+				context.Skip("Measure was never called");
+			ret.push_back(context.GetResult());
+		}
+
+		return ret;
+	}
+
+	std::string BenchmarkRegistry::GetTempDirectory()
+	{
+		return (std::filesystem::temp_directory_path() / "DebutBenchmarks").string();
+	}
+
+	void BenchmarkRegistry::ClearTempDirectory()
+	{
+		std::error_code error;
+		std::filesystem::remove_all(GetTempDirectory(), error);
+	}
+
+	std::vector<BenchmarkRegistry::Entry>& BenchmarkRegistry::GetEntries()
+	{
+		static std::vector<Entry> entries;
+		return entries;
+	}
+}
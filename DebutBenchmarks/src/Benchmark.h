@@ -0,0 +1,153 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+/*
+	Minimal microbenchmark harness.
+
+	A benchmark does its setup, then calls Measure with the code to time. The code is run in batches until the
+	minimum time has passed, the result is the median time of the batches divided by the number of processed items.
+	Random data must come from GetRandom, which is seeded with the same value for every run, so that results can
+	be compared against a baseline. Allocations are counted by replacing the global operator new.
+	Benchmarks can also verify their output and call Fail when it's wrong, the runner then returns an error.
+*/
+
+#define DBT_BENCHMARK_CONCAT_INNER(a, b) a ## b
+#define DBT_BENCHMARK_CONCAT(a, b) DBT_BENCHMARK_CONCAT_INNER(a, b)
+
+#define DBT_BENCHMARK(name) \
+	static void name(::Debut::BenchmarkContext& context); \
+	static bool DBT_BENCHMARK_CONCAT(s_Registered, name) = ::Debut::BenchmarkRegistry::Register(#name, name); \
+	static void name(::Debut::BenchmarkContext& context)
+
+namespace Debut
+{
+	struct BenchmarkResult
+	{
+		std::string Name;
+		bool Skipped = false;
+		bool Failed = false;
+
+		uint64_t Items = 0;
+		// Per processed item
+		double Nanoseconds = 0.0;
+		double Allocations = 0.0;
+		double AllocatedBytes = 0.0;
+
+		inline double GetItemsPerSecond() const { return Nanoseconds > 0 ? 1e9 / Nanoseconds : 0.0; }
+	};
+
+	class AllocationCounter
+	{
+	public:
+		static uint64_t GetAllocations();
+		static uint64_t GetAllocatedBytes();
+	};
+
+	// Forces the compiler to compute a value that is otherwise unused
+	template <typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+		static const void* volatile s_Sink;
+		s_Sink = &value;
+	}
+
+	class BenchmarkContext
+	{
+	public:
+		BenchmarkContext(const std::string& name, uint32_t seed, double minTime) : m_Random(seed), m_MinTime(minTime)
+		{
+			m_Result.Name = name;
+		}
+
+		// Runs function until the minimum time has passed. Every call processes itemsPerCall items
+		template <typename Fn>
+		void Measure(Fn&& function, uint64_t itemsPerCall = 1)
+		{
+			const uint32_t batches = 10;
+			double batchTime = m_MinTime / batches;
+
+			// Find how many calls fill a batch, this also warms up the caches
+			uint64_t calls = 1;
+			double elapsed = RunCalls(function, calls);
+			while (elapsed < batchTime && calls < (1ull << 32))
+			{
+				double scale = elapsed > 0.0 ? std::min(batchTime / elapsed * 1.2, 100.0) : 100.0;
+				calls = std::max(calls + 1, (uint64_t)(calls * scale));
+				elapsed = RunCalls(function, calls);
+			}
+
+			std::vector<double> times(batches);
+			uint64_t allocations = AllocationCounter::GetAllocations();
+			uint64_t bytes = AllocationCounter::GetAllocatedBytes();
+
+			for (uint32_t i = 0; i < batches; i++)
+				times[i] = RunCalls(function, calls);
+
+			double items = (double)calls * batches * itemsPerCall;
+			std::nth_element(times.begin(), times.begin() + batches / 2, times.end());
+
+			m_Result.Items = calls * batches * itemsPerCall;
+			m_Result.Nanoseconds = times[batches / 2] * 1e9 / ((double)calls * itemsPerCall);
+			m_Result.Allocations = (AllocationCounter::GetAllocations() - allocations) / items;
+			m_Result.AllocatedBytes = (AllocationCounter::GetAllocatedBytes() - bytes) / items;
+		}
+
+		// Marks the benchmark as not runnable, for example when an asset it needs is missing
+		void Skip(const std::string& reason);
+		// Marks the benchmark as failed, for example when the output doesn't match the expected result
+		void Fail(const std::string& reason);
+
+		inline std::mt19937& GetRandom() { return m_Random; }
+		inline float RandomFloat(float min, float max) { return std::uniform_real_distribution<float>(min, max)(m_Random); }
+		inline uint32_t RandomInt(uint32_t min, uint32_t max) { return std::uniform_int_distribution<uint32_t>(min, max)(m_Random); }
+
+		// Path of a scratch file, the scratch directory is deleted when all the benchmarks have run
+		std::string GetTempPath(const std::string& fileName);
+
+		inline const BenchmarkResult& GetResult() const { return m_Result; }
+
+	private:
+		template <typename Fn>
+		double RunCalls(Fn& function, uint64_t calls)
+		{
+			auto start = std::chrono::steady_clock::now();
+			for (uint64_t i = 0; i < calls; i++)
+				function();
+			return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+
+	private:
+		std::mt19937 m_Random;
+		double m_MinTime;
+		BenchmarkResult m_Result;
+	};
+
+	using BenchmarkFn = void(*)(BenchmarkContext&);
+
+	class BenchmarkRegistry
+	{
+	public:
+		static bool Register(const char* name, BenchmarkFn function);
+
+		// Runs the benchmarks whose name contains filter
+		static std::vector<BenchmarkResult> Run(const std::string& filter, uint32_t seed, double minTime);
+
+		static std::string GetTempDirectory();
+		static void ClearTempDirectory();
+
+	private:
+		struct Entry
+		{
+			const char* Name;
+			BenchmarkFn Function;
+		};
+
+		// Function static, registration happens during static initialization
+		static std::vector<Entry>& GetEntries();
+	};
+}
@@ -0,0 +1,207 @@
+#include <Benchmark.h>
+
+#include <Debut/Core/Log.h>
+#include <Debut/Core/JobSystem.h>
+#include <Debut/Core/Instrumentor.h>
+#include <Debut/AssetManager/AssetManager.h>
+#include <Debut/Rendering/Renderer/Renderer.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <filesystem>
+#include <unordered_map>
+
+/*
+	Runs the engine microbenchmarks on the null renderer:
+
+		DebutBenchmarks [--project <dir>] [--filter <text>] [--seed <n>] [--min-time <s>]
+			[--output <file.json>] [--baseline <file.json>]
+
+	Some benchmarks use the assets of the project, the default one is the working directory. A file written with
+	--output can be passed back as --baseline to compare the current results against it.
+*/
+
+using namespace Debut;
+
+struct BenchmarkOptions
+{
+	std::string ProjectDir = ".";
+	std::string Filter = "";
+	std::string OutputPath = "";
+	std::string BaselinePath = "";
+	uint32_t Seed = 1234;
+	double MinTime = 0.5;
+};
+
+static void PrintUsage()
+{
+	std::cout << "Usage: DebutBenchmarks [--project <dir>] [--filter <text>] [--seed <n>] [--min-time <s>]\n"
+		<< "\t[--output <file.json>] [--baseline <file.json>]\n";
+}
+
+static bool ParseArguments(int argc, char** argv, BenchmarkOptions& options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (i + 1 >= argc)
+			return false;
+
+		if (arg == "--project")
+			options.ProjectDir = argv[++i];
+		else if (arg == "--filter")
+			options.Filter = argv[++i];
+		else if (arg == "--seed")
+			options.Seed = std::stoul(argv[++i]);
+		else if (arg == "--min-time")
+			options.MinTime = std::stod(argv[++i]);
+		else if (arg == "--output")
+			options.OutputPath = argv[++i];
+		else if (arg == "--baseline")
+			options.BaselinePath = argv[++i];
+		else
+			return false;
+	}
+
+	return options.MinTime > 0;
+}
+
+static std::unordered_map<std::string, BenchmarkResult> LoadBaseline(const std::string& path)
+{
+	std::unordered_map<std::string, BenchmarkResult> ret;
+	if (path.empty())
+		return ret;
+
+	try
+	{
+		// JSON is valid YAML
+		YAML::Node baseline = YAML::LoadFile(path);
+		for (auto node : baseline["benchmarks"])
+		{
+			BenchmarkResult result;
+			result.Name = node["name"].as<std::string>();
+			result.Nanoseconds = node["nsPerItem"].as<double>();
+			result.Allocations = node["allocsPerItem"].as<double>();
+			result.AllocatedBytes = node["bytesPerItem"].as<double>();
+			ret[result.Name] = result;
+		}
+	}
+	catch (const YAML::Exception& e)
+	{
+		Log.AppError("Couldn't load the baseline {0}: {1}", path, e.what());
+	}
+
+	return ret;
+}
+
+static void PrintResults(const std::vector<BenchmarkResult>& results, const std::unordered_map<std::string, BenchmarkResult>& baseline)
+{
+	std::cout << std::left << std::setw(40) << "Benchmark" << std::right << std::setw(14) << "ns/item"
+		<< std::setw(16) << "items/s" << std::setw(14) << "allocs/item" << std::setw(14) << "bytes/item";
+	if (baseline.size() > 0)
+		std::cout << std::setw(12) << "time" << std::setw(12) << "allocs";
+	std::cout << "\n";
+
+	std::cout << std::fixed;
+	for (auto& result : results)
+	{
+		std::cout << std::left << std::setw(40) << result.Name << std::right;
+		if (result.Skipped)
+		{
+			std::cout << std::setw(14) << "skipped" << "\n";
+			continue;
+		}
+
+		std::cout << std::setprecision(2) << std::setw(14) << result.Nanoseconds << std::setprecision(0)
+			<< std::setw(16) << result.GetItemsPerSecond() << std::setprecision(3) << std::setw(14) << result.Allocations
+			<< std::setprecision(1) << std::setw(14) << result.AllocatedBytes;
+
+		auto base = baseline.find(result.Name);
+		if (base != baseline.end() && base->second.Nanoseconds > 0)
+		{
+			// Negative is faster than the baseline
+			double timeChange = (result.Nanoseconds / base->second.Nanoseconds - 1.0) * 100.0;
+			std::cout << std::showpos << std::setprecision(1) << std::setw(11) << timeChange << "%"
+				<< std::setprecision(3) << std::setw(12) << result.Allocations - base->second.Allocations << std::noshowpos;
+		}
+		if (result.Failed)
+			std::cout << "  FAILED";
+		std::cout << "\n";
+	}
+}
+
+static bool WriteResults(const std::string& path, const std::vector<BenchmarkResult>& results, const BenchmarkOptions& options)
+{
+	std::ofstream output(path);
+	if (!output.is_open())
+	{
+		Log.AppError("Couldn't write the benchmark results to {0}", path);
+		return false;
+	}
+
+	output << std::setprecision(4) << std::fixed;
+	output << "{\"seed\":" << options.Seed << ",\"minTime\":" << options.MinTime << ",\"benchmarks\":[";
+
+	bool first = true;
+	for (auto& result : results)
+	{
+		if (result.Skipped)
+			continue;
+		if (!first)
+			output << ",";
+		first = false;
+
+		output << "{\"name\":";
+		Instrumentor::WriteJsonString(output, result.Name.c_str());
+		output << ",\"items\":" << result.Items << ",\"nsPerItem\":" << result.Nanoseconds;
+		output << ",\"itemsPerSecond\":" << result.GetItemsPerSecond();
+		output << ",\"allocsPerItem\":" << result.Allocations << ",\"bytesPerItem\":" << result.AllocatedBytes << "}";
+	}
+	output << "]}";
+
+	return output.good();
+}
+
+int main(int argc, char** argv)
+{
+	BenchmarkOptions options;
+	try
+	{
+		if (!ParseArguments(argc, argv, options))
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+	catch (const std::exception&)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	Log.Init();
+	// The engine logs a lot while loading and saving, that would end up in the measurements
+	spdlog::set_level(spdlog::level::warn);
+	std::filesystem::current_path(options.ProjectDir);
+
+	JobSystem::Init();
+	RendererAPI::SetAPI(RendererAPI::API::Null);
+	Renderer::Init();
+	AssetManager::Init(".");
+
+	std::unordered_map<std::string, BenchmarkResult> baseline = LoadBaseline(options.BaselinePath);
+	std::vector<BenchmarkResult> results = BenchmarkRegistry::Run(options.Filter, options.Seed, options.MinTime);
+	BenchmarkRegistry::ClearTempDirectory();
+
+	PrintResults(results, baseline);
+
+	int ret = std::any_of(results.begin(), results.end(), [](const BenchmarkResult& result) { return result.Failed; }) ? 1 : 0;
+	if (!options.OutputPath.empty() && !WriteResults(options.OutputPath, results, options))
+		ret = 1;
+
+	JobSystem::Shutdown();
+	return ret;
+}
@@ -0,0 +1,23 @@
+#include <Benchmark.h>
+
+#include <Debut/Utils/MathUtils.h>
+#include <glm/gtc/constants.hpp>
+
+namespace Debut
+{
+	DBT_BENCHMARK(MathUtilsTriangulate)
+	{
+		const uint32_t vertices = 512;
+		std::vector<glm::vec2> polygon(vertices);
+
+		// Star shaped polygons are always simple, the random radius makes it concave
+		for (uint32_t i = 0; i < vertices; i++)
+		{
+			float angle = glm::two_pi<float>() * i / vertices;
+			float radius = context.RandomFloat(5.0f, 10.0f);
+			polygon[i] = { glm::cos(angle) * radius, glm::sin(angle) * radius };
+		}
+
+		context.Measure([&]() { DoNotOptimize(MathUtils::Triangulate(polygon)); }, vertices);
+	}
+}
@@ -0,0 +1,317 @@
+#include <Benchmark.h>
+
+#include <Debut/Scene/Components.h>
+#include <Debut/Scene/SceneCamera.h>
+#include <Debut/Rendering/Material.h>
+#include <Debut/Rendering/Texture.h>
+#include <Debut/Rendering/Structures/Frustum.h>
+#include <Debut/Rendering/Structures/LightClusters.h>
+#include <Debut/Rendering/Structures/OcclusionBuffer.h>
+#include <Debut/Rendering/Renderer/Renderer.h>
+#include <Debut/Rendering/Renderer/Renderer2D.h>
+#include <Debut/Rendering/Renderer/SpriteQueue.h>
+#include <Debut/AssetManager/AssetManager.h>
+#include <Debut/Utils/MathUtils.h>
+
+#include <filesystem>
+
+namespace Debut
+{
+	static SceneCamera CreateCamera()
+	{
+		SceneCamera camera;
+		camera.SetPerspective(30, 0.1f, 1000.0f);
+		camera.SetFOV(glm::radians(40.0f));
+		camera.SetViewportSize(1600, 900);
+		camera.SetView(glm::inverse(MathUtils::CreateTransform({ 0, 5, 50 }, glm::vec3(0.0f), glm::vec3(1.0f))));
+		return camera;
+	}
+
+	static glm::mat4 CreateRandomTransform(BenchmarkContext& context, float range)
+	{
+		// Separate statements, the evaluation order of function arguments isn't specified
+		glm::vec3 translation = { context.RandomFloat(-range, range), context.RandomFloat(-range, range), context.RandomFloat(-range, range) };
+		glm::vec3 rotation = { context.RandomFloat(-3, 3), context.RandomFloat(-3, 3), context.RandomFloat(-3, 3) };
+		glm::vec3 scale = glm::vec3(context.RandomFloat(0.5f, 2.0f));
+
+		return MathUtils::CreateTransform(translation, rotation, scale);
+	}
+
+	DBT_BENCHMARK(FrustumTestAABB)
+	{
+		const uint32_t boxes = 4096;
+		SceneCamera camera = CreateCamera();
+		Frustum frustum(camera);
+
+		std::vector<AABB> aabbs(boxes);
+		std::vector<glm::mat4> transforms(boxes);
+		for (uint32_t i = 0; i < boxes; i++)
+		{
+			glm::vec3 size = { context.RandomFloat(0.1f, 5), context.RandomFloat(0.1f, 5), context.RandomFloat(0.1f, 5) };
+			aabbs[i].Center = glm::vec3(0.0f);
+			aabbs[i].MinExtents = -size;
+			aabbs[i].MaxExtents = size;
+			// Roughly half of the boxes are outside of the frustum
+			transforms[i] = CreateRandomTransform(context, 100);
+		}
+
+		context.Measure([&]()
+			{
+				uint32_t visible = 0;
+				for (uint32_t i = 0; i < boxes; i++)
+					visible += frustum.TestAABB(aabbs[i], transforms[i]);
+				DoNotOptimize(visible);
+			}, boxes);
+	}
+
+	DBT_BENCHMARK(LightClustersBuild)
+	{
+		const uint32_t lights = 4096;
+		SceneCamera camera = CreateCamera();
+		LightClusters clusters;
+
+		// Lights spread around the camera, most of them are in the frustum
+		std::vector<glm::vec4> spheres(lights);
+		for (uint32_t i = 0; i < lights; i++)
+		{
+			glm::vec3 position = { context.RandomFloat(-100, 100), context.RandomFloat(-20, 30), context.RandomFloat(-200, 40) };
+			spheres[i] = glm::vec4(position, context.RandomFloat(1, 10));
+		}
+
+		// The first build creates the cluster bounds, every iteration after that is a frame
+		clusters.Build(camera.GetView(), camera.GetProjection(), camera.GetNearPlane(), camera.GetFarPlane(), spheres.data(), lights);
+		context.Measure([&]()
+			{
+				clusters.Build(camera.GetView(), camera.GetProjection(), camera.GetNearPlane(), camera.GetFarPlane(), spheres.data(), lights);
+				DoNotOptimize(clusters.GetLightIndices().size());
+			}, lights);
+	}
+
+	// Unit cube, 12 triangles
+	static void CreateBox(std::vector<float>& positions, std::vector<int>& indices)
+	{
+		positions.clear();
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			positions.push_back((i & 1) ? 1.0f : -1.0f);
+			positions.push_back((i & 2) ? 1.0f : -1.0f);
+			positions.push_back((i & 4) ? 1.0f : -1.0f);
+		}
+		indices = { 0, 1, 3, 0, 3, 2, 4, 6, 7, 4, 7, 5, 0, 4, 5, 0, 5, 1, 2, 3, 7, 2, 7, 6, 0, 2, 6, 0, 6, 4, 1, 5, 7, 1, 7, 3 };
+	}
+
+	static std::vector<glm::mat4> CreateWalls(BenchmarkContext& context, uint32_t count)
+	{
+		// Thin walls between the camera and the rest of the scene
+		std::vector<glm::mat4> walls(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			glm::vec3 position = { context.RandomFloat(-40, 40), context.RandomFloat(-5, 15), context.RandomFloat(-10, 30) };
+			walls[i] = MathUtils::CreateTransform(position, glm::vec3(0.0f), { context.RandomFloat(2, 8), context.RandomFloat(2, 6), 0.2f });
+		}
+		return walls;
+	}
+
+	DBT_BENCHMARK(OcclusionBufferRasterize)
+	{
+		const uint32_t occluders = 64;
+		SceneCamera camera = CreateCamera();
+		OcclusionBuffer buffer;
+
+		std::vector<float> positions;
+		std::vector<int> indices;
+		CreateBox(positions, indices);
+		std::vector<glm::mat4> walls = CreateWalls(context, occluders);
+
+		context.Measure([&]()
+			{
+				buffer.Begin(camera.GetProjection() * camera.GetView());
+				for (uint32_t i = 0; i < occluders; i++)
+					buffer.AddOccluder(positions.data(), indices.data(), (uint32_t)indices.size(), walls[i]);
+				buffer.Rasterize();
+				DoNotOptimize(buffer.GetDepth().data());
+			}, occluders);
+	}
+
+	DBT_BENCHMARK(OcclusionBufferTestAABB)
+	{
+		const uint32_t occluders = 64;
+		const uint32_t boxes = 4096;
+		SceneCamera camera = CreateCamera();
+		OcclusionBuffer buffer;
+
+		std::vector<float> positions;
+		std::vector<int> indices;
+		CreateBox(positions, indices);
+		std::vector<glm::mat4> walls = CreateWalls(context, occluders);
+
+		buffer.Begin(camera.GetProjection() * camera.GetView());
+		for (uint32_t i = 0; i < occluders; i++)
+			buffer.AddOccluder(positions.data(), indices.data(), (uint32_t)indices.size(), walls[i]);
+		buffer.Rasterize();
+
+		// Boxes behind the walls
+		std::vector<AABB> aabbs(boxes);
+		std::vector<glm::mat4> transforms(boxes);
+		for (uint32_t i = 0; i < boxes; i++)
+		{
+			glm::vec3 size = { context.RandomFloat(0.1f, 2), context.RandomFloat(0.1f, 2), context.RandomFloat(0.1f, 2) };
+			glm::vec3 position = { context.RandomFloat(-60, 60), context.RandomFloat(-10, 20), context.RandomFloat(-100, -10) };
+			aabbs[i] = { glm::vec3(0.0f), size, -size };
+			transforms[i] = MathUtils::CreateTransform(position, glm::vec3(0.0f), glm::vec3(1.0f));
+		}
+
+		context.Measure([&]()
+			{
+				uint32_t visible = 0;
+				for (uint32_t i = 0; i < boxes; i++)
+					visible += buffer.TestAABB(aabbs[i], transforms[i]);
+				DoNotOptimize(visible);
+			}, boxes);
+	}
+
+	DBT_BENCHMARK(Renderer2DDrawSprite)
+	{
+		const uint32_t sprites = 10000;
+		SceneCamera camera = CreateCamera();
+
+		std::vector<SpriteRendererComponent> components(sprites);
+		std::vector<glm::mat4> transforms(sprites);
+		for (uint32_t i = 0; i < sprites; i++)
+		{
+			components[i].Color = { context.RandomFloat(0, 1), context.RandomFloat(0, 1), context.RandomFloat(0, 1), 1.0f };
+			transforms[i] = CreateRandomTransform(context, 50);
+		}
+
+		// Includes the batch flushes, the null renderer only counts the submitted data. Every iteration is a frame
+		context.Measure([&]()
+			{
+				Renderer2D::BeginScene(camera, glm::mat4(1.0f));
+				for (uint32_t i = 0; i < sprites; i++)
+					Renderer2D::DrawSprite(transforms[i], components[i], i);
+				Renderer2D::EndScene();
+				Renderer::EndFrame();
+			}, sprites);
+	}
+
+	// Packed path, the vertices or the instances are built on the workers
+	static void DrawPackedSprites(BenchmarkContext& context, bool instanced)
+	{
+		const uint32_t sprites = 200000;
+		SceneCamera camera = CreateCamera();
+
+		std::vector<SpriteRendererComponent> components(sprites);
+		std::vector<glm::mat4> transforms(sprites);
+		std::vector<int32_t> entityIDs(sprites);
+		for (uint32_t i = 0; i < sprites; i++)
+		{
+			components[i].Color = { context.RandomFloat(0, 1), context.RandomFloat(0, 1), context.RandomFloat(0, 1), 1.0f };
+			transforms[i] = CreateRandomTransform(context, 50);
+			entityIDs[i] = (int32_t)i;
+		}
+
+		RendererConfig previous = Renderer::GetConfig();
+		RendererConfig config = previous;
+		config.InstancedSprites = instanced;
+		Renderer::SetConfig(config);
+
+		context.Measure([&]()
+			{
+				Renderer2D::BeginScene(camera, glm::mat4(1.0f));
+				Renderer2D::DrawSprites(transforms.data(), components.data(), entityIDs.data(), nullptr, sprites);
+				Renderer2D::EndScene();
+				Renderer::EndFrame();
+			}, sprites);
+
+		Renderer::SetConfig(previous);
+	}
+
+	DBT_BENCHMARK(Renderer2DDrawSprites)
+	{
+		DrawPackedSprites(context, false);
+	}
+
+	DBT_BENCHMARK(Renderer2DDrawSpritesInstanced)
+	{
+		DrawPackedSprites(context, true);
+	}
+
+	DBT_BENCHMARK(SpriteQueueSort)
+	{
+		const uint32_t sprites = 100000;
+		SpriteQueue queue;
+
+		// A few layers and textures, sprites spread in depth
+		std::vector<uint64_t> keys(sprites);
+		for (uint32_t i = 0; i < sprites; i++)
+		{
+			// Drawn in order, so that the keys don't depend on the evaluation order of the arguments
+			int32_t layer = context.RandomInt(0, 4);
+			float distance = context.RandomFloat(1, 100);
+			uint64_t texture = context.RandomInt(1, 32);
+			keys[i] = SpriteQueue::MakeKey(layer, 0, distance, texture);
+		}
+
+		context.Measure([&]()
+			{
+				queue.Clear();
+				for (uint32_t i = 0; i < sprites; i++)
+					queue.Push(keys[i]);
+				queue.Sort();
+				DoNotOptimize(queue.GetOrder().data());
+			}, sprites);
+	}
+
+	DBT_BENCHMARK(Renderer2DDrawTexturedQuad)
+	{
+		// More textures than slots, so that the batches are flushed when the slots run out
+		const uint32_t quads = 10000;
+		const uint32_t textures = 48;
+		SceneCamera camera = CreateCamera();
+
+		std::vector<Ref<Texture>> textureList(textures);
+		for (uint32_t i = 0; i < textures; i++)
+			textureList[i] = Texture2D::Create(1, 1);
+
+		std::vector<glm::vec3> positions(quads);
+		std::vector<uint32_t> textureIndices(quads);
+		for (uint32_t i = 0; i < quads; i++)
+		{
+			positions[i] = { context.RandomFloat(-50, 50), context.RandomFloat(-50, 50), 0.0f };
+			textureIndices[i] = context.RandomInt(0, textures - 1);
+		}
+
+		context.Measure([&]()
+			{
+				Renderer2D::BeginScene(camera, glm::mat4(1.0f));
+				for (uint32_t i = 0; i < quads; i++)
+					Renderer2D::DrawQuad(positions[i], glm::vec2(1.0f), 0.0f, textureList[textureIndices[i]]);
+				Renderer2D::EndScene();
+				Renderer::EndFrame();
+			}, quads);
+	}
+
+	DBT_BENCHMARK(MaterialUse)
+	{
+		const std::string shaderPath = "assets/shaders/default-3d.glsl";
+		if (!std::filesystem::exists(shaderPath))
+		{
+			context.Skip("the project doesn't contain " + shaderPath);
+			return;
+		}
+
+		Material material;
+		material.SetShader(AssetManager::Request<Shader>(shaderPath));
+		if (material.GetRuntimeShader() == nullptr)
+		{
+			context.Skip("couldn't load " + shaderPath);
+			return;
+		}
+
+		context.Measure([&]()
+			{
+				material.Use();
+				material.Unuse();
+			});
+	}
+}
@@ -0,0 +1,187 @@
+#include <Benchmark.h>
+
+#include <Debut/Scene/Scene.h>
+#include <Debut/Scene/Entity.h>
+#include <Debut/Scene/Components.h>
+#include <Debut/Scene/SceneSerializer.h>
+#include <Debut/Scene/ScriptableEntity.h>
+#include <Debut/Scene/SceneRenderState.h>
+#include <Debut/Core/FrameAllocator.h>
+#include <Debut/Rendering/Renderer/Renderer.h>
+#include <Debut/Rendering/Structures/FrameBuffer.h>
+
+#include <yaml-cpp/yaml.h>
+
+namespace Debut
+{
+	static Entity CreateRandomEntity(BenchmarkContext& context, Ref<Scene> scene, Entity parent)
+	{
+		// Seeded ids, so that the entity storage is the same in every run
+		Entity ret = scene->CreateEntity(parent, UUID(context.GetRandom()()), "Entity");
+		TransformComponent& transform = ret.Transform();
+
+		transform.Translation = { context.RandomFloat(-10, 10), context.RandomFloat(-10, 10), context.RandomFloat(-10, 10) };
+		transform.Rotation = { context.RandomFloat(-3, 3), context.RandomFloat(-3, 3), context.RandomFloat(-3, 3) };
+		transform.Scale = glm::vec3(context.RandomFloat(0.5f, 2.0f));
+
+		return ret;
+	}
+
+	// Moves another entity than its own, the scene can't know which one from the script
+	static Entity s_ScriptTarget;
+	class MoveTargetScript : public ScriptableEntity
+	{
+	protected:
+		virtual void OnUpdate(Timestep ts) override
+		{
+			s_ScriptTarget.Transform().Translation.x += 1.0f;
+		}
+	};
+
+	static void DeleteSceneGraph(EntitySceneNode* node)
+	{
+		for (auto child : node->Children)
+			DeleteSceneGraph(child);
+		delete node;
+	}
+
+	DBT_BENCHMARK(TransformGetTransformDeep)
+	{
+		const uint32_t depth = 64;
+		Ref<Scene> scene = CreateRef<Scene>();
+
+		Entity leaf = {};
+		for (uint32_t i = 0; i < depth; i++)
+			leaf = CreateRandomEntity(context, scene, leaf);
+
+		TransformComponent& transform = leaf.Transform();
+		context.Measure([&]() { DoNotOptimize(transform.GetTransform()); });
+	}
+
+	DBT_BENCHMARK(TransformGetTransformWide)
+	{
+		const uint32_t children = 1024;
+		Ref<Scene> scene = CreateRef<Scene>();
+		std::vector<Entity> entities;
+		std::vector<TransformComponent*> transforms;
+
+		Entity root = CreateRandomEntity(context, scene, {});
+		for (uint32_t i = 0; i < children; i++)
+			entities.push_back(CreateRandomEntity(context, scene, root));
+
+		// Components can move while entities are created, take the pointers at the end
+		for (auto& entity : entities)
+			transforms.push_back(&entity.Transform());
+
+		context.Measure([&]()
+			{
+				for (auto transform : transforms)
+					DoNotOptimize(transform->GetTransform());
+			}, transforms.size());
+	}
+
+	DBT_BENCHMARK(SceneExtractLights)
+	{
+		const uint32_t pointLights = 256;
+		Ref<Scene> scene = CreateRef<Scene>();
+		SceneRenderState state;
+
+		CreateRandomEntity(context, scene, {}).AddComponent<DirectionalLightComponent>();
+		for (uint32_t i = 0; i < pointLights; i++)
+			CreateRandomEntity(context, scene, {}).AddComponent<PointLightComponent>();
+
+		// The state keeps its memory, only the first extraction allocates
+		context.Measure([&]()
+			{
+				scene->ExtractRenderState(state);
+				DoNotOptimize(state.PointLights.data());
+			}, pointLights + 1);
+
+		if (state.DirectionalLights.size() != 1 || state.PointLights.size() != pointLights)
+			context.Fail("The extracted state doesn't contain every light of the scene");
+	}
+
+	DBT_BENCHMARK(SceneRuntimeUpdateScripted)
+	{
+		const uint32_t meshes = 1024;
+		Ref<Scene> scene = CreateRef<Scene>();
+
+		for (uint32_t i = 0; i < meshes; i++)
+			CreateRandomEntity(context, scene, {}).AddComponent<MeshRendererComponent>();
+		s_ScriptTarget = CreateRandomEntity(context, scene, {});
+		s_ScriptTarget.AddComponent<MeshRendererComponent>();
+
+		FrameBufferSpecifications specs;
+		specs.Attachments = { FrameBufferTextureFormat::Color, FrameBufferTextureFormat::Depth, FrameBufferTextureFormat::RED_INTEGER };
+		specs.Width = 64;
+		specs.Height = 64;
+		Ref<FrameBuffer> target = FrameBuffer::Create(specs);
+
+		auto runFrame = [&]()
+		{
+			scene->OnRuntimeUpdate(1.0f / 60.0f, target);
+			FrameAllocator::EndFrame();
+			Renderer::EndFrame();
+		};
+
+		// The proxies become static before the script is added
+		scene->OnRuntimeStart();
+		for (uint32_t i = 0; i < 16; i++)
+			runFrame();
+		CreateRandomEntity(context, scene, {}).AddComponent<NativeScriptComponent>().Bind<MoveTargetScript>();
+
+		context.Measure(runFrame, meshes + 1);
+
+		// The proxy of the moved entity must follow it even if nothing told the scene it moved
+		const RenderProxyArrays& proxies = scene->GetRenderProxies();
+		glm::mat4 expected = s_ScriptTarget.Transform().GetTransform();
+		bool found = false;
+		for (uint32_t i = 0; i < proxies.Size(); i++)
+		{
+			if (proxies.EntityIDs[i] != (int32_t)(entt::entity)s_ScriptTarget)
+				continue;
+
+			found = true;
+			if (proxies.WorldMatrices[i] != expected)
+				context.Fail("The proxy of an entity moved by a script wasn't refreshed");
+		}
+		if (!found)
+			context.Fail("The entity moved by the script doesn't have a proxy");
+
+		scene->OnRuntimeStop();
+		s_ScriptTarget = {};
+	}
+
+	DBT_BENCHMARK(SceneSerializerRoundTrip)
+	{
+		const uint32_t entities = 256;
+		Ref<Scene> scene = CreateRef<Scene>();
+		EntitySceneNode graph(true, {});
+
+		for (uint32_t i = 0; i < entities; i++)
+		{
+			Entity entity = CreateRandomEntity(context, scene, {});
+			SpriteRendererComponent& sprite = entity.AddComponent<SpriteRendererComponent>();
+			sprite.Color = { context.RandomFloat(0, 1), context.RandomFloat(0, 1), context.RandomFloat(0, 1), 1.0f };
+
+			graph.Children.push_back(new EntitySceneNode(false, entity));
+		}
+
+		std::string path = context.GetTempPath("RoundTrip.debut");
+		YAML::Node additionalData;
+
+		context.Measure([&]()
+			{
+				Ref<Scene> loaded = CreateRef<Scene>();
+				YAML::Node loadedData;
+
+				SceneSerializer(scene).SerializeText(path, graph, additionalData);
+				EntitySceneNode* loadedGraph = SceneSerializer(loaded).DeserializeText(path, loadedData);
+				if (loadedGraph != nullptr)
+					DeleteSceneGraph(loadedGraph);
+			}, entities);
+
+		for (auto child : graph.Children)
+			delete child;
+	}
+}
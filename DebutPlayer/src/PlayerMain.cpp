@@ -0,0 +1,113 @@
+#include <SceneBenchmark.h>
+
+#include <Debut/Core/Log.h>
+#include <Debut/Core/JobSystem.h>
+#include <Debut/AssetManager/AssetManager.h>
+
+#include <filesystem>
+#include <iostream>
+
+/*
+	Runs a scene without the editor:
+
+		DebutPlayer <scene.debut> [--project <dir>] [--frames <n>] [--warmup <n>] [--timestep <s>]
+			[--size <width> <height>] [--backend null|opengl] [--output <file.json|file.csv>] [--trace <file.json>]
+			[--pipelined]
+
+	The scene and the output paths are relative to the project directory, which must contain the asset map.
+*/
+
+using namespace Debut;
+
+static void PrintUsage()
+{
+	std::cout << "Usage: DebutPlayer <scene.debut> [--project <dir>] [--frames <n>] [--warmup <n>] [--timestep <s>]\n"
+		<< "\t[--size <width> <height>] [--backend null|opengl] [--output <file.json|file.csv>] [--trace <file.json>]\n"
+		<< "\t[--pipelined]\n";
+}
+
+static bool ParseArguments(int argc, char** argv, BenchmarkSettings& settings, std::string& projectDir)
+{
+	if (argc < 2)
+		return false;
+
+	settings.ScenePath = argv[1];
+	settings.OutputPath = std::filesystem::path(settings.ScenePath).stem().string() + "-benchmark.json";
+
+	for (int i = 2; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (arg == "--project" && hasValue)
+			projectDir = argv[++i];
+		else if (arg == "--frames" && hasValue)
+			settings.Frames = std::stoul(argv[++i]);
+		else if (arg == "--warmup" && hasValue)
+			settings.WarmupFrames = std::stoul(argv[++i]);
+		else if (arg == "--timestep" && hasValue)
+			settings.Timestep = std::stof(argv[++i]);
+		else if (arg == "--size" && i + 2 < argc)
+		{
+			settings.Width = std::stoul(argv[++i]);
+			settings.Height = std::stoul(argv[++i]);
+		}
+		else if (arg == "--backend" && hasValue)
+		{
+			std::string backend = argv[++i];
+			if (backend == "null")
+				settings.Backend = RendererAPI::API::Null;
+			else if (backend == "opengl")
+				settings.Backend = RendererAPI::API::OpenGL;
+			else
+				return false;
+		}
+		else if (arg == "--output" && hasValue)
+			settings.OutputPath = argv[++i];
+		else if (arg == "--trace" && hasValue)
+			settings.TracePath = argv[++i];
+		else if (arg == "--pipelined")
+			settings.Pipelined = true;
+		else
+			return false;
+	}
+
+	return settings.Frames > 0 && settings.Width > 0 && settings.Height > 0 && settings.Timestep > 0;
+}
+
+int main(int argc, char** argv)
+{
+	BenchmarkSettings settings;
+	std::string projectDir = ".";
+
+	try
+	{
+		if (!ParseArguments(argc, argv, settings, projectDir))
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+	catch (const std::exception&)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	Log.Init();
+	std::filesystem::current_path(projectDir);
+	Log.AppInfo("CWD: {0}", std::filesystem::current_path().string().c_str());
+
+	JobSystem::Init();
+	int ret = 0;
+	{
+		SceneBenchmark benchmark(settings);
+		AssetManager::Init(".");
+
+		if (!benchmark.Run() || !benchmark.WriteResults())
+			ret = 1;
+	}
+	JobSystem::Shutdown();
+
+	return ret;
+}
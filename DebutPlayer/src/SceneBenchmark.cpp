@@ -0,0 +1,368 @@
+#include <SceneBenchmark.h>
+
+#include <Debut/Core/Log.h>
+#include <Debut/Core/Window.h>
+#include <Debut/Core/JobSystem.h>
+#include <Debut/Core/Instrumentor.h>
+#include <Debut/Core/FrameProfiler.h>
+#include <Debut/Core/FrameAllocator.h>
+#include <Debut/Scene/Scene.h>
+#include <Debut/Scene/Entity.h>
+#include <Debut/Scene/SceneSerializer.h>
+#include <Debut/Rendering/Renderer/Renderer.h>
+#include <Debut/Rendering/Structures/BufferArena.h>
+#include <Debut/Rendering/Structures/FrameBuffer.h>
+#include <Platform/Null/NullRendererAPI.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <filesystem>
+
+namespace Debut
+{
+	std::vector<BenchmarkCategory> SceneBenchmark::s_Categories = {
+		{ "Scripts", "Scene: Script Update" },
+		{ "Physics2D", "Scene: Physics2D Update" },
+		{ "Physics3D", "Scene: Physics3D update" },
+		{ "Culling", "Renderer3D::Culling" },
+		{ "Occlusion", "Renderer3D::OcclusionCulling" },
+		{ "Shadows", "ShadowPass" },
+		{ "Renderer3D", "Rendering3D" },
+		{ "Renderer2D", "Rendering2D" }
+	};
+
+	static void DeleteSceneGraph(EntitySceneNode* node)
+	{
+		for (auto child : node->Children)
+			DeleteSceneGraph(child);
+		delete node;
+	}
+
+	static float GetPercentile(std::vector<float>& values, float percentile)
+	{
+		if (values.size() == 0)
+			return 0.0f;
+
+		size_t index = (size_t)(percentile * (values.size() - 1));
+		std::nth_element(values.begin(), values.begin() + index, values.end());
+		return values[index];
+	}
+
+	SceneBenchmark::SceneBenchmark(const BenchmarkSettings& settings) : m_Settings(settings)
+	{
+		// A window is only needed to get an OpenGL context
+		if (m_Settings.Backend != RendererAPI::API::Null)
+		{
+			m_Window = std::unique_ptr<Window>(Window::Create(WindowProps("Debut Player", m_Settings.Width, m_Settings.Height)));
+			m_Window->SetVSync(false);
+		}
+
+		RendererAPI::SetAPI(m_Settings.Backend);
+		Renderer::Init();
+		Renderer::OnWindowResized(m_Settings.Width, m_Settings.Height);
+
+		FrameBufferSpecifications specs;
+		specs.Attachments = {
+			FrameBufferTextureFormat::Color, FrameBufferTextureFormat::Depth,
+			FrameBufferTextureFormat::RED_INTEGER
+		};
+		specs.Width = m_Settings.Width;
+		specs.Height = m_Settings.Height;
+		m_FrameBuffer = FrameBuffer::Create(specs);
+	}
+
+	SceneBenchmark::~SceneBenchmark()
+	{
+		if (m_SceneGraph != nullptr)
+			DeleteSceneGraph(m_SceneGraph);
+	}
+
+	bool SceneBenchmark::LoadScene()
+	{
+		DBT_PROFILE_SCOPE("Player::LoadScene");
+		if (!std::filesystem::exists(m_Settings.ScenePath))
+		{
+			Log.AppError("Scene {0} doesn't exist", m_Settings.ScenePath);
+			return false;
+		}
+
+		YAML::Node additionalData;
+		Entity::s_ExistingEntities.clear();
+
+		m_Scene = CreateRef<Scene>();
+		SceneSerializer ss(m_Scene);
+		m_SceneGraph = ss.DeserializeText(m_Settings.ScenePath, additionalData);
+
+		if (!additionalData["Valid"] || !additionalData["Valid"].as<bool>())
+		{
+			Log.AppError("Couldn't load scene {0}", m_Settings.ScenePath);
+			return false;
+		}
+
+		// Also creates the shadow maps
+		m_Scene->OnViewportResize(m_Settings.Width, m_Settings.Height);
+		return true;
+	}
+
+	bool SceneBenchmark::Run()
+	{
+		if (!LoadScene())
+			return false;
+
+		Log.AppInfo("Running {0}: {1} warmup frames, {2} measured frames, {3} s timestep", m_Settings.ScenePath,
+			m_Settings.WarmupFrames, m_Settings.Frames, m_Settings.Timestep);
+
+		m_Scene->SetPipelined(m_Settings.Pipelined);
+		m_Scene->OnRuntimeStart();
+
+		for (uint32_t i = 0; i < m_Settings.WarmupFrames; i++)
+			RunFrame(nullptr);
+
+		// Events are only recorded from now on, so the history only contains the measured frames
+		FrameProfiler::Init(m_Settings.Frames);
+		if (!m_Settings.TracePath.empty())
+			DBT_PROFILE_BEGIN_SESSION("Benchmark", m_Settings.TracePath);
+
+		m_Frames.clear();
+		m_Frames.resize(m_Settings.Frames);
+		for (uint32_t i = 0; i < m_Settings.Frames; i++)
+		{
+			m_Frames[i].StartTicks = Instrumentor::GetTicks();
+			RunFrame(&m_Frames[i]);
+		}
+
+		FrameProfiler::Flush();
+		CollectTimings();
+
+		if (!m_Settings.TracePath.empty())
+			DBT_PROFILE_END_SESSION();
+		FrameProfiler::Shutdown();
+
+		m_Scene->OnRuntimeStop();
+		return true;
+	}
+
+	void SceneBenchmark::RunFrame(BenchmarkFrame* frame)
+	{
+		DBT_PROFILE_FRAME("Player Frame");
+
+		if (m_Settings.Backend == RendererAPI::API::Null)
+			NullRendererAPI::ResetStats();
+
+		JobSystem::ProcessMainThreadJobs();
+		m_Scene->OnRuntimeUpdate(m_Settings.Timestep, m_FrameBuffer);
+
+		if (m_Window != nullptr)
+			m_Window->OnUpdate();
+		FrameAllocator::EndFrame();
+		Renderer::EndFrame();
+
+		if (frame != nullptr)
+		{
+			FrameAllocatorStats memory = FrameAllocator::GetStats();
+			frame->FrameMemoryBytes = memory.AllocatedBytes;
+			frame->FrameHeapAllocations = memory.HeapAllocations;
+			frame->DynamicGeometryBytes = Renderer::GetDynamicGeometry()->GetStats().AllocatedBytes;
+			frame->StateCache = RenderStateCache::GetStats();
+
+			SimulationTimings simulation = m_Scene->GetSimulationTimings();
+			frame->Physics2D = simulation.Physics2D;
+			frame->Physics3D = simulation.Physics3D;
+		}
+
+		if (frame != nullptr && m_Settings.Backend == RendererAPI::API::Null)
+		{
+			const NullRendererStats& stats = NullRendererAPI::GetStats();
+			frame->DrawCalls = stats.DrawCalls;
+			frame->StateChanges = stats.StateChanges;
+			frame->BytesUploaded = stats.BytesUploaded;
+		}
+	}
+
+	void SceneBenchmark::CollectTimings()
+	{
+		ProfiledFrame profiled;
+
+		for (auto& frame : m_Frames)
+			frame.Categories.assign(s_Categories.size(), 0.0f);
+
+		// Frames whose events were dropped are missing from the history, so the profiled frames can't be matched
+		// by position: each one belongs to the last benchmark frame that started before it
+		uint32_t frameIndex = 0;
+		uint32_t nProfiled = 0;
+		for (uint32_t i = 0; FrameProfiler::GetFrame(i, profiled); i++)
+		{
+			while (frameIndex + 1 < m_Frames.size() && m_Frames[frameIndex + 1].StartTicks <= profiled.GetStart())
+				frameIndex++;
+			BenchmarkFrame& frame = m_Frames[frameIndex];
+			if (frame.Profiled || profiled.GetStart() < frame.StartTicks)
+				continue;
+
+			frame.Profiled = true;
+			nProfiled++;
+			frame.Total = profiled.GetDuration();
+			for (auto& scope : profiled.Scopes)
+			{
+				for (uint32_t c = 0; c < s_Categories.size(); c++)
+				{
+					if (strcmp(scope.Name, s_Categories[c].Scope) == 0)
+					{
+						frame.Categories[c] += ProfiledFrame::ToMilliseconds(scope.End - scope.Start);
+						break;
+					}
+				}
+			}
+
+			// The frame thread only waited for the simulation, the physics ran on a worker
+			if (m_Settings.Pipelined)
+			{
+				for (uint32_t c = 0; c < s_Categories.size(); c++)
+				{
+					if (strcmp(s_Categories[c].Name, "Physics2D") == 0)
+						frame.Categories[c] = frame.Physics2D;
+					else if (strcmp(s_Categories[c].Name, "Physics3D") == 0)
+						frame.Categories[c] = frame.Physics3D;
+				}
+			}
+		}
+
+		if (nProfiled < m_Frames.size())
+			Log.AppWarn("Only {0} of {1} frames have been profiled", nProfiled, m_Frames.size());
+	}
+
+	bool SceneBenchmark::WriteResults()
+	{
+		if (m_Settings.OutputPath.empty())
+			return true;
+
+		std::ofstream output(m_Settings.OutputPath);
+		if (!output.is_open())
+		{
+			Log.AppError("Couldn't write the benchmark results to {0}", m_Settings.OutputPath);
+			return false;
+		}
+
+		output << std::setprecision(4) << std::fixed;
+		bool ret;
+		if (std::filesystem::path(m_Settings.OutputPath).extension() == ".csv")
+			ret = WriteCsv(output);
+		else
+			ret = WriteJson(output);
+
+		Log.AppInfo("Benchmark results saved to {0}", m_Settings.OutputPath);
+		return ret;
+	}
+
+	bool SceneBenchmark::WriteJson(std::ostream& output)
+	{
+		bool nullBackend = m_Settings.Backend == RendererAPI::API::Null;
+		std::vector<float> values;
+		values.reserve(m_Frames.size());
+		uint32_t nProfiled = (uint32_t)std::count_if(m_Frames.begin(), m_Frames.end(), [](const BenchmarkFrame& frame) { return frame.Profiled; });
+
+		output << "{\"scene\":";
+		Instrumentor::WriteJsonString(output, m_Settings.ScenePath.c_str());
+		output << ",\"backend\":\"" << (nullBackend ? "Null" : "OpenGL") << "\"";
+		output << ",\"frames\":" << m_Frames.size() << ",\"profiledFrames\":" << nProfiled;
+		output << ",\"warmupFrames\":" << m_Settings.WarmupFrames;
+		output << ",\"timestep\":" << m_Settings.Timestep;
+		output << ",\"width\":" << m_Settings.Width << ",\"height\":" << m_Settings.Height;
+
+		// Summary of every category, -1 is the whole frame. Frames that haven't been profiled have no timings
+		output << ",\"summary\":{";
+		for (int c = -1; c < (int)s_Categories.size(); c++)
+		{
+			float sum = 0.0f;
+			values.clear();
+			for (auto& frame : m_Frames)
+			{
+				if (!frame.Profiled)
+					continue;
+				values.push_back(c < 0 ? frame.Total : frame.Categories[c]);
+				sum += values.back();
+			}
+
+			if (c >= 0)
+				output << ",";
+			output << "\"" << (c < 0 ? "Frame" : s_Categories[c].Name) << "\":{";
+			output << "\"avg\":" << (values.size() > 0 ? sum / values.size() : 0.0f);
+			output << ",\"min\":" << (values.size() > 0 ? *std::min_element(values.begin(), values.end()) : 0.0f);
+			output << ",\"max\":" << (values.size() > 0 ? *std::max_element(values.begin(), values.end()) : 0.0f);
+			output << ",\"p50\":" << GetPercentile(values, 0.5f);
+			output << ",\"p95\":" << GetPercentile(values, 0.95f);
+			output << ",\"p99\":" << GetPercentile(values, 0.99f) << "}";
+		}
+		output << "}";
+
+		// Milliseconds spent in every category for each frame
+		output << ",\"frameTimes\":[";
+		for (uint32_t i = 0; i < m_Frames.size(); i++)
+		{
+			const BenchmarkFrame& frame = m_Frames[i];
+			if (i > 0)
+				output << ",";
+
+			output << "{\"Profiled\":" << (frame.Profiled ? "true" : "false") << ",\"Frame\":" << frame.Total;
+			for (uint32_t c = 0; c < s_Categories.size(); c++)
+				output << ",\"" << s_Categories[c].Name << "\":" << frame.Categories[c];
+			output << ",\"FrameMemoryBytes\":" << frame.FrameMemoryBytes << ",\"FrameHeapAllocations\":" << frame.FrameHeapAllocations;
+			output << ",\"DynamicGeometryBytes\":" << frame.DynamicGeometryBytes;
+			output << ",\"ElidedStateChanges\":" << frame.StateCache.Elided;
+			output << ",\"ElidedShaderBinds\":" << frame.StateCache.ElidedShaderBinds;
+			output << ",\"ElidedVertexArrayBinds\":" << frame.StateCache.ElidedVertexArrayBinds;
+			output << ",\"ElidedTextureBinds\":" << frame.StateCache.ElidedTextureBinds;
+			output << ",\"ElidedFrameBufferBinds\":" << frame.StateCache.ElidedFrameBufferBinds;
+			output << ",\"ElidedPipelineChanges\":" << frame.StateCache.ElidedPipelineChanges;
+			output << ",\"ElidedUniforms\":" << frame.StateCache.ElidedUniforms;
+
+			if (nullBackend)
+			{
+				output << ",\"DrawCalls\":" << frame.DrawCalls << ",\"StateChanges\":" << frame.StateChanges;
+				output << ",\"BytesUploaded\":" << frame.BytesUploaded;
+			}
+			output << "}";
+		}
+		output << "]}";
+
+		return output.good();
+	}
+
+	bool SceneBenchmark::WriteCsv(std::ostream& output)
+	{
+		bool nullBackend = m_Settings.Backend == RendererAPI::API::Null;
+
+		output << "Frame,Profiled,Total";
+		for (auto& category : s_Categories)
+			output << "," << category.Name;
+		output << ",FrameMemoryBytes,FrameHeapAllocations,DynamicGeometryBytes";
+		output << ",ElidedStateChanges,ElidedShaderBinds,ElidedVertexArrayBinds,ElidedTextureBinds,ElidedFrameBufferBinds";
+		output << ",ElidedPipelineChanges,ElidedUniforms";
+		if (nullBackend)
+			output << ",DrawCalls,StateChanges,BytesUploaded";
+		output << "\n";
+
+		for (uint32_t i = 0; i < m_Frames.size(); i++)
+		{
+			const BenchmarkFrame& frame = m_Frames[i];
+			output << i << "," << frame.Profiled << "," << frame.Total;
+			for (float time : frame.Categories)
+				output << "," << time;
+			output << "," << frame.FrameMemoryBytes << "," << frame.FrameHeapAllocations << "," << frame.DynamicGeometryBytes;
+			const RenderStateCacheStats& cache = frame.StateCache;
+			output << "," << cache.Elided << "," << cache.ElidedShaderBinds << "," << cache.ElidedVertexArrayBinds << ",";
+			output << cache.ElidedTextureBinds << "," << cache.ElidedFrameBufferBinds << "," << cache.ElidedPipelineChanges << ",";
+			output << cache.ElidedUniforms;
+
+			if (nullBackend)
+			{
+				output << "," << frame.DrawCalls << "," << frame.StateChanges << "," << frame.BytesUploaded;
+			}
+			output << "\n";
+		}
+
+		return output.good();
+	}
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <Debut/Core/Core.h>
+#include <Debut/Rendering/Renderer/RendererAPI.h>
+#include <Debut/Rendering/Renderer/RenderStateCache.h>
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <iosfwd>
+
+/*
+	Runs a scene for a fixed number of frames with a fixed timestep and collects the CPU time spent in each part
+	of the frame, so that the same scene always produces comparable numbers.
+
+	Timings come from the instrumentation scopes that the scene and the renderers already have, through the
+	FrameProfiler. Categories may overlap: culling happens inside the shadow and 3D passes. Occlusion only measures
+	the occlusion buffer, the meshes are tested against it during the culling. In pipelined mode the
+	physics run on a worker, where the profiler doesn't see them: their categories come from the timings measured
+	by the simulation instead.
+*/
+
+namespace Debut
+{
+	class Scene;
+	class FrameBuffer;
+	class Window;
+	struct EntitySceneNode;
+
+	struct BenchmarkSettings
+	{
+		std::string ScenePath;
+		// .csv writes a CSV file, anything else JSON
+		std::string OutputPath;
+		// Chrome trace of the measured frames, not written if empty
+		std::string TracePath;
+
+		uint32_t Frames = 600;
+		// Run before measuring, so that the assets are loaded and the caches are warm
+		uint32_t WarmupFrames = 60;
+		float Timestep = 1.0f / 60.0f;
+		// Simulates the next frame while the current one is rendered
+		bool Pipelined = false;
+
+		uint32_t Width = 1600;
+		uint32_t Height = 900;
+		RendererAPI::API Backend = RendererAPI::API::Null;
+	};
+
+	struct BenchmarkFrame
+	{
+		// Instrumentor ticks when the frame started, used to find its profiled frame
+		uint64_t StartTicks = 0;
+		// False if the instrumentation buffers were full and the frame couldn't be recorded
+		bool Profiled = false;
+
+		// Milliseconds
+		float Total = 0.0f;
+		std::vector<float> Categories;
+		// Physics of the simulation that produced the frame, used in pipelined mode
+		float Physics2D = 0.0f;
+		float Physics3D = 0.0f;
+
+		// Only available with the null backend
+		uint64_t DrawCalls = 0;
+		uint64_t StateChanges = 0;
+		uint64_t BytesUploaded = 0;
+
+		// State changes dropped before reaching the backend
+		RenderStateCacheStats StateCache;
+
+		// Frame allocator usage, the heap is only used while the frame memory grows
+		uint64_t FrameMemoryBytes = 0;
+		uint32_t FrameHeapAllocations = 0;
+		// Vertex data uploaded to the dynamic geometry arena
+		uint64_t DynamicGeometryBytes = 0;
+	};
+
+	struct BenchmarkCategory
+	{
+		const char* Name;
+		// Name of the profiling scope that measures the category
+		const char* Scope;
+	};
+
+	class SceneBenchmark
+	{
+	public:
+		SceneBenchmark(const BenchmarkSettings& settings);
+		~SceneBenchmark();
+
+		bool Run();
+		bool WriteResults();
+
+		static const std::vector<BenchmarkCategory>& GetCategories() { return s_Categories; }
+
+	private:
+		bool LoadScene();
+		void RunFrame(BenchmarkFrame* frame);
+		void CollectTimings();
+
+		bool WriteJson(std::ostream& output);
+		bool WriteCsv(std::ostream& output);
+
+	private:
+		BenchmarkSettings m_Settings;
+
+		std::unique_ptr<Window> m_Window;
+		Ref<Scene> m_Scene;
+		Ref<FrameBuffer> m_FrameBuffer;
+		EntitySceneNode* m_SceneGraph = nullptr;
+
+		std::vector<BenchmarkFrame> m_Frames;
+
+		static std::vector<BenchmarkCategory> s_Categories;
+	};
+}
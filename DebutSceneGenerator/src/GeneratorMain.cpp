@@ -0,0 +1,151 @@
+#include <StressSceneGenerator.h>
+
+#include <Debut/Core/Log.h>
+#include <Debut/Core/JobSystem.h>
+#include <Debut/AssetManager/AssetManager.h>
+#include <Debut/Rendering/Renderer/Renderer.h>
+
+#include <filesystem>
+#include <iostream>
+
+/*
+	Generates a stress scene for the benchmarks:
+
+		DebutSceneGenerator <output.debut> [--preset <name>] [--project <dir>] [--seed <n>] [--scale <f>]
+			[--sprites <n>] [--textures <n>] [--meshes <n>] [--mesh-assets <n>] [--materials <n>]
+			[--depth <n>] [--branching <n>] [--rigidbodies2d <n>] [--rigidbodies3d <n>] [--point-lights <n>]
+			[--distribution uniform|grid|clustered] [--clusters <n>] [--extent <f>]
+
+	The preset is applied first, the other options override its values. The output path is relative to the
+	project directory, whose assets are used by the scene.
+*/
+
+using namespace Debut;
+
+static void PrintUsage()
+{
+	std::cout << "Usage: DebutSceneGenerator <output.debut> [--preset <name>] [--project <dir>] [--seed <n>] [--scale <f>]\n"
+		<< "\t[--sprites <n>] [--textures <n>] [--meshes <n>] [--mesh-assets <n>] [--materials <n>]\n"
+		<< "\t[--depth <n>] [--branching <n>] [--rigidbodies2d <n>] [--rigidbodies3d <n>] [--point-lights <n>]\n"
+		<< "\t[--distribution uniform|grid|clustered] [--clusters <n>] [--extent <f>]\n";
+
+	std::cout << "Presets:";
+	for (auto& preset : StressSceneGenerator::GetPresetNames())
+		std::cout << " " << preset;
+	std::cout << "\n";
+}
+
+static bool ParseArguments(int argc, char** argv, StressSceneSettings& settings, std::string& outputPath, std::string& projectDir)
+{
+	if (argc < 2)
+		return false;
+	outputPath = argv[1];
+
+	// The preset replaces all the settings, so it's applied before the rest of the options
+	for (int i = 2; i + 1 < argc; i++)
+		if (std::string(argv[i]) == "--preset" && !StressSceneGenerator::GetPreset(argv[i + 1], settings))
+			return false;
+
+	for (int i = 2; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (i + 1 >= argc)
+			return false;
+
+		if (arg == "--preset")
+			i++;
+		else if (arg == "--project")
+			projectDir = argv[++i];
+		else if (arg == "--seed")
+			settings.Seed = std::stoul(argv[++i]);
+		else if (arg == "--scale")
+			settings.Scale = std::stof(argv[++i]);
+		else if (arg == "--sprites")
+			settings.Sprites = std::stoul(argv[++i]);
+		else if (arg == "--textures")
+			settings.SpriteTextures = std::stoul(argv[++i]);
+		else if (arg == "--meshes")
+			settings.MeshRenderers = std::stoul(argv[++i]);
+		else if (arg == "--mesh-assets")
+			settings.Meshes = std::stoul(argv[++i]);
+		else if (arg == "--materials")
+			settings.Materials = std::stoul(argv[++i]);
+		else if (arg == "--depth")
+			settings.HierarchyDepth = std::stoul(argv[++i]);
+		else if (arg == "--branching")
+			settings.HierarchyBranching = std::stoul(argv[++i]);
+		else if (arg == "--rigidbodies2d")
+			settings.Rigidbodies2D = std::stoul(argv[++i]);
+		else if (arg == "--rigidbodies3d")
+			settings.Rigidbodies3D = std::stoul(argv[++i]);
+		else if (arg == "--point-lights")
+			settings.PointLights = std::stoul(argv[++i]);
+		else if (arg == "--distribution")
+		{
+			std::string distribution = argv[++i];
+			if (distribution == "uniform")
+				settings.Distribution = StressDistribution::Uniform;
+			else if (distribution == "grid")
+				settings.Distribution = StressDistribution::Grid;
+			else if (distribution == "clustered")
+				settings.Distribution = StressDistribution::Clustered;
+			else
+				return false;
+		}
+		else if (arg == "--clusters")
+			settings.Clusters = std::stoul(argv[++i]);
+		else if (arg == "--extent")
+			settings.Extent = std::stof(argv[++i]);
+		else
+			return false;
+	}
+
+	return settings.Scale > 0 && settings.Extent > 0;
+}
+
+int main(int argc, char** argv)
+{
+	StressSceneSettings settings;
+	std::string outputPath;
+	std::string projectDir = ".";
+
+	try
+	{
+		if (!ParseArguments(argc, argv, settings, outputPath, projectDir))
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+	catch (const std::exception&)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	Log.Init();
+	// The serializer logs the whole scene
+	spdlog::set_level(spdlog::level::warn);
+	std::filesystem::current_path(projectDir);
+
+	JobSystem::Init();
+	// Models are loaded to read their meshes and materials, nothing is drawn
+	RendererAPI::SetAPI(RendererAPI::API::Null);
+	Renderer::Init();
+	AssetManager::Init(".");
+
+	int ret = 0;
+	{
+		StressSceneGenerator generator(settings);
+		if (generator.Generate())
+		{
+			generator.Save(outputPath);
+			std::cout << "Generated " << generator.GetEntityCount() << " entities in " << outputPath << "\n";
+		}
+		else
+			ret = 1;
+	}
+
+	JobSystem::Shutdown();
+	return ret;
+}
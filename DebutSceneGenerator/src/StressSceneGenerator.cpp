@@ -0,0 +1,400 @@
+#include <StressSceneGenerator.h>
+
+#include <Debut/Core/Log.h>
+#include <Debut/Scene/Scene.h>
+#include <Debut/Scene/Components.h>
+#include <Debut/Scene/SceneSerializer.h>
+#include <Debut/AssetManager/AssetManager.h>
+#include <Debut/Rendering/Resources/Model.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <filesystem>
+#include <unordered_set>
+
+namespace Debut
+{
+	static void DeleteSceneGraph(EntitySceneNode* node)
+	{
+		for (auto child : node->Children)
+			DeleteSceneGraph(child);
+		delete node;
+	}
+
+	static void GatherModelAssets(Ref<Model> model, std::vector<UUID>& meshes, std::vector<UUID>& materials,
+		std::unordered_set<uint64_t>& added)
+	{
+		if (model == nullptr)
+			return;
+
+		for (auto mesh : model->GetMeshes())
+			if (added.insert(mesh).second)
+				meshes.push_back(mesh);
+		for (auto material : model->GetMaterials())
+			if (added.insert(material).second)
+				materials.push_back(material);
+
+		for (auto submodel : model->GetSubmodels())
+			GatherModelAssets(AssetManager::Request<Model>(submodel), meshes, materials, added);
+	}
+
+	StressSceneGenerator::StressSceneGenerator(const StressSceneSettings& settings) : m_Settings(settings), m_Random(settings.Seed)
+	{
+		m_Settings.HierarchyDepth = std::max(m_Settings.HierarchyDepth, 1u);
+		m_Settings.HierarchyBranching = std::max(m_Settings.HierarchyBranching, 1u);
+		m_Settings.Clusters = std::max(m_Settings.Clusters, 1u);
+	}
+
+	StressSceneGenerator::~StressSceneGenerator()
+	{
+		if (m_SceneGraph != nullptr)
+			DeleteSceneGraph(m_SceneGraph);
+	}
+
+	bool StressSceneGenerator::GetPreset(const std::string& name, StressSceneSettings& settings)
+	{
+		StressSceneSettings preset;
+
+		if (name == "sprites")
+		{
+			preset.Sprites = 200000;
+			preset.SpriteTextures = 8;
+			preset.Extent = 500.0f;
+		}
+		else if (name == "meshes")
+		{
+			preset.MeshRenderers = 50000;
+			preset.Meshes = 8;
+			preset.Materials = 8;
+			preset.Extent = 500.0f;
+		}
+		else if (name == "deep")
+		{
+			preset.MeshRenderers = 10000;
+			preset.HierarchyDepth = 64;
+			preset.HierarchyBranching = 1;
+		}
+		else if (name == "wide")
+		{
+			preset.MeshRenderers = 10000;
+			preset.HierarchyDepth = 2;
+			preset.HierarchyBranching = 1000;
+		}
+		else if (name == "physics2d")
+			preset.Rigidbodies2D = 5000;
+		else if (name == "physics3d")
+			preset.Rigidbodies3D = 5000;
+		else if (name == "lights")
+		{
+			preset.MeshRenderers = 5000;
+			preset.PointLights = 1024;
+			preset.Distribution = StressDistribution::Clustered;
+		}
+		else
+			return false;
+
+		preset.Seed = settings.Seed;
+		settings = preset;
+		return true;
+	}
+
+	std::vector<std::string> StressSceneGenerator::GetPresetNames()
+	{
+		return { "sprites", "meshes", "deep", "wide", "physics2d", "physics3d", "lights" };
+	}
+
+	bool StressSceneGenerator::Generate()
+	{
+		if (!GatherAssets())
+			return false;
+
+		m_Scene = CreateRef<Scene>();
+		m_SceneGraph = new EntitySceneNode(true, {});
+		m_EntityCount = 0;
+
+		m_ClusterCenters.resize(m_Settings.Clusters);
+		for (auto& center : m_ClusterCenters)
+			center = { RandomFloat(-1, 1), RandomFloat(-1, 1), RandomFloat(-1, 1) };
+
+		CreateCamera();
+		CreateSprites();
+		CreateMeshes();
+		CreateRigidbodies2D();
+		CreateRigidbodies3D();
+		CreatePointLights();
+
+		return true;
+	}
+
+	void StressSceneGenerator::Save(const std::string& path)
+	{
+		// Keep the settings in the scene, so that it can be generated again
+		YAML::Node additionalData;
+		YAML::Node generator = additionalData["StressSceneGenerator"];
+		generator["Seed"] = m_Settings.Seed;
+		generator["Sprites"] = GetCount(m_Settings.Sprites);
+		generator["SpriteTextures"] = m_Textures.size();
+		generator["MeshRenderers"] = GetCount(m_Settings.MeshRenderers);
+		generator["Meshes"] = m_Meshes.size();
+		generator["Materials"] = m_Materials.size();
+		generator["HierarchyDepth"] = m_Settings.HierarchyDepth;
+		generator["HierarchyBranching"] = m_Settings.HierarchyBranching;
+		generator["Rigidbodies2D"] = GetCount(m_Settings.Rigidbodies2D);
+		generator["Rigidbodies3D"] = GetCount(m_Settings.Rigidbodies3D);
+		generator["PointLights"] = GetCount(m_Settings.PointLights);
+		generator["Distribution"] = (int)m_Settings.Distribution;
+		generator["Extent"] = m_Settings.Extent;
+
+		SceneSerializer ss(m_Scene);
+		ss.SerializeText(path, *m_SceneGraph, additionalData);
+	}
+
+	bool StressSceneGenerator::GatherAssets()
+	{
+		bool needsMeshes = m_Settings.MeshRenderers > 0 || m_Settings.Rigidbodies3D > 0;
+		std::unordered_set<uint64_t> added;
+
+		for (auto& [id, path] : AssetManager::GetAssetMap())
+		{
+			std::string extension = std::filesystem::path(path).extension().string();
+			std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+			if (m_Textures.size() < m_Settings.SpriteTextures && path.find("icons") == std::string::npos &&
+				(extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga"))
+				m_Textures.push_back(id);
+			else if (needsMeshes && extension == ".model" &&
+				(m_Meshes.size() < m_Settings.Meshes || m_Materials.size() < m_Settings.Materials))
+				GatherModelAssets(AssetManager::Request<Model>(id), m_Meshes, m_Materials, added);
+		}
+
+		if (m_Meshes.size() > m_Settings.Meshes)
+			m_Meshes.resize(m_Settings.Meshes);
+		if (m_Materials.size() > m_Settings.Materials)
+			m_Materials.resize(m_Settings.Materials);
+
+		if (m_Textures.size() < m_Settings.SpriteTextures)
+			Log.AppWarn("Requested {0} sprite textures, the project only has {1}", m_Settings.SpriteTextures, m_Textures.size());
+		if (needsMeshes)
+		{
+			if (m_Meshes.size() == 0 || m_Materials.size() == 0)
+			{
+				Log.AppError("The project doesn't contain any model to take meshes and materials from");
+				return false;
+			}
+			if (m_Meshes.size() < m_Settings.Meshes || m_Materials.size() < m_Settings.Materials)
+				Log.AppWarn("Requested {0} meshes and {1} materials, using {2} and {3}", m_Settings.Meshes, m_Settings.Materials,
+					m_Meshes.size(), m_Materials.size());
+		}
+
+		return true;
+	}
+
+	Entity StressSceneGenerator::CreateEntity(const std::string& name, Entity parent, EntitySceneNode* parentNode, EntitySceneNode** node)
+	{
+		// Seeded ids, the same settings produce the same file
+		uint64_t id = (uint64_t)m_Random() << 32;
+		id |= m_Random();
+		Entity ret = m_Scene->CreateEntity(parent, UUID(id), name + " " + std::to_string(m_EntityCount++));
+
+		EntitySceneNode* newNode = new EntitySceneNode(false, ret);
+		newNode->IndexInNode = (uint32_t)parentNode->Children.size();
+		parentNode->Children.push_back(newNode);
+
+		if (node != nullptr)
+			*node = newNode;
+		return ret;
+	}
+
+	template <typename Fn>
+	void StressSceneGenerator::CreateHierarchy(const std::string& name, uint32_t count, bool is2D, Fn&& setup)
+	{
+		// Trees are stored like heaps: the parent of the node i is (i - 1) / branching
+		uint32_t treeSize = 0;
+		uint64_t levelSize = 1;
+		for (uint32_t i = 0; i < m_Settings.HierarchyDepth && treeSize < count; i++)
+		{
+			treeSize += (uint32_t)std::min<uint64_t>(levelSize, count);
+			levelSize *= m_Settings.HierarchyBranching;
+		}
+		treeSize = std::max(std::min(treeSize, count), 1u);
+
+		uint32_t trees = (count + treeSize - 1) / treeSize;
+		std::vector<std::pair<Entity, EntitySceneNode*>> tree(treeSize);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			uint32_t node = i % treeSize;
+			Entity parent = {};
+			EntitySceneNode* parentNode = m_SceneGraph;
+			if (node > 0)
+				std::tie(parent, parentNode) = tree[(node - 1) / m_Settings.HierarchyBranching];
+
+			Entity entity = CreateEntity(name, parent, parentNode, &tree[node].second);
+			tree[node].first = entity;
+
+			// Roots are spread in the scene, children stay close to their parent
+			TransformComponent& transform = entity.Transform();
+			if (node == 0)
+				transform.Translation = GetPosition(i / treeSize, trees, is2D);
+			else
+				transform.Translation = { RandomFloat(-2, 2), RandomFloat(-2, 2), is2D ? 0.0f : RandomFloat(-2, 2) };
+
+			// 2D entities only rotate around the view axis
+			if (is2D)
+				transform.Rotation.z = RandomFloat(-3.14f, 3.14f);
+			else
+				transform.Rotation = { RandomFloat(-3.14f, 3.14f), RandomFloat(-3.14f, 3.14f), RandomFloat(-3.14f, 3.14f) };
+
+			setup(entity, i);
+		}
+	}
+
+	glm::vec3 StressSceneGenerator::GetPosition(uint32_t index, uint32_t count, bool is2D)
+	{
+		glm::vec3 ret(0.0f);
+
+		switch (m_Settings.Distribution)
+		{
+		case StressDistribution::Uniform:
+			ret = { RandomFloat(-1, 1), RandomFloat(-1, 1), RandomFloat(-1, 1) };
+			break;
+		case StressDistribution::Grid:
+		{
+			uint32_t side = (uint32_t)std::ceil(is2D ? std::sqrt((float)count) : std::cbrt((float)count));
+			side = std::max(side, 2u);
+			float step = 2.0f / (side - 1);
+			ret = { -1.0f + (index % side) * step, -1.0f + ((index / side) % side) * step, -1.0f + (index / (side * side)) * step };
+			if (is2D)
+				ret.z = 0.0f;
+			break;
+		}
+		case StressDistribution::Clustered:
+		{
+			std::normal_distribution<float> spread(0.0f, 0.08f);
+			ret = m_ClusterCenters[m_Random() % m_ClusterCenters.size()];
+			ret += glm::vec3{ spread(m_Random), spread(m_Random), spread(m_Random) };
+			break;
+		}
+		}
+
+		if (is2D)
+			ret.z = 0.0f;
+		return ret * m_Settings.Extent;
+	}
+
+	float StressSceneGenerator::RandomFloat(float min, float max)
+	{
+		return std::uniform_real_distribution<float>(min, max)(m_Random);
+	}
+
+	void StressSceneGenerator::CreateCamera()
+	{
+		bool is3D = m_Settings.MeshRenderers > 0 || m_Settings.Rigidbodies3D > 0 || m_Settings.PointLights > 0;
+		float extent = m_Settings.Extent;
+
+		Entity camera = CreateEntity("Camera", {}, m_SceneGraph, nullptr);
+		CameraComponent& cameraComponent = camera.AddComponent<CameraComponent>();
+		if (is3D)
+		{
+			cameraComponent.Camera.SetPerspective(30, 0.1f, extent * 10.0f);
+			cameraComponent.Camera.SetFOV(glm::radians(40.0f));
+			camera.Transform().Translation = { 0.0f, extent * 0.5f, extent * 2.5f };
+
+			Entity light = CreateEntity("Directional light", {}, m_SceneGraph, nullptr);
+			light.AddComponent<DirectionalLightComponent>().Direction = glm::vec3(0.5f, 0.5f, 0.5f);
+		}
+		else
+		{
+			cameraComponent.Camera.SetOrthographic(extent * 2.2f, -10.0f, 10.0f);
+		}
+	}
+
+	void StressSceneGenerator::CreateSprites()
+	{
+		CreateHierarchy("Sprite", GetCount(m_Settings.Sprites), true, [&](Entity entity, uint32_t index)
+			{
+				SpriteRendererComponent& sprite = entity.AddComponent<SpriteRendererComponent>();
+				sprite.Color = { RandomFloat(0, 1), RandomFloat(0, 1), RandomFloat(0, 1), 1.0f };
+				if (m_Textures.size() > 0)
+					sprite.Texture = m_Textures[index % m_Textures.size()];
+			});
+	}
+
+	void StressSceneGenerator::CreateMeshes()
+	{
+		CreateHierarchy("Mesh", GetCount(m_Settings.MeshRenderers), false, [&](Entity entity, uint32_t index)
+			{
+				entity.AddComponent<MeshRendererComponent>(m_Meshes[index % m_Meshes.size()], m_Materials[index % m_Materials.size()]);
+			});
+	}
+
+	void StressSceneGenerator::CreateRigidbodies2D()
+	{
+		uint32_t count = GetCount(m_Settings.Rigidbodies2D);
+		if (count == 0)
+			return;
+
+		float extent = m_Settings.Extent;
+		Entity ground = CreateEntity("Ground 2D", {}, m_SceneGraph, nullptr);
+		ground.Transform().Translation = { 0.0f, -extent - 1.0f, 0.0f };
+		ground.AddComponent<Rigidbody2DComponent>().Type = Rigidbody2DComponent::BodyType::Static;
+		ground.AddComponent<BoxCollider2DComponent>().Size = { extent * 2.0f, 1.0f };
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			Entity body = CreateEntity("Body 2D", {}, m_SceneGraph, nullptr);
+			body.Transform().Translation = GetPosition(i, count, true);
+			body.Transform().Rotation.z = RandomFloat(-3.14f, 3.14f);
+			body.AddComponent<SpriteRendererComponent>().Color = { RandomFloat(0, 1), RandomFloat(0, 1), RandomFloat(0, 1), 1.0f };
+			body.AddComponent<Rigidbody2DComponent>();
+
+			// Mix of shapes, so that all the collision pairs are exercised
+			if (i % 2 == 0)
+				body.AddComponent<BoxCollider2DComponent>();
+			else
+				body.AddComponent<CircleCollider2DComponent>().Radius = 0.5f;
+		}
+	}
+
+	void StressSceneGenerator::CreateRigidbodies3D()
+	{
+		uint32_t count = GetCount(m_Settings.Rigidbodies3D);
+		if (count == 0)
+			return;
+
+		float extent = m_Settings.Extent;
+		Entity ground = CreateEntity("Ground 3D", {}, m_SceneGraph, nullptr);
+		ground.Transform().Translation = { 0.0f, -extent - 1.0f, 0.0f };
+		ground.AddComponent<BoxCollider3DComponent>().Size = { extent * 2.0f, 1.0f, extent * 2.0f };
+		ground.GetComponent<Rigidbody3DComponent>().Type = Rigidbody3DComponent::BodyType::Static;
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			Entity body = CreateEntity("Body 3D", {}, m_SceneGraph, nullptr);
+			body.Transform().Translation = GetPosition(i, count, false);
+			body.AddComponent<MeshRendererComponent>(m_Meshes[i % m_Meshes.size()], m_Materials[i % m_Materials.size()]);
+
+			// Colliders add the rigidbody
+			if (i % 2 == 0)
+				body.AddComponent<BoxCollider3DComponent>();
+			else
+				body.AddComponent<SphereCollider3DComponent>();
+		}
+	}
+
+	void StressSceneGenerator::CreatePointLights()
+	{
+		uint32_t count = GetCount(m_Settings.PointLights);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			Entity entity = CreateEntity("Point light", {}, m_SceneGraph, nullptr);
+			entity.Transform().Translation = GetPosition(i, count, false);
+
+			PointLightComponent& light = entity.AddComponent<PointLightComponent>();
+			light.Position = entity.Transform().Translation;
+			light.Color = { RandomFloat(0.2f, 1), RandomFloat(0.2f, 1), RandomFloat(0.2f, 1) };
+			light.Radius = RandomFloat(2.0f, 10.0f);
+			light.Intensity = RandomFloat(0.5f, 2.0f);
+		}
+	}
+}
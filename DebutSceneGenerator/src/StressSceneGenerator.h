@@ -0,0 +1,106 @@
+#pragma once
+
+#include <Debut/Core/Core.h>
+#include <Debut/Core/UUID.h>
+#include <Debut/Scene/Entity.h>
+
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+#include <random>
+
+/*
+	Generates large synthetic scenes through the Scene API and saves them with the SceneSerializer, so that they
+	can be opened in the editor or run with the player.
+
+	Renderable entities are grouped in trees of HierarchyDepth levels where every node has HierarchyBranching
+	children: depth 1 is a flat scene, a branching of 1 makes chains. Textures, meshes and materials are taken
+	from the assets of the current project, in the order of the asset map, so the same settings always produce
+	the same scene.
+*/
+
+namespace Debut
+{
+	class Scene;
+
+	enum class StressDistribution { Uniform = 0, Grid, Clustered };
+
+	struct StressSceneSettings
+	{
+		uint32_t Seed = 1234;
+
+		uint32_t Sprites = 0;
+		// 0 draws untextured sprites
+		uint32_t SpriteTextures = 0;
+
+		uint32_t MeshRenderers = 0;
+		// Number of distinct meshes and materials shared by the mesh renderers
+		uint32_t Meshes = 1;
+		uint32_t Materials = 1;
+
+		uint32_t HierarchyDepth = 1;
+		uint32_t HierarchyBranching = 1;
+
+		// Bodies fall on a static ground
+		uint32_t Rigidbodies2D = 0;
+		uint32_t Rigidbodies3D = 0;
+		uint32_t PointLights = 0;
+
+		StressDistribution Distribution = StressDistribution::Uniform;
+		uint32_t Clusters = 16;
+		// Half size of the volume that contains the entities
+		float Extent = 100.0f;
+
+		// Multiplies all the entity counts
+		float Scale = 1.0f;
+	};
+
+	class StressSceneGenerator
+	{
+	public:
+		StressSceneGenerator(const StressSceneSettings& settings);
+		~StressSceneGenerator();
+
+		// Creates the scene, returns false if the project doesn't have the assets the settings need
+		bool Generate();
+		void Save(const std::string& path);
+
+		static bool GetPreset(const std::string& name, StressSceneSettings& settings);
+		static std::vector<std::string> GetPresetNames();
+
+		inline Ref<Scene> GetScene() { return m_Scene; }
+		inline uint32_t GetEntityCount() { return m_EntityCount; }
+
+	private:
+		bool GatherAssets();
+
+		Entity CreateEntity(const std::string& name, Entity parent, EntitySceneNode* parentNode, EntitySceneNode** node);
+		// Creates count entities in trees, the callback adds the components to each of them
+		template <typename Fn>
+		void CreateHierarchy(const std::string& name, uint32_t count, bool is2D, Fn&& setup);
+
+		glm::vec3 GetPosition(uint32_t index, uint32_t count, bool is2D);
+		float RandomFloat(float min, float max);
+		uint32_t GetCount(uint32_t count) { return (uint32_t)(count * m_Settings.Scale); }
+
+		void CreateCamera();
+		void CreateSprites();
+		void CreateMeshes();
+		void CreateRigidbodies2D();
+		void CreateRigidbodies3D();
+		void CreatePointLights();
+
+	private:
+		StressSceneSettings m_Settings;
+		std::mt19937 m_Random;
+
+		Ref<Scene> m_Scene;
+		EntitySceneNode* m_SceneGraph = nullptr;
+		uint32_t m_EntityCount = 0;
+
+		std::vector<glm::vec3> m_ClusterCenters;
+		std::vector<UUID> m_Textures;
+		std::vector<UUID> m_Meshes;
+		std::vector<UUID> m_Materials;
+	};
+}
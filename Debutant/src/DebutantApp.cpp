@@ -9,14 +9,14 @@
 
 namespace Debut
 {
-	DebutantApp::DebutantApp() : Application("Debutant")
+	DebutantApp::DebutantApp(ApplicationCommandLineArgs args) : Application("Debutant", args)
 	{
 		PushLayer(new DebutantLayer());
 	}
 
-	Application* CreateApplication()
+	Application* CreateApplication(ApplicationCommandLineArgs args)
 	{
-		return new DebutantApp();
+		return new DebutantApp(args);
 	}
 
 }
\ No newline at end of file
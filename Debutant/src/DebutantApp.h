@@ -8,7 +8,7 @@ namespace Debut
 	class DebutantApp : public Application
 	{
 	public:
-		DebutantApp();
+		DebutantApp(ApplicationCommandLineArgs args);
 		~DebutantApp() = default;
 
 		static DebutantApp& Get() { return *((DebutantApp*)s_Instance); }
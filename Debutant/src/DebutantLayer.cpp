@@ -16,6 +16,8 @@
 
 #include <chrono>
 #include "Debut/ImGui/ImGuiUtils.h"
+#include <Debut/ImGui/ProfilerPanel.h>
+#include <Debut/ImGui/MemoryPanel.h>
 #include <imgui_internal.h>
 #include <yaml-cpp/yaml.h>
 #include <Debut/Utils/YamlUtils.h>
@@ -98,6 +100,7 @@ namespace Debut
         m_ContentBrowser.SetPropertiesPanel(&m_PropertiesPanel);
 
         AssetManager::Init(".");
+        MemoryTracker::LoadBudgets("Debut\\MemoryBudgets.yaml");
     }
 
     void DebutantLayer::OnDetach()
@@ -368,6 +371,16 @@ namespace Debut
                 ImGui::EndMenu();
             }
 
+            if (ImGui::BeginMenu("Window"))
+            {
+                if (ImGui::MenuItem("Profiler", nullptr, ProfilerPanel::IsOpen()))
+                    ProfilerPanel::SetOpen(!ProfilerPanel::IsOpen());
+                if (ImGui::MenuItem("Memory", nullptr, MemoryPanel::IsOpen()))
+                    MemoryPanel::SetOpen(!MemoryPanel::IsOpen());
+
+                ImGui::EndMenu();
+            }
+
             ImGui::EndMenuBar();
         }
     }
@@ -18,6 +18,39 @@
 
 namespace Debut
 {
+	// Accepts .mesh files dropped on the last item, returns the ID of the mesh or 0
+	static UUID MeshDragDestination()
+	{
+		UUID ret = 0;
+		if (ImGui::BeginDragDropTarget())
+		{
+			if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("CONTENT_BROWSER_DATA"))
+			{
+				const wchar_t* path = (const wchar_t*)payload->Data;
+				std::filesystem::path pathStr(path);
+
+				if (pathStr.extension() == ".mesh")
+				{
+					pathStr = pathStr.replace_extension();
+					std::ifstream meta(AssetManager::s_MetadataDir + pathStr.string() + ".meta");
+
+					if (meta.good())
+					{
+						std::stringstream ss;
+						ss << meta.rdbuf();
+						YAML::Node metaData = YAML::Load(ss.str());
+
+						ret = metaData["ID"].as<uint64_t>();
+					}
+				}
+			}
+
+			ImGui::EndDragDropTarget();
+		}
+
+		return ret;
+	}
+
 	void InspectorPanel::OnImGuiRender()
 	{
 		ImGui::Begin("Inspector");
@@ -118,10 +151,13 @@ namespace Debut
 				static MeshMetadata meshData; 
 				static MaterialMetadata materialData;
 
+				static MeshMetadata occluderData;
+
 				if ((entt::entity)m_PrevSelectionContext != (entt::entity)m_SelectionContext)
 				{
 					meshData = Mesh::GetMetadata(component.Mesh);
 					materialData = Material::GetMetadata(component.Material);
+					occluderData = Mesh::GetMetadata(component.OccluderMesh);
 				}
 
 				// Mesh reference
@@ -129,31 +165,9 @@ namespace Debut
 				ImGui::NextColumn();
 
 				ImGui::Button((meshData.Name + "##mesh").c_str(), { ImGui::GetContentRegionAvail().x, ImGui::GetTextLineHeight() * 1.2f });
-				if (ImGui::BeginDragDropTarget())
-				{
-					if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("CONTENT_BROWSER_DATA"))
-					{
-						const wchar_t* path = (const wchar_t*)payload->Data;
-						std::filesystem::path pathStr(path);
-
-						if (pathStr.extension() == ".mesh")
-						{
-							pathStr = pathStr.replace_extension();
-							std::ifstream meta(AssetManager::s_MetadataDir + pathStr.string() + ".meta");
-
-							if (meta.good())
-							{
-								std::stringstream ss;
-								ss << meta.rdbuf();
-								YAML::Node metaData = YAML::Load(ss.str());
-
-								component.Mesh = metaData["ID"].as<uint64_t>();
-							}
-						}
-					}
-
-					ImGui::EndDragDropTarget();
-				}
+				UUID mesh = MeshDragDestination();
+				if (mesh != 0)
+					component.Mesh = mesh;
 
 				ImGui::NextColumn();
 
@@ -201,6 +215,25 @@ namespace Debut
 
 				ImGui::NextColumn();
 
+				// Occlusion culling
+				ImGui::LabelText("##occluderlabel", "Occluder");
+				ImGui::NextColumn();
+				ImGui::Checkbox("##occluder", &component.Occluder);
+				ImGui::NextColumn();
+
+				ImGui::LabelText("##occludermeshlabel", "Occluder mesh");
+				ImGui::NextColumn();
+
+				ImGui::Button((occluderData.Name + "##occludermesh").c_str(), { ImGui::GetContentRegionAvail().x, ImGui::GetTextLineHeight() * 1.2f });
+				UUID occluderMesh = MeshDragDestination();
+				if (occluderMesh != 0)
+				{
+					component.OccluderMesh = occluderMesh;
+					occluderData = Mesh::GetMetadata(occluderMesh);
+				}
+
+				ImGui::NextColumn();
+
 				ImGuiUtils::ResetColumns();
 			});
 
@@ -240,6 +273,16 @@ namespace Debut
 				ImGui::SameLine();
 				ImGuiUtils::DragFloat("Tiling factor", &component.TilingFactor, 0.1f);
 
+				// Sorting
+				ImGuiUtils::DragInt("Sort layer", &component.SortLayer, 0.1f, SpriteRendererComponent::MinSortLayer,
+					SpriteRendererComponent::MaxSortLayer);
+				ImGuiUtils::DragInt("Order in layer", &component.OrderInLayer, 0.1f, SpriteRendererComponent::MinOrderInLayer,
+					SpriteRendererComponent::MaxOrderInLayer);
+				// The widgets don't clamp the values that are typed in
+				component.SortLayer = std::clamp(component.SortLayer, SpriteRendererComponent::MinSortLayer,
+					SpriteRendererComponent::MaxSortLayer);
+				component.OrderInLayer = std::clamp(component.OrderInLayer, SpriteRendererComponent::MinOrderInLayer,
+					SpriteRendererComponent::MaxOrderInLayer);
 			});
 
 		DrawComponent<Rigidbody2DComponent>("Rigidbody 2D", entity, [](auto& component)
@@ -405,5 +448,11 @@ namespace Debut
 
 				component.Position = entity.Transform().Translation;
 			});
+
+		// The widgets modify the components in place
+		if (entity.HasComponent<TransformComponent>())
+			entity.MarkChanged<TransformComponent>();
+		if (entity.HasComponent<MeshRendererComponent>())
+			entity.MarkChanged<MeshRendererComponent>();
 	}
 }
\ No newline at end of file
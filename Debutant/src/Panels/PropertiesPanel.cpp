@@ -269,6 +269,10 @@ namespace Debut
 		{
 			texParams.Filtering = texture->GetFilteringMode();
 			texParams.WrapMode = texture->GetWrapMode();
+			texParams.Mipmaps = texture->HasMipmaps();
+			texParams.SRGB = texture->IsSRGB();
+			texParams.Compression = texture->GetCompression();
+			texParams.Quality = texture->GetQuality();
 			texParams.ID = texture->GetID();
 		}
 
@@ -277,13 +281,21 @@ namespace Debut
 
 		std::string currFilterStdStr = Tex2DParamToString(texParams.Filtering);
 		std::string currWrapStdStr = Tex2DParamToString(texParams.WrapMode);
+		std::string currCompressionStdStr = Tex2DParamToString(texParams.Compression);
+		std::string currQualityStdStr = Tex2DParamToString(texParams.Quality);
 		const char* currFilterString = currFilterStdStr.c_str();
 		const char* currWrapString = currWrapStdStr.c_str();
+		const char* currCompressionString = currCompressionStdStr.c_str();
+		const char* currQualityString = currQualityStdStr.c_str();
 
 		const char* filterTypes[] = { "Linear", "Point" };
 		const char* newFilterType = nullptr;
 		const char* wrapTypes[] = { "Clamp", "Repeat" };
 		const char* newWrapMode = nullptr;
+		const char* compressionTypes[] = { "None", "Color", "Mask", "NormalMap" };
+		const char* newCompression = nullptr;
+		const char* qualityTypes[] = { "Fast", "Normal", "High" };
+		const char* newQuality = nullptr;
 
 		const ImGuiTreeNodeFlags treeNodeFlags = ImGuiTreeNodeFlags_AllowItemOverlap
 			| ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_FramePadding;
@@ -295,8 +307,20 @@ namespace Debut
 		ImGuiUtils::StartColumns(2, { 100, 200 });
 		if (ImGuiUtils::Combo("Wrap mode", wrapTypes, 2, &currWrapString, &newWrapMode))
 			texParams.WrapMode = StringToTex2DParam(newWrapMode);
+
+		ImGuiUtils::StartColumns(2, { 100, 200 });
+		if (ImGuiUtils::Combo("Compression", compressionTypes, 4, &currCompressionString, &newCompression))
+			texParams.Compression = StringToTex2DParam(newCompression);
+
+		ImGuiUtils::StartColumns(2, { 100, 200 });
+		if (ImGuiUtils::Combo("Quality", qualityTypes, 3, &currQualityString, &newQuality))
+			texParams.Quality = StringToTex2DParam(newQuality);
 		ImGuiUtils::ResetColumns();
 
+		ImGui::Checkbox("Generate mipmaps", &texParams.Mipmaps);
+		// Normal maps and masks aren't colors, they must be filtered linearly
+		ImGui::Checkbox("sRGB", &texParams.SRGB);
+
 		if (ImGui::TreeNodeEx("Texture preview", treeNodeFlags))
 		{
 			ImVec2 windowSize = ImGui::GetContentRegionAvail();
@@ -239,6 +239,7 @@ namespace Debut
 					}
 
 					child.Transform().SetParent(node.EntityData);
+					child.MarkChanged<TransformComponent>();
 					RebuildSceneGraph();
 				}
 
@@ -445,11 +446,13 @@ namespace Debut
 		{
 			m_EntityParenting[movedEntity] = -1;
 			child->EntityData.Transform().SetParent({});
+			child->EntityData.MarkChanged<TransformComponent>();
 		}
 		else
 		{
 			m_EntityParenting[movedEntity] = newParent->EntityData;
 			child->EntityData.Transform().SetParent(newParent->EntityData);
+			child->EntityData.MarkChanged<TransformComponent>();
 		}
 
 		RebuildSceneGraph();
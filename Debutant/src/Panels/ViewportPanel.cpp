@@ -3,6 +3,7 @@
 #include <DebutantApp.h>
 #include <Debut/Core/Application.h>
 #include <Debut/Core/Instrumentor.h>
+#include <Debut/Core/FrameAllocator.h>
 #include <Debut/Core/Window.h>
 #include <Debut/Events/KeyEvent.h>
 #include <Debut/Events/MouseEvent.h>
@@ -12,11 +13,16 @@
 #include <Debut/Scene/Scene.h>
 #include <Debut/Rendering/RenderTexture.h>
 #include <Debut/Rendering/Resources/PostProcessing.h>
+#include <Debut/Rendering/Renderer/Renderer2D.h>
 #include <Debut/Rendering/Renderer/Renderer3D.h>
+#include <Debut/Rendering/Structures/BufferArena.h>
 #include <Debut/Rendering/Structures/FrameBuffer.h>
+#include <Debut/Rendering/Structures/MeshPool.h>
 #include <Debut/Rendering/Structures/ShadowMap.h>
 #include <Debut/Rendering/Renderer/Renderer.h>
 #include <Debut/Rendering/Renderer/RendererDebug.h>
+#include <Debut/Rendering/Renderer/RenderStateCache.h>
+#include <Debut/Rendering/Renderer/RenderCommandBuffer.h>
 
 #include <Debut/Utils/TransformationUtils.h>
 
@@ -152,6 +158,41 @@ namespace Debut
             ImGui::Text("DEFAULT: Shadow passes: %d", shadowPasses);
             ImGui::Text("SHADOW: Shadow draw calls: %d", shadowDrawCalls);
             ImGui::Text("SHADOW: Shadow triangles: %d", shadowTriangles);
+            ImGui::Text("SHADOW: Skipped maps: %u, static updates: %u", stats.SkippedShadowMaps, stats.StaticShadowUpdates);
+            ImGui::Text("LIGHTS: Clustered: %u, indices: %u, most in a cluster: %u", stats.ClusteredLights,
+                stats.ClusterLightIndices, stats.MaxClusterLights);
+            Render2DStats stats2D = Renderer2D::GetStats();
+            ImGui::Text("2D: Draw calls: %u, sprites: %u, texture flushes: %u", stats2D.DrawCalls, stats2D.QuadCount,
+                stats2D.TextureFlushes);
+            ImGui::Text("OCCLUSION: Occluders: %u (%u triangles), occluded meshes: %u", stats.Occluders,
+                stats.OccluderTriangles, stats.OccludedMeshes);
+
+            FrameAllocatorStats memory = FrameAllocator::GetStats();
+            ImGui::Text("MEMORY: Frame allocations: %u (%.1f KB)", memory.Allocations, memory.AllocatedBytes / 1024.0f);
+            ImGui::Text("MEMORY: Frame heap allocations: %u", memory.HeapAllocations);
+
+            BufferArenaStats geometry = Renderer::GetDynamicGeometry()->GetStats();
+            ImGui::Text("GEOMETRY: Dynamic uploads: %u (%.1f KB)", geometry.Allocations, geometry.AllocatedBytes / 1024.0f);
+            ImGui::Text("GEOMETRY: Region: %.1f KB, peak %.1f KB", geometry.RegionSize / 1024.0f, geometry.PeakBytes / 1024.0f);
+            ImGui::Text("GEOMETRY: Grows: %u, shrinks: %u, stalls: %u", geometry.Grows, geometry.Shrinks, geometry.Stalls);
+
+            MeshPoolStats meshes = Renderer::GetMeshPool()->GetStats();
+            ImGui::Text("MESHES: Loaded: %u", meshes.Meshes);
+            ImGui::Text("MESHES: Vertices: %u / %u, indices: %u / %u", meshes.UsedVertices, meshes.VertexCapacity,
+                meshes.UsedIndices, meshes.IndexCapacity);
+            ImGui::Text("MESHES: Free ranges: %u vertex, %u index, fragmentation %.2f / %.2f", meshes.FreeVertexRanges,
+                meshes.FreeIndexRanges, meshes.VertexFragmentation, meshes.IndexFragmentation);
+            ImGui::Text("MESHES: Grows: %u, defragmentations: %u", meshes.Grows, meshes.Defragmentations);
+
+            RenderStateCacheStats state = RenderStateCache::GetStats();
+            ImGui::Text("STATE: Calls: %u, elided: %u", state.Calls, state.Elided);
+            ImGui::Text("STATE: Elided binds: %u shaders, %u arrays, %u textures, %u frame buffers", state.ElidedShaderBinds,
+                state.ElidedVertexArrayBinds, state.ElidedTextureBinds, state.ElidedFrameBufferBinds);
+            ImGui::Text("STATE: Elided pipeline changes: %u, uniforms: %u", state.ElidedPipelineChanges, state.ElidedUniforms);
+
+            RenderQueueStats queues = RenderQueue::GetStats();
+            ImGui::Text("QUEUES: Commands: %u, draws: %u, executions: %u", queues.Commands, queues.Draws, queues.Executions);
+            ImGui::Text("QUEUES: Recording threads: %u", queues.RecordingThreads);
         }
         ImGui::End();
 
@@ -335,6 +376,32 @@ namespace Debut
                 ScopedStyleVar var(ImGuiStyleVar_FramePadding, { 0.0f, 0.0f });
                 ImGui::Checkbox("Render colliders", &currSceneConfig.RenderColliders);
             }
+            {
+                ScopedStyleVar var(ImGuiStyleVar_FramePadding, { 0.0f, 0.0f });
+                ImGui::Checkbox("Cache static shadows", &currSceneConfig.CacheStaticShadows);
+            }
+            {
+                ScopedStyleVar var(ImGuiStyleVar_FramePadding, { 0.0f, 0.0f });
+                ImGui::Checkbox("Clustered lighting", &currSceneConfig.ClusteredLighting);
+            }
+            {
+                ScopedStyleVar var(ImGuiStyleVar_FramePadding, { 0.0f, 0.0f });
+                ImGui::Checkbox("Occlusion culling", &currSceneConfig.OcclusionCulling);
+            }
+            {
+                ScopedStyleVar var(ImGuiStyleVar_FramePadding, { 0.0f, 0.0f });
+                ImGui::Checkbox("Automatic occluders", &currSceneConfig.AutoOccluders);
+            }
+            {
+                ScopedStyleVar var(ImGuiStyleVar_FramePadding, { 0.0f, 0.0f });
+                ImGui::Checkbox("Instanced sprites", &currSceneConfig.InstancedSprites);
+            }
+            {
+                ScopedStyleVar var(ImGuiStyleVar_FramePadding, { 0.0f, 0.0f });
+                int interval = (int)currSceneConfig.FarCascadeUpdateInterval;
+                if (ImGui::InputInt("Far cascades interval", &interval))
+                    currSceneConfig.FarCascadeUpdateInterval = (uint32_t)std::max(interval, 1);
+            }
 
             ImGui::Dummy({ 0.0f, 3.0f });
 
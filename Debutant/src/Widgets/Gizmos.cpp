@@ -88,6 +88,7 @@ namespace Debut
                 tc.Translation = finalTrans;
                 tc.Rotation += deltaRot;
                 tc.Scale = finalScale;
+                currSelection.MarkChanged<TransformComponent>();
             }
         }
 	}
@@ -89,6 +89,9 @@ void main()
 
 #define N_MAX_LIGHTS	16
 #define N_SHADOW_MAPS	4
+#define N_CLUSTERS_X	16
+#define N_CLUSTERS_Y	9
+#define N_CLUSTERS_Z	24
 
 struct PointLight
 {
@@ -146,6 +149,15 @@ uniform vec3 u_AmbientLightColor;
 uniform int u_NPointLights;
 uniform PointLight u_PointLights[N_MAX_LIGHTS];
 
+// Clustered lighting: lights are read from buffers, each cluster has a range in the list of light indices
+uniform int u_ClusteredLighting;
+uniform mat4 u_ProjectionMatrix;
+uniform float u_ClusterDepthScale;
+uniform float u_ClusterDepthBias;
+uniform samplerBuffer u_ClusterLights;
+uniform usamplerBuffer u_ClusterRanges;
+uniform usamplerBuffer u_ClusterLightIndices;
+
 uniform ShadowMap u_ShadowMaps[N_SHADOW_MAPS];
 uniform float u_ShadowFadeoutStart;
 uniform float u_ShadowFadeoutEnd;
@@ -181,6 +193,28 @@ vec3 DirectionalPhong(vec3 normal, vec3 lightDir, vec3 viewDir, vec2 texCoords)
     return (diff + spec) * u_DirectionalLightCol * u_DirectionalLightIntensity;
 }
 
+int GetCluster(vec3 viewPos)
+{
+	vec4 clip = u_ProjectionMatrix * vec4(viewPos, 1.0);
+	vec2 tile = clamp((clip.xy / clip.w * 0.5 + 0.5) * vec2(N_CLUSTERS_X, N_CLUSTERS_Y), vec2(0.0), vec2(N_CLUSTERS_X - 1, N_CLUSTERS_Y - 1));
+	float slice = clamp(log(max(-viewPos.z, 0.0001)) * u_ClusterDepthScale + u_ClusterDepthBias, 0.0, float(N_CLUSTERS_Z - 1));
+	
+	return int(tile.x) + int(tile.y) * N_CLUSTERS_X + int(slice) * N_CLUSTERS_X * N_CLUSTERS_Y;
+}
+
+PointLight GetClusterLight(int index)
+{
+	vec4 positionRadius = texelFetch(u_ClusterLights, index * 2);
+	vec4 colorIntensity = texelFetch(u_ClusterLights, index * 2 + 1);
+	
+	PointLight light;
+	light.Position = positionRadius.xyz;
+	light.Radius = positionRadius.w;
+	light.Color = colorIntensity.rgb;
+	light.Intensity = colorIntensity.a;
+	return light;
+}
+
 vec3 PointPhong(vec3 normal, PointLight light, vec3 viewDir, vec3 lightDir, vec2 texCoords)
 {
 	// Attenuation
@@ -314,8 +348,10 @@ void main()
 	// Sample normalmap
 	if (u_NormalMap.Use)
 	{
-		normal = normalize(v_TangentSpace * vec3(vec4(u_NormalMap.Intensity, u_NormalMap.Intensity, 1.0, 1.0) * 
-			(texture(u_NormalMap.Sampler, texCoords * u_NormalMap.Tiling + u_NormalMap.Offset) * 2 - 1)));
+		// Rebuild Z from XY so that two channel (BC5) normal maps work too
+		vec2 normalXY = texture(u_NormalMap.Sampler, texCoords * u_NormalMap.Tiling + u_NormalMap.Offset).xy * 2 - 1;
+		vec3 tangentNormal = vec3(normalXY * u_NormalMap.Intensity, sqrt(max(1.0 - dot(normalXY, normalXY), 0.0)));
+		normal = normalize(v_TangentSpace * tangentNormal);
 	}
 	
 	// Compute shadows
@@ -327,8 +363,20 @@ void main()
 			texColor * vec4(shadow * DirectionalPhong(normal, lightDir, fragToCamera, texCoords), 1.0);
 	
 	// Get point lights color
-	for (int i=0; i<u_NPointLights; i++)
-		color += texColor * vec4(PointPhong(normal, u_PointLights[i], fragToCamera, u_PointLights[i].Position - v_FragPos, texCoords), 1.0);
+	if (u_ClusteredLighting != 0)
+	{
+		uvec2 range = texelFetch(u_ClusterRanges, GetCluster(v_FragPosView)).xy;
+		for (uint i=0u; i<range.y; i++)
+		{
+			PointLight light = GetClusterLight(int(texelFetch(u_ClusterLightIndices, int(range.x + i)).r));
+			color += texColor * vec4(PointPhong(normal, light, fragToCamera, light.Position - v_FragPos, texCoords), 1.0);
+		}
+	}
+	else
+	{
+		for (int i=0; i<u_NPointLights; i++)
+			color += texColor * vec4(PointPhong(normal, u_PointLights[i], fragToCamera, u_PointLights[i].Position - v_FragPos, texCoords), 1.0);
+	}
 	
 	// Occlusion
 	if (u_OcclusionMap.Use)
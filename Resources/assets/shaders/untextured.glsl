@@ -17,6 +17,7 @@ uniform mat4 u_Transform;
 out vec4 v_Color;
 out vec3 v_Normal;
 out vec3 v_FragPos;
+out vec3 v_FragPosView;
 
 out mat3 v_TangentSpace;
 out vec3 v_CameraPosTangent;
@@ -42,6 +43,7 @@ void main()
 	mat3 inverseTangentSpace = transpose(v_TangentSpace);
 	
 	v_FragPos = vec3(u_Transform * vec4(a_Position, 1.0));
+	v_FragPosView = vec3(u_ViewMatrix * vec4(v_FragPos, 1.0));
 	v_CameraPosTangent = inverseTangentSpace * u_CameraPosition;
 	v_FragPosTangent = inverseTangentSpace * v_FragPos;
 	v_EntityID = a_EntityID;
@@ -53,6 +55,9 @@ void main()
 #version 410
 
 #define N_MAX_LIGHTS	16
+#define N_CLUSTERS_X	16
+#define N_CLUSTERS_Y	9
+#define N_CLUSTERS_Z	24
 
 struct PointLight
 {
@@ -66,6 +71,7 @@ struct PointLight
 in vec4 v_Color;
 in vec3 v_Normal;
 in vec3 v_FragPos;
+in vec3 v_FragPosView;
 flat in int v_EntityID;
 
 in mat3 v_TangentSpace;
@@ -87,6 +93,15 @@ uniform vec3 u_AmbientLightColor;
 uniform int u_NPointLights;
 uniform PointLight u_PointLights[N_MAX_LIGHTS];
 
+// Clustered lighting: lights are read from buffers, each cluster has a range in the list of light indices
+uniform int u_ClusteredLighting;
+uniform mat4 u_ProjectionMatrix;
+uniform float u_ClusterDepthScale;
+uniform float u_ClusterDepthBias;
+uniform samplerBuffer u_ClusterLights;
+uniform usamplerBuffer u_ClusterRanges;
+uniform usamplerBuffer u_ClusterLightIndices;
+
 
 vec3 DirectionalPhong(vec3 normal, vec3 lightDir, vec3 viewDir)
 {
@@ -101,6 +116,28 @@ vec3 DirectionalPhong(vec3 normal, vec3 lightDir, vec3 viewDir)
     return (diff + spec) * u_DirectionalLightCol * u_DirectionalLightIntensity;
 }
 
+int GetCluster(vec3 viewPos)
+{
+	vec4 clip = u_ProjectionMatrix * vec4(viewPos, 1.0);
+	vec2 tile = clamp((clip.xy / clip.w * 0.5 + 0.5) * vec2(N_CLUSTERS_X, N_CLUSTERS_Y), vec2(0.0), vec2(N_CLUSTERS_X - 1, N_CLUSTERS_Y - 1));
+	float slice = clamp(log(max(-viewPos.z, 0.0001)) * u_ClusterDepthScale + u_ClusterDepthBias, 0.0, float(N_CLUSTERS_Z - 1));
+	
+	return int(tile.x) + int(tile.y) * N_CLUSTERS_X + int(slice) * N_CLUSTERS_X * N_CLUSTERS_Y;
+}
+
+PointLight GetClusterLight(int index)
+{
+	vec4 positionRadius = texelFetch(u_ClusterLights, index * 2);
+	vec4 colorIntensity = texelFetch(u_ClusterLights, index * 2 + 1);
+	
+	PointLight light;
+	light.Position = positionRadius.xyz;
+	light.Radius = positionRadius.w;
+	light.Color = colorIntensity.rgb;
+	light.Intensity = colorIntensity.a;
+	return light;
+}
+
 vec3 PointPhong(vec3 normal, PointLight light, vec3 viewDir, vec3 lightDir)
 {
 	// Attenuation
@@ -132,10 +169,22 @@ void main()
 	color = texColor * vec4(u_AmbientLightColor*u_AmbientLightIntensity, 1.0) + 
 			texColor * vec4(DirectionalPhong(normal, lightDir, u_CameraPosition - v_FragPos), 1.0);
 	
-	for (int i=0; i<u_NPointLights; i++)
-		color += texColor * vec4(PointPhong
-			(normal, u_PointLights[i], u_CameraPosition - v_FragPos, 
-			u_PointLights[i].Position - v_FragPos), 1.0);
+	if (u_ClusteredLighting != 0)
+	{
+		uvec2 range = texelFetch(u_ClusterRanges, GetCluster(v_FragPosView)).xy;
+		for (uint i=0u; i<range.y; i++)
+		{
+			PointLight light = GetClusterLight(int(texelFetch(u_ClusterLightIndices, int(range.x + i)).r));
+			color += texColor * vec4(PointPhong(normal, light, u_CameraPosition - v_FragPos, light.Position - v_FragPos), 1.0);
+		}
+	}
+	else
+	{
+		for (int i=0; i<u_NPointLights; i++)
+			color += texColor * vec4(PointPhong
+				(normal, u_PointLights[i], u_CameraPosition - v_FragPos, 
+				u_PointLights[i].Position - v_FragPos), 1.0);
+	}
 	
 	id = v_EntityID;
 }
\ No newline at end of file